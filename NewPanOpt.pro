@@ -25,6 +25,8 @@ DEFINES -= UNICODE QT_LARGEFILE_SUPPORT
 TARGET = NewPanOpt
 #LIBS += -lgmpxx -lgmp
 LIBS += -pthread
+# Compiles the PROFILE_ZONE markers of utils/profiler.h into the library
+#DEFINES += PROFILER
 
 CONFIG(release, debug|release) {
     #message("NewPanOpt: Release mode!")
@@ -112,6 +114,7 @@ HEADERS += include/debug.h \
            include/lp/model.h \
            include/lp/modelbuilder.h \
            include/lp/manualmodelbuilder.h \
+           include/lp/modelsnapshot.h \
            include/lp/variable.h \
            include/lp/constraint.h \
            include/lp/mpsproblem.h \
@@ -142,6 +145,7 @@ HEADERS += include/debug.h \
            include/simplex/basisheadio.h \
            include/simplex/basisheadbas.h \
            include/utils/arch/x86.h \
+           include/utils/arch/x86simd.h \
            include/utils/numerical.h \
            include/utils/elementproducer.h \
            include/utils/file.h \
@@ -161,10 +165,16 @@ HEADERS += include/debug.h \
            include/utils/colors.h \
            include/utils/platform.h \
            include/utils/hashtable.h \
+           include/utils/nametable.h \
+           include/utils/namepool.h \
+           include/utils/processpool.h \
            include/utils/thread.h \
            include/utils/iterationreport.h \
            include/utils/iterationreportprovider.h \
            include/utils/iterationreportfield.h \
+           include/utils/iterationtrace.h \
+           include/utils/profiler.h \
+           include/utils/perfcounters.h \
            include/utils/entry.h \
            include/utils/sha1.h \
            include/utils/datetime.h \
@@ -198,6 +208,8 @@ HEADERS += include/debug.h \
     include/utils/multiplefloat.h \
     include/utils/stacktrace.h \
     include/simplex/simplexthread.h \
+    include/simplex/simplexengine.h \
+    include/simplex/scratchbuffers.h \
     include/simplex/pricing/primalsteepestedgepricing.h \
     include/simplex/pricing/primaldevexpricing.h \
     include/lp/hilbertmodelbuilder.h \
@@ -213,6 +225,7 @@ SOURCES += src/linalg/matrix.cpp \
            src/linalg/linalgparameterhandler.cpp \
            src/lp/model.cpp \
            src/lp/manualmodelbuilder.cpp \
+           src/lp/modelsnapshot.cpp \
            src/lp/variable.cpp \
            src/lp/constraint.cpp \
            src/lp/mpsproblem.cpp \
@@ -241,6 +254,7 @@ SOURCES += src/linalg/matrix.cpp \
            src/simplex/checker.cpp \
            src/simplex/primalpricing.cpp \
            src/utils/arch/x86.cpp \
+           src/utils/arch/x86simd.cpp \
            src/utils/file.cpp \
            src/utils/numerical.cpp \
            src/utils/timer.cpp \
@@ -248,7 +262,12 @@ SOURCES += src/linalg/matrix.cpp \
            src/utils/outputhandler.cpp \
            src/utils/memoryman.cpp \
            src/utils/hashtable.cpp \
+           src/utils/namepool.cpp \
+           src/utils/processpool.cpp \
            src/utils/iterationreport.cpp \
+           src/utils/iterationtrace.cpp \
+           src/utils/profiler.cpp \
+           src/utils/perfcounters.cpp \
            src/utils/sha1.cpp \
            src/utils/datetime.cpp \
            src/utils/system.cpp \
@@ -67,8 +67,12 @@ INCLUDEPATH += . \
 
 
 #Sources
+HEADERS += \
+    standalones/standaloneutils.h
+
 SOURCES += \
-    standalones/solver.cpp
+    standalones/solver.cpp \
+    standalones/standaloneutils.cpp
 
 
 #OBJECTS_DIR = .o
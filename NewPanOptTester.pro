@@ -9,6 +9,7 @@ CONFIG += console
 TARGET = NewPanOptTester
 
 LIBS += -pthread
+LIBS += -lsqlite3
 
 CONFIG(release, debug|release) {
     message("NewPanOptTester: Release mode!")
@@ -33,6 +34,7 @@ CONFIG(debug, debug|release) {
 #Includes
 INCLUDEPATH += . \
                include/ \
+               include/utils/thirdparty \
                test/
 
 #Input
@@ -52,6 +54,8 @@ HEADERS += test/framework/tester.h \
     test/outputhandlertest.h \ #\
     test/coretest.h \
     test/sparsevectortest.h \
+    test/densevectortest.h \
+    test/presolvertest.h \
     test/framework/report.h \
     test/framework/reportgenerator.h \
     test/framework/htmlreportgenerator.h \
@@ -75,6 +79,8 @@ SOURCES += test/framework/tester.cpp \
     test/outputhandlertest.cpp \
     test/coretest.cpp \
     test/sparsevectortest.cpp \
+    test/densevectortest.cpp \
+    test/presolvertest.cpp \
     test/framework/report.cpp \
     test/framework/htmlreportgenerator.cpp \
     test/framework/latexreportgenerator.cpp \
@@ -7,6 +7,9 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <dirent.h>
 #include <sys/stat.h>
 
@@ -29,6 +32,11 @@
     #define PATH_SEPARATOR '\\'
 #else
     #define PATH_SEPARATOR '/'
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <unistd.h>
+    #include <sys/resource.h>
+    #include <sys/wait.h>
 #endif
 
 const std::string outputName("result.txt");
@@ -257,7 +265,7 @@ std::string to_string_scientific(const T a_value, const int n = 6)
 }
 
 void printHelp() {
-    std::cout << "Usage: GBACGenerator [APPLICATION] [SWEEP] \n" <<
+    std::cout << "Usage: GBACGenerator [OPTION] [APPLICATION] [SWEEP] \n" <<
                  "Generate paramter sweep files of the application specified by \n"<<
                  "application descriptor file [APPLICATION] using sweep descriptor \n"<<
                  "file [SWEEPFILE]\n"<<
@@ -265,6 +273,12 @@ void printHelp() {
                  "Application specific parameters can be set in the .GAD application descriptor. \n"<<
                  "Sweep specific parameters can be set in the .GSD sweep descriptor. \n"<<
                  "\n"<<
+                 "   -l, --local     \t Run the jobs of the sweep on this machine instead of generating \n"<<
+                 "                   \t the GBAC script, and collect their output into " << outputName << ".\n"<<
+                 "                   \t An interrupted local sweep continues with the unfinished jobs.\n"<<
+                 "   -j, --jobs      \t The number of jobs running at once in local mode.\n"<<
+                 "   -t, --time      \t The time limit of a job in seconds in local mode.\n"<<
+                 "   -m, --memory    \t The memory limit of a job in megabytes in local mode.\n"<<
                  "   -h, --help      \t Displays this help.\n"<<
                  "\n";
 }
@@ -787,6 +801,52 @@ void computeParameter(std::vector<std::map<std::string, std::string> >* values,
     }
 }
 
+std::string buildParameterArguments(const ApplicationConfiguration& application,
+                                    const std::map<std::string, std::string>& values){
+    std::string line;
+    line.append("./" + application.applicationName + " ");
+    //Print parameters
+    std::string nameid("$PARAMETER_NAME");
+    std::string valueid("$PARAMETER_VALUE");
+    for(auto it = values.cbegin(); it != values.cend(); ++it){
+        std::string parameter(application.parameterSyntax);
+        std::string::size_type namepos = parameter.find(nameid);
+        if(namepos == std::string::npos){
+            throw ConsistencyException();
+        }
+        parameter.replace(namepos, nameid.length(), it->first);
+        std::string::size_type valuepos = parameter.find(valueid);
+        if(valuepos == std::string::npos){
+            throw ConsistencyException();
+        }
+        parameter.replace(valuepos, valueid.length(), it->second);
+        line.append(parameter + " ");
+    }
+    return line;
+}
+
+std::string buildProblemArguments(const ApplicationConfiguration& application,
+                                  const std::string& problemName,
+                                  const std::string& outputFile){
+    //Print problem syntax
+    std::string problem(application.problemSyntax);
+    std::string problemid("$PROBLEM_NAME");
+    std::string::size_type problempos = problem.find(problemid);
+    if(problempos == std::string::npos){
+        throw ConsistencyException();
+    }
+    problem.replace(problempos, problemid.length(), problemName);
+    //Print output syntax
+    std::string output(application.outputSyntax);
+    std::string outputid("$OUTPUT_NAME");
+    std::string::size_type outputpos = output.find(outputid);
+    if(outputpos == std::string::npos){
+        throw ConsistencyException();
+    }
+    output.replace(outputpos, outputid.length(), outputFile);
+    return problem + " " + output;
+}
+
 unsigned int generateArglists(const ApplicationConfiguration& application, const SweepConfiguration& sweep){
     std::vector<std::map<std::string, std::string> > values;
     std::map<std::string, std::string> actualMap;
@@ -798,53 +858,13 @@ unsigned int generateArglists(const ApplicationConfiguration& application, const
     mkdirCommand += sweep.sweepName;
     system(mkdirCommand.c_str());
     for(arglistCount=0; arglistCount<values.size(); arglistCount++){
-        //Print command
-        std::string line;
-        line.append("./" + sweep.applicationName + " ");
-        //Print parameters
-        std::string nameid("$PARAMETER_NAME");
-        std::string valueid("$PARAMETER_VALUE");
-        for(auto it = values[arglistCount].cbegin(); it != values[arglistCount].cend(); ++it){
-            std::string parameter(application.parameterSyntax);
-            unsigned int namepos = parameter.find(nameid);
-            if(namepos == std::string::npos){
-                throw ConsistencyException();
-                return 0;
-            }
-            parameter.replace(namepos, nameid.length(), it->first);
-            unsigned int valuepos = parameter.find(valueid);
-            if(valuepos == std::string::npos){
-                throw ConsistencyException();
-                return 0;
-            }
-            parameter.replace(valuepos, valueid.length(), it->second);
-            line.append(parameter + " ");
-        }
-        //Print output syntax
-        std::string output(application.outputSyntax);
-        std::string outputid("$OUTPUT_NAME");
-        unsigned int outputpos = output.find(outputid);
-        if(outputpos == std::string::npos){
-            throw ConsistencyException();
-            return 0;
-        }
-        output.replace(outputpos, outputid.length(), outputName);
+        std::string line = buildParameterArguments(application, values[arglistCount]);
 
         std::ofstream arglist;
         arglist.open("arglists/"+sweep.sweepName+"/arglist_"+std::to_string(arglistCount)+".txt");
         std::cout << "arglists/"+sweep.sweepName+"/arglist_"+std::to_string(arglistCount)+".txt" << " : \n";
         for(auto it = sweep.problems.cbegin(); it != sweep.problems.cend(); ++it){
-            std::string outline;
-            //Print problem syntax
-            std::string problem(application.problemSyntax);
-            std::string problemid("$PROBLEM_NAME");
-            unsigned int problempos = problem.find(problemid);
-            if(problempos == std::string::npos){
-                throw ConsistencyException();
-                return 0;
-            }
-            problem.replace(problempos, problemid.length(), *it);
-            outline = line + problem  + " " + output + "\n";
+            std::string outline = line + buildProblemArguments(application, *it, outputName) + "\n";
             arglist << outline;
             std::cout << outline;
         }
@@ -854,6 +874,218 @@ unsigned int generateArglists(const ApplicationConfiguration& application, const
     return arglistCount;
 }
 
+#ifndef WIN32
+struct LocalConfiguration{
+    unsigned int jobs;
+    unsigned int timeLimit;
+    unsigned int memoryLimit;
+};
+
+struct LocalJob{
+    enum JOB_STATE{
+        WAITING,
+        RUNNING,
+        FINISHED,
+        FAILED,
+        TIMED_OUT,
+        JOB_STATE_ENUM_LENGTH
+    };
+
+    std::string command;
+    std::string outputFile;
+    pid_t pid;
+    std::chrono::steady_clock::time_point start;
+    bool killed;
+    JOB_STATE state;
+};
+
+const char * jobStateToString(LocalJob::JOB_STATE state){
+    switch(state){
+    case LocalJob::FINISHED:
+        return "FINISHED";
+    case LocalJob::FAILED:
+        return "FAILED";
+    case LocalJob::TIMED_OUT:
+        return "TIMED_OUT";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * Reads the journal of a previous local run of the sweep.
+ * Every line of the journal is a finished job: its index and its final state.
+ */
+void readJournal(const std::string& journalPath, std::vector<LocalJob>* jobs){
+    std::ifstream journal(journalPath);
+    unsigned int index;
+    std::string state;
+    while(journal >> index >> state){
+        if(index >= jobs->size()){
+            continue;
+        }
+        for(int stateIndex = LocalJob::FINISHED; stateIndex < LocalJob::JOB_STATE_ENUM_LENGTH; stateIndex++){
+            if(state.compare(jobStateToString((LocalJob::JOB_STATE)stateIndex)) == 0){
+                (*jobs)[index].state = (LocalJob::JOB_STATE)stateIndex;
+            }
+        }
+    }
+}
+
+void startLocalJob(LocalJob* job, const LocalConfiguration& local){
+    std::cout.flush();
+    job->start = std::chrono::steady_clock::now();
+    job->killed = false;
+    job->pid = fork();
+    if(job->pid < 0){
+        std::cout << "Unable to start the job: " << job->command << "\n";
+        job->state = LocalJob::FAILED;
+        return;
+    }
+    if(job->pid == 0){
+        //The job gets its own process group, so the time limit stops the processes started by the shell too
+        setpgid(0, 0);
+        //The output of the job is collected in its own file, the output syntax appends to it too
+        int outputFd = open(job->outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        if(outputFd >= 0){
+            dup2(outputFd, STDOUT_FILENO);
+            dup2(outputFd, STDERR_FILENO);
+            close(outputFd);
+        }
+        if(local.memoryLimit > 0){
+            struct rlimit limit;
+            limit.rlim_cur = limit.rlim_max = (rlim_t)local.memoryLimit * 1024 * 1024;
+            setrlimit(RLIMIT_AS, &limit);
+        }
+        if(local.timeLimit > 0){
+            struct rlimit limit;
+            limit.rlim_cur = limit.rlim_max = local.timeLimit;
+            setrlimit(RLIMIT_CPU, &limit);
+        }
+        execl("/bin/sh", "sh", "-c", job->command.c_str(), (char*)NULL);
+        _exit(127);
+    }
+    job->state = LocalJob::RUNNING;
+}
+
+/**
+ * Runs the jobs of the sweep on the local machine instead of the GBAC grid.
+ * The jobs are the lines of the arglists, at most local.jobs of them run at once.
+ * The finished jobs are written into a journal, so an interrupted sweep continues
+ * with the unfinished jobs when it is started again. At the end the outputs of the
+ * jobs are collected into the result file, in the order of the arglists.
+ */
+void runLocally(const ApplicationConfiguration& application, const SweepConfiguration& sweep,
+                const LocalConfiguration& local){
+    std::vector<std::map<std::string, std::string> > values;
+    std::map<std::string, std::string> actualMap;
+    computeParameter(&values, &actualMap, 0, sweep);
+
+    std::string localDir = "arglists/" + sweep.sweepName + "/local";
+    std::string mkdirCommand = "mkdir -p " + localDir;
+    system(mkdirCommand.c_str());
+    std::string journalPath = localDir + "/journal.txt";
+
+    std::vector<LocalJob> jobs;
+    for(unsigned int arglistIndex = 0; arglistIndex < values.size(); arglistIndex++){
+        std::string line = buildParameterArguments(application, values[arglistIndex]);
+        for(unsigned int problemIndex = 0; problemIndex < sweep.problems.size(); problemIndex++){
+            LocalJob job;
+            job.outputFile = localDir + "/job_" + std::to_string(arglistIndex) + "_" +
+                    std::to_string(problemIndex) + ".txt";
+            job.command = line + buildProblemArguments(application, sweep.problems[problemIndex], job.outputFile);
+            job.pid = 0;
+            job.killed = false;
+            job.state = LocalJob::WAITING;
+            jobs.push_back(job);
+        }
+    }
+    readJournal(journalPath, &jobs);
+    std::ofstream journal(journalPath, std::ios::out | std::ios::app);
+
+    unsigned int next = 0;
+    unsigned int running = 0;
+    unsigned int finished = 0;
+    for(unsigned int i = 0; i < jobs.size(); i++){
+        if(jobs[i].state != LocalJob::WAITING){
+            finished++;
+        }
+    }
+    std::cout << "Running " << jobs.size() << " jobs locally, " << finished << " finished earlier.\n";
+    while(finished < jobs.size()){
+        while(running < local.jobs && next < jobs.size()){
+            LocalJob& job = jobs[next++];
+            if(job.state != LocalJob::WAITING){
+                continue;
+            }
+            std::cout << "Executing the following command: " << job.command << "\n";
+            startLocalJob(&job, local);
+            if(job.state == LocalJob::RUNNING){
+                running++;
+            } else {
+                journal << (&job - &jobs[0]) << " " << jobStateToString(job.state) << std::endl;
+                finished++;
+            }
+        }
+
+        bool changed = false;
+        int status;
+        pid_t pid;
+        while(running > 0 && (pid = waitpid(-1, &status, WNOHANG)) > 0){
+            for(unsigned int i = 0; i < jobs.size(); i++){
+                LocalJob& job = jobs[i];
+                if(job.state == LocalJob::RUNNING && job.pid == pid){
+                    if(job.killed || (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU)){
+                        job.state = LocalJob::TIMED_OUT;
+                    } else if(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS){
+                        job.state = LocalJob::FINISHED;
+                    } else {
+                        job.state = LocalJob::FAILED;
+                    }
+                    journal << i << " " << jobStateToString(job.state) << std::endl;
+                    std::cout << "Job " << i << " " << jobStateToString(job.state) << "\n";
+                    running--;
+                    finished++;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+
+        if(local.timeLimit > 0){
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            for(unsigned int i = 0; i < jobs.size(); i++){
+                LocalJob& job = jobs[i];
+                if(job.state == LocalJob::RUNNING && !job.killed &&
+                        now - job.start >= std::chrono::seconds(local.timeLimit)){
+                    kill(-job.pid, SIGKILL);
+                    job.killed = true;
+                }
+            }
+        }
+
+        if(!changed){
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    journal.close();
+
+    std::ofstream result(outputName, std::ios::out | std::ios::trunc);
+    for(unsigned int i = 0; i < jobs.size(); i++){
+        result << "\nExecuting the following command: " << jobs[i].command << '\n';
+        std::ifstream output(jobs[i].outputFile, std::ios::binary);
+        if(output.is_open() && output.peek() != std::ifstream::traits_type::eof()){
+            result << output.rdbuf();
+        }
+        if(jobs[i].state != LocalJob::FINISHED){
+            result << "\nJob " << jobStateToString(jobs[i].state) << "\n";
+        }
+    }
+    result.close();
+    std::cout << "Results collected into " << outputName << "\n";
+}
+#endif
+
 enum ScriptType
 {
     METAJOB
@@ -881,17 +1113,50 @@ int main(int argc, char** argv)
     setbuf(stdout, 0);
     ApplicationConfiguration application;
     SweepConfiguration sweep;
+    bool localRun = false;
+#ifndef WIN32
+    LocalConfiguration local;
+    local.jobs = std::max(1u, std::thread::hardware_concurrency());
+    local.timeLimit = 0;
+    local.memoryLimit = 0;
+#endif
+    std::vector<std::string> descriptors;
+    for(int i = 1; i < argc; i++){
+        std::string arg(argv[i]);
+        if(arg.compare("-l") == 0 || arg.compare("--local") == 0){
+            localRun = true;
+#ifndef WIN32
+        } else if(i+1 < argc && (arg.compare("-j") == 0 || arg.compare("--jobs") == 0)){
+            local.jobs = std::max(1, atoi(argv[++i]));
+        } else if(i+1 < argc && (arg.compare("-t") == 0 || arg.compare("--time") == 0)){
+            local.timeLimit = std::max(0, atoi(argv[++i]));
+        } else if(i+1 < argc && (arg.compare("-m") == 0 || arg.compare("--memory") == 0)){
+            local.memoryLimit = std::max(0, atoi(argv[++i]));
+#endif
+        } else {
+            descriptors.push_back(arg);
+        }
+    }
 
-    if(argc == 3){
-        std::string applicationDescriptorPath = argv[1];
-        std::string sweepDescriptorPath = argv[2];
+    if(descriptors.size() == 2){
+        std::string applicationDescriptorPath = descriptors[0];
+        std::string sweepDescriptorPath = descriptors[1];
         if(isFile(applicationDescriptorPath) && isFile(sweepDescriptorPath)){
             try{
                 parseApplicationDescriptor(&application, applicationDescriptorPath);
                 parseSweepDescriptor(&sweep, sweepDescriptorPath);
                 checkConsistency(application, sweep);
-                unsigned int arglistCount = generateArglists(application, sweep);
-                generateScript(arglistCount, sweep);
+                if(localRun){
+#ifndef WIN32
+                    runLocally(application, sweep, local);
+#else
+                    std::cout << "Local runs are not supported on this platform! \n";
+                    return EXIT_FAILURE;
+#endif
+                } else {
+                    unsigned int arglistCount = generateArglists(application, sweep);
+                    generateScript(arglistCount, sweep);
+                }
             } catch ( const SyntaxErrorException & exception ) {
                 exception.show();
                 return EXIT_FAILURE;
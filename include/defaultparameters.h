@@ -29,13 +29,20 @@ public:
     static const double E_ABSOLUTE;
     static const double E_RELATIVE;
     static const double SPARSITY_RATIO;
+    static const double UNCALIBRATED_SPARSITY_RATIO;
     static const int ELBOWROOM;
+    static const char * FTRAN_ADD_MODE;
+    static const char * BTRAN_ADD_MODE;
+    static const bool ETA_STATISTICS;
+    static const int HUGE_PAGE_THRESHOLD;
 
     //Simplex Parameters
 
     class NumericalInstability {
     public:
         static const bool ENABLE_NUMERICAL_INSTABILITY_DETECTION;
+        static const int REFINEMENT_PASSES;
+        static const double E_REFINEMENT;
     };
 
     //Parallel
@@ -44,6 +51,7 @@ public:
         static const bool ENABLE_PARALLELIZATION;
         static const bool ENABLE_THREAD_SYNCHRONIZATION;
         static const int NUMBER_OF_THREADS;
+        static const bool ENABLE_NUMA_BINDING;
     };
 
     //Tolerances
@@ -66,6 +74,9 @@ public:
         public:
             static const bool ENABLE;
             static const char * TYPE;
+            static const int MAX_ITERATIONS;
+            static const double CONVERGENCE_TOLERANCE;
+            static const int NUMBER_OF_THREADS;
         };
 
         class Basis {
@@ -176,8 +187,18 @@ public:
             static const char * TYPE;
         };
 
+        class Trace {
+        public:
+            static const bool ENABLE;
+            static const int CAPACITY;
+            static const char * FILENAME;
+            static const char * FORMAT;
+        };
+
         static const bool BATCH_OUTPUT;
         static const int BATCH_SIZE;
+        static const bool PERFORMANCE_COUNTERS;
+        static const bool SIMPLEX_ENGINE;
     };
 
     //Parallelization
@@ -33,7 +33,13 @@ public:
 
     static void threadRelease();
 
+    // Applies the linalg parameters to the globals cached at initialization,
+    // it has to be called after the linalg parameters are changed
+    static void applyLinalgParameters();
+
     const ArchitectureInterface & getArchitecture() const;
+
+    ArchitectureInterface & getArchitecture();
 private:
     static thread_local ArchitectureInterface * sm_architecture;
 
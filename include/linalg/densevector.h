@@ -35,6 +35,7 @@ class DenseVector {
     friend class SparseVector;
     friend class PfiBasis;
     friend class LuBasis;
+    friend class DenseVectorTestSuite;
 
     //TODO remove, debug only
     friend class DualSimplex;
@@ -44,6 +45,47 @@ private:
 
     unsigned int m_length;
 
+    /**
+     * Indices of the elements which can be nonzero while the vector is sparse.
+     * It is nullptr if the vector does not track its nonzeros, see setNonzeroTracking().
+     */
+    unsigned int * m_nonzeroIndices;
+
+    /**
+     * Marks the elements listed in m_nonzeroIndices, so an index is listed only once.
+     */
+    bool * m_nonzeroMarks;
+
+    /**
+     * Number of the listed indices.
+     */
+    unsigned int m_nonzeroIndexCount;
+
+    /**
+     * Size of the m_nonzeroIndices and m_nonzeroMarks arrays.
+     */
+    unsigned int m_nonzeroIndexCapacity;
+
+    /**
+     * The index list is dropped when it grows beyond this limit.
+     */
+    unsigned int m_sparsityLimit;
+
+    /**
+     * True if the vector tracks its nonzeros, and the index list is still valid.
+     */
+    bool m_sparse;
+
+    /**
+     * True if the index list is in ascending order.
+     */
+    mutable bool m_nonzeroIndicesSorted;
+
+    /**
+     * The ratio of the tracked nonzeros and the length, above which the index list is dropped.
+     */
+    static Numerical::Double sm_sparsityRatio;
+
     template<class ADD>
     friend void addDenseToSparseTemplate(Numerical::Double lambda,
                                          SparseVector * vector1,
@@ -203,6 +245,9 @@ public:
      * @param value The new value.
      */
     ALWAYS_INLINE void set(unsigned int index, Numerical::Double value) {
+        if (m_sparse && value != 0.0) {
+            addNonzeroIndex(index);
+        }
         m_data[index] = value;
     }
 
@@ -392,6 +437,45 @@ public:
 
     void reInit(unsigned int length);
 
+    /**
+     * Enables or disables the tracking of the nonzero indices.
+     * A tracking vector lists the indices of its nonzero elements while its density is below
+     * the sparsity_ratio linear algebra parameter, so the operations on it can skip the
+     * zeros. If the parameter is 0, the calibrated density limit of the architecture is
+     * used. Above this density the list is dropped, and the vector is handled as a normal
+     * dense vector until the next clear() or reInit(), which restart the tracking.
+     * Operations which do not maintain the list drop it too.
+     *
+     * @param enabled True to enable the tracking.
+     */
+    void setNonzeroTracking(bool enabled);
+
+    /**
+     * Returns true if the vector has a valid list of its nonzero indices.
+     *
+     * @return True if the nonzero indices are available.
+     */
+    ALWAYS_INLINE bool isSparse() const {
+        return m_sparse;
+    }
+
+    /**
+     * Returns the indices of the nonzero elements in ascending order, if isSparse() is true.
+     * The list can contain indices whose element became zero.
+     *
+     * @return Pointer to the array of the indices.
+     */
+    const unsigned int * getNonzeroIndices() const;
+
+    /**
+     * Returns the number of the indices listed by getNonzeroIndices().
+     *
+     * @return The number of the indices.
+     */
+    ALWAYS_INLINE unsigned int getNonzeroIndexCount() const {
+        return m_nonzeroIndexCount;
+    }
+
     friend std::ostream & operator<<(std::ostream & os, const DenseVector & vector);
 
 protected:
@@ -418,12 +502,54 @@ protected:
     static AddIndexedDenseToDense sm_addIndexedDenseToDense;
     static AddSparseToDense sm_addSparseToDense;
 
+    /**
+     * Adds a vector with nonzero index list, it visits only the listed elements.
+     */
+    static AddDenseToDense sm_addTrackedDenseToDense;
+
     static DenseToIndexedDenseDotProduct sm_denseToIndexedDenseDotProduct;
     static DenseToDenseDotProduct sm_denseToDenseDotProduct;
     static DenseToSparseDotProduct sm_denseToSparseDotProduct;
 
     static void _globalInit();
 
+    /**
+     * Lists the index of an element which becomes nonzero, and drops the list if the
+     * vector becomes too dense.
+     *
+     * @param index The index of the element.
+     */
+    ALWAYS_INLINE void addNonzeroIndex(unsigned int index) {
+        if (!m_nonzeroMarks[index]) {
+            m_nonzeroMarks[index] = true;
+            if (m_nonzeroIndexCount > 0 && m_nonzeroIndices[m_nonzeroIndexCount - 1] > index) {
+                m_nonzeroIndicesSorted = false;
+            }
+            m_nonzeroIndices[m_nonzeroIndexCount++] = index;
+            if (unlikely(m_nonzeroIndexCount > m_sparsityLimit)) {
+                m_sparse = false;
+            }
+        }
+    }
+
+    /**
+     * Drops the nonzero index list, it is called by the operations which do not maintain it.
+     */
+    ALWAYS_INLINE void dropNonzeroIndices() {
+        m_sparse = false;
+    }
+
+    /**
+     * Clears the elements and restarts the nonzero tracking.
+     * While the vector is sparse, only the listed elements are cleared.
+     */
+    void clearTracked();
+
+    /**
+     * Initializes the members of the nonzero tracking to an untracked state.
+     */
+    void initNonzeroTracking();
+
     /**
      *
      * @param orig
@@ -445,6 +571,10 @@ protected:
     void addDenseToDenseAbs(Numerical::Double lambda, const DenseVector & vector);
     void addDenseToDenseAbsRel(Numerical::Double lambda,  const DenseVector & vector);
 
+    void addTrackedDenseToDenseFast(Numerical::Double lambda, const DenseVector & vector);
+    void addTrackedDenseToDenseAbs(Numerical::Double lambda, const DenseVector & vector);
+    void addTrackedDenseToDenseAbsRel(Numerical::Double lambda, const DenseVector & vector);
+
     void addIndexedDenseToDenseFast(Numerical::Double lambda, const IndexedDenseVector & vector);
     void addIndexedDenseToDenseAbs(Numerical::Double lambda, const IndexedDenseVector & vector);
     void addIndexedDenseToDenseAbsRel(Numerical::Double lambda, const IndexedDenseVector & vector);
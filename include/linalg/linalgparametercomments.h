@@ -20,9 +20,22 @@
 const char * E_ABSOLUTE_COMMENT = "# Absolute tolerance";
 const char * E_RELATIVE_COMMENT = "# Relative tolerance for additive operations ";
 
-const char * SPARSITY_RATIO_COMMENT = "# Nonzero ratio used as a bound between sparse and dense vector forms";
+const char * SPARSITY_RATIO_COMMENT =
+        R"(# Nonzero ratio used as a bound between sparse and dense vector forms
+# 0: the calibrated limit of the architecture parameter file, or 0.45 if the machine is not calibrated)";
 const char * ELBOWROOM_COMMENT = "# The number of extra spaces reserved in vectors for new elements";
 
+const char * FTRAN_ADD_MODE_COMMENT =
+        R"(# Add mode of the eta updates in FTRAN
+# ADD_FAST | ADD_ABS | ADD_ABS_REL)";
+const char * BTRAN_ADD_MODE_COMMENT =
+        R"(# Add mode of the positive and negative sums of the dot products in BTRAN
+# ADD_FAST | ADD_ABS | ADD_ABS_REL)";
+const char * ETA_STATISTICS_COMMENT = "# Collect the rounding loss statistics of the FTRAN eta updates";
+
+const char * HUGE_PAGE_THRESHOLD_COMMENT =
+        "# Allocations of at least this many bytes are backed by transparent huge pages (0: disabled)";
+
 /********************************************
  * BLOCK COMMENTS
  * *****************************************/
@@ -75,6 +75,10 @@ public:
 
     /**
      * Builds the matrix using the builder object.
+     * The representation not given by the builder is computed by a transposition,
+     * which runs in parallel for large matrices. The vectors of the matrix are sorted
+     * after building, the vectors given by the builder are sorted only if the
+     * builder does not guarantee their order.
      * @see MatrixBuilder
      *
      * @param builder This object contains the matrix data.
@@ -357,6 +361,32 @@ public:
      */
     void scaleOnlyColumnwiseLambdas(unsigned int index, const std::vector<Numerical::Double> &lambdas);
 
+    /**
+     * Scales the elements of the given row by the column multipliers and by the
+     * row multiplier in one pass. It multiplies only in the rowwise form.
+     * The columnwise form must be updated manually when this function is used.
+     * Otherwise it will lead to undefined behaviour.
+     *
+     * @param index The index of the row to be scaled.
+     * @param lambdas The column multipliers.
+     * @param lambda The multiplier of the row.
+     */
+    void scaleOnlyRowwiseLambdas(unsigned int index, const std::vector<Numerical::Double> &lambdas,
+                                 Numerical::Double lambda);
+
+    /**
+     * Scales the elements of the given column by the row multipliers and by the
+     * column multiplier in one pass. It multiplies only in the columnwise form.
+     * The rowwise form must be updated manually when this function is used.
+     * Otherwise it will lead to undefined behaviour.
+     *
+     * @param index The index of the column to be scaled.
+     * @param lambdas The row multipliers.
+     * @param lambda The multiplier of the column.
+     */
+    void scaleOnlyColumnwiseLambdas(unsigned int index, const std::vector<Numerical::Double> &lambdas,
+                                    Numerical::Double lambda);
+
     /**
      * Inverts the matrix.
      * The invers is created using Gauss-Jordan elimination.
@@ -639,6 +669,22 @@ private:
      */
     void copy(const Matrix & matrix);
 
+    /**
+     * Builds the target vectors as the transpose of the source vectors. The nonzeros
+     * of each target vector are stored in increasing order of their indices.
+     * Large matrices are transposed by a parallel counting sort: each thread counts
+     * and then places the nonzeros of a contiguous range of source vectors.
+     *
+     * @param sources The source vectors.
+     * @param sourceCount The number of source vectors.
+     * @param targets The target vectors, their length is set to sourceCount.
+     * @param targetCount The number of target vectors.
+     * @param nonZeros The number of nonzeros in the source vectors.
+     */
+    static void transpose(SparseVector * const * sources, unsigned int sourceCount,
+                          SparseVector ** targets, unsigned int targetCount,
+                          unsigned long long int nonZeros);
+
     /**
      * Initializes the matrix with the size given by the parameters.
      * When initVectors is true, the vectors will be initialized, otherwise not.
@@ -84,6 +84,16 @@ public:
      * @return True if the matrix is stored columnwise.
      */
     virtual bool hasColumnwiseRepresentation() const = 0;
+
+    /**
+     * Returns true if the builder gives the nonzeros of each row and column
+     * in increasing order of their indices, so they need not be sorted.
+     *
+     * @return True if the built vectors are sorted.
+     */
+    virtual bool hasSortedVectors() const {
+        return false;
+    }
 };
 
 #endif	/* MATRIXBUILDER_H */
@@ -40,8 +40,10 @@ class SparseVector {
     friend class DenseVector;
     friend class IndexedDenseVector;
     friend class SparseVectorTestSuite;
+    friend class Basis;
     friend class PfiBasis;
     friend class LuBasis;
+    friend class Matrix;
 
     Numerical::Double * m_data;
 
@@ -336,6 +338,15 @@ public:
 
     void scaleByLambdas(const std::vector<Numerical::Double> &lambdas);
 
+    /**
+     * Scales each nonzero element by the lambda belonging to its index and by
+     * the common multiplier, in a single pass over the nonzeros.
+     *
+     * @param lambdas The index-wise scale factors.
+     * @param lambda The common scale factor.
+     */
+    void scaleByLambdas(const std::vector<Numerical::Double> &lambdas, Numerical::Double lambda);
+
     void scaleElementBy(unsigned int index, Numerical::Double lambda);
 
     bool operator==(const SparseVector& other) const;
@@ -351,14 +362,18 @@ public:
 
     ALWAYS_INLINE void prepareForData(const unsigned int nonZeros, const unsigned int length)
     {
+        m_length = length;
+        m_nonZeros = 0;
+        // a reused vector keeps its arrays if they are large enough
+        if (m_capacity >= nonZeros + sm_elbowRoom && m_data != nullptr) {
+            return;
+        }
         ::release(m_data);
         ::release(m_indices);
 
-        m_length = length;
         m_capacity = nonZeros + sm_elbowRoom;
         m_indices = alloc<unsigned int, 16>(nonZeros + sm_elbowRoom);
         m_data = Numerical::allocDouble(nonZeros + sm_elbowRoom);
-        m_nonZeros = 0;
     }
 
     ALWAYS_INLINE void newNonZero(const Numerical::Double value, const unsigned int index)
@@ -369,7 +384,8 @@ public:
     }
 
     /**
-     * Sorts the stored nonzero indices.
+     * Sorts the stored nonzero indices in ascending order, the values are moved with their indices.
+     * It is cheap if the indices are already sorted.
      */
     void sortIndices();
 
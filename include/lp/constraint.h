@@ -27,6 +27,7 @@
 #include <utils/numerical.h>
 #include <linalg/sparsevector.h>
 #include <utils/exceptions.h>
+#include <utils/namepool.h>
 
 /**
  * Represents a general constraint of an LP problem. The constraint has a name, an L lower bound
@@ -303,6 +304,14 @@ public:
      */
     inline void setName(const char * name);
 
+    /**
+     * Sets the constraint's name to a name already stored in the NamePool,
+     * without copying it.
+     *
+     * @param name The handle of the constraint's new name.
+     */
+    inline void setName(const PooledName & name);
+
     /**
      * Returns with the name of the constraint.
      *
@@ -310,6 +319,15 @@ public:
      */
     inline const char * getName() const;
 
+    /**
+     * Returns with the handle of the constraint's name in the NamePool.
+     *
+     * @return The handle of the name; it is empty if the constraint has no name.
+     */
+    inline const PooledName & getPooledName() const {
+        return m_name;
+    }
+
     /**
      * Returns with the pointer of the corresponding vector.
      *
@@ -355,9 +373,10 @@ private:
     CONSTRAINT_TYPE m_type;
 
     /**
-     * Represents the name of the constraint. The default name is <NO NAME>.
+     * Represents the name of the constraint, stored in the NamePool.
+     * The default name is <NO NAME>.
      */
-    std::string m_name;
+    PooledName m_name;
 
     /**
      * Represents the coefficient vector of the constraint. The class Model fills
@@ -416,9 +435,7 @@ inline Constraint::Constraint(Numerical::Double lowerBound,
 {
     m_lowerBound = lowerBound;
     m_upperBound = upperBound;
-    if (name != 0) {
-        m_name = name;
-    }
+    m_name = NamePool::getInstance().add(name);
     m_vector = 0;
     check();
     adjustType();
@@ -464,13 +481,18 @@ inline void Constraint::setBounds(Numerical::Double lowerBound,
 }
 
 inline void Constraint::setName(const char * name)
+{
+    m_name = NamePool::getInstance().add(name);
+}
+
+inline void Constraint::setName(const PooledName & name)
 {
     m_name = name;
 }
 
 inline const char * Constraint::getName() const
 {
-    if (m_name.length() > 0) {
+    if (m_name.isEmpty() == false) {
         return m_name.c_str();
     }
     return "<NO NAME>";
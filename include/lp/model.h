@@ -104,6 +104,8 @@ public:
 
     void addToCostCoefficient(unsigned int index, Numerical::Double value);
 
+    void setMatrixElement(unsigned int rowIndex, unsigned int columnIndex, Numerical::Double value);
+
     void setCostConstant(Numerical::Double value);
 
     inline std::vector<Variable> * getVariables() {return &m_variables;}
@@ -130,6 +132,9 @@ public:
     void changeObjectiveCoefficients(const double* objCoefficients);
 
 protected:
+    // The names of the variables and constraints are valid while the model exists
+    NamePool::Reference m_namePoolReference;
+
     Matrix m_matrix;
     std::vector<Variable> m_variables;
     std::vector<Constraint> m_constraints;
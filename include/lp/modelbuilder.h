@@ -73,6 +73,13 @@ public:
     /**
      */
     virtual OBJECTIVE_TYPE getObjectiveType() const = 0;
+
+private:
+
+    /**
+     * The names of the variables and constraints of the builder are valid while it exists.
+     */
+    NamePool::Reference m_namePoolReference;
 };
 
 #endif	/* MODELBUILDER_H */
@@ -0,0 +1,280 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file modelsnapshot.h This file contains the API of the ModelSnapshot class.
+ */
+
+#ifndef MODELSNAPSHOT_H
+#define MODELSNAPSHOT_H
+
+#include <globals.h>
+
+#include <lp/modelbuilder.h>
+#include <utils/exceptions.h>
+#include <utils/file.h>
+#include <string>
+#include <vector>
+
+class Model;
+
+/**
+ * This class reads and writes the binary snapshot of a Model.
+ *
+ * A snapshot stores the matrix in both rowwise and columnwise form, the cost
+ * vector, the bounds and the names of the model, in cache line aligned arrays
+ * with the native byte order. The header contains the SHA1 hash of the model
+ * given by Model::getHash(), so the model built from the snapshot can be
+ * validated against it.
+ *
+ * The snapshot file is mapped into the memory, and the Model is built directly
+ * from the mapped arrays, so loading does not parse anything.
+ *
+ * @class ModelSnapshot
+ */
+class ModelSnapshot: public ModelBuilder
+{
+public:
+
+    /**
+     * This exception is thrown when a snapshot file is corrupted, or it was written
+     * by an incompatible version or on a machine with different byte order.
+     *
+     * @class InvalidSnapshotException
+     */
+    class InvalidSnapshotException: public PanOptException {
+    public:
+        InvalidSnapshotException(const std::string & message):
+            PanOptException(message) {}
+    };
+
+    /**
+     * Constructor of the ModelSnapshot class.
+     *
+     * @constructor
+     */
+    ModelSnapshot();
+
+    /**
+     * Destructor of the ModelSnapshot class.
+     *
+     * @destructor
+     */
+    virtual ~ModelSnapshot();
+
+    /**
+     * Writes the snapshot of a model.
+     *
+     * @throws FileNotFoundException if the file cannot be written.
+     *
+     * @param model The model to be saved.
+     * @param fileName The name of the snapshot file.
+     */
+    static void write(const Model & model, const std::string & fileName);
+
+    /**
+     * Maps a snapshot file into the memory and checks its layout, the indices of the
+     * vectors and the bounds.
+     *
+     * @throws FileNotFoundException if the file cannot be opened.
+     * @throws InvalidSnapshotException if the file is not a valid snapshot.
+     *
+     * @param fileName The name of the snapshot file.
+     */
+    void loadFromFile(const std::string & fileName);
+
+    /**
+     * Returns true if the name of the file has the extension of the snapshot files.
+     *
+     * @param fileName The name of the file.
+     * @return True if the file name ends with ".PSN" or ".psn".
+     */
+    static bool isSnapshotFile(const std::string & fileName);
+
+    /**
+     * Returns the hash of the saved model, it equals to Model::getHash()
+     * of the model built from the snapshot.
+     *
+     * @return The SHA1 hash of the saved model.
+     */
+    const std::string & getModelHash() const;
+
+    // ********************************************************
+    // Inherited from MatrixBuilder
+    // ********************************************************
+
+    unsigned int getColumnCount() const;
+
+    unsigned int getRowCount() const;
+
+    void buildRow(unsigned int index, SparseVector * rowVector,
+                  std::vector<unsigned int> * nonzeros) const;
+
+    void buildColumn(unsigned int index, SparseVector * columnVector,
+                     std::vector<unsigned int> * nonzeros) const;
+
+    bool hasRowwiseRepresentation() const;
+
+    bool hasColumnwiseRepresentation() const;
+
+    bool hasSortedVectors() const;
+
+    // ********************************************************
+    // Inherited from ModelBuilder
+    // ********************************************************
+
+    const Variable & getVariable(unsigned int index) const;
+
+    const Constraint & getConstraint(unsigned int index) const;
+
+    void buildCostVector(DenseVector * costVector) const;
+
+    double getObjectiveConstant() const;
+
+    std::string getName() const;
+
+    OBJECTIVE_TYPE getObjectiveType() const;
+
+private:
+
+    /**
+     * The arrays stored in the snapshot, in the order of the file.
+     */
+    enum SECTION {
+        MODEL_NAME = 0,
+        ROW_STARTS,
+        ROW_INDICES,
+        ROW_VALUES,
+        COLUMN_STARTS,
+        COLUMN_INDICES,
+        COLUMN_VALUES,
+        COSTS,
+        VARIABLE_BOUNDS,
+        CONSTRAINT_BOUNDS,
+        VARIABLE_NAME_STARTS,
+        VARIABLE_NAMES,
+        CONSTRAINT_NAME_STARTS,
+        CONSTRAINT_NAMES,
+        SECTION_COUNT
+    };
+
+    /**
+     * The fixed size header at the beginning of the snapshot file.
+     * m_sortedVectors is nonzero if the indices of every stored vector are increasing.
+     */
+    struct Header {
+        char m_magic[8];
+        unsigned int m_version;
+        unsigned int m_byteOrder;
+        char m_hash[64];
+        unsigned int m_rowCount;
+        unsigned int m_columnCount;
+        unsigned long long int m_nonZeros;
+        unsigned int m_objectiveType;
+        unsigned int m_sortedVectors;
+        double m_costConstant;
+        unsigned long long int m_sectionOffsets[SECTION_COUNT];
+        unsigned long long int m_sectionSizes[SECTION_COUNT];
+        unsigned long long int m_fileSize;
+    };
+
+    /**
+     * The snapshot file mapped into the memory.
+     */
+    File m_file;
+
+    /**
+     * Points to the header at the beginning of the loaded snapshot.
+     */
+    const Header * m_header;
+
+    std::string m_hash;
+
+    std::string m_name;
+
+    std::vector<Variable> m_variables;
+
+    std::vector<Constraint> m_constraints;
+
+    const unsigned long long int * m_rowStarts;
+
+    const unsigned int * m_rowIndices;
+
+    const double * m_rowValues;
+
+    const unsigned long long int * m_columnStarts;
+
+    const unsigned int * m_columnIndices;
+
+    const double * m_columnValues;
+
+    const double * m_costs;
+
+    /**
+     * Returns the beginning of a section of the loaded snapshot.
+     *
+     * @param section The section to be accessed.
+     * @return Pointer to the first byte of the section.
+     */
+    const char * getSection(SECTION section) const;
+
+    /**
+     * Checks that a section of the loaded snapshot has the expected size.
+     *
+     * @throws InvalidSnapshotException if the size differs.
+     *
+     * @param section The section to be checked.
+     * @param size The expected size in bytes.
+     */
+    void checkSectionSize(SECTION section, unsigned long long int size) const;
+
+    /**
+     * Checks that a start array of a vector or name section is monotonic and ends
+     * at the given number of elements.
+     *
+     * @throws InvalidSnapshotException if the start array is invalid.
+     *
+     * @param starts The start array.
+     * @param count The number of vectors or names.
+     * @param total The number of elements stored in the corresponding section.
+     */
+    static void checkStarts(const unsigned long long int * starts, unsigned int count,
+                            unsigned long long int total);
+
+    /**
+     * Checks that the indices of the vectors are less than the length of the vectors, and
+     * increasing within each vector if the snapshot has sorted vectors.
+     *
+     * @throws InvalidSnapshotException if an index is invalid.
+     *
+     * @param indices The index array of the vectors.
+     * @param starts The start array of the vectors, checked by checkStarts().
+     * @param count The number of vectors.
+     * @param length The length of the vectors.
+     * @param sorted True if the indices are increasing within each vector.
+     */
+    static void checkIndices(const unsigned int * indices, const unsigned long long int * starts,
+                             unsigned int count, unsigned int length, bool sorted);
+
+    /**
+     * Builds a sparse vector from the arrays of the loaded snapshot.
+     */
+    static void buildVector(SparseVector * vector, unsigned int length,
+                            const unsigned int * indices, const double * values,
+                            unsigned long long int begin, unsigned long long int end);
+};
+
+#endif // MODELSNAPSHOT_H
@@ -23,7 +23,7 @@
 #include <vector>
 #include <sstream>
 #include <utils/file.h>
-#include <utils/hashtable.h>
+#include <utils/nametable.h>
 #include <utils/list.h>
 #include <linalg/densevector.h>
 #include <lp/modelbuilder.h>
@@ -407,6 +407,35 @@ private:
         }
     };
 
+    /**
+     * A sequence of consecutive COLUMNS records with the same column name,
+     * parsed by a ColumnsChunk.
+     */
+    struct ColumnRun {
+        MpsName m_name;
+        unsigned int m_firstNonzero;
+        unsigned int m_nonzeros;
+        unsigned int m_line;
+    };
+
+    /**
+     * A part of the COLUMNS section parsed by one thread. The chunk starts at a
+     * record boundary, and it stores the parsed nonzeros and cost coefficients
+     * with chunk relative column indices and line numbers.
+     */
+    struct ColumnsChunk {
+        const char * m_begin;
+        const char * m_end;
+        const char * m_stop;
+        bool m_sectionEnd;
+        bool m_irregular;
+        unsigned int m_lines;
+        std::vector<double> m_values;
+        std::vector<unsigned int> m_indices;
+        std::vector<ColumnRun> m_columns;
+        std::vector<std::pair<double, unsigned int> > m_costVector;
+    };
+
     File m_inputFile;
 
     unsigned int m_bufferSize;
@@ -426,9 +455,9 @@ private:
         }
     };
 
-    HashTable<RowIndex, MpsNameHash> m_rowsTable;
+    NameTable<RowIndex, MpsNameHash> m_rowsTable;
 
-    HashTable<ColumnIndex, MpsNameHash> m_columnsTable;
+    NameTable<ColumnIndex, MpsNameHash> m_columnsTable;
 
     std::vector<const Row*> m_rowsMap;
 
@@ -460,7 +489,11 @@ private:
                     std::vector<Column> ** lastVectorPtr,
                     bool * columnPattern);
 
-    bool parseRecordStart(double * value,
+    void storeColumn(const Column & column,
+                     std::vector<Column> ** lastVectorPtr);
+
+    bool parseRecordStart(const char * & buffer,
+                          double * value,
                           MpsName * id1,
                           MpsName * id2,
                           EmptySection4 * startSection,
@@ -471,11 +504,26 @@ private:
                           MpsName * id2,
                           EmptySection4 * startSection);
 
-    bool parseRecordEnd(double * value,
+    bool parseRecordEnd(const char * & buffer,
+                        double * value,
                         MpsName * id);
 
     void readColumns();
 
+    /**
+     * Parses the COLUMNS section of a memory mapped file in parallel.
+     * The chunks are merged in order, so the result is the same as the result
+     * of the sequential parser. If any chunk meets a record which is not handled
+     * by the fast path, nothing is modified, and the caller has to parse the
+     * section sequentially.
+     *
+     * @param threadCount The number of the parser threads.
+     * @return True if the section has been parsed.
+     */
+    bool readColumnsParallel(unsigned int threadCount);
+
+    void parseColumnsChunk(ColumnsChunk * chunk);
+
     void finishColumns();
 
     void readRhsOrRanges(double Row::*range );
@@ -91,6 +91,17 @@ public:
 
 protected:
 
+    /**
+     * Computes the bounds of the dual constraint activity of a column from the implied bounds of
+     * the dual variables. A bound is infinite if the column has an extra dual variable on its side,
+     * these are created by the bounded variables and the range constraints.
+     *
+     * @param index The index of the column.
+     * @param impliedLB The lower bound of the dual constraint activity.
+     * @param impliedUB The upper bound of the dual constraint activity.
+     */
+    void computeDualActivityBounds(int index, Numerical::Double * impliedLB, Numerical::Double * impliedUB) const;
+
     /**
      * Pointer to the parent Presolver of the module.
      */
@@ -314,6 +325,122 @@ private:
     DenseVector * m_variableStack;
 };
 
+/**
+ * Presolver module fixing dominated and weakly dominated columns.
+ * The reduced cost of every column is bounded by the implied bounds of the dual variables
+ * computed by the DualBoundsModule. If the sign of the reduced cost is known for every dual
+ * feasible solution, the variable is fixed to the corresponding bound.
+ * This module should run after the DualBoundsModule to make use of the tightened dual bounds.
+ *
+ * @throws InfeasibilityException if infeasibility is detected.
+ * @throws UnboundedException if unboundedness is detected.
+ *
+ * @class DominatedColumnModule
+ */
+class DominatedColumnModule : public PresolverModule {
+public:
+
+    /**
+     * Default constructor of the DominatedColumnModule class.
+     *
+     * @constructor
+     * @param parent Pointer to the parent Presolver containing this module.
+     */
+    DominatedColumnModule(Presolver * parent);
+
+    /**
+     * Destructor of the DominatedColumnModule class.
+     *
+     * @destructor
+     */
+    ~DominatedColumnModule();
+
+    /**
+     * Executes the presolving techniques implemented by the DominatedColumnModule.
+     * These are found in the literature by the names "Dominated Column" and
+     * "Weakly Dominated Column".
+     */
+    void executeMethod();
+
+    /**
+     * Prints the statistics of the module to the output.
+     * This contains the number of the eliminated variales, constaints and nonzero elements of the model.
+     */
+    void printStatistics();
+
+    /**
+     * Returns the number of successfully removed nonzero elements by this module.
+     *
+     * @return  The number of successfully removed nonzero elements by this module.
+     */
+    inline int getRemovedNonzerosCount() const { return m_removedNzr; }
+
+private:
+
+    /**
+     * The number of eliminated nonzero elements.
+     */
+    int m_removedNzr;
+};
+
+/**
+ * Presolver module eliminating doubleton equations.
+ * An equality constraint with two nonzero elements makes it possible to express one of its
+ * variables with the other one. The eliminated variable is substituted out of every other
+ * constraint and the cost vector, and its bounds are transferred to the remaining variable.
+ * The variable with fewer nonzeros is eliminated to keep the fill-in low, unless its
+ * coefficient is much smaller than the other one.
+ *
+ * @throws InfeasibilityException if infeasibility is detected.
+ *
+ * @class DoubletonEquationModule
+ */
+class DoubletonEquationModule : public PresolverModule {
+public:
+
+    /**
+     * Default constructor of the DoubletonEquationModule class.
+     *
+     * @constructor
+     * @param parent Pointer to the parent Presolver containing this module.
+     */
+    DoubletonEquationModule(Presolver * parent);
+
+    /**
+     * Destructor of the DoubletonEquationModule class.
+     *
+     * @destructor
+     */
+    ~DoubletonEquationModule();
+
+    /**
+     * Executes the presolving techniques implemented by the DoubletonEquationModule.
+     * These are found in the literature by the name "Doubleton Equation".
+     */
+    void executeMethod();
+
+    /**
+     * Prints the statistics of the module to the output.
+     * This contains the number of the eliminated variales, constaints and nonzero elements of the model.
+     */
+    void printStatistics();
+
+    /**
+     * Returns the number of successfully removed nonzero elements by this module.
+     * Fill-in created by the substitution is subtracted from this number.
+     *
+     * @return  The number of successfully removed nonzero elements by this module.
+     */
+    inline int getRemovedNonzerosCount() const { return m_removedNzr; }
+
+private:
+
+    /**
+     * The number of eliminated nonzero elements.
+     */
+    int m_removedNzr;
+};
+
 /**
  * Presolver module checking the model for duplicate rows and columns.
  * Duplicate vectors are identified via the hashing of nonzero pattern. Linear dependency of multiple
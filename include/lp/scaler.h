@@ -18,25 +18,139 @@
 #define SCALER_H
 
 #include <vector>
+#include <functional>
 #include <linalg/matrix.h>
 #include <utils/numerical.h>
 
+/**
+ * Computes power of 2 row and column multipliers for a matrix, and applies them.
+ * The multipliers are computed on the unmodified matrix, the rows and columns are
+ * processed in parallel when the matrix is large enough, and the final multipliers
+ * are applied to the rowwise and columnwise forms in one pass.
+ *
+ * @class Scaler
+ */
 class Scaler {
 public:
+
+    /**
+     * Describes the available scaling methods.
+     */
+    enum SCALING_TYPE {
+        BENICHOU,
+        CURTIS_REID,
+        EQUILIBRATION
+    };
+
+    /**
+     * Constructor of the Scaler class, it reads the Starting.Scaling parameters.
+     *
+     * @constructor
+     */
+    Scaler();
+
+    /**
+     * Scales the matrix with the method given by the Starting.Scaling.type parameter.
+     *
+     * @param matrix The matrix to be scaled.
+     * @param name The name of the problem.
+     */
     void scale(Matrix * matrix, const char *name = 0);
 
     const std::vector<Numerical::Double> & getRowMultipliers() const;
 
     const std::vector<Numerical::Double> & getColumnMultipliers() const;
 
+    /**
+     * Returns the name of the applied scaling method.
+     *
+     * @return The name of the scaling method.
+     */
+    const char * getName() const;
+
 private:
+    SCALING_TYPE m_type;
+
+    /**
+     * Maximal number of scaling passes.
+     */
+    unsigned int m_maxIterations;
+
+    /**
+     * The scaling stops when the relative improvement of a pass is below this value.
+     */
+    Numerical::Double m_convergenceTolerance;
+
+    /**
+     * Number of threads used for the computation of the multipliers.
+     */
+    unsigned int m_threadCount;
+
     std::vector<Numerical::Double> m_rowMultipliers;
     std::vector<Numerical::Double> m_columnMultipliers;
 
-    void benichou(Matrix *matrix, const char * name = 0);
+    /**
+     * Geometric scaling with power of 2 multipliers, closed by an equilibration.
+     *
+     * @param matrix The unscaled matrix.
+     */
+    void benichou(const Matrix & matrix);
+
+    /**
+     * Curtis-Reid scaling: minimizes the sum of squared logarithms of the scaled
+     * nonzeros with a Jacobi preconditioned conjugate gradient method.
+     *
+     * @param matrix The unscaled matrix.
+     */
+    void curtisReid(const Matrix & matrix);
+
+    /**
+     * Scales the largest absolute element of each row and then of each column
+     * near to 1. It refines the current multipliers.
+     *
+     * @param matrix The unscaled matrix.
+     */
+    void equilibration(const Matrix & matrix);
+
+    /**
+     * Computes the geometric mean row multipliers using the current column multipliers.
+     *
+     * @param matrix The unscaled matrix.
+     */
+    void geometricRowPass(const Matrix & matrix);
+
+    /**
+     * Computes the geometric mean column multipliers using the current row multipliers.
+     *
+     * @param matrix The unscaled matrix.
+     */
+    void geometricColumnPass(const Matrix & matrix);
+
+    /**
+     * Returns the variance of the absolute values of the scaled nonzeros.
+     *
+     * @param matrix The unscaled matrix.
+     * @return The variance.
+     */
+    Numerical::Double getVariance(const Matrix & matrix) const;
+
+    /**
+     * Multiplies the rowwise and columnwise forms of the matrix with the multipliers.
+     *
+     * @param matrix The matrix to be scaled.
+     */
+    void applyMultipliers(Matrix * matrix) const;
 
-    Numerical::Double getVarianceBenichou(Matrix * matrix,
-                                          std::vector<Numerical::Double> * rowMultpiliersPtr);
+    /**
+     * Processes the [0, count) range in parallel with ThreadSupervisor::parallelFor(),
+     * using the number of threads of the scaler.
+     *
+     * @param count The size of the range.
+     * @param function The function processing a chunk.
+     * @return The number of chunks.
+     */
+    unsigned int parallelFor(unsigned int count,
+                             const std::function<void(unsigned int, unsigned int, unsigned int)> & function) const;
 
     Numerical::Double roundPowerOf2(Numerical::Double value) const;
 };
@@ -28,6 +28,7 @@
 #include <utils/numerical.h>
 #include <utils/exceptions.h>
 #include <linalg/sparsevector.h>
+#include <utils/namepool.h>
 
 class Variable;
 
@@ -314,6 +315,14 @@ public:
      */
     inline void setName(const char * name);
 
+    /**
+     * Sets the variable's name to a name already stored in the NamePool,
+     * without copying it.
+     *
+     * @param name The handle of the variable's new name.
+     */
+    inline void setName(const PooledName & name);
+
     /**
      * Returns with the name of the variable.
      *
@@ -321,6 +330,15 @@ public:
      */
     inline const char * getName() const;
 
+    /**
+     * Returns with the handle of the variable's name in the NamePool.
+     *
+     * @return The handle of the name; it is empty if the variable has no name.
+     */
+    inline const PooledName & getPooledName() const {
+        return m_name;
+    }
+
     /**
      * Returns with the pointer of the corresponding vector.
      *
@@ -377,9 +395,10 @@ private:
     VARIABLE_TYPE m_type;
 
     /**
-     * Represents the name of the variable. The default name is <NO NAME>.
+     * Represents the name of the variable, stored in the NamePool.
+     * The default name is <NO NAME>.
      */
-    std::string m_name;
+    PooledName m_name;
 
     /**
      * Represents the coefficient vector of the variable. The class Model fills
@@ -438,9 +457,7 @@ inline Variable::Variable(Numerical::Double lowerBound,
 {
     m_lowerBound = lowerBound;
     m_upperBound = upperBound;
-    if (name != 0) {
-        m_name = name;
-    }
+    m_name = NamePool::getInstance().add(name);
     m_vector = 0;
     check();
     adjustType();
@@ -485,13 +502,18 @@ inline void Variable::setBounds(Numerical::Double lowerBound,
 }
 
 inline void Variable::setName(const char * name)
+{
+    m_name = NamePool::getInstance().add(name);
+}
+
+inline void Variable::setName(const PooledName & name)
 {
     m_name = name;
 }
 
 inline const char * Variable::getName() const
 {
-    if (m_name.length() > 0) {
+    if (m_name.isEmpty() == false) {
         return m_name.c_str();
     }
     return "<NO NAME>";
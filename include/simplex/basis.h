@@ -189,6 +189,18 @@ public:
      */
     int getSingularityCount() {return m_singularityCounter;}
 
+    /**
+     * Returns the number of eta matrices appended to the inverse since the last inversion.
+     * @return The number of update etas.
+     */
+    virtual unsigned int getUpdateEtaCount() const = 0;
+
+    /**
+     * Returns the number of nonzeros in the inverse representation, including the update etas.
+     * @return Basis::m_inverseNonzeros
+     */
+    unsigned int getInverseNonzeros() const {return m_inverseNonzeros;}
+
     /**
      * Setting the actual inversion parameters (simplex state) to be used for inversion.
      * This must be called before inversion.
@@ -238,6 +250,11 @@ protected:
      */
     static thread_local const DenseVector* m_basicVariableValues;
 
+    /**
+     * The released eta vectors of the basis updates, they are reused by createUpdateEta().
+     */
+    static thread_local std::vector<SparseVector*>* m_etaPool;
+
     /**
      * The new basis head needed in the Basis::setNewHead() function.
      */
@@ -312,6 +329,46 @@ protected:
      */
     SparseVector *createEta(const SparseVector &vector, int pivotPosition);
 
+    /**
+     * Creates the Eta vector of a basis update like createEta(), but it reuses the vectors
+     * released by releaseUpdateEta(), so after the first reinversion cycle the updates do not
+     * allocate.
+     * @param vector is the alpha vector containing the pivot element.
+     * @param pivotPosition points to the pivot element in the vector
+     * @return the computed Eta vector.
+     *
+     * @throws NumericalException if the pivot element is zero.
+     */
+    SparseVector *createUpdateEta(const SparseVector &vector, int pivotPosition);
+
+    /**
+     * Releases an Eta vector of a basis update for the reuse in createUpdateEta().
+     * @param eta is the released Eta vector.
+     */
+    void releaseUpdateEta(SparseVector *eta);
+
+    /**
+     * Fills the released Eta vectors of the thread up to the reinversion frequency, and sizes them
+     * for twice the densest update of the previous cycle, so the updates of the next cycle do not
+     * allocate. It is called at the reinversions, after the updates are released.
+     */
+    void reserveUpdateEtas();
+
+    /**
+     * Deletes the released Eta vectors of the thread.
+     */
+    void releaseEtaPool();
+
+    /**
+     * Computes the Eta vector of the pivot element into an existing vector.
+     * @param eta is the result, its arrays are reused if they are large enough.
+     * @param vector is the alpha vector containing the pivot element.
+     * @param pivotPosition points to the pivot element in the vector
+     *
+     * @throws NumericalException if the pivot element is zero.
+     */
+    void computeEta(SparseVector *eta, const SparseVector &vector, int pivotPosition);
+
     /**
      * Checker for the numerical singularity.
      */
@@ -26,6 +26,7 @@
 #include <simplex/basis.h>
 #include <simplex/pricing/simpri.h>
 #include <simplex/pricing.h>
+#include <simplex/scratchbuffers.h>
 
 class SimplexModel;
 
@@ -47,6 +48,7 @@ public:
      * @param basisHead The basic variable indices.
      * @param simplexModel The model of the LP problem.
      * @param basis The B basis.
+     * @param scratchBuffers The work vectors of the simplex.
      *
      * @constructor
      */
@@ -55,7 +57,8 @@ public:
                 const IndexList<> & reducedCostFeasibilities,
                 const std::vector<int> & basisHead,
                 const SimplexModel & simplexModel,
-                const Basis & basis);
+                const Basis & basis,
+                ScratchBuffers & scratchBuffers);
 
     /**
      * Default destructor of the class.
@@ -169,6 +172,11 @@ protected:
      */
     const Basis & m_basis;
 
+    /**
+     * The work vectors of the simplex.
+     */
+    ScratchBuffers & m_scratchBuffers;
+
     /**
      * The selected reduced cost value.
      */
@@ -38,6 +38,7 @@
 class DualSimplex: public Simplex
 {
     friend class SimplexController;
+    template <class SIMPLEX, class BASIS, class PRICING> friend class SimplexEngine;
 private:
 
     /**
@@ -95,6 +96,22 @@ private:
      */
     DenseVector m_pivotRowOfBasisInverse;
 
+    /**
+     * Partial sums of the pivot row elements, computed by computeTransformedRow().
+     * They are kept between the iterations, and only the touched sums are read and cleared.
+     */
+    std::vector<Numerical::Summarizer> m_pivotRowSums;
+
+    /**
+     * Indices of the touched elements of m_pivotRowSums.
+     */
+    std::vector<unsigned int> m_pivotRowSumIndices;
+
+    /**
+     * Marks the touched elements of m_pivotRowSums.
+     */
+    std::vector<char> m_pivotRowSumMarks;
+
     /**
      * A counter measuring row disabling
      */
@@ -126,6 +143,34 @@ private:
      */
     virtual void update();
 
+    /**
+     * Creates the pricing of type PRICING.
+     * For the generic DualPricing the type is given by the "Pricing.type" parameter, SimplexEngine
+     * creates its final pricing type directly.
+     */
+    template <class PRICING>
+    void createPricing();
+
+    /**
+     * The bodies of price(), selectPivot() and update() for the given basis and pricing types.
+     * The virtual functions instantiate them with Basis and DualPricing, SimplexEngine with the final
+     * implementations, where the Ftran, Btran and pricing calls are resolved at compile time.
+     */
+    template <class BASIS, class PRICING>
+    void priceImpl();
+
+    /**
+     * @see DualSimplex::priceImpl()
+     */
+    template <class BASIS, class PRICING>
+    void selectPivotImpl();
+
+    /**
+     * @see DualSimplex::priceImpl()
+     */
+    template <class BASIS, class PRICING>
+    void updateImpl();
+
     /**
      * Function for updating the solution if Wolfe's 'ad hoc' method is used.
      */
@@ -172,6 +217,12 @@ private:
      */
     void computeTransformedRow();
 
+    /**
+     * The body of computeTransformedRow() for the given basis type.
+     */
+    template <class BASIS>
+    void computeTransformedRowImpl();
+
     // Interface of the iteration report provider:
     /**
      * Returns the iteration report fields of this class.
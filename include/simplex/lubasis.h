@@ -46,7 +46,7 @@ struct PivotPosition
     int columnindex;
 };
 
-class LuBasis : public Basis{
+class LuBasis final : public Basis{
 public:
     LuBasis();
     virtual ~LuBasis();
@@ -64,6 +64,8 @@ public:
 
     virtual void analyzeStability() const;
 
+    unsigned int getUpdateEtaCount() const {return m_updateETMs->size();}
+
     /**
      * Thread handling
      */
@@ -24,6 +24,7 @@
 #include <globals.h>
 #include <vector>
 #include <list>
+#include <atomic>
 
 #include <simplex/basis.h>
 #include <simplex/simplexmodel.h>
@@ -46,7 +47,7 @@ extern int aprExpCounter;
  *
  * @class PfiBasis
  */
-class PfiBasis : public Basis{
+class PfiBasis final : public Basis{
 public:
     /**
      * Used to distinguish two methods processing the non-triangular part of the basis.
@@ -138,6 +139,11 @@ public:
     virtual void Btran(DenseVector &vector, BTRAN_MODE mode = DEFAULT_BTRAN) const;
     virtual void Btran(SparseVector &vector, BTRAN_MODE mode = DEFAULT_BTRAN) const;
 
+    /**
+     * Returns the number of eta matrices appended since the last inversion.
+     */
+    unsigned int getUpdateEtaCount() const {return m_updates == nullptr ? 0 : m_updates->size();}
+
     /**
      * Thread handling
      */
@@ -274,6 +280,35 @@ private:
     NONTRIANGULAR_PIVOT_RULE m_nontriangularPivotRule;
     //Threshold value for threshold pivoting
     const double & m_threshold;
+    //Add mode of the eta updates in FTRAN
+    Numerical::ADD_TYPE m_ftranAddMode;
+    //Add mode of the dot products in BTRAN
+    Numerical::ADD_TYPE m_btranAddMode;
+    //Collect the rounding loss statistics of the FTRAN eta updates
+    bool m_etaStatistics;
+    //Largest rounding loss of the FTRAN eta updates, collected if m_etaStatistics is set
+    mutable std::atomic<double> m_maxLostValue;
+
+    /**
+     * The FTRAN and BTRAN kernels instantiated for the add modes and the statistics policy.
+     * They are selected once by selectTransformationKernels(), so the inner loops contain
+     * only the arithmetic required by the numerical settings.
+     */
+    void (PfiBasis::*m_ftranDense)(DenseVector & vector) const;
+    void (PfiBasis::*m_ftranSparse)(SparseVector & vector) const;
+    void (PfiBasis::*m_btranDense)(DenseVector & vector) const;
+    void (PfiBasis::*m_btranSparse)(SparseVector & vector) const;
+
+    void selectTransformationKernels();
+
+    template <Numerical::ADD_TYPE ADD_MODE, bool STATISTICS>
+    void ftranDense(DenseVector & vector) const;
+    template <Numerical::ADD_TYPE ADD_MODE, bool STATISTICS>
+    void ftranSparse(SparseVector & vector) const;
+    template <Numerical::ADD_TYPE ADD_MODE>
+    void btranDense(DenseVector & vector) const;
+    template <Numerical::ADD_TYPE ADD_MODE>
+    void btranSparse(SparseVector & vector) const;
 
     void copyBasis(bool buildIndexLists = true);
 
@@ -333,6 +368,20 @@ private:
         // TODO: exception
         return NONE;
     }
+
+    static Numerical::ADD_TYPE getAddMode(const std::string & mode) {
+        if (mode == "ADD_FAST") {
+            return Numerical::ADD_FAST;
+        }
+        if (mode == "ADD_ABS") {
+            return Numerical::ADD_ABS;
+        }
+        if (mode == "ADD_ABS_REL") {
+            return Numerical::ADD_ABS_REL;
+        }
+        LPWARNING("Invalid add mode: " << mode << ", ADD_ABS_REL is used");
+        return Numerical::ADD_ABS_REL;
+    }
 };
 
 #endif // PFIBASIS_H
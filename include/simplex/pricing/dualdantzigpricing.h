@@ -29,7 +29,7 @@
 
 #include <simplex/pricing/dualsteepestedgepricing.h>
 
-class DualDantzigPricing: public DualPricing
+class DualDantzigPricing final: public DualPricing
 {
 public:
     DualDantzigPricing(const DenseVector &basicVariableValues,
@@ -38,6 +38,7 @@ public:
                        const std::vector<int> & basisHead,
                        const SimplexModel & simplexModel,
                        const Basis &basis,
+                       ScratchBuffers & scratchBuffers,
                        bool shadowSteepestEdgeWeights);
     virtual ~DualDantzigPricing();
 
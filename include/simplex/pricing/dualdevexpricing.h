@@ -20,14 +20,15 @@
 #include <simplex/dualpricing.h>
 #include <vector>
 
-class DualDevexPricing: public DualPricing {
+class DualDevexPricing final: public DualPricing {
 public:
     DualDevexPricing(const DenseVector &basicVariableValues,
                      IndexList<> *basicVariableFeasibilities,
                      const IndexList<> &reducedCostFeasibilities,
                      const std::vector<int> & basisHead,
                      const SimplexModel & simplexModel,
-                     const Basis &basis);
+                     const Basis &basis,
+                     ScratchBuffers & scratchBuffers);
 
     virtual ~DualDevexPricing();
 
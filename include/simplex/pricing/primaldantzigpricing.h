@@ -28,7 +28,7 @@
 #include <utils/indexlist.h>
 #include <vector>
 
-class PrimalDantzigPricing: public PrimalPricing
+class PrimalDantzigPricing final: public PrimalPricing
 {
 public:
     PrimalDantzigPricing(const DenseVector & basicVariableValues,
@@ -38,6 +38,7 @@ public:
                          const std::vector<int> & basisHead,
                          const SimplexModel & model,
                          const Basis & basis,
+                         ScratchBuffers & scratchBuffers,
                          const DenseVector & reducedCosts);
     virtual ~PrimalDantzigPricing();
 
@@ -24,7 +24,7 @@
 #include <utils/indexlist.h>
 #include <vector>
 
-class PrimalSteepestEdgePricing: public PrimalPricing
+class PrimalSteepestEdgePricing final: public PrimalPricing
 {
 public:
     PrimalSteepestEdgePricing(const DenseVector & basicVariableValues,
@@ -34,6 +34,7 @@ public:
                               const std::vector<int> & basisHead,
                               const SimplexModel & model,
                               const Basis & basis,
+                              ScratchBuffers & scratchBuffers,
                               const DenseVector & reducedCosts);
     virtual ~PrimalSteepestEdgePricing();
 
@@ -26,6 +26,7 @@
 #include <simplex/basis.h>
 #include <simplex/pricing/simpri.h>
 #include <simplex/pricing.h>
+#include <simplex/scratchbuffers.h>
 
 class SimplexModel;
 
@@ -48,6 +49,7 @@ public:
      * @param basisHead The basishead containing basic variable indices.
      * @param simplexModel The simplex model of the LP problem.
      * @param basis The B basis.
+     * @param scratchBuffers The work vectors of the simplex.
      * @param reducedCosts Vector of the reduced costs.
      *
      * @constructor
@@ -59,6 +61,7 @@ public:
                   const std::vector<int> & basisHead,
                   const SimplexModel & model,
                   const Basis & basis,
+                  ScratchBuffers & scratchBuffers,
                   const DenseVector & reducedCosts);
 
     /**
@@ -167,6 +170,11 @@ protected:
      */
     const Basis & m_basis;
 
+    /**
+     * The work vectors of the simplex.
+     */
+    ScratchBuffers & m_scratchBuffers;
+
     /**
      * The selected reduced cost value.
      */
@@ -37,6 +37,7 @@
 class PrimalSimplex: public Simplex
 {
     friend class SimplexController;
+    template <class SIMPLEX, class BASIS, class PRICING> friend class SimplexEngine;
 private:
 
     /**
@@ -115,6 +116,34 @@ private:
      */
     virtual void update();
 
+    /**
+     * Creates the pricing of type PRICING.
+     * For the generic PrimalPricing the type is given by the "Pricing.type" parameter, SimplexEngine
+     * creates its final pricing type directly.
+     */
+    template <class PRICING>
+    void createPricing();
+
+    /**
+     * The bodies of price(), selectPivot() and update() for the given basis and pricing types.
+     * The virtual functions instantiate them with Basis and PrimalPricing, SimplexEngine with the final
+     * implementations, where the Ftran and pricing calls are resolved at compile time.
+     */
+    template <class BASIS, class PRICING>
+    void priceImpl();
+
+    /**
+     * @see PrimalSimplex::priceImpl()
+     */
+    template <class BASIS, class PRICING>
+    void selectPivotImpl();
+
+    /**
+     * @see PrimalSimplex::priceImpl()
+     */
+    template <class BASIS, class PRICING>
+    void updateImpl();
+
     /**
      * Function for updating the solution if Wolfe's 'ad hoc' method is used.
      */
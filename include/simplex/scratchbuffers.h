@@ -0,0 +1,175 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file scratchbuffers.h This file contains the ScratchBuffers class.
+ */
+
+#ifndef SCRATCHBUFFERS_H
+#define SCRATCHBUFFERS_H
+
+#include <globals.h>
+#include <linalg/densevector.h>
+#include <linalg/sparsevector.h>
+#include <utils/numerical.h>
+#include <qd/dd_real.h>
+#include <vector>
+
+/**
+ * The work vectors of the simplex iterations.
+ * Every Simplex owns one, and its phases and pricing use the buffers instead of local vectors,
+ * so the buffers are allocated in the first iterations only, and the later iterations between
+ * the reinversions do not allocate. Every buffer has one user, the users are listed at the
+ * enumerators; a buffer is valid until the next request of the same buffer.
+ *
+ * @class ScratchBuffers
+ */
+class ScratchBuffers
+{
+public:
+
+    /**
+     * The dense work vectors.
+     */
+    enum DENSE_VECTOR {
+        // DualSimplex::update(), the column of a boundflipping variable
+        BOUNDFLIP_COLUMN = 0,
+        // PrimalSimplex::updateReducedCosts(), the row of the basis inverse
+        REDUCED_COST_ROW,
+        // Simplex::computeReducedCosts()
+        SIMPLEX_MULTIPLIER,
+        // Simplex::refineBasicSolution() and Simplex::refineSimplexMultiplier()
+        REFINEMENT_CORRECTION,
+        REFINEMENT_PREVIOUS_VALUES,
+        // The steepest edge and devex pricings
+        PRICING_TAU,
+        PRICING_ROW,
+        // DualPricing::initPhase1() and PrimalPricing::initPhase1()
+        PRICING_PHASE1_AUXILIARY,
+        DENSE_VECTOR_COUNT
+    };
+
+    /**
+     * The sparse work vectors.
+     */
+    enum SPARSE_VECTOR {
+        // The entering column of the basis change in the update of the simplex
+        BASIS_CHANGE_COLUMN = 0,
+        // The primal steepest edge and devex pricings
+        PRICING_ALPHA,
+        PRICING_MULTIPLIER,
+        SPARSE_VECTOR_COUNT
+    };
+
+    /**
+     * The arrays of numbers.
+     */
+    enum DOUBLE_ARRAY {
+        // The reordered weights of the steepest edge pricing after a reinversion
+        PRICING_WEIGHTS = 0,
+        // PrimalDevexPricing, the sums of the positive and negative products
+        PRICING_POSITIVE_SUMS,
+        PRICING_NEGATIVE_SUMS,
+        DOUBLE_ARRAY_COUNT
+    };
+
+    /**
+     * The arrays of double-double numbers.
+     */
+    enum DD_REAL_ARRAY {
+        // Simplex::refineBasicSolution(), the residuals of the rows
+        REFINEMENT_RESIDUALS = 0,
+        DD_REAL_ARRAY_COUNT
+    };
+
+    /**
+     * Returns a dense work vector.
+     * The arrays of the vector grow only, so after the first request of a length it is not
+     * allocated again.
+     *
+     * @param buffer The requested buffer.
+     * @param length The length of the vector.
+     * @return The vector filled with zeros.
+     */
+    DenseVector & getDenseVector(DENSE_VECTOR buffer, unsigned int length) {
+        DenseVector & vector = m_denseVectors[buffer];
+        vector.reInit(length);
+        return vector;
+    }
+
+    /**
+     * Returns a sparse work vector.
+     * The arrays of the vector are reserved for length nonzeros, and the assignments and
+     * SparseVector::prepareForData() keep them, so the vector is not allocated again however
+     * dense its content is.
+     *
+     * @param buffer The requested buffer.
+     * @param length The length of the vector.
+     * @return The vector without nonzeros, its content can be overwritten.
+     */
+    SparseVector & getSparseVector(SPARSE_VECTOR buffer, unsigned int length) {
+        SparseVector & vector = m_sparseVectors[buffer];
+        vector.prepareForData(length, length);
+        return vector;
+    }
+
+    /**
+     * Returns an array of numbers.
+     * The capacity of the array is kept, so std::vector::assign() does not allocate after
+     * the first use.
+     *
+     * @param buffer The requested buffer.
+     * @return The array, its content is left from the previous use.
+     */
+    std::vector<Numerical::Double> & getDoubleArray(DOUBLE_ARRAY buffer) {
+        return m_doubleArrays[buffer];
+    }
+
+    /**
+     * Returns an array of double-double numbers.
+     * The capacity of the array is kept like in getDoubleArray().
+     *
+     * @param buffer The requested buffer.
+     * @return The array, its content is left from the previous use.
+     */
+    std::vector<dd_real> & getDdRealArray(DD_REAL_ARRAY buffer) {
+        return m_ddRealArrays[buffer];
+    }
+
+private:
+
+    /**
+     * The dense work vectors.
+     */
+    DenseVector m_denseVectors[DENSE_VECTOR_COUNT];
+
+    /**
+     * The sparse work vectors.
+     */
+    SparseVector m_sparseVectors[SPARSE_VECTOR_COUNT];
+
+    /**
+     * The arrays of numbers.
+     */
+    std::vector<Numerical::Double> m_doubleArrays[DOUBLE_ARRAY_COUNT];
+
+    /**
+     * The arrays of double-double numbers.
+     */
+    std::vector<dd_real> m_ddRealArrays[DD_REAL_ARRAY_COUNT];
+};
+
+#endif // SCRATCHBUFFERS_H
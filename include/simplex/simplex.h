@@ -31,7 +31,10 @@
 #include <utils/iterationreport.h>
 #include <utils/iterationreportprovider.h>
 #include <utils/timer.h>
+#include <utils/perfcounters.h>
 #include <simplex/pricing.h>
+#include <simplex/scratchbuffers.h>
+#include <utils/profiler.h>
 
 class SimplexController;
 class StartingBasisFinder;
@@ -210,6 +213,11 @@ protected:
      */
     DenseVector m_pivotRow;
 
+    /**
+     * The work vectors of the iterations, they are shared with the pricing.
+     */
+    ScratchBuffers m_scratchBuffers;
+
     /**
      * Variable index of the incoming candidate.
      */
@@ -266,6 +274,25 @@ protected:
      */
     Timer m_updateTimer;
 
+    /**
+     * The timed phases measured by the hardware performance counters.
+     */
+    enum PERF_COUNTER_PHASE {
+        PERF_INVERSION,
+        PERF_COMPUTE_BASIC_SOLUTION,
+        PERF_COMPUTE_REDUCED_COSTS,
+        PERF_PRICE,
+        PERF_SELECT_PIVOT,
+        PERF_UPDATE,
+        PERF_PHASE_COUNT
+    };
+
+    /**
+     * The hardware performance counters of the timed phases, they are started and stopped
+     * together with the timers above if the "performance_counters" parameter is set.
+     */
+    PerfCounterPhase m_perfCounters[PERF_PHASE_COUNT];
+
     //Parameter variables
     /**
      * Parameter reference of the run-time parameter "reinversion_frequency".
@@ -344,6 +371,20 @@ protected:
      */
     const double & m_pivotTolerance;
 
+    /**
+     * Parameter reference of the run-time parameter "refinement_passes".
+     *
+     * @see SimplexParameterHandler
+     */
+    const int & m_refinementPasses;
+
+    /**
+     * Parameter reference of the run-time parameter "e_refinement".
+     *
+     * @see SimplexParameterHandler
+     */
+    const double & m_refinementTolerance;
+
     //Tolerance handling
     /**
      * Master tolerance given in the parameter file.
@@ -435,9 +476,11 @@ protected:
 
     /**
      * This function performs one simplex iteration. (pricing, ratiotest, update)
+     * The phases are called through the virtual functions, SimplexEngine overrides it with the
+     * devirtualized version.
      * @param iterationIndex The index of the actual iteration. Important for reporting
      */
-    void iterate(int iterationIndex);
+    virtual void iterate(int iterationIndex);
 
     /**
      * Setter for the iteration reporter.
@@ -563,8 +606,28 @@ protected:
     /**
      * Computes the reduced costs from the cost vector.
      * The function is called in every reinversion.
+     *
+     * @param refine True if the simplex multiplier is refined, only the reinversion refines it.
      */
-    void computeReducedCosts();
+    void computeReducedCosts(bool refine = false);
+
+    /**
+     * Iterative refinement of the basic solution after computeBasicSolution().
+     * The residual of the equality constraints is computed in double-double precision, and if its
+     * largest relative element exceeds the "e_refinement" tolerance, x_B is corrected with the Ftran
+     * of the residual. At most "refinement_passes" corrections are made, a correction which does not
+     * decrease the residual is undone.
+     */
+    void refineBasicSolution();
+
+    /**
+     * Iterative refinement of the simplex multiplier in computeReducedCosts() after a reinversion.
+     * The dual residual c_B - B^T y is computed in double-double precision, and y is corrected with
+     * the Btran of the residual like in refineBasicSolution().
+     *
+     * @param simplexMultiplier The simplex multiplier computed by the Btran of c_B.
+     */
+    void refineSimplexMultiplier(DenseVector * simplexMultiplier);
 
     /**
      * Pure virtual function for computing the feasibility, implemented in child classes.
@@ -642,6 +705,50 @@ protected:
     void reset();
 
     virtual void resetTolerances() = 0;
+
+    /**
+     * The body of iterate(), the phases are called through the given pointer.
+     * If SIMPLEX is a final class (see SimplexEngine), the calls are resolved at compile time.
+     *
+     * @param simplex Pointer to this object with its most derived type.
+     * @param iterationIndex The index of the actual iteration.
+     */
+    template <class SIMPLEX>
+    void performIteration(SIMPLEX * simplex, int iterationIndex);
 };
 
+template <class SIMPLEX>
+void Simplex::performIteration(SIMPLEX * simplex, int iterationIndex)
+{
+    PROFILE_ZONE("Iteration");
+    m_iterationIndex = iterationIndex;
+    m_feasibleIteration = m_feasible;
+
+    m_priceTimer.start();
+    m_perfCounters[PERF_PRICE].start();
+    simplex->price();
+    m_perfCounters[PERF_PRICE].stop();
+    m_priceTimer.stop();
+
+    m_selectPivotTimer.start();
+    m_perfCounters[PERF_SELECT_PIVOT].start();
+    simplex->selectPivot();
+    m_perfCounters[PERF_SELECT_PIVOT].stop();
+    m_selectPivotTimer.stop();
+
+    m_updateTimer.start();
+    m_perfCounters[PERF_UPDATE].start();
+    simplex->update();
+    m_perfCounters[PERF_UPDATE].stop();
+    m_updateTimer.stop();
+    simplex->computeWorkingTolerance();
+
+    if(!m_feasible){
+        m_recomputeReducedCosts = true;
+    }
+
+    //The iteration is complete, count it in the iteration number
+    m_iterationIndex++;
+}
+
 #endif /* SIMPLEX_H */
@@ -22,6 +22,7 @@
 
 #include <globals.h>
 #include <utils/iterationreportprovider.h>
+#include <utils/iterationtrace.h>
 #include <simplex/primalsimplex.h>
 #include <simplex/dualsimplex.h>
 
@@ -127,7 +128,90 @@ public:
      */
     inline bool isOptimal() const { return m_isOptimal; }
 
+    /**
+     * Returns the iteration trace of the last solution.
+     * The trace can be exported at any time, even during the solution.
+     *
+     * @return The iteration trace, or nullptr if tracing is disabled.
+     */
+    const IterationTrace * getIterationTrace() const { return m_iterationTrace; }
+
+    /**
+     * The measures of the last solution.
+     */
+    struct SolveStatistics {
+        double m_inversionTime;
+        double m_computeBasicSolutionTime;
+        double m_computeReducedCostsTime;
+        double m_priceTime;
+        double m_selectPivotTime;
+        double m_updateTime;
+        unsigned int m_reinversions;
+        unsigned int m_maxInverseNonzeros;
+        // Iterations after the first reinversion cycle of the algorithm, without the reinversions
+        unsigned int m_steadyStateIterations;
+        // Allocations of the steady state iterations, counted by the MemoryManager
+        unsigned long long int m_steadyStateAllocations;
+    };
+
+    /**
+     * Returns the phase times, the reinversion count, the peak size of the inverse and the
+     * steady state allocations of the last sequential solution, summed over the primal and
+     * dual algorithms.
+     *
+     * @return The statistics of the last solution.
+     */
+    const SolveStatistics & getSolveStatistics() const { return m_solveStatistics; }
+
 private:
+
+    /**
+     * Creates the simplex object of the algorithm for the basis and the "Pricing.type" parameter.
+     * If the "simplex_engine" parameter is set, the basis is PfiBasis or LuBasis and the pricing is
+     * DANTZIG, DEVEX or STEEPEST_EDGE, the matching SimplexEngine is created, otherwise the generic
+     * SIMPLEX.
+     *
+     * @return The new simplex object.
+     */
+    template <class SIMPLEX, class DANTZIG, class DEVEX, class STEEPEST_EDGE>
+    SIMPLEX * createSimplex() const;
+
+    /**
+     * Creates the primal simplex with createSimplex().
+     *
+     * @return The new primal simplex object.
+     */
+    PrimalSimplex * createPrimalSimplex() const;
+
+    /**
+     * Creates the dual simplex with createSimplex().
+     *
+     * @return The new dual simplex object.
+     */
+    DualSimplex * createDualSimplex() const;
+
+    /**
+     * The identifiers of the iteration trace fields, they are resolved when the trace is created.
+     */
+    struct TraceFields {
+        unsigned int m_iteration;
+        unsigned int m_algorithm;
+        unsigned int m_phase;
+        unsigned int m_objective;
+        unsigned int m_infeasibility;
+        unsigned int m_incoming;
+        unsigned int m_outgoing;
+        unsigned int m_reinversion;
+        unsigned int m_etaCount;
+        unsigned int m_time;
+        unsigned int m_inversionTime;
+        unsigned int m_computeBasicSolutionTime;
+        unsigned int m_computeReducedCostsTime;
+        unsigned int m_priceTime;
+        unsigned int m_selectPivotTime;
+        unsigned int m_updateTime;
+    };
+
     /**
      * This shows the current solver algorithm it can be either primal or dual simplex.
      */
@@ -272,6 +356,37 @@ private:
      */
     const std::string & m_exportFilename;
 
+    /**
+     * Parameter reference for "Trace.enable" run-time parameter.
+     *
+     * @see SimplexParameterHandler
+     */
+    const bool & m_enableTrace;
+
+    /**
+     * Parameter reference for "Trace.filename" run-time parameter.
+     *
+     * @see SimplexParameterHandler
+     */
+    const std::string & m_traceFilename;
+
+    /**
+     * Parameter reference for "Trace.format" run-time parameter.
+     *
+     * @see SimplexParameterHandler
+     */
+    const std::string & m_traceFormat;
+
+    /**
+     * The per-iteration records of the sequential solver, nullptr if tracing is disabled.
+     */
+    IterationTrace * m_iterationTrace;
+
+    /**
+     * The identifiers of the fields of m_iterationTrace.
+     */
+    TraceFields m_traceFields;
+
     /**
      * Counter for the triggered reinversions. (eg. numerical issues)
      */
@@ -282,6 +397,11 @@ private:
      */
     unsigned int m_iterations;
 
+    /**
+     * The measures of the last solution.
+     */
+    SolveStatistics m_solveStatistics;
+
     /**
      * Optimality flag for the solution
      */
@@ -315,6 +435,21 @@ private:
      * @param model The model of the LP problem.
      */
     void switchAlgorithm(const Model &model, IterationReport *iterationReport);
+
+    /**
+     * Creates the iteration trace and registers its fields.
+     */
+    void createIterationTrace();
+
+    /**
+     * Adds the state of the current iteration to the iteration trace.
+     */
+    void traceIteration();
+
+    /**
+     * Adds the phase timers of the simplex algorithms to the solve statistics.
+     */
+    void collectSolveStatistics();
 };
 
 #endif // SIMPLEXCONTROLLER_H
@@ -0,0 +1,102 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file simplexengine.h This file contains the SimplexEngine class template.
+ */
+
+#ifndef SIMPLEXENGINE_H
+#define SIMPLEXENGINE_H
+
+#include <globals.h>
+#include <simplex/dualsimplex.h>
+#include <simplex/primalsimplex.h>
+#include <simplex/pfibasis.h>
+#include <simplex/lubasis.h>
+#include <simplex/pricing/dualdantzigpricing.h>
+#include <simplex/pricing/dualdevexpricing.h>
+#include <simplex/pricing/dualsteepestedgepricing.h>
+#include <simplex/pricing/primaldantzigpricing.h>
+#include <simplex/pricing/primaldevexpricing.h>
+#include <simplex/pricing/primalsteepestedgepricing.h>
+
+/**
+ * The simplex algorithm with a fixed basis and pricing type.
+ * SIMPLEX is DualSimplex or PrimalSimplex, BASIS and PRICING are the final implementations of
+ * Basis and the pricing of SIMPLEX. The class is final and the basis and the pricing are final,
+ * so the iteration calls its phases, the Ftran, Btran and pricing functions directly, without the
+ * virtual dispatch of the generic Simplex. The combinations are instantiated in dualsimplex.cpp
+ * and primalsimplex.cpp, SimplexController::createSimplex() selects one of them at the start of
+ * the solution.
+ *
+ * @class SimplexEngine
+ */
+template <class SIMPLEX, class BASIS, class PRICING>
+class SimplexEngine final : public SIMPLEX
+{
+    friend class Simplex;
+public:
+
+    /**
+     * Constructor of the class.
+     *
+     * @param basis The basis of the solution, its dynamic type is BASIS.
+     *
+     * @constructor
+     */
+    SimplexEngine(BASIS * basis): SIMPLEX(basis) {}
+
+    /**
+     * Performs one simplex iteration with the devirtualized phases.
+     *
+     * @param iterationIndex The index of the actual iteration.
+     */
+    void iterate(int iterationIndex) {
+        Simplex::performIteration(this, iterationIndex);
+    }
+
+private:
+
+    /**
+     * The pricing of SIMPLEX, the pricing object is created as PRICING on the first call.
+     */
+    void price() {
+        SIMPLEX::template priceImpl<BASIS, PRICING>();
+    }
+
+    /**
+     * The ratiotest of SIMPLEX.
+     */
+    void selectPivot() {
+        SIMPLEX::template selectPivotImpl<BASIS, PRICING>();
+    }
+
+    /**
+     * The basis change of SIMPLEX.
+     */
+    void update() {
+        SIMPLEX::template updateImpl<BASIS, PRICING>();
+    }
+
+    /**
+     * The working tolerance computation of SIMPLEX.
+     */
+    void computeWorkingTolerance() {
+        SIMPLEX::computeWorkingTolerance();
+    }
+};
+
+#endif // SIMPLEXENGINE_H
@@ -23,7 +23,12 @@
 
 #define STARTING_PRESOLVE_ENABLE_COMMENT ""
 #define STARTING_SCALING_ENABLE_COMMENT ""
-#define STARTING_SCALING_TYPE_COMMENT "# BENICHOU: Benichou scaling with powers of 2 "
+#define STARTING_SCALING_TYPE_COMMENT R"(# BENICHOU: Benichou scaling with powers of 2 \
+# CURTIS_REID: Curtis-Reid least squares scaling with powers of 2 \
+# EQUILIBRATION: Row and column equilibration with powers of 2)"
+#define STARTING_SCALING_MAX_ITERATIONS_COMMENT "# Maximal number of scaling passes (conjugate gradient iterations for CURTIS_REID)"
+#define STARTING_SCALING_CONVERGENCE_TOLERANCE_COMMENT "# Scaling stops when the relative improvement of a pass drops below this value"
+#define STARTING_SCALING_NUMBER_OF_THREADS_COMMENT "# Number of threads computing the scale factors (0: number of hardware threads)"
 
 #define STARTING_BASIS_STARTING_NONBASIC_STATES_COMMENT R"(# NONBASIC_TO_LOWER: Non-basic variables at lower bound \
 # NONBASIC_TO_UPPER: Non-basic variables at upper bound \
@@ -181,14 +186,24 @@
 #define GLOBAL_EXPORT_FILENAME_COMMENT ""
 #define GLOBAL_EXPORT_TYPE_COMMENT ""
 
+#define GLOBAL_TRACE_ENABLE_COMMENT ""
+#define GLOBAL_TRACE_CAPACITY_COMMENT "# The number of the most recent iterations kept in the trace."
+#define GLOBAL_TRACE_FILENAME_COMMENT ""
+#define GLOBAL_TRACE_FORMAT_COMMENT "# CSV or JSON"
+
 #define GLOBAL_BATCH_OUTPUT_COMMENT "# The output can be set to batch mode."
 #define GLOBAL_BATCH_SIZE_COMMENT "# The size of the output batch."
+#define GLOBAL_PERFORMANCE_COUNTERS_COMMENT "# Measures the IPC and the cache misses of the simplex phases with the hardware counters (Linux only)."
+#define GLOBAL_SIMPLEX_ENGINE_COMMENT "# Uses the simplex instantiated for the basis and pricing type, without virtual calls in the iterations."
 
 #define ENABLE_PARALLELIZATION_COMMENT "# This flag enables parallel solution, each thread can be parameterized."
 #define ENABLE_THREAD_SYNCHRONIZATION_COMMENT "# This flag enables the usage of the thread synchronizing parallel framework. "
 #define NUMBER_OF_THREADS_COMMENT "# The number of worker threads during solution (0 means the number of CPU cores)"
+#define ENABLE_NUMA_BINDING_COMMENT "# This flag binds the parallel simplex replicas to the NUMA nodes, and allocates their data on the node."
 
 #define ENABLE_NUMERICAL_INSTABILITY_DETEICTION_COMMENT ""
+#define REFINEMENT_PASSES_COMMENT "# Maximal number of double-double iterative refinement passes of x_B and the reduced costs after reinversion (0 disables it)"
+#define E_REFINEMENT_COMMENT "# The refinement is triggered if the largest relative residual of the basic solution or the simplex multiplier exceeds this value"
 
 /********************************************
  * BLOCK COMMENTS
@@ -233,6 +248,11 @@ const char * SIMPLEX_PARAMETERS_GLOBAL_EXPORT_COMMENT =
 # PARAMETER_STUDY = Parameter study (reporting numerical problems, tolerances and the solution)
 # RATIOTEST_STUDY = Ratiotest study (reporting measures of the ratio tests))";
 
+const char * SIMPLEX_PARAMETERS_GLOBAL_TRACE_COMMENT =
+    R"(# The solver can record the state of each iteration (iteration index, phase, objective,
+# infeasibility, pivot indices, timers, eta count) into a buffer of fixed size records.
+# The trace is written into the given file after the solution.)";
+
 const char * SIMPLEX_PARAMETERS_PARALLEL_COMMENT = "# Parallel #";
 const char * SIMPLEX_PARAMETERS_TOLERANCES_COMMENT = "# Tolerances #";
 const char * SIMPLEX_PARAMETERS_STARTING_COMMENT = "# Starting procedures";
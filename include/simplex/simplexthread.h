@@ -24,6 +24,7 @@
 #include <globals.h>
 #include <simplex/primalsimplex.h>
 #include <simplex/dualsimplex.h>
+#include <functional>
 
 /**
  * @class SimplexThread
@@ -102,6 +103,23 @@ public:
      */
     void setCurrentSimplex(Simplex * currentSimplex);
 
+    /**
+     * Sets the NUMA node of the simplex replica, performIterations() binds its thread to it.
+     *
+     * @param node The index of the node, or -1 to leave the threads unbound.
+     */
+    void setNumaNode(int node);
+
+    /**
+     * Calls the function on a thread bound to the NUMA node of the replica, so the memory
+     * allocated and initialized by the function is placed on the node.
+     * The exceptions of the function are rethrown on the calling thread.
+     * If the replica has no NUMA node, the function is called directly.
+     *
+     * @param function The function to be called.
+     */
+    void runOnNumaNode(const std::function<void()> & function);
+
 private:
 
     /**
@@ -128,6 +146,11 @@ private:
      */
     Simplex * m_currentSimplex;
 
+    /**
+     * The NUMA node of the replica, -1 if the threads are not bound.
+     */
+    int m_numaNode;
+
     //Parameter values
     /**
      * Parameter reference for "save_basis" run-time parameter.
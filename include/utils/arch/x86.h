@@ -490,6 +490,19 @@ protected:
      */
     void setFeatureList();
 
+    /**
+     * Queries the structured extended features (AVX2, AVX-512), and removes the
+     * AVX and AVX-512 features if the operating system does not save their registers.
+     */
+    void setExtendedFeatureList();
+
+    /**
+     * Returns the register states enabled by the operating system (XCR0).
+     *
+     * @return The XCR0 register.
+     */
+    unsigned long long int getEnabledRegisterStates() const;
+
     void setCPUTopologyData();
 
     /**
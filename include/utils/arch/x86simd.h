@@ -0,0 +1,156 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file x86simd.h This file contains the AVX2/FMA and AVX-512 vector kernels.
+ *
+ * The kernels are written with compiler intrinsics, and every function is compiled for its own
+ * instruction set with a target attribute, so the library itself does not need -mavx2 or
+ * -mavx512f. ArchitectureX86 selects them only if the processor and the operating system
+ * support the instruction set. They have the signatures of the ArchitectureInterface kernel
+ * types, and the same semantics as the portable versions in primitives.h: the stable dot
+ * products sum the positive and negative products separately, and the stable adds zero the
+ * results which are below the absolute tolerance, or which are cancelled relative to the
+ * operands.
+ */
+
+#ifndef X86SIMD_H
+#define X86SIMD_H
+
+#include <globals.h>
+#include <utils/platform.h>
+#include <utils/numerical.h>
+#include <cstddef>
+
+#if defined(PLATFORM_X86) && defined(__GNUC__) && DOUBLE_TYPE == DOUBLE_CLASSIC
+#define X86_SIMD_KERNELS
+#endif
+
+#ifdef X86_SIMD_KERNELS
+
+/***********************************************
+ * AVX2 and FMA
+ **********************************************/
+
+Numerical::Double denseToDenseDotProductUnstableAVX2(const Numerical::Double * vec1,
+                                                     const Numerical::Double * vec2,
+                                                     size_t count);
+
+Numerical::Double denseToDenseDotProductStableAVX2(const Numerical::Double * vec1,
+                                                   const Numerical::Double * vec2,
+                                                   size_t count,
+                                                   Numerical::Double * negPtr);
+
+Numerical::Double denseToSparseDotProductUnstableAVX2(const Numerical::Double * dense,
+                                                      const Numerical::Double * sparse,
+                                                      const unsigned int * indices,
+                                                      size_t count);
+
+Numerical::Double denseToSparseDotProductStableAVX2(const Numerical::Double * dense,
+                                                    const Numerical::Double * sparse,
+                                                    const unsigned int * indices,
+                                                    size_t count,
+                                                    Numerical::Double * negPtr);
+
+Numerical::Double indexedDenseToIndexedDenseDotProductUnstableAVX2(const Numerical::Double * dense1,
+                                                                   const Numerical::Double * dense2,
+                                                                   const unsigned int * indices,
+                                                                   size_t nonZeroCount);
+
+Numerical::Double indexedDenseToIndexedDenseDotProductStableAVX2(const Numerical::Double * dense1,
+                                                                 const Numerical::Double * dense2,
+                                                                 const unsigned int * indices,
+                                                                 size_t nonZeroCount,
+                                                                 Numerical::Double * negPtr);
+
+void denseToDenseAddAVX2Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                              size_t count, Numerical::Double lambda);
+
+void denseToDenseAddAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                size_t count, Numerical::Double lambda);
+
+void denseToDenseAddAbsAVX2Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                 size_t count, Numerical::Double lambda, Numerical::Double absTolerance);
+
+void denseToDenseAddAbsAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                   size_t count, Numerical::Double lambda, Numerical::Double absTolerance);
+
+void denseToDenseAddAbsRelAVX2Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                    size_t count, Numerical::Double lambda, Numerical::Double absTolerance,
+                                    Numerical::Double relTolerance);
+
+void denseToDenseAddAbsRelAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                      size_t count, Numerical::Double lambda, Numerical::Double absTolerance,
+                                      Numerical::Double relTolerance);
+
+/***********************************************
+ * AVX-512
+ **********************************************/
+
+Numerical::Double denseToDenseDotProductUnstableAVX512(const Numerical::Double * vec1,
+                                                       const Numerical::Double * vec2,
+                                                       size_t count);
+
+Numerical::Double denseToDenseDotProductStableAVX512(const Numerical::Double * vec1,
+                                                     const Numerical::Double * vec2,
+                                                     size_t count,
+                                                     Numerical::Double * negPtr);
+
+Numerical::Double denseToSparseDotProductUnstableAVX512(const Numerical::Double * dense,
+                                                        const Numerical::Double * sparse,
+                                                        const unsigned int * indices,
+                                                        size_t count);
+
+Numerical::Double denseToSparseDotProductStableAVX512(const Numerical::Double * dense,
+                                                      const Numerical::Double * sparse,
+                                                      const unsigned int * indices,
+                                                      size_t count,
+                                                      Numerical::Double * negPtr);
+
+Numerical::Double indexedDenseToIndexedDenseDotProductUnstableAVX512(const Numerical::Double * dense1,
+                                                                     const Numerical::Double * dense2,
+                                                                     const unsigned int * indices,
+                                                                     size_t nonZeroCount);
+
+Numerical::Double indexedDenseToIndexedDenseDotProductStableAVX512(const Numerical::Double * dense1,
+                                                                   const Numerical::Double * dense2,
+                                                                   const unsigned int * indices,
+                                                                   size_t nonZeroCount,
+                                                                   Numerical::Double * negPtr);
+
+void denseToDenseAddAVX512Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                size_t count, Numerical::Double lambda);
+
+void denseToDenseAddAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                  size_t count, Numerical::Double lambda);
+
+void denseToDenseAddAbsAVX512Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                   size_t count, Numerical::Double lambda, Numerical::Double absTolerance);
+
+void denseToDenseAddAbsAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                     size_t count, Numerical::Double lambda, Numerical::Double absTolerance);
+
+void denseToDenseAddAbsRelAVX512Cache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                      size_t count, Numerical::Double lambda, Numerical::Double absTolerance,
+                                      Numerical::Double relTolerance);
+
+void denseToDenseAddAbsRelAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                                        size_t count, Numerical::Double lambda, Numerical::Double absTolerance,
+                                        Numerical::Double relTolerance);
+
+#endif // X86_SIMD_KERNELS
+
+#endif // X86SIMD_H
@@ -162,6 +162,38 @@ public:
 
     static size_t getLargestCacheSize();
 
+    /**
+     * Returns the size in bytes from which the memory copies use the non-temporal kernel.
+     * It is the calibrated value, or the size of the largest cache if it is not calibrated.
+     *
+     * @return The limit of the cached copy.
+     */
+    static size_t getNonTemporalCopyLimit();
+
+    /**
+     * Returns the size in bytes from which the dense vector additions use the non-temporal kernels.
+     * It is the calibrated value, or the size of the largest cache if it is not calibrated.
+     *
+     * @return The limit of the cached addition.
+     */
+    static size_t getNonTemporalAddLimit();
+
+    /**
+     * Returns the density below which adding a vector through its nonzero index list is faster
+     * than the dense kernel, or 0 if it is not calibrated.
+     *
+     * @return The calibrated density limit.
+     */
+    static double getSparseAddDensityLimit();
+
+    /**
+     * Measures the crossover points of the kernel variants on the current machine.
+     * The cached and the non-temporal memcpy and dense add kernels are compared for
+     * increasing sizes, and the index list add is compared with the dense add for
+     * increasing densities.
+     */
+    void calibrate();
+
 protected:
 
     static MemCpyCache sm_memCpyCachePtr;
@@ -194,6 +226,13 @@ protected:
 
     static size_t sm_largestCacheSize;
 
+    /**
+     * The calibrated dispatch thresholds, they are 0 if not calibrated.
+     */
+    static size_t sm_nonTemporalCopyLimit;
+    static size_t sm_nonTemporalAddLimit;
+    static double sm_sparseAddDensityLimit;
+
     /**
      * The set of features the system supports.
      */
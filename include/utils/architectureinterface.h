@@ -292,6 +292,12 @@ public:
      * Generates an architecture specific parameter file.
      */
     virtual void generateParameterFile() const = 0;
+
+    /**
+     * Measures the dispatch thresholds of the kernels on the current machine.
+     * The thresholds are saved by generateParameterFile(), and loaded by loadParameters().
+     */
+    virtual void calibrate() = 0;
 };
 
 #endif // ARCHITECTUREINTERFACE_H
@@ -74,6 +74,42 @@ public:
      */
     void openForRead(const char * fileName, int bufferSize, int recordSize);
 
+    /**
+     * Maps the whole content of the specified file into the memory for read.
+     * The mapped content is followed by zero bytes, so the last character can be
+     * read as a terminating zero, as in the case of openForRead().
+     * After a successful mapping, nextBlock() does not move the data.
+     *
+     * @throws FileNotFoundException when the specified file is not found.
+     *
+     * @param fileName The name of the file to be mapped.
+     * @return False if memory mapping is not supported or failed; the file is not opened then.
+     */
+    bool mapForRead(const char * fileName);
+
+    /**
+     * Returns the size of the specified file in bytes, or 0 if it cannot be determined.
+     *
+     * @param fileName The name of the file.
+     * @return The size of the file.
+     */
+    static size_t getFileSize(const char * fileName);
+
+    /**
+     * Returns true if the file is mapped into the memory by mapForRead().
+     *
+     * @return True if the file is mapped.
+     */
+    bool isMapped() const;
+
+    /**
+     * Returns the pointer after the last character of the file stored in the buffer.
+     * If the file is mapped, it is the end of the whole file.
+     *
+     * @return The pointer after the last available character.
+     */
+    const char * getEnd() const;
+
     /**
      * Returns true if the pointer has reached the end of file.
      *
@@ -146,6 +182,16 @@ private:
      * Pointer to the last character of the file.
      */
     char * m_end;
+
+    /**
+     * True if the file is mapped into the memory.
+     */
+    bool m_mapped;
+
+    /**
+     * The size of the memory mapped region, including the zero guard pages.
+     */
+    size_t m_mappedSize;
 };
 
 #endif	/* FILE_H */
@@ -26,7 +26,6 @@
 #include <globals.h>
 #include <utils/numerical.h>
 
-#include <set>
 #include <iostream>
 #include <typeinfo>
 #include <vector>
@@ -524,9 +523,12 @@ public:
         Element<TYPE> * m_actual;
 
         /**
-         * The partition borders for the iterator.
+         * The headers of the first and last iterated partitions in case of multiple-partition
+         * iteration. The headers are consecutive, so the iterator steps over the headers
+         * between them without allocating a set of borders.
          */
-        std::set<Element<TYPE>*> m_borders;
+        Element<TYPE> * m_firstBorder;
+        Element<TYPE> * m_lastBorder;
     public:
 
         /**
@@ -539,6 +541,8 @@ public:
         _Iterator()
         {
             m_actual = 0;
+            m_firstBorder = 0;
+            m_lastBorder = 0;
         }
 
         /**
@@ -550,6 +554,8 @@ public:
         _Iterator(Element<TYPE> * actual)
         {
             m_actual = actual;
+            m_firstBorder = 0;
+            m_lastBorder = 0;
         }
 
         /**
@@ -560,12 +566,14 @@ public:
          *
          * @constructor
          * @param actual The value of pointer of actual element in linked list.
-         * @param borders The set of headers of partitions in case of multiple-partition iteration.
+         * @param firstBorder The header of the first iterated partition.
+         * @param lastBorder The header of the last iterated partition.
          */
-        _Iterator(Element<TYPE> * actual, const std::set<Element<TYPE>*> & borders)
+        _Iterator(Element<TYPE> * actual, Element<TYPE> * firstBorder, Element<TYPE> * lastBorder)
         {
             m_actual = actual;
-            m_borders = borders;
+            m_firstBorder = firstBorder;
+            m_lastBorder = lastBorder;
         }
 
         /**
@@ -618,29 +626,9 @@ public:
         void next()
         {
             m_actual = m_actual->m_next;
-            if (m_actual->m_isHeader == true) {
-                typename std::set<Element<TYPE>*>::iterator iter = m_borders.find(m_actual);
-                if (iter != m_borders.end()) {
-                    ++iter; // next border
-                    if (iter != m_borders.end()) {
-                        m_actual = (*iter)->m_next;
-                        bool end = !m_actual->m_isHeader;
-                        while (end == false) {
-                            iter = m_borders.find(m_actual);
-                            if (iter != m_borders.end()) {
-                                ++iter;
-                                if (iter != m_borders.end()) {
-                                    m_actual = (*iter)->m_next;
-                                    end = !m_actual->m_isHeader;
-                                } else {
-                                    end = true;
-                                }
-                            } else {
-                                end = true;
-                            }
-                        }
-                    }
-                }
+            // steps over the empty partitions to the first element of the next border
+            while (m_actual->m_isHeader == true && m_actual >= m_firstBorder && m_actual < m_lastBorder) {
+                m_actual = (m_actual + 1)->m_next;
             }
         }
 
@@ -915,15 +903,8 @@ public:
         unsigned int lastPartitionIndex = partitionIndex + partitions - 1;
         Element<ATTACHED_TYPE> * beginHead = m_heads + partitionIndex;
         Element<ATTACHED_TYPE> * endHead = m_heads + lastPartitionIndex;
-        std::set<Element<ATTACHED_TYPE>*> borders;
-        *end = Iterator(endHead, borders);
-
-        unsigned int index = partitionIndex;
-        for (; index <= lastPartitionIndex; index++) {
-            borders.insert(m_heads + index);
-        }
-
-        *begin = Iterator(beginHead, borders);
+        *end = Iterator(endHead);
+        *begin = Iterator(beginHead, beginHead, endHead);
         begin->next();
     }
 
@@ -226,6 +226,11 @@ private:
      */
     std::vector< Entry > m_exportTable;
 
+    /**
+     * The entries of the actual iteration row, the vector is reused in every iteration.
+     */
+    std::vector< Entry > m_iterationRow;
+
     /**
      *
      */
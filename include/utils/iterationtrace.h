@@ -0,0 +1,211 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file iterationtrace.h This file contains the API of the IterationTrace class.
+ */
+
+#ifndef ITERATIONTRACE_H
+#define ITERATIONTRACE_H
+
+#include <globals.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * This class records the state of the solver in every iteration into a preallocated
+ * ring buffer, keeping the most recent iterations.
+ *
+ * Unlike the IterationReport, nothing is formatted during the solution: the fields
+ * are registered once before the first record and get a numeric identifier, and
+ * each record is a fixed row of numbers addressed by these identifiers. The records
+ * can be exported in CSV or JSON format after the solution, or at any time on demand.
+ *
+ * @class IterationTrace
+ */
+class IterationTrace {
+private:
+
+    /**
+     * One value of a record.
+     */
+    union Slot {
+        long long int m_integer;
+        double m_float;
+    };
+
+public:
+
+    /**
+     * The type of a trace field.
+     */
+    enum FIELD_TYPE {
+        IT_INT,
+        IT_FLOAT
+    };
+
+    /**
+     * Handle of a record in the ring buffer, it is valid until the next record is added.
+     *
+     * @class Record
+     */
+    class Record {
+        friend class IterationTrace;
+    public:
+
+        /**
+         * Sets an integer field of the record.
+         *
+         * @param field The identifier returned by IterationTrace::registerField().
+         * @param value The value of the field.
+         */
+        ALWAYS_INLINE void setInteger(unsigned int field, long long int value) {
+            m_slots[field].m_integer = value;
+        }
+
+        /**
+         * Sets a floating point field of the record.
+         *
+         * @param field The identifier returned by IterationTrace::registerField().
+         * @param value The value of the field.
+         */
+        ALWAYS_INLINE void setFloat(unsigned int field, double value) {
+            m_slots[field].m_float = value;
+        }
+
+    private:
+
+        Slot * m_slots;
+
+        explicit Record(Slot * slots): m_slots(slots) {}
+    };
+
+    /**
+     * Constructor of the IterationTrace class.
+     *
+     * @constructor
+     * @param capacity The number of the most recent records kept.
+     */
+    explicit IterationTrace(unsigned int capacity);
+
+    /**
+     * Registers a field of the records, and returns its identifier.
+     * Registering a name again returns the identifier of the existing field.
+     * The fields can be registered only while the trace is empty.
+     *
+     * @param name The name of the field, used as the column name of the exports.
+     * @param type The type of the field.
+     * @return The identifier of the field.
+     * @throws PanOptException if the trace already contains records.
+     */
+    unsigned int registerField(const std::string & name, FIELD_TYPE type);
+
+    /**
+     * Adds a new record to the trace, overwriting the oldest one if the buffer is full.
+     * The fields of the new record are zero.
+     *
+     * @return Handle of the new record.
+     */
+    Record addRecord();
+
+    /**
+     * Removes the records, the registered fields are kept.
+     */
+    void clear();
+
+    /**
+     * Returns the number of records added since the last clear, including the overwritten ones.
+     *
+     * @return The total number of records.
+     */
+    unsigned long long int getTotalRecordCount() const {
+        return m_totalRecordCount;
+    }
+
+    /**
+     * Returns the number of records stored in the buffer.
+     *
+     * @return The number of stored records.
+     */
+    unsigned int getRecordCount() const;
+
+    /**
+     * Writes the stored records to a stream in CSV format, from the oldest to the newest.
+     * The first line contains the names of the fields.
+     *
+     * @param out The target stream.
+     */
+    void writeCsv(std::ostream & out) const;
+
+    /**
+     * Writes the stored records to a stream as a JSON array of objects,
+     * from the oldest to the newest.
+     *
+     * @param out The target stream.
+     */
+    void writeJson(std::ostream & out) const;
+
+    /**
+     * Writes the stored records into a file.
+     *
+     * @param filename The name of the file.
+     * @param format The format of the file, CSV or JSON.
+     * @throws PanOptException if the file cannot be opened or the format is unknown.
+     */
+    void exportToFile(const std::string & filename, const std::string & format) const;
+
+private:
+
+    /**
+     * The names of the registered fields.
+     */
+    std::vector<std::string> m_names;
+
+    /**
+     * The types of the registered fields.
+     */
+    std::vector<FIELD_TYPE> m_types;
+
+    /**
+     * The records, one row of m_names.size() slots for each.
+     * It is allocated when the first record is added.
+     */
+    std::vector<Slot> m_slots;
+
+    /**
+     * The maximal number of stored records.
+     */
+    unsigned int m_capacity;
+
+    /**
+     * The index of the row of the next record.
+     */
+    unsigned int m_next;
+
+    /**
+     * The number of records added since the last clear.
+     */
+    unsigned long long int m_totalRecordCount;
+
+    /**
+     * Writes a value of a record.
+     */
+    void writeValue(std::ostream & out, const Slot & slot, FIELD_TYPE type, bool json) const;
+};
+
+#endif // ITERATIONTRACE_H
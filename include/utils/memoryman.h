@@ -22,10 +22,9 @@
 #define MEMORYMAN_H
 
 #include <cstddef>
-#include <iostream>
+#include <vector>
 
 #define CACHE_LINE_ALIGNMENT
-#define CLASSIC_NEW_DELETE
 
 constexpr unsigned int logarithm2(unsigned int n) {
     return n == 1 ? 0 : 1 + logarithm2(n / 2);
@@ -43,304 +42,154 @@ struct Logarithm<1>
     enum { value = 0 };
 };*/
 
-#ifndef CLASSIC_NEW_DELETE
-
-
-#define likely(x)       __builtin_expect((x),1)
-#define unlikely(x)     __builtin_expect((x),0)
-
-#include <new>
-#include <cstdlib>
-#include <iostream>
-#include <cstdio>
-
-// TODO: cache hatarokra valo igazitast meg kell oldani
-
-struct ChunkStack;
-
-struct Chunk {
-    Chunk * m_previous;
-    ChunkStack * m_stack;
-};
-
-struct Buffer {
-    Buffer * m_next;
-    unsigned int m_size;
-    char * m_bufferStart;
-    char * m_bufferEnd;
-    char * m_actual;
-};
-
-class Pool {
-    friend class MemoryManagerInitializer;
-public:
-    static void init(bool parallel = false) {
-        sm_head = static_cast<Buffer*>(malloc(sizeof(Buffer)));
-        sm_head->m_next = 0;
-        sm_head->m_bufferStart = static_cast<char*>(malloc( sm_poolSize ));
-        sm_head->m_actual = sm_head->m_bufferStart;
-        sm_head->m_size = sm_poolSize;
-        sm_head->m_bufferEnd = sm_head->m_bufferStart + sm_poolSize;
-        if (parallel == true) {
-            sm_sequentialHead = sm_head;
-        }
-    }
-
-    static void release() {
-        //        sm_head = 0;
-        //        return;
-        Buffer * actual = sm_head;
-        while (actual != 0) {
-            Buffer * next = actual->m_next;
-            free(actual->m_bufferStart);
-            free(actual);
-            actual = next;
-        }
-        sm_head = 0;
-    }
-
-    inline static Chunk * getChunk(size_t size) {
-        Buffer * actual = sm_head;
-        size += sizeof(Chunk);
-        while ( actual != 0 && ((actual->m_bufferEnd - actual->m_actual) < (long int)size) ) {
-            actual = actual->m_next;
-        }
-        if (unlikely(actual == 0)) {
-            //printf("Uj buffer kell\n");
-            Buffer * newBuffer = static_cast<Buffer*>(malloc(sizeof(Buffer)));
-            newBuffer->m_next = sm_head;
-            sm_head = newBuffer;
-            newBuffer->m_bufferStart = static_cast<char*>(malloc( sm_poolSize ));
-            newBuffer->m_actual = newBuffer->m_bufferStart;
-            newBuffer->m_size = sm_poolSize;
-            newBuffer->m_bufferEnd = newBuffer->m_bufferStart + sm_poolSize;
-            actual = newBuffer;
-        }
-        Chunk * result = reinterpret_cast<Chunk*>(actual->m_actual);
-        actual->m_actual += size;
-        return result;
-    }
-
-    static thread_local Buffer * sm_head;
-    static Buffer * sm_sequentialHead;
-
-private:
-    static const int sm_poolSize = 1048576;
-
-};
-
-class ChunkStack {
-public:
-    ChunkStack() {
-        m_head = 0;
-    }
-
-    void init() {
-        m_head = 0;
-    }
-
-    void release() {
-
-    }
-
-    inline Chunk * getChunk(size_t size) {
-        Chunk * result;
-        if (m_head != 0) {
-            result = m_head;
-            m_head = m_head->m_previous;
-
-        } else {
-            result = Pool::getChunk(size);
-            //result = reinterpret_cast<Chunk*>(malloc(sizeof(Chunk) + size));
-            result->m_stack = this;
-            result->m_previous = 0;
-        }
-        return result;
-    }
-
-    inline void addChunk(Chunk * chunk) {
-        chunk->m_previous = m_head;
-        m_head = chunk;
-    }
-
-private:
-    Chunk * m_head;
+/**
+ * Allocation statistics of a size class of the MemoryManager.
+ */
+struct MemoryStatistics {
+    /**
+     * The largest request served by the size class, 0 for the direct allocations.
+     */
+    size_t m_blockSize;
+
+    /**
+     * The number of allocations.
+     */
+    unsigned long long int m_allocations;
+
+    /**
+     * The number of releases.
+     */
+    unsigned long long int m_releases;
+
+    /**
+     * The number of batches moved from the shared depot to a thread cache.
+     */
+    unsigned long long int m_refills;
+
+    /**
+     * The number of batches returned from a thread cache to the shared depot.
+     */
+    unsigned long long int m_returns;
+
+    /**
+     * The memory reserved from the system for the size class, in bytes.
+     */
+    unsigned long long int m_reservedBytes;
+
+    /**
+     * The number of the allocations backed by huge pages.
+     */
+    unsigned long long int m_hugePageAllocations;
 };
 
+/**
+ * Size class pool allocator with thread-local caches.
+ *
+ * The requests up to sm_maxPooledSize bytes are rounded up to one of the size classes.
+ * Every thread keeps a free list of blocks for each size class, so most allocations and
+ * releases do not synchronize. The thread caches exchange batches of blocks with a shared,
+ * mutex protected depot, which carves the blocks from large slabs. A block can be released
+ * by any thread. The larger requests are allocated directly from the system.
+ *
+ * Every block is preceded by a small header, and the returned memory is aligned to
+ * sm_alignment bytes, so the vectors need no over-allocation for their SIMD kernels.
+ * The slabs are kept until the end of the process, and reused by the later solves.
+ *
+ * The direct allocations above the huge page threshold are aligned to huge pages, and the
+ * operating system is advised to back them with transparent huge pages. The pages are
+ * placed on the NUMA node of the thread which touches them first, so the large arrays of a
+ * thread should be allocated and initialized by the thread itself.
+ *
+ * @class MemoryManager
+ */
 class MemoryManager {
-    friend class MemoryManagerInitializer;
-    friend class InitPanOpt;
 public:
 
-    static bool sm_initialized;
-
-    MemoryManager() {
-        //std::cout << "Initialize memory manager" << std::endl;
-        //init();
-    }
-
-    ~MemoryManager() {
-        release();
-    }
-
-    inline static void * allocate(size_t size) {
-        Chunk * chunk;
-        if (likely(size <= (size_t)sm_maxSmallStackSize)) {
-            chunk = sm_smallStacks[size >> logarithm2(sm_smallSteps)].getChunk(((size >> logarithm2(sm_smallSteps) ) + 1) << logarithm2(sm_smallSteps));
-            // std::cout << "ALLOC CHUNK 1: " << chunk << "  " << chunk->m_stack << std::endl;
-        } else if (size <= (size_t) sm_maxLargeStackSize) {
-            chunk = sm_largeStacks[size >> logarithm2(sm_largeSteps)].getChunk(((size >> logarithm2(sm_largeSteps)) + 1) << logarithm2(sm_largeSteps));
-            // std::cout << "ALLOC CHUNK 2: " << chunk << std::endl;
-        } else {
-            chunk = static_cast<Chunk*>(malloc( sizeof(Chunk) + size ));
-            //  std::cout << "ALLOC CHUNK: " << chunk << std::endl;
-            chunk->m_stack = 0;
-        }
-
-        chunk++;
-        //        printf("address: %p\n", chunk);
-        //        getchar();
-        return static_cast<void*>(chunk);
-    }
-
-    inline static void release(void * pointer) {
-        Chunk * chunk = reinterpret_cast<Chunk*>(pointer);  //reinterpret_cast<Chunk*>(reinterpret_cast<char*>(pointer) - sizeof(Chunk));
-        chunk--;
-        if (likely(chunk->m_stack != 0)) {
-            chunk->m_stack->addChunk(chunk);
-        } else {
-            //  std::cout << "CHUNK: " << chunk << std::endl;
-            free(chunk);
-        }
-        //free(pointer);
-    }
-
-private:
-
-    static const int sm_smallSteps = 4;
-    static const int sm_maxSmallStackSize = 1024;
-
-    static const int sm_largeSteps = 4;
-    static const int sm_maxLargeStackSize = 1024 * 256;
-
-    static thread_local ChunkStack * sm_smallStacks;
-    static thread_local ChunkStack * sm_largeStacks;
-
-    static ChunkStack * sm_sequentialSmallStacks;
-    static ChunkStack * sm_sequentialLargeStacks;
-public:
-
-    static void startParallel() {
-        std::cout << "parallel SM_SMALLSTACKS: " << sm_smallStacks << std::endl;
-        init(true);
-    }
-
-    static void endParallel() {
-
-    }
-
-    static void init(bool parallel = false) {
-        Pool::init(parallel);
-        unsigned int count = sm_maxSmallStackSize / sm_smallSteps + 1;
-        sm_smallStacks = static_cast<ChunkStack*>(malloc( count * sizeof(ChunkStack) ));
-        std::cout << "SM_SMALLSTACKS: " << sm_smallStacks << std::endl;
-        unsigned int index;
-        for (index = 0; index < count; index++) {
-            sm_smallStacks[index].init();
-        }
-
-        count = sm_maxLargeStackSize / sm_largeSteps + 1;
-        sm_largeStacks = static_cast<ChunkStack*>(malloc( count * sizeof(ChunkStack) ));
-        for (index = 0; index < count; index++) {
-            sm_largeStacks[index].init();
-        }
-        sm_initialized = true;
-        //printf("Memory manager initialized\n");
-        if (parallel == true) {
-            sm_sequentialSmallStacks = sm_smallStacks;
-            sm_sequentialLargeStacks = sm_largeStacks;
-        }
-    }
-
-    static void release() {
-        unsigned int index;
-        unsigned int count = sm_maxSmallStackSize / sm_smallSteps;
-        for (index = 0; index < count; index++) {
-            sm_smallStacks[index].release();
-        }
-        free(sm_smallStacks);
-        sm_smallStacks = 0;
-        count = sm_maxLargeStackSize / sm_largeSteps;
-        for (index = 0; index < count; index++) {
-            sm_largeStacks[index].release();
-        }
-        free(sm_largeStacks);
-        sm_largeStacks = 0;
-        Pool::release();
-        sm_initialized = false;
-    }
-};
-
-inline void * operator new (size_t size) {
-    //    return malloc(size + sizeof(int)*0);
-    return MemoryManager::allocate(size);
-}
-
-inline void operator delete(void * p) {
-    //free(p);
-    if (likely(p != nullptr)) {
-        MemoryManager::release(p);
-    }
-}
-
-inline void * operator new [](size_t size) {
-    //return malloc(size + sizeof(int)*0);
-    return MemoryManager::allocate(size);
-}
-
-inline void operator delete [](void * p) {
-    //free(p);
-    if (likely(p != nullptr)) {
-        MemoryManager::release(p);
-    }
-}
-
-
-#undef likely
-#undef unlikely
-
-#endif
-
-union Pointer {
-    void * ptr;
-    unsigned long int bits;
+    /**
+     * The alignment of the allocated memory, the size of a cache line.
+     */
+    static const size_t sm_alignment = 64;
+
+    /**
+     * The largest request served from the size classes.
+     */
+    static const size_t sm_maxPooledSize = 256 * 1024 - 16;
+
+    /**
+     * The size of the transparent huge pages.
+     */
+    static const size_t sm_hugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * Allocates memory aligned to sm_alignment bytes.
+     *
+     * @param size The size of the requested memory in bytes.
+     * @return Pointer to the allocated memory.
+     * @throws std::bad_alloc if the system is out of memory.
+     */
+    static void * allocate(size_t size);
+
+    /**
+     * Releases memory allocated by allocate().
+     * It can be called from any thread.
+     *
+     * @param pointer The memory to be released, it can be nullptr.
+     */
+    static void release(void * pointer);
+
+    /**
+     * Returns the free blocks cached by the current thread to the shared depot, and
+     * merges the statistics of the thread.
+     * It is called automatically at the exit of the threads, and by InitPanOpt::threadRelease().
+     */
+    static void releaseThreadCache();
+
+    /**
+     * Returns the statistics of the size classes, the last element describes the
+     * direct allocations.
+     * The statistics of the running threads other than the caller are included only
+     * after their releaseThreadCache().
+     *
+     * @return The statistics of the size classes.
+     */
+    static std::vector<MemoryStatistics> getStatistics();
+
+    /**
+     * Returns the number of allocations of the current thread since its start.
+     * The counter is never reset, the allocations of a code section are the difference of
+     * two calls, as in SimplexController::sequentialSolve().
+     *
+     * @return The number of allocations of the current thread.
+     */
+    static unsigned long long int getAllocationCount();
+
+    /**
+     * Counts an allocation of the current thread which is not served by the MemoryManager.
+     * A replacement of the global operator new can call it, so getAllocationCount() covers
+     * the objects and the standard containers too.
+     */
+    static void countAllocation();
+
+    /**
+     * Writes the statistics of the used size classes to the log.
+     */
+    static void printStatistics();
+
+    /**
+     * Sets the size above which the allocations are backed by huge pages.
+     * It is set from the huge_page_threshold linear algebra parameter at the initialization.
+     *
+     * @param size The threshold in bytes, 0 disables the huge pages.
+     */
+    static void setHugePageThreshold(size_t size);
 };
 
 // TODO: ezeket attenni egy meta.h fileba
 
 template <class T, unsigned alignment>
 T * alloc(int size) {
-#ifndef CACHE_LINE_ALIGNMENT
-    return new T[size];
-#endif
-
-    size *= sizeof(T);
-
-#ifdef CLASSIC_NEW_DELETE
-    char * originalPtr = new char[size + alignment + sizeof(void*)];
-#else
-    char * originalPtr = (char*)MemoryManager::allocate(size + alignment + sizeof(void*));
-#endif
-    char * ptr2 = originalPtr + alignment + sizeof(void*);
-
-    Pointer ptr;
-    ptr.ptr = ptr2;
-    ptr.bits &= ~((1 << logarithm2(alignment)) - 1);
-    ptr2 = static_cast<char*>(ptr.ptr);
-    ptr2 -= sizeof(void*);
-    *((char**)ptr2) = originalPtr;
-    ptr2 = ptr2 + sizeof(void*);
-    return reinterpret_cast<T*>(ptr2);
+    static_assert(alignment <= MemoryManager::sm_alignment, "The MemoryManager aligns to cache lines only");
+    return static_cast<T*>(MemoryManager::allocate(size * sizeof(T)));
 }
 
 void release(void * ptr);
@@ -0,0 +1,239 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file namepool.h This file contains the API of the NamePool and PooledName classes.
+ */
+
+#ifndef NAMEPOOL_H
+#define NAMEPOOL_H
+
+#include <globals.h>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+class NamePool;
+
+/**
+ * Handle of a name stored in the NamePool.
+ * It is as small as a pointer, and copying it does not copy the name itself,
+ * so the objects holding names (like Variable and Constraint) are cheap to copy.
+ *
+ * @class PooledName
+ */
+class PooledName {
+    friend class NamePool;
+public:
+
+    /**
+     * Constructor of the PooledName class, it creates an empty name.
+     *
+     * @constructor
+     */
+    PooledName(): m_name(0) {}
+
+    /**
+     * Returns the characters of the name, or 0 if the name is empty.
+     *
+     * @return Pointer to the zero terminated name.
+     */
+    ALWAYS_INLINE const char * c_str() const {
+        return m_name;
+    }
+
+    /**
+     * Returns true if no name is given.
+     *
+     * @return True if the name is empty.
+     */
+    ALWAYS_INLINE bool isEmpty() const {
+        return m_name == 0;
+    }
+
+    bool operator==(const PooledName & other) const {
+        if (m_name == other.m_name) {
+            return true;
+        }
+        return m_name != 0 && other.m_name != 0 && strcmp(m_name, other.m_name) == 0;
+    }
+
+    bool operator!=(const PooledName & other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * Compares the name with a string, the empty name equals to the empty string.
+     */
+    bool operator==(const char * name) const {
+        if (m_name == 0) {
+            return name == 0 || name[0] == 0;
+        }
+        return name != 0 && strcmp(m_name, name) == 0;
+    }
+
+    bool operator!=(const char * name) const {
+        return !(*this == name);
+    }
+
+private:
+
+    /**
+     * Points to the name in the NamePool.
+     */
+    const char * m_name;
+
+    explicit PooledName(const char * name): m_name(name) {}
+};
+
+/**
+ * This class stores the names of the model elements. The names are never moved,
+ * and they are stored in large blocks, one after the other, instead of separate
+ * heap allocations. Adding names is thread safe.
+ * The models and the model builders hold a NamePool::Reference, and the blocks are
+ * released when the last reference is destroyed, so a process which loads many
+ * models one after the other does not grow without bound. The PooledName handles
+ * stay valid while a Model or a ModelBuilder exists; the names of the elements
+ * created without any of them are released with the next model.
+ *
+ * @class NamePool
+ */
+class NamePool {
+public:
+
+    /**
+     * Keeps the stored names alive, Model and ModelBuilder have one as a member.
+     *
+     * @class Reference
+     */
+    class Reference {
+    public:
+
+        /**
+         * Constructor of the Reference class.
+         *
+         * @constructor
+         */
+        Reference() {
+            NamePool::getInstance().acquire();
+        }
+
+        /**
+         * Copy constructor of the Reference class, the copy is a new reference.
+         *
+         * @constructor
+         */
+        Reference(const Reference &) {
+            NamePool::getInstance().acquire();
+        }
+
+        /**
+         * Both references remain, so the assignment does nothing.
+         */
+        Reference & operator=(const Reference &) {
+            return *this;
+        }
+
+        /**
+         * Destructor of the Reference class, the last reference releases the names.
+         *
+         * @destructor
+         */
+        ~Reference() {
+            NamePool::getInstance().release();
+        }
+    };
+
+    /**
+     * Returns the instance of the singleton NamePool class.
+     *
+     * @return The instance of the NamePool.
+     */
+    static NamePool & getInstance();
+
+    /**
+     * Stores a copy of a name.
+     *
+     * @param name The zero terminated name to be stored.
+     * @return Handle of the stored name; empty if name is 0 or an empty string.
+     */
+    PooledName add(const char * name);
+
+    /**
+     * Returns the total number of bytes used by the stored names.
+     *
+     * @return The size of the stored names.
+     */
+    size_t getSize() const;
+
+private:
+
+    /**
+     * The minimal size of a block of names.
+     */
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+    /**
+     * The blocks of the stored names.
+     */
+    std::vector<char*> m_blocks;
+
+    /**
+     * Points to the free space of the last block.
+     */
+    char * m_next;
+
+    /**
+     * Points after the last block.
+     */
+    char * m_end;
+
+    /**
+     * The total number of stored bytes.
+     */
+    size_t m_size;
+
+    /**
+     * The number of the living references.
+     */
+    unsigned int m_references;
+
+    /**
+     * Protects the blocks when names are added concurrently.
+     */
+    mutable std::mutex m_mutex;
+
+    NamePool();
+
+    ~NamePool();
+
+    /**
+     * Registers a new reference.
+     */
+    void acquire();
+
+    /**
+     * Unregisters a reference, and releases the blocks if it was the last one.
+     */
+    void release();
+
+    NamePool(const NamePool &) = delete;
+
+    NamePool & operator=(const NamePool &) = delete;
+};
+
+#endif // NAMEPOOL_H
@@ -0,0 +1,321 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file nametable.h
+ */
+
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+#include <globals.h>
+#include <new>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * This class describes an open addressing hash table for entries identified by
+ * 8 byte names, like the names of the MPS format. The KEY_FUNCTION template
+ * returns the 64 bit word of the name of an entry.
+ *
+ * The slots are organized into cache line aligned groups of 4, each group stores
+ * the 4 keys followed by the 4 entries. A lookup compares the keys of a whole
+ * group with the searched key at once, and goes on to the next group only if the
+ * group is full, so most of the lookups touch only the memory of one group.
+ * The table keeps at least half of the slots empty.
+ *
+ * @class NameTable
+ */
+template<class TYPE, class KEY_FUNCTION>
+class NameTable {
+public:
+
+    /**
+     * Constructor of the NameTable class.
+     *
+     * @constructor
+     */
+    NameTable():
+        m_groups(0),
+        m_groupCount(0),
+        m_shift(64),
+        m_count(0),
+        m_hasZeroKey(false)
+    {
+
+    }
+
+    /**
+     * Destructor of the NameTable class.
+     *
+     * @destructor
+     */
+    ~NameTable() {
+        freeTable();
+    }
+
+    NameTable(const NameTable &) = delete;
+
+    NameTable & operator=(const NameTable &) = delete;
+
+    /**
+     * Clears the table, and reserves space for the given number of entries.
+     *
+     * @param size The number of entries stored without growing the table.
+     */
+    void setSize(unsigned int size) {
+        unsigned int groupCount = 2;
+        while (groupCount * GROUP_SIZE < size * 2) {
+            groupCount *= 2;
+        }
+        allocateTable(groupCount);
+    }
+
+    /**
+     * Adds an entry to the table, if there is no entry with the same name.
+     *
+     * @param value The entry to be added.
+     * @return True if the entry has been added.
+     */
+    bool addUnique(const TYPE & value) {
+        const unsigned long long int key = KEY_FUNCTION::getHash(value);
+        if (unlikely(key == 0)) {
+            if (m_hasZeroKey) {
+                return false;
+            }
+            m_hasZeroKey = true;
+            m_zeroKeyValue = value;
+            m_count++;
+            return true;
+        }
+        if (get(value) != 0) {
+            return false;
+        }
+        if (unlikely((m_count + 1) * 2 > m_groupCount * GROUP_SIZE)) {
+            grow();
+        }
+        insert(key, value);
+        m_count++;
+        return true;
+    }
+
+    /**
+     * Gets an entry from the table by its name.
+     *
+     * @param value The entry with the name to be searched for.
+     * @return Pointer to the entry with the same name. Returns 0 if there is no entry such that.
+     */
+    const TYPE * get(const TYPE & value) const {
+        const unsigned long long int key = KEY_FUNCTION::getHash(value);
+        if (unlikely(key == 0)) {
+            return m_hasZeroKey ? &m_zeroKeyValue : 0;
+        }
+        if (unlikely(m_groupCount == 0)) {
+            return 0;
+        }
+        unsigned int group = getGroup(key);
+        while (true) {
+            const Group & current = m_groups[group];
+            unsigned int emptyMask;
+            const unsigned int matchMask = compareGroup(current.m_keys, key, &emptyMask);
+            if (likely(matchMask != 0)) {
+                return current.m_values + firstBit(matchMask);
+            }
+            if (emptyMask != 0) {
+                return 0;
+            }
+            group = (group + 1) & (m_groupCount - 1);
+        }
+    }
+
+    /**
+     * Returns the number of entries in the table.
+     *
+     * @return The number of entries in the table.
+     */
+    unsigned int getCount() const {
+        return m_count;
+    }
+
+private:
+
+    /**
+     * Number of keys compared at once.
+     */
+    static const unsigned int GROUP_SIZE = 4;
+
+    /**
+     * A group of slots, the names of the entries are followed by the entries.
+     * The all zero name denotes an empty slot.
+     */
+    struct Group {
+        unsigned long long int m_keys[GROUP_SIZE];
+        TYPE m_values[GROUP_SIZE];
+    };
+
+    /**
+     * The groups of the table, aligned to cache lines.
+     */
+    Group * m_groups;
+
+    /**
+     * The number of key groups, it is a power of 2.
+     */
+    unsigned int m_groupCount;
+
+    /**
+     * The group index is given by the highest bits of the hashed key.
+     */
+    unsigned int m_shift;
+
+    /**
+     * The number of entries in the table.
+     */
+    unsigned int m_count;
+
+    /**
+     * The all zero name marks the empty slots, so its entry is stored separately.
+     */
+    bool m_hasZeroKey;
+
+    TYPE m_zeroKeyValue;
+
+    unsigned int getGroup(unsigned long long int key) const {
+        // Fibonacci hashing, it mixes the characters of the name into the highest bits
+        return (key * 0x9E3779B97F4A7C15ULL) >> m_shift;
+    }
+
+    static unsigned int firstBit(unsigned int mask) {
+        return __builtin_ctz(mask);
+    }
+
+    /**
+     * Compares the keys of a group with the given key.
+     *
+     * @param keys The first key of the group.
+     * @param key The searched key.
+     * @param emptyMask Bit i is set if the i-th slot of the group is empty.
+     * @return Bit i is set if the i-th key of the group equals to key.
+     */
+    static unsigned int compareGroup(const unsigned long long int * keys,
+                                     unsigned long long int key,
+                                     unsigned int * emptyMask) {
+#ifdef __SSE2__
+        const __m128i pattern = _mm_set1_epi64x(key);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i keys0 = _mm_load_si128(reinterpret_cast<const __m128i*>(keys));
+        const __m128i keys1 = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + 2));
+        *emptyMask = equalMask(keys0, zero) | (equalMask(keys1, zero) << 2);
+        return equalMask(keys0, pattern) | (equalMask(keys1, pattern) << 2);
+#else
+        unsigned int matchMask = 0;
+        *emptyMask = 0;
+        unsigned int index;
+        for (index = 0; index < GROUP_SIZE; index++) {
+            matchMask |= (keys[index] == key) << index;
+            *emptyMask |= (keys[index] == 0) << index;
+        }
+        return matchMask;
+#endif
+    }
+
+#ifdef __SSE2__
+    /**
+     * Returns a 2 bit mask of the equal 64 bit lanes; SSE2 compares only 32 bit lanes,
+     * so the results of the halves are combined.
+     */
+    static unsigned int equalMask(__m128i left, __m128i right) {
+        const __m128i equal32 = _mm_cmpeq_epi32(left, right);
+        const __m128i equal64 = _mm_and_si128(equal32, _mm_shuffle_epi32(equal32, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_movemask_pd(_mm_castsi128_pd(equal64));
+    }
+#endif
+
+    void insert(unsigned long long int key, const TYPE & value) {
+        unsigned int group = getGroup(key);
+        while (true) {
+            Group & current = m_groups[group];
+            unsigned int emptyMask;
+            compareGroup(current.m_keys, key, &emptyMask);
+            if (emptyMask != 0) {
+                const unsigned int index = firstBit(emptyMask);
+                current.m_keys[index] = key;
+                current.m_values[index] = value;
+                return;
+            }
+            group = (group + 1) & (m_groupCount - 1);
+        }
+    }
+
+    void allocateTable(unsigned int groupCount) {
+        freeTable();
+        m_groupCount = groupCount;
+        m_shift = 64 - logarithm2(groupCount);
+        m_groups = alloc<Group, 64>(groupCount);
+        unsigned int index;
+        for (index = 0; index < groupCount; index++) {
+            new (m_groups + index) Group;
+            panOptMemset(m_groups[index].m_keys, 0, sizeof(m_groups[index].m_keys));
+        }
+        m_count = 0;
+        m_hasZeroKey = false;
+    }
+
+    void grow() {
+        Group * oldGroups = m_groups;
+        const unsigned int oldGroupCount = m_groupCount;
+        const unsigned int count = m_count;
+        const bool hasZeroKey = m_hasZeroKey;
+        m_groups = 0;
+        m_groupCount = 0;
+        allocateTable(oldGroupCount == 0 ? 2 : oldGroupCount * 2);
+        unsigned int group;
+        for (group = 0; group < oldGroupCount; group++) {
+            unsigned int index;
+            for (index = 0; index < GROUP_SIZE; index++) {
+                if (oldGroups[group].m_keys[index] != 0) {
+                    insert(oldGroups[group].m_keys[index], oldGroups[group].m_values[index]);
+                }
+            }
+        }
+        m_count = count;
+        m_hasZeroKey = hasZeroKey;
+        releaseGroups(oldGroups, oldGroupCount);
+    }
+
+    static void releaseGroups(Group * groups, unsigned int groupCount) {
+        if (groups == 0) {
+            return;
+        }
+        unsigned int index;
+        for (index = 0; index < groupCount; index++) {
+            groups[index].~Group();
+        }
+        release(groups);
+    }
+
+    void freeTable() {
+        releaseGroups(m_groups, m_groupCount);
+        m_groups = 0;
+        m_groupCount = 0;
+        m_count = 0;
+        m_hasZeroKey = false;
+    }
+};
+
+#endif // NAMETABLE_H
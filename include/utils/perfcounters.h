@@ -0,0 +1,183 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file perfcounters.h This file contains the API of the PerfCounters and PerfCounterPhase classes.
+ */
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <globals.h>
+
+/**
+ * This class reads the hardware performance counters of the calling thread.
+ *
+ * On Linux the counters are opened with perf_event_open() as one group per thread,
+ * when the thread reads them first. If the kernel does not allow the counters
+ * (for example because of perf_event_paranoid or a container), or on other platforms,
+ * the counters are reported as unavailable, and the solver runs without them.
+ *
+ * @class PerfCounters
+ */
+class PerfCounters {
+public:
+
+    /**
+     * The measured events.
+     */
+    enum COUNTER {
+        INSTRUCTIONS,
+        CYCLES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        COUNTER_COUNT
+    };
+
+    /**
+     * A snapshot of the counters.
+     */
+    struct Values {
+        unsigned long long int m_counts[COUNTER_COUNT];
+    };
+
+    /**
+     * Returns true if the counters can be read on the calling thread.
+     * The first call on a thread opens the counters.
+     *
+     * @return True if the counters are available.
+     */
+    static bool isAvailable();
+
+    /**
+     * Returns true if the given counter is supported on the calling thread.
+     *
+     * @param counter The counter to check.
+     * @return True if the counter is counted.
+     */
+    static bool isSupported(COUNTER counter);
+
+    /**
+     * Reads the current values of the counters of the calling thread.
+     * The unsupported counters are zero.
+     *
+     * @param values The values to be filled.
+     * @return False if the counters are not available.
+     */
+    static bool read(Values * values);
+
+    /**
+     * Returns the size of a cache line in bytes.
+     *
+     * @return The cache line size.
+     */
+    static unsigned int getCacheLineSize();
+};
+
+/**
+ * Accumulates the counters between the start() and stop() calls of a phase,
+ * like a Timer.
+ *
+ * @class PerfCounterPhase
+ */
+class PerfCounterPhase {
+public:
+
+    /**
+     * Constructor of the PerfCounterPhase class, the phase is disabled by default.
+     *
+     * @constructor
+     */
+    PerfCounterPhase();
+
+    /**
+     * Enables or disables the measurement; a disabled phase does nothing in start() and stop().
+     *
+     * @param enabled True to measure the phase.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Returns true if the phase is measured.
+     *
+     * @return True if enabled.
+     */
+    bool isEnabled() const {
+        return m_enabled;
+    }
+
+    /**
+     * Starts a measurement.
+     */
+    ALWAYS_INLINE void start() {
+        if (unlikely(m_enabled)) {
+            m_running = PerfCounters::read(&m_start);
+        }
+    }
+
+    /**
+     * Stops the measurement, and adds the counted events to the totals.
+     */
+    ALWAYS_INLINE void stop() {
+        if (unlikely(m_enabled)) {
+            accumulate();
+        }
+    }
+
+    /**
+     * Clears the totals.
+     */
+    void reset();
+
+    /**
+     * Returns the total count of an event in the phase.
+     *
+     * @param counter The event.
+     * @return The total count.
+     */
+    unsigned long long int getCount(PerfCounters::COUNTER counter) const {
+        return m_total.m_counts[counter];
+    }
+
+    /**
+     * Returns the instructions per cycle in the phase.
+     *
+     * @return The IPC, or 0 if no cycles are counted.
+     */
+    double getInstructionsPerCycle() const;
+
+    /**
+     * Estimates the bytes moved between the memory and the last level cache,
+     * as the number of LLC misses multiplied by the cache line size.
+     *
+     * @return The estimated bytes moved.
+     */
+    double getBytesMoved() const;
+
+private:
+
+    bool m_enabled;
+
+    bool m_running;
+
+    PerfCounters::Values m_start;
+
+    PerfCounters::Values m_total;
+
+    void accumulate();
+};
+
+#endif // PERFCOUNTERS_H
@@ -0,0 +1,109 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file processpool.h This file contains the API of the ProcessPool class.
+ */
+
+#ifndef PROCESSPOOL_H
+#define PROCESSPOOL_H
+
+#include <globals.h>
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * This class runs independent tasks in forked worker processes.
+ *
+ * The parameter handlers and the other singletons of the library are process wide,
+ * so tasks with different parameters cannot run on threads of one process. A worker
+ * process gets a copy of the parent, including the models already loaded into it,
+ * and its parameters can be changed freely.
+ *
+ * The log (standard output and error) of a task goes to a temporary file, and the task
+ * can write its result into another temporary file. The tasks are reported in the
+ * order of their indices, regardless of the order they finish.
+ *
+ * On platforms without fork() the tasks run one after the other in the calling process.
+ *
+ * @class ProcessPool
+ */
+class ProcessPool {
+public:
+
+    /**
+     * The final state of a task.
+     */
+    enum TASK_RESULT {
+        SUCCEEDED,
+        FAILED,
+        TIMED_OUT
+    };
+
+    /**
+     * Runs a task in the worker process.
+     * The parameters are the index of the task and the name of its result file.
+     * Returns true if the task succeeded.
+     */
+    typedef std::function<bool(unsigned int, const std::string &)> Task;
+
+    /**
+     * Called in the parent process for each finished task, in the order of the indices.
+     * The parameters are the index of the task, its result, and the names of its log
+     * and result files. The files are removed after the call.
+     */
+    typedef std::function<void(unsigned int, TASK_RESULT, const std::string &, const std::string &)> Report;
+
+    /**
+     * Constructor of the ProcessPool class.
+     *
+     * @constructor
+     * @param processCount The maximal number of worker processes running at once.
+     * @param timeout The wall-clock time limit of a task in seconds, 0 means no limit.
+     */
+    ProcessPool(unsigned int processCount, unsigned int timeout);
+
+    /**
+     * Runs the tasks and reports them.
+     *
+     * @param count The number of tasks.
+     * @param priorities The tasks with larger priorities are started first;
+     * if empty, the tasks are started in the order of their indices.
+     * @param task Runs a task in the worker process.
+     * @param report Reports a finished task in the parent process.
+     */
+    void run(unsigned int count, const std::vector<unsigned long long int> & priorities,
+             const Task & task, const Report & report);
+
+    /**
+     * Appends the contents of a file to a stream.
+     *
+     * @param fileName The name of the file to be copied.
+     * @param target The stream to be appended.
+     */
+    static void copyFile(const std::string & fileName, std::ostream & target);
+
+private:
+
+    unsigned int m_processCount;
+
+    unsigned int m_timeout;
+};
+
+#endif // PROCESSPOOL_H
@@ -0,0 +1,206 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file profiler.h This file contains the API of the Profiler and ProfilerZone classes.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <globals.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef PLATFORM_X86
+#include <x86intrin.h>
+#endif
+
+/**
+ * Define this to compile the PROFILE_ZONE markers into the code.
+ * Without it the markers expand to nothing.
+ */
+//#define PROFILER
+
+#define PROFILER_CONCAT(a, b) CONCAT(a, b)
+
+#ifdef PROFILER
+/**
+ * Measures the rest of the enclosing scope as a zone of the profiler.
+ * The zones are nested: a zone opened inside another one is reported as its child.
+ * The name is registered only once, at the first execution of the marker.
+ */
+#define PROFILE_ZONE(NAME) \
+    static const unsigned int PROFILER_CONCAT(__profilerZoneId, __LINE__) = Profiler::getInstance().registerZone(NAME); \
+    ProfilerZone PROFILER_CONCAT(__profilerZone, __LINE__)(PROFILER_CONCAT(__profilerZoneId, __LINE__));
+#else
+#define PROFILE_ZONE(NAME)
+#endif
+
+/**
+ * This class collects the time spent in the zones marked by PROFILE_ZONE.
+ *
+ * Each thread accumulates its own call tree without locking. The tree of a thread is
+ * merged into the common tree when the thread exits, or when the report is written
+ * by the thread.
+ *
+ * @class Profiler
+ */
+class Profiler {
+public:
+
+    /**
+     * Returns the instance of the singleton Profiler class.
+     *
+     * @return The instance of the Profiler.
+     */
+    static Profiler & getInstance();
+
+    /**
+     * Returns a time stamp in ticks, the time stamp counter of the CPU if available.
+     *
+     * @return The current time stamp.
+     */
+    ALWAYS_INLINE static unsigned long long int getTicks() {
+#ifdef PLATFORM_X86
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    /**
+     * Registers the name of a zone.
+     *
+     * @param name The name of the zone.
+     * @return The identifier of the zone.
+     */
+    unsigned int registerZone(const char * name);
+
+    /**
+     * Enters a zone on the current thread.
+     *
+     * @param zone The identifier of the zone.
+     */
+    static void enter(unsigned int zone);
+
+    /**
+     * Leaves the innermost zone of the current thread.
+     *
+     * @param ticks The ticks spent in the zone.
+     */
+    static void leave(unsigned long long int ticks);
+
+    /**
+     * Writes the merged call tree with LPINFO, and clears the collected data.
+     * The data of the threads still running (except the calling one) is not included.
+     */
+    void writeReport();
+
+    /**
+     * The per-thread call tree, merged into the Profiler when the thread exits.
+     */
+    struct ThreadData;
+
+private:
+
+    /**
+     * A node of a call tree.
+     */
+    struct Node {
+        unsigned int m_zone;
+        unsigned int m_parent;
+        unsigned int m_firstChild;
+        unsigned int m_nextSibling;
+        unsigned long long int m_calls;
+        unsigned long long int m_ticks;
+    };
+
+    /**
+     * The names of the registered zones.
+     */
+    std::vector<std::string> m_zoneNames;
+
+    /**
+     * The merged call tree, the first node is the root.
+     */
+    std::vector<Node> m_nodes;
+
+    /**
+     * The ticks and the wall-clock time at the last clear, used to convert ticks to seconds.
+     */
+    unsigned long long int m_startTicks;
+
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /**
+     * Protects the zone names and the merged call tree.
+     */
+    std::mutex m_mutex;
+
+    Profiler();
+
+    Profiler(const Profiler &) = delete;
+
+    Profiler & operator=(const Profiler &) = delete;
+
+    /**
+     * Returns the child of a node with the given zone, it is created if necessary.
+     */
+    static unsigned int getChild(std::vector<Node> * nodes, unsigned int parent, unsigned int zone);
+
+    /**
+     * Adds the call tree of a thread to the merged call tree, and clears it.
+     */
+    void merge(ThreadData * data);
+
+    /**
+     * Writes a subtree of the merged call tree.
+     */
+    void writeNode(unsigned int node, unsigned int depth, double secondsPerTick) const;
+};
+
+/**
+ * Measures the time between its construction and destruction as a profiler zone.
+ * Use it through the PROFILE_ZONE macro.
+ *
+ * @class ProfilerZone
+ */
+class ProfilerZone {
+public:
+
+    ALWAYS_INLINE explicit ProfilerZone(unsigned int zone) {
+        Profiler::enter(zone);
+        m_start = Profiler::getTicks();
+    }
+
+    ALWAYS_INLINE ~ProfilerZone() {
+        Profiler::leave(Profiler::getTicks() - m_start);
+    }
+
+private:
+
+    unsigned long long int m_start;
+
+    ProfilerZone(const ProfilerZone &) = delete;
+
+    ProfilerZone & operator=(const ProfilerZone &) = delete;
+};
+
+#endif // PROFILER_H
@@ -24,8 +24,10 @@
 
 #include <globals.h>
 #include <set>
+#include <vector>
 #include <thread>
 #include <mutex>
+#include <functional>
 
 /**
  * This class manages the identifiers of the running threads.
@@ -55,6 +57,38 @@ public:
      */
     static void unregisterMyThread();
 
+    /**
+     * Splits the range [0, count) into at most threadCount contiguous chunks of nearly
+     * equal size, and calls the function for each chunk on separate threads.
+     * The splitting depends only on count and threadCount, so two calls with the same
+     * arguments process the same chunks.
+     *
+     * @param threadCount The maximal number of threads, the calling thread included.
+     * @param count The number of elements of the range.
+     * @param function It is called with the begin and end of the chunk, and the index of the chunk.
+     * @return The number of chunks.
+     */
+    static unsigned int parallelFor(unsigned int threadCount, unsigned int count,
+                                    const std::function<void(unsigned int, unsigned int, unsigned int)> & function);
+
+    /**
+     * Returns the number of the NUMA nodes of the system.
+     * It is 1 if the system has no NUMA topology information.
+     *
+     * @return The number of the NUMA nodes.
+     */
+    static unsigned int getNumaNodeCount();
+
+    /**
+     * Restricts the current thread to the processors of a NUMA node.
+     * The operating system places the memory pages on the node of the thread which touches
+     * them first, so the data allocated and initialized by the bound thread becomes local.
+     *
+     * @param node The index of the node, it is taken modulo getNumaNodeCount().
+     * @return True if the thread has been bound.
+     */
+    static bool bindMyThreadToNumaNode(unsigned int node);
+
 private:
 
     /**
@@ -72,6 +106,11 @@ private:
      */
     static thread_local unsigned int sm_myThreadId;
 
+    /**
+     * The processors of the NUMA nodes, empty if the topology is unknown.
+     */
+    static std::vector<std::vector<unsigned int> > * sm_numaNodes;
+
     /**
      * Initializes the necessary data structures.
      */
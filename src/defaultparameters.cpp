@@ -23,16 +23,24 @@
 //Linalg Parameters
 const double DefaultParameters::E_ABSOLUTE = 1.0E-14;
 const double DefaultParameters::E_RELATIVE = 1.0E-10;
-const double DefaultParameters::SPARSITY_RATIO = 0.45;
+const double DefaultParameters::SPARSITY_RATIO = 0.0;
+const double DefaultParameters::UNCALIBRATED_SPARSITY_RATIO = 0.45;
 const int DefaultParameters::ELBOWROOM = 5;
+const char * DefaultParameters::FTRAN_ADD_MODE = "ADD_ABS";
+const char * DefaultParameters::BTRAN_ADD_MODE = "ADD_ABS_REL";
+const bool DefaultParameters::ETA_STATISTICS = false;
+const int DefaultParameters::HUGE_PAGE_THRESHOLD = 4 * 1024 * 1024;
 
 //Simplex Parameters
 //NumericalStability
 const bool DefaultParameters::NumericalInstability::ENABLE_NUMERICAL_INSTABILITY_DETECTION = false;
+const int DefaultParameters::NumericalInstability::REFINEMENT_PASSES = 2;
+const double DefaultParameters::NumericalInstability::E_REFINEMENT = 1.0E-09;
 //Parallel
 const bool DefaultParameters::Parallel::ENABLE_PARALLELIZATION = false;
 const bool DefaultParameters::Parallel::ENABLE_THREAD_SYNCHRONIZATION = true;
 const int DefaultParameters::Parallel::NUMBER_OF_THREADS = 2;
+const bool DefaultParameters::Parallel::ENABLE_NUMA_BINDING = true;
 //Tolerances
 const double DefaultParameters::Tolerances::E_PIVOT = 1.0E-06;
 const double DefaultParameters::Tolerances::E_FEASIBILITY = 1.0E-08;
@@ -41,6 +49,9 @@ const double DefaultParameters::Tolerances::E_OPTIMALITY = 1.0E-08;
 const bool DefaultParameters::Starting::Presolve::ENABLE = false;
 const bool DefaultParameters::Starting::Scaling::ENABLE = false;
 const char * DefaultParameters::Starting::Scaling::TYPE = "BENICHOU";
+const int DefaultParameters::Starting::Scaling::MAX_ITERATIONS = 5;
+const double DefaultParameters::Starting::Scaling::CONVERGENCE_TOLERANCE = 1.0E-02;
+const int DefaultParameters::Starting::Scaling::NUMBER_OF_THREADS = 0;
 const char * DefaultParameters::Starting::Basis::STARTING_NONBASIC_STATES = "NONBASIC_TO_LOWER";
 const char * DefaultParameters::Starting::Basis::STARTING_BASIS_STRATEGY = "LOGICAL";
 //Basis factorization
@@ -104,5 +115,12 @@ const bool DefaultParameters::Global::Export::ENABLE = false;
 const char * DefaultParameters::Global::Export::FILENAME = "exported_result.txt";
 const char * DefaultParameters::Global::Export::TYPE = "REVISION_CHECK";
 
+const bool DefaultParameters::Global::Trace::ENABLE = false;
+const int DefaultParameters::Global::Trace::CAPACITY = 100000;
+const char * DefaultParameters::Global::Trace::FILENAME = "iteration_trace.csv";
+const char * DefaultParameters::Global::Trace::FORMAT = "CSV";
+
 const bool DefaultParameters::Global::BATCH_OUTPUT = false;
 const int DefaultParameters::Global::BATCH_SIZE = 10;
+const bool DefaultParameters::Global::PERFORMANCE_COUNTERS = false;
+const bool DefaultParameters::Global::SIMPLEX_ENGINE = true;
@@ -55,19 +55,6 @@ InitPanOpt &InitPanOpt::getInstance() {
 }
 
 void InitPanOpt::init() {
-#ifndef CLASSIC_NEW_DELETE
-    MemoryManager::sm_smallStacks = 0;
-
-    MemoryManager::sm_largeStacks = 0;
-
-    Pool::sm_head = 0;
-
-    MemoryManager::sm_initialized = false;
-
-
-    MemoryManager::init();
-#endif
-
     SET_FPU_TO_64();
 
     D::init();
@@ -76,12 +63,11 @@ void InitPanOpt::init() {
     ThreadSupervisor::_globalInit();
     SimplexParameterHandler::_globalInit();
     LinalgParameterHandler::_globalInit();
+    MemoryManager::setHugePageThreshold(
+                LinalgParameterHandler::getInstance().getIntegerParameterValue("huge_page_threshold"));
     Numerical::_globalInit();
-    IndexedDenseVector::_globalInit();
-    DenseVector::_globalInit();
-    SparseVector::_globalInit();
-    GeneralMessageHandler::_globalInit();
 
+    // the vectors use the calibrated thresholds of the architecture parameter file
 #ifdef PLATFORM_X86
     sm_architecture = new ArchitectureX86;
 #else
@@ -89,6 +75,20 @@ void InitPanOpt::init() {
 #endif
     sm_architecture->loadParameters();
     sm_architecture->detect();
+
+    IndexedDenseVector::_globalInit();
+    DenseVector::_globalInit();
+    SparseVector::_globalInit();
+    GeneralMessageHandler::_globalInit();
+}
+
+void InitPanOpt::applyLinalgParameters() {
+    MemoryManager::setHugePageThreshold(
+                LinalgParameterHandler::getInstance().getIntegerParameterValue("huge_page_threshold"));
+    Numerical::_globalInit();
+    DenseVector::_globalInit();
+    SparseVector::_globalRelease();
+    SparseVector::_globalInit();
 }
 
 void InitPanOpt::threadInit() {
@@ -118,9 +118,7 @@ void InitPanOpt::release()
     delete sm_architecture;
     sm_architecture = nullptr;
 
-#ifndef CLASSIC_NEW_DELETE
-    MemoryManager::release();
-#endif
+    MemoryManager::releaseThreadCache();
 }
 
 void InitPanOpt::threadRelease() {
@@ -129,12 +127,17 @@ void InitPanOpt::threadRelease() {
 
     SparseVector::_globalRelease();
 
+    MemoryManager::releaseThreadCache();
 }
 
 const ArchitectureInterface & InitPanOpt::getArchitecture() const {
     return *sm_architecture;
 }
 
+ArchitectureInterface & InitPanOpt::getArchitecture() {
+    return *sm_architecture;
+}
+
 __attribute__((constructor))
 void initPanOpt() {
     //initSignalHandler();
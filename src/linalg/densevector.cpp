@@ -17,8 +17,11 @@
 #include <linalg/densevector.h>
 #include <linalg/indexeddensevector.h>
 #include <linalg/sparsevector.h>
+#include <linalg/linalgparameterhandler.h>
 #include <utils/architecture.h>
 #include <utils/exceptions.h>
+#include <defaultparameters.h>
+#include <algorithm>
 
 DenseVector::AddDenseToDense DenseVector::sm_addDenseToDense;
 DenseVector::AddIndexedDenseToDense DenseVector::sm_addIndexedDenseToDense;
@@ -26,11 +29,14 @@ DenseVector::AddSparseToDense DenseVector::sm_addSparseToDense;
 DenseVector::DenseToDenseDotProduct DenseVector::sm_denseToDenseDotProduct;
 DenseVector::DenseToIndexedDenseDotProduct DenseVector::sm_denseToIndexedDenseDotProduct;
 DenseVector::DenseToSparseDotProduct DenseVector::sm_denseToSparseDotProduct;
+DenseVector::AddDenseToDense DenseVector::sm_addTrackedDenseToDense;
+Numerical::Double DenseVector::sm_sparsityRatio;
 
 DenseVector::DenseVector(unsigned int length)
 {
     m_length = length;
     m_data = nullptr;
+    initNonzeroTracking();
 
     if (m_length > 0) {
         m_data = Numerical::allocDouble(m_length);
@@ -40,11 +46,13 @@ DenseVector::DenseVector(unsigned int length)
 
 DenseVector::DenseVector(const DenseVector &orig)
 {
+    initNonzeroTracking();
     copy(orig);
 }
 
 DenseVector::DenseVector(DenseVector &&orig)
 {
+    initNonzeroTracking();
     move(orig);
 }
 
@@ -53,6 +61,7 @@ DenseVector &DenseVector::operator=(const DenseVector &orig)
     if (this == &orig) {
         return *this;
     }
+    dropNonzeroIndices();
     if(m_length == orig.length()) {
         COPY_DOUBLES(m_data, orig.m_data, m_length);
     } else {
@@ -67,8 +76,7 @@ DenseVector &DenseVector::operator=(const SparseVector &orig)
     this->reInit(orig.length());
     unsigned int nonZeroIndex;
     for (nonZeroIndex = 0; nonZeroIndex < orig.m_nonZeros; nonZeroIndex++) {
-        const unsigned int index = orig.m_indices[nonZeroIndex];
-        m_data[index] = orig.m_data[nonZeroIndex];
+        set(orig.m_indices[nonZeroIndex], orig.m_data[nonZeroIndex]);
     }
     return *this;
 }
@@ -86,6 +94,7 @@ DenseVector &DenseVector::operator=(DenseVector &&orig)
 DenseVector::~DenseVector()
 {
     release();
+    setNonzeroTracking(false);
 }
 
 Numerical::Double DenseVector::euclidNorm() const
@@ -121,6 +130,7 @@ Numerical::Double DenseVector::l1Norm() const
 DenseVector &DenseVector::addVector(Numerical::Double lambda,
                                     const SparseVector &vector)
 {
+    dropNonzeroIndices();
     (this->*sm_addSparseToDense)(lambda, vector);
     return *this;
 }
@@ -128,13 +138,19 @@ DenseVector &DenseVector::addVector(Numerical::Double lambda,
 DenseVector &DenseVector::addVector(Numerical::Double lambda,
                                     const DenseVector &vector)
 {
-    (this->*sm_addDenseToDense)(lambda, vector);
+    if (vector.m_sparse) {
+        (this->*sm_addTrackedDenseToDense)(lambda, vector);
+    } else {
+        dropNonzeroIndices();
+        (this->*sm_addDenseToDense)(lambda, vector);
+    }
     return *this;
 }
 
 DenseVector &DenseVector::addVector(Numerical::Double lambda,
                                     const IndexedDenseVector &vector)
 {
+    dropNonzeroIndices();
     (this->*sm_addIndexedDenseToDense)(lambda, vector);
     return *this;
 }
@@ -157,6 +173,13 @@ Numerical::Double DenseVector::dotProduct(const SparseVector &vector) const
 void DenseVector::scale(Numerical::Double lambda)
 {
     unsigned int index;
+    if (m_sparse) {
+        // the zeros remain zeros, so the index list is still valid
+        for (index = 0; index < m_nonzeroIndexCount; index++) {
+            m_data[ m_nonzeroIndices[index] ] *= lambda;
+        }
+        return;
+    }
     for (index = 0; index < m_length; index++) {
         m_data[index] *= lambda;
     }
@@ -164,7 +187,11 @@ void DenseVector::scale(Numerical::Double lambda)
 
 void DenseVector::clear()
 {
-    CLEAR_DOUBLES(m_data, m_length);
+    if (m_nonzeroIndices != nullptr) {
+        clearTracked();
+    } else {
+        CLEAR_DOUBLES(m_data, m_length);
+    }
 }
 
 void DenseVector::setAddMode(Numerical::ADD_TYPE type)
@@ -174,16 +201,19 @@ void DenseVector::setAddMode(Numerical::ADD_TYPE type)
         sm_addDenseToDense = &DenseVector::addDenseToDenseFast;
         sm_addIndexedDenseToDense = &DenseVector::addIndexedDenseToDenseFast;
         sm_addSparseToDense = &DenseVector::addSparseToDenseFast;
+        sm_addTrackedDenseToDense = &DenseVector::addTrackedDenseToDenseFast;
         break;
     case Numerical::ADD_ABS:
         sm_addDenseToDense = &DenseVector::addDenseToDenseAbs;
         sm_addIndexedDenseToDense = &DenseVector::addIndexedDenseToDenseAbs;
         sm_addSparseToDense = &DenseVector::addSparseToDenseAbs;
+        sm_addTrackedDenseToDense = &DenseVector::addTrackedDenseToDenseAbs;
         break;
     case Numerical::ADD_ABS_REL:
         sm_addDenseToDense = &DenseVector::addDenseToDenseAbsRel;
         sm_addIndexedDenseToDense = &DenseVector::addIndexedDenseToDenseAbsRel;
         sm_addSparseToDense = &DenseVector::addSparseToDenseAbsRel;
+        sm_addTrackedDenseToDense = &DenseVector::addTrackedDenseToDenseAbsRel;
         break;
     }
 }
@@ -218,6 +248,14 @@ unsigned int DenseVector::nonZeros() const
 {
     unsigned int index;
     unsigned int count = 0;
+    if (m_sparse) {
+        for (index = 0; index < m_nonzeroIndexCount; index++) {
+            if (m_data[ m_nonzeroIndices[index] ] != 0.0) {
+                count++;
+            }
+        }
+        return count;
+    }
     for (index = 0; index < m_length; index++) {
         if (m_data[index] != 0.0) {
             count++;
@@ -233,6 +271,7 @@ void DenseVector::remove(unsigned int index)
         throw InvalidIndexException("Invalid index in DenseVector", 0, m_length, index);
     }
 #endif
+    dropNonzeroIndices();
     for (; index < m_length - 1; index++) {
         m_data[index] = m_data[index + 1];
     }
@@ -241,6 +280,7 @@ void DenseVector::remove(unsigned int index)
 
 void DenseVector::insert(unsigned int index, Numerical::Double value)
 {
+    dropNonzeroIndices();
     Numerical::Double * newData = Numerical::allocDouble(m_length + 1);
     COPY_DOUBLES(newData, m_data, index);
     newData[index] = value;
@@ -252,6 +292,7 @@ void DenseVector::insert(unsigned int index, Numerical::Double value)
 
 void DenseVector::append(Numerical::Double value)
 {
+    dropNonzeroIndices();
     Numerical::Double * newData = Numerical::allocDouble(m_length + 1);
     COPY_DOUBLES(newData, m_data, m_length);
     newData[m_length] = value;
@@ -270,6 +311,7 @@ void DenseVector::reserve()
 
 void DenseVector::resize(unsigned int length)
 {
+    dropNonzeroIndices();
     if (length <= m_length) {
         m_length = length;
         return;
@@ -283,6 +325,7 @@ void DenseVector::resize(unsigned int length)
 }
 
 void DenseVector::resize(unsigned int length, Numerical::Double value) {
+    dropNonzeroIndices();
     if (length <= m_length) {
         m_length = length;
         return;
@@ -299,6 +342,17 @@ void DenseVector::resize(unsigned int length, Numerical::Double value) {
 
 void DenseVector::reInit(unsigned int length)
 {
+    if (m_nonzeroIndices != nullptr) {
+        if (length > m_length) {
+            Numerical::freeDouble(m_data);
+            m_data = Numerical::allocDouble(length);
+            // the new array is not cleared yet
+            dropNonzeroIndices();
+        }
+        m_length = length;
+        clearTracked();
+        return;
+    }
     if(length <= m_length) {
         CLEAR_DOUBLES(m_data, length)
     } else {
@@ -310,6 +364,80 @@ void DenseVector::reInit(unsigned int length)
     return;
 }
 
+void DenseVector::setNonzeroTracking(bool enabled)
+{
+    if (enabled == (m_nonzeroIndices != nullptr)) {
+        return;
+    }
+    if (!enabled) {
+        ::release(m_nonzeroIndices);
+        ::release(m_nonzeroMarks);
+        initNonzeroTracking();
+        return;
+    }
+    m_nonzeroIndexCapacity = m_length;
+    m_nonzeroIndices = alloc<unsigned int, 16>(m_nonzeroIndexCapacity);
+    m_nonzeroMarks = alloc<bool, 16>(m_nonzeroIndexCapacity);
+    panOptMemset(m_nonzeroMarks, 0, m_nonzeroIndexCapacity * sizeof(bool));
+    m_nonzeroIndexCount = 0;
+    m_nonzeroIndicesSorted = true;
+    m_sparsityLimit = m_length * sm_sparsityRatio;
+    m_sparse = true;
+    unsigned int index;
+    for (index = 0; index < m_length && m_sparse; index++) {
+        if (m_data[index] != 0.0) {
+            addNonzeroIndex(index);
+        }
+    }
+}
+
+const unsigned int * DenseVector::getNonzeroIndices() const
+{
+    if (!m_nonzeroIndicesSorted) {
+        std::sort(m_nonzeroIndices, m_nonzeroIndices + m_nonzeroIndexCount);
+        m_nonzeroIndicesSorted = true;
+    }
+    return m_nonzeroIndices;
+}
+
+void DenseVector::clearTracked()
+{
+    unsigned int index;
+    if (m_sparse) {
+        for (index = 0; index < m_nonzeroIndexCount; index++) {
+            const unsigned int nonzeroIndex = m_nonzeroIndices[index];
+            m_data[nonzeroIndex] = 0.0;
+            m_nonzeroMarks[nonzeroIndex] = false;
+        }
+    } else {
+        CLEAR_DOUBLES(m_data, m_length);
+        panOptMemset(m_nonzeroMarks, 0, m_nonzeroIndexCapacity * sizeof(bool));
+    }
+    if (m_nonzeroIndexCapacity < m_length) {
+        ::release(m_nonzeroIndices);
+        ::release(m_nonzeroMarks);
+        m_nonzeroIndexCapacity = m_length;
+        m_nonzeroIndices = alloc<unsigned int, 16>(m_nonzeroIndexCapacity);
+        m_nonzeroMarks = alloc<bool, 16>(m_nonzeroIndexCapacity);
+        panOptMemset(m_nonzeroMarks, 0, m_nonzeroIndexCapacity * sizeof(bool));
+    }
+    m_nonzeroIndexCount = 0;
+    m_nonzeroIndicesSorted = true;
+    m_sparsityLimit = m_length * sm_sparsityRatio;
+    m_sparse = true;
+}
+
+void DenseVector::initNonzeroTracking()
+{
+    m_nonzeroIndices = nullptr;
+    m_nonzeroMarks = nullptr;
+    m_nonzeroIndexCount = 0;
+    m_nonzeroIndexCapacity = 0;
+    m_sparsityLimit = 0;
+    m_sparse = false;
+    m_nonzeroIndicesSorted = true;
+}
+
 std::ostream & operator<<(std::ostream & os, const DenseVector & vector)
 {
 #ifndef NDEBUG
@@ -376,6 +504,16 @@ void DenseVector::move(DenseVector &orig)
     orig.m_length = 0;
     m_data = orig.m_data;
     orig.m_data = 0;
+
+    setNonzeroTracking(false);
+    m_nonzeroIndices = orig.m_nonzeroIndices;
+    m_nonzeroMarks = orig.m_nonzeroMarks;
+    m_nonzeroIndexCount = orig.m_nonzeroIndexCount;
+    m_nonzeroIndexCapacity = orig.m_nonzeroIndexCapacity;
+    m_sparsityLimit = orig.m_sparsityLimit;
+    m_sparse = orig.m_sparse;
+    m_nonzeroIndicesSorted = orig.m_nonzeroIndicesSorted;
+    orig.initNonzeroTracking();
 }
 
 void DenseVector::release()
@@ -391,7 +529,7 @@ void DenseVector::addDenseToDenseFast(Numerical::Double lambda,
     for (index = 0; index < vector.m_length; index++) {
         m_data[index] += vector.m_data[index] * lambda;
     }*/
-    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getLargestCacheSize() )) {
+    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getNonTemporalAddLimit() )) {
         Architecture::getAddDenseToDenseCache()(m_data, vector.m_data, m_data, m_length, lambda);
     } else {
         Architecture::getAddDenseToDenseNoCache()(m_data, vector.m_data, m_data, m_length, lambda);
@@ -405,7 +543,7 @@ void DenseVector::addDenseToDenseAbs(Numerical::Double lambda,
     for (index = 0; index < vector.m_length; index++) {
         m_data[index] = Numerical::stableAddAbs(m_data[index], vector.m_data[index] * lambda);
     }*/
-    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getLargestCacheSize() )) {
+    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getNonTemporalAddLimit() )) {
         Architecture::getAddDenseToDenseAbsCache()(m_data, vector.m_data, m_data, m_length, lambda,
                                                    Numerical::AbsoluteTolerance);
     } else {
@@ -421,7 +559,7 @@ void DenseVector::addDenseToDenseAbsRel(Numerical::Double lambda,
     for (index = 0; index < vector.m_length; index++) {
         m_data[index] = Numerical::stableAdd(m_data[index], vector.m_data[index] * lambda);
     }*/
-    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getLargestCacheSize() )) {
+    if (likely(m_length * sizeof(Numerical::Double) < Architecture::getNonTemporalAddLimit() )) {
         Architecture::getAddDenseToDenseAbsRelCache()(m_data, vector.m_data, m_data, m_length, lambda,
                                                       Numerical::AbsoluteTolerance, Numerical::RelativeTolerance);
     } else {
@@ -431,6 +569,39 @@ void DenseVector::addDenseToDenseAbsRel(Numerical::Double lambda,
 
 }
 
+void DenseVector::addTrackedDenseToDenseFast(Numerical::Double lambda,
+                                             const DenseVector &vector)
+{
+    const unsigned int * indices = vector.getNonzeroIndices();
+    unsigned int nonZeroIndex;
+    for (nonZeroIndex = 0; nonZeroIndex < vector.m_nonzeroIndexCount; nonZeroIndex++) {
+        const unsigned int index = indices[nonZeroIndex];
+        set(index, m_data[index] + lambda * vector.m_data[index]);
+    }
+}
+
+void DenseVector::addTrackedDenseToDenseAbs(Numerical::Double lambda,
+                                            const DenseVector &vector)
+{
+    const unsigned int * indices = vector.getNonzeroIndices();
+    unsigned int nonZeroIndex;
+    for (nonZeroIndex = 0; nonZeroIndex < vector.m_nonzeroIndexCount; nonZeroIndex++) {
+        const unsigned int index = indices[nonZeroIndex];
+        set(index, Numerical::stableAddAbs(m_data[index], lambda * vector.m_data[index]));
+    }
+}
+
+void DenseVector::addTrackedDenseToDenseAbsRel(Numerical::Double lambda,
+                                               const DenseVector &vector)
+{
+    const unsigned int * indices = vector.getNonzeroIndices();
+    unsigned int nonZeroIndex;
+    for (nonZeroIndex = 0; nonZeroIndex < vector.m_nonzeroIndexCount; nonZeroIndex++) {
+        const unsigned int index = indices[nonZeroIndex];
+        set(index, Numerical::stableAdd(m_data[index], lambda * vector.m_data[index]));
+    }
+}
+
 void DenseVector::addIndexedDenseToDenseFast(Numerical::Double lambda,
                                              const IndexedDenseVector &vector)
 {
@@ -609,6 +780,12 @@ Numerical::Double DenseVector::dotProductDenseToSparseAbsRel(const DenseVector &
 
 void DenseVector::_globalInit()
 {
+    // the calibrated crossover of the index list add and the dense add is used only if the ratio is not given
+    sm_sparsityRatio = LinalgParameterHandler::getInstance().getDoubleParameterValue("sparsity_ratio");
+    if (sm_sparsityRatio <= 0) {
+        sm_sparsityRatio = Architecture::getSparseAddDensityLimit() > 0 ? Architecture::getSparseAddDensityLimit() :
+                                                                         DefaultParameters::UNCALIBRATED_SPARSITY_RATIO;
+    }
     setAddMode(Numerical::ADD_ABS_REL);
     setDotProductMode(Numerical::DOT_ABS_REL);
 }
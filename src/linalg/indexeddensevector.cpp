@@ -458,6 +458,7 @@ IndexedDenseVector IndexedDenseVector::createVectorFromDenseArray(const Numerica
             result.m_nonzeroIndices[result.m_nonZeros] = index;
             result.m_nonZeros++;
         } else {
+            result.m_data[index] = 0.0;
             result.m_indexIndices[index] = nullptr;
         }
     }
@@ -472,11 +473,11 @@ IndexedDenseVector IndexedDenseVector::createVectorFromSparseArray(const Numeric
     IndexedDenseVector result;
     result.m_length = length;
     result.m_nonZeros = count;
-    result.m_data = Numerical::allocDouble(count);
-    result.m_nonzeroIndices = alloc<unsigned int, 16>(count);
-    result.m_indexIndices = alloc<unsigned int *, 16>(count);
+    result.m_data = Numerical::allocDouble(length);
+    result.m_nonzeroIndices = alloc<unsigned int, 16>(length);
+    result.m_indexIndices = alloc<unsigned int *, 16>(length);
     CLEAR_DOUBLES(result.m_data, length);
-    panOptMemset(result.m_indexIndices, 0, sizeof( unsigned int * ) * count);
+    panOptMemset(result.m_indexIndices, 0, sizeof( unsigned int * ) * length);
 
 //    if (DEBUG_MODE) {
 //        unsigned int i;
@@ -538,7 +539,12 @@ void IndexedDenseVector::copy(const IndexedDenseVector &orig)
     m_indexIndices = alloc<unsigned int *, 16>(m_length);
     COPY_DOUBLES(m_data, orig.m_data, m_length);
     panOptMemcpy(m_nonzeroIndices, orig.m_nonzeroIndices, sizeof(unsigned int) * m_nonZeros);
-    panOptMemcpy(m_indexIndices, orig.m_indexIndices, sizeof(unsigned int*) * m_length);
+    // the index pointers of the original point into its own nonzero index array
+    panOptMemset(m_indexIndices, 0, sizeof(unsigned int*) * m_length);
+    unsigned int nonZeroIndex;
+    for (nonZeroIndex = 0; nonZeroIndex < m_nonZeros; nonZeroIndex++) {
+        m_indexIndices[m_nonzeroIndices[nonZeroIndex]] = m_nonzeroIndices + nonZeroIndex;
+    }
 }
 
 void IndexedDenseVector::release()
@@ -102,11 +102,27 @@ void LinalgParameterHandler::initParameters()
     createParameter("elbowroom", Entry::INTEGER, ELBOWROOM_COMMENT);
     setParameterValue("elbowroom", DefaultParameters::ELBOWROOM);
 
+    //Basis transformations
+    createParameter("ftran_add_mode", Entry::STRING, FTRAN_ADD_MODE_COMMENT);
+    setParameterValue("ftran_add_mode", DefaultParameters::FTRAN_ADD_MODE);
+    createParameter("btran_add_mode", Entry::STRING, BTRAN_ADD_MODE_COMMENT);
+    setParameterValue("btran_add_mode", DefaultParameters::BTRAN_ADD_MODE);
+    createParameter("eta_statistics", Entry::BOOL, ETA_STATISTICS_COMMENT);
+    setParameterValue("eta_statistics", DefaultParameters::ETA_STATISTICS);
+
+    //Memory
+    createParameter("huge_page_threshold", Entry::INTEGER, HUGE_PAGE_THRESHOLD_COMMENT);
+    setParameterValue("huge_page_threshold", DefaultParameters::HUGE_PAGE_THRESHOLD);
+
 }
 
 bool LinalgParameterHandler::validateParameterValue(const std::string &parameter, const std::string &value)
 {
-    __UNUSED(parameter);
-    __UNUSED(value);
+    if (parameter == "ftran_add_mode" || parameter == "btran_add_mode") {
+        if (value == "ADD_FAST") return true;
+        else if (value == "ADD_ABS") return true;
+        else if (value == "ADD_ABS_REL") return true;
+        else return false;
+    }
     return false;
 }
@@ -20,12 +20,15 @@
 
 #include <debug.h>
 #include <linalg/matrix.h>
+#include <utils/thread.h>
 
 #include <cassert>
 #include <cstring>
 #include <iostream>
 #include <vector>
 
+static const unsigned int PARALLEL_TRANSPOSE_NONZERO_LIMIT = 100000;
+
 Matrix::Matrix(unsigned int rowCount, unsigned int columnCount)
 {
     if (rowCount == 0 && columnCount == 0) {
@@ -105,32 +108,111 @@ void Matrix::build(const MatrixBuilder & builder)
             builder.buildColumn(columnIndex, m_columnWise[columnIndex], nonzerosInRowsPtr);
         }
     }
-    if (builder.hasRowwiseRepresentation() == false) {
-        for (rowIndex = 0; rowIndex < builder.getRowCount(); rowIndex++) {
-            SparseVector * row = m_rowWise[rowIndex];
-            row->prepareForData(nonzerosInRows[rowIndex], builder.getColumnCount());
+    // the transposed vectors are sorted, only the vectors of the builder may need sorting
+    if (builder.hasSortedVectors() == false) {
+        if (builder.hasRowwiseRepresentation() == true) {
+            for (rowIndex = 0; rowIndex < m_rowCount; rowIndex++) {
+                m_rowWise[rowIndex]->sortIndices();
+            }
         }
-        for (columnIndex = 0; columnIndex < builder.getColumnCount(); columnIndex++) {
-            SparseVector::NonzeroIterator iter = m_columnWise[columnIndex]->beginNonzero();
-            SparseVector::NonzeroIterator iterEnd = m_columnWise[columnIndex]->endNonzero();
-            for (; iter < iterEnd; ++iter) {
-                m_rowWise[ iter.getIndex() ]->newNonZero(*iter, columnIndex);
+        if (builder.hasColumnwiseRepresentation() == true) {
+            for (columnIndex = 0; columnIndex < m_columnCount; columnIndex++) {
+                m_columnWise[columnIndex]->sortIndices();
             }
         }
     }
+    if (builder.hasRowwiseRepresentation() == false) {
+        unsigned long long int nonZeros = 0;
+        for (rowIndex = 0; rowIndex < m_rowCount; rowIndex++) {
+            nonZeros += nonzerosInRows[rowIndex];
+        }
+        transpose(m_columnWise, m_columnCount, m_rowWise, m_rowCount, nonZeros);
+    }
     if (builder.hasColumnwiseRepresentation() == false) {
-        for (columnIndex = 0; columnIndex < builder.getColumnCount(); columnIndex++) {
-            SparseVector * column = m_columnWise[columnIndex];
-            column->prepareForData(nonzerosInColumns[columnIndex], builder.getRowCount());
+        unsigned long long int nonZeros = 0;
+        for (columnIndex = 0; columnIndex < m_columnCount; columnIndex++) {
+            nonZeros += nonzerosInColumns[columnIndex];
         }
-        for (rowIndex = 0; rowIndex < builder.getRowCount(); rowIndex++) {
-            SparseVector::NonzeroIterator iter = m_rowWise[rowIndex]->beginNonzero();
-            SparseVector::NonzeroIterator iterEnd = m_rowWise[rowIndex]->endNonzero();
+        transpose(m_rowWise, m_rowCount, m_columnWise, m_columnCount, nonZeros);
+    }
+}
+
+void Matrix::transpose(SparseVector * const * sources, unsigned int sourceCount,
+                       SparseVector ** targets, unsigned int targetCount,
+                       unsigned long long int nonZeros)
+{
+    unsigned int threadCount = 1;
+    if (nonZeros >= PARALLEL_TRANSPOSE_NONZERO_LIMIT) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    unsigned int targetIndex;
+    if (threadCount <= 1) {
+        std::vector<unsigned int> counts(targetCount, 0);
+        unsigned int sourceIndex;
+        for (sourceIndex = 0; sourceIndex < sourceCount; sourceIndex++) {
+            const unsigned int * index = sources[sourceIndex]->m_indices;
+            const unsigned int * indexEnd = index + sources[sourceIndex]->m_nonZeros;
+            for (; index < indexEnd; index++) {
+                counts[*index]++;
+            }
+        }
+        for (targetIndex = 0; targetIndex < targetCount; targetIndex++) {
+            targets[targetIndex]->prepareForData(counts[targetIndex], sourceCount);
+        }
+        for (sourceIndex = 0; sourceIndex < sourceCount; sourceIndex++) {
+            SparseVector::NonzeroIterator iter = sources[sourceIndex]->beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = sources[sourceIndex]->endNonzero();
             for (; iter < iterEnd; ++iter) {
-                m_columnWise[ iter.getIndex() ]->newNonZero(*iter, rowIndex);
+                targets[ iter.getIndex() ]->newNonZero(*iter, sourceIndex);
             }
         }
+        return;
     }
+
+    // counts[chunk][target]: the number of nonzeros of the target in the sources of the chunk,
+    // later the position where the chunk places its next nonzero in the target
+    std::vector< std::vector<unsigned int> > counts(threadCount);
+    const unsigned int chunks = ThreadSupervisor::parallelFor(threadCount, sourceCount,
+                                                             [&](unsigned int begin, unsigned int end, unsigned int chunk) {
+        std::vector<unsigned int> & chunkCounts = counts[chunk];
+        chunkCounts.resize(targetCount, 0);
+        for (unsigned int sourceIndex = begin; sourceIndex < end; sourceIndex++) {
+            const unsigned int * index = sources[sourceIndex]->m_indices;
+            const unsigned int * indexEnd = index + sources[sourceIndex]->m_nonZeros;
+            for (; index < indexEnd; index++) {
+                chunkCounts[*index]++;
+            }
+        }
+    });
+
+    ThreadSupervisor::parallelFor(threadCount, targetCount,
+                                  [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int targetIndex = begin; targetIndex < end; targetIndex++) {
+            unsigned int position = 0;
+            for (unsigned int chunk = 0; chunk < chunks; chunk++) {
+                const unsigned int count = counts[chunk][targetIndex];
+                counts[chunk][targetIndex] = position;
+                position += count;
+            }
+            targets[targetIndex]->prepareForData(position, sourceCount);
+            targets[targetIndex]->m_nonZeros = position;
+        }
+    });
+
+    ThreadSupervisor::parallelFor(threadCount, sourceCount,
+                                  [&](unsigned int begin, unsigned int end, unsigned int chunk) {
+        std::vector<unsigned int> & positions = counts[chunk];
+        for (unsigned int sourceIndex = begin; sourceIndex < end; sourceIndex++) {
+            const SparseVector * source = sources[sourceIndex];
+            unsigned int nonZeroIndex;
+            for (nonZeroIndex = 0; nonZeroIndex < source->m_nonZeros; nonZeroIndex++) {
+                SparseVector * target = targets[ source->m_indices[nonZeroIndex] ];
+                const unsigned int position = positions[ source->m_indices[nonZeroIndex] ]++;
+                target->m_data[position] = source->m_data[nonZeroIndex];
+                target->m_indices[position] = sourceIndex;
+            }
+        }
+    });
 }
 
 void Matrix::resizeVectors(SparseVector **&vectors, unsigned int vectorCount,
@@ -549,6 +631,16 @@ void Matrix::scaleOnlyColumnwiseLambdas(unsigned int index, const std::vector<Nu
     m_columnWise[index]->scaleByLambdas(lambdas);
 }
 
+void Matrix::scaleOnlyRowwiseLambdas(unsigned int index, const std::vector<Numerical::Double> & lambdas,
+                                     Numerical::Double lambda) {
+    m_rowWise[index]->scaleByLambdas(lambdas, lambda);
+}
+
+void Matrix::scaleOnlyColumnwiseLambdas(unsigned int index, const std::vector<Numerical::Double> & lambdas,
+                                        Numerical::Double lambda) {
+    m_columnWise[index]->scaleByLambdas(lambdas, lambda);
+}
+
 void Matrix::invert()
 {
     if (m_isDiagonal == true) {
@@ -19,6 +19,7 @@
 #include <linalg/densevector.h>
 #include <linalg/indexeddensevector.h>
 #include <utils/architecture.h>
+#include <algorithm>
 
 thread_local Numerical::Double * SparseVector::sm_fullLengthVector;
 thread_local unsigned int * SparseVector::sm_indexVector;
@@ -242,7 +243,38 @@ SparseVector &SparseVector::operator=(const SparseVector &orig)
 
 SparseVector &SparseVector::operator =(const DenseVector &orig)
 {
-    release();
+    // the arrays are kept if they are large enough, and they grow geometrically,
+    // so a reused vector rarely allocates
+    if (orig.isSparse()) {
+        // gather only the listed elements, in ascending order like convertFromDenseArray
+        const unsigned int * indices = orig.getNonzeroIndices();
+        const unsigned int count = orig.getNonzeroIndexCount();
+        m_length = orig.m_length;
+        m_nonZeros = 0;
+        unsigned int index;
+        unsigned int nonZeros = 0;
+        for (index = 0; index < count; index++) {
+            if (orig.m_data[ indices[index] ] != 0.0) {
+                nonZeros++;
+            }
+        }
+        if (nonZeros > 0) {
+            if (nonZeros > m_capacity) {
+                Numerical::freeDouble(m_data);
+                ::release(m_indices);
+                m_capacity = std::min(std::max(nonZeros, 2 * m_capacity), m_length);
+                m_data = Numerical::allocDouble(m_capacity);
+                m_indices = alloc<unsigned int, 16>(m_capacity);
+            }
+            for (index = 0; index < count; index++) {
+                const Numerical::Double value = orig.m_data[ indices[index] ];
+                if (value != 0.0) {
+                    newNonZero(value, indices[index]);
+                }
+            }
+        }
+        return *this;
+    }
     convertFromDenseArray(orig.m_data, orig.m_length);
     /*this->prepareForData(orig.nonZeros(), orig.m_length);
     for(unsigned i = 0; i < m_length; i++) {
@@ -495,6 +527,28 @@ void SparseVector::scaleByLambdas(const std::vector<Numerical::Double> & lambdas
     }
 }
 
+void SparseVector::scaleByLambdas(const std::vector<Numerical::Double> & lambdas, Numerical::Double lambda)
+{
+    decltype(m_data) dataPtr = m_data;
+    unsigned int * indexPtr = m_indices;
+    decltype(m_data) lastData = m_data + m_nonZeros - 1;
+    unsigned int * lastIndex = m_indices + m_nonZeros - 1;
+
+    while (dataPtr <= lastData) {
+        *dataPtr *= lambda * lambdas[*indexPtr];
+        if (*dataPtr == 0.0) {
+            m_nonZeros--;
+            *dataPtr = *lastData;
+            *indexPtr = *lastIndex;
+            lastData--;
+            lastIndex--;
+        } else {
+            dataPtr++;
+            indexPtr++;
+        }
+    }
+}
+
 void SparseVector::scaleElementBy(unsigned int index, Numerical::Double lambda)
 {
     decltype(m_data) ptr = nullptr;
@@ -539,8 +593,29 @@ bool SparseVector::operator ==(const SparseVector& other) const
 
 void SparseVector::sortIndices()
 {
-    //TODO: Sort the indices!
     //TODO: Exploit sorted indices everywhere, where it is possible
+    unsigned int index;
+    for (index = 1; index < m_nonZeros; index++) {
+        if (m_indices[index - 1] > m_indices[index]) {
+            break;
+        }
+    }
+    if (index >= m_nonZeros) {
+        return;
+    }
+    if (unlikely(sm_fullLengthVectorLength < m_length)) {
+        resizeFullLengthVector(m_length);
+    }
+    //The values are scattered to the full length vector, and gathered in the order of the sorted indices
+    auto tls_fullLengthVector = SparseVector::sm_fullLengthVector;
+    for (index = 0; index < m_nonZeros; index++) {
+        tls_fullLengthVector[ m_indices[index] ] = m_data[index];
+    }
+    std::sort(m_indices, m_indices + m_nonZeros);
+    for (index = 0; index < m_nonZeros; index++) {
+        m_data[index] = tls_fullLengthVector[ m_indices[index] ];
+        tls_fullLengthVector[ m_indices[index] ] = 0.0;
+    }
 }
 
 void SparseVector::clear()
@@ -876,6 +951,7 @@ void SparseVector::copy(const SparseVector &orig)
     } else {
         m_data = nullptr;
         m_indices = nullptr;
+        m_capacity = 0;
     }
 }
 
@@ -1187,19 +1263,20 @@ void SparseVector::convertFromDenseArray(const Numerical::Double *source, unsign
         }
     }
     if (m_nonZeros == 0) {
-        m_data = nullptr;
-        m_indices = nullptr;
-        m_capacity = 0;
         return;
     }
-    m_data = Numerical::allocDouble(m_nonZeros);
-    m_indices = alloc<unsigned int, 16>(m_nonZeros);
+    if (m_nonZeros > m_capacity) {
+        Numerical::freeDouble(m_data);
+        ::release(m_indices);
+        m_capacity = std::min(std::max(m_nonZeros, 2 * m_capacity), length);
+        m_data = Numerical::allocDouble(m_capacity);
+        m_indices = alloc<unsigned int, 16>(m_capacity);
+    }
     for (index = 0; index < m_nonZeros; index++) {
         m_data[index] = tls_fullLengthVector[index];
         tls_fullLengthVector[index] = 0.0;
         m_indices[index] = tls_indexVector[index];
         tls_indexVector[index] = 0;
     }
-    m_capacity = m_nonZeros;
 }
 
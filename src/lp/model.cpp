@@ -52,8 +52,6 @@ void Model::build(const ModelBuilder & builder)
         m_constraints[index].setVector(m_matrix.row(index));
     }
 
-    m_matrix.sortVectors();
-
     LPINFO("Input problem: "<<m_name<<" ("<<m_matrix.rowCount()<<" x "<<m_matrix.columnCount()<<")");
     /*m_matrix.reInit(builder.getRowCount(), builder.getColumnCount(), false);
 
@@ -210,8 +208,7 @@ void Model::scale() {
         m_costVector.set( index, m_costVector.at(index) * *mulIter );
     }
 
-    // TODO: ezt majd okosabban kellene, jobb ha a scaler mondja meg
-    m_history.push_back("Scaler: Benichou");
+    m_history.push_back(std::string("Scaler: ") + scaler.getName());
 }
 
 std::string Model::getHash() const {
@@ -328,6 +325,10 @@ void Model::addToCostCoefficient(unsigned int index, Numerical::Double value) {
     m_costVector.set( index, Numerical::stableAdd(m_costVector.at(index), value) );
 }
 
+void Model::setMatrixElement(unsigned int rowIndex, unsigned int columnIndex, Numerical::Double value) {
+    m_matrix.set(rowIndex, columnIndex, value);
+}
+
 void Model::setCostConstant(Numerical::Double value) {
     m_costConstant = value;
 }
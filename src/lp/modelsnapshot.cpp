@@ -0,0 +1,500 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file modelsnapshot.cpp
+ */
+
+#include <lp/modelsnapshot.h>
+#include <lp/model.h>
+#include <cstdio>
+#include <cstring>
+
+static const char SNAPSHOT_MAGIC[8] = {'P', 'A', 'N', 'O', 'P', 'T', 'S', 'N'};
+
+static const unsigned int SNAPSHOT_VERSION = 1;
+
+static const unsigned int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+static const unsigned int SNAPSHOT_SECTION_ALIGNMENT = 64;
+
+/**
+ * Writes the sections of a snapshot file sequentially, each of them starting
+ * on a cache line boundary.
+ */
+class SnapshotWriter {
+public:
+    SnapshotWriter(const std::string & fileName, unsigned long long int headerSize,
+                   unsigned long long int * offsets, unsigned long long int * sizes):
+        m_offsets(offsets),
+        m_sizes(sizes),
+        m_position(0),
+        m_section(0)
+    {
+        m_file = fopen(fileName.c_str(), "wb");
+        if (m_file == 0) {
+            throw FileNotFoundException("Error when creating file!", fileName);
+        }
+        m_fileName = fileName;
+        pad(headerSize);
+    }
+
+    ~SnapshotWriter() {
+        if (m_file != 0) {
+            fclose(m_file);
+        }
+    }
+
+    void beginSection(unsigned int section) {
+        pad((m_position + SNAPSHOT_SECTION_ALIGNMENT - 1) / SNAPSHOT_SECTION_ALIGNMENT * SNAPSHOT_SECTION_ALIGNMENT);
+        m_section = section;
+        m_offsets[section] = m_position;
+    }
+
+    void write(const void * data, unsigned long long int size) {
+        if (size > 0 && fwrite(data, 1, size, m_file) != size) {
+            throw FileNotFoundException("Error when writing file!", m_fileName);
+        }
+        m_position += size;
+    }
+
+    void endSection() {
+        m_sizes[m_section] = m_position - m_offsets[m_section];
+    }
+
+    unsigned long long int getPosition() const {
+        return m_position;
+    }
+
+    void finish(const void * header, unsigned long long int headerSize) {
+        if (fseek(m_file, 0, SEEK_SET) != 0 || fwrite(header, 1, headerSize, m_file) != headerSize) {
+            throw FileNotFoundException("Error when writing file!", m_fileName);
+        }
+        if (fclose(m_file) != 0) {
+            m_file = 0;
+            throw FileNotFoundException("Error when writing file!", m_fileName);
+        }
+        m_file = 0;
+    }
+
+private:
+    FILE * m_file;
+
+    std::string m_fileName;
+
+    unsigned long long int * m_offsets;
+
+    unsigned long long int * m_sizes;
+
+    unsigned long long int m_position;
+
+    unsigned int m_section;
+
+    void pad(unsigned long long int position) {
+        static const char zeros[SNAPSHOT_SECTION_ALIGNMENT] = {0};
+        while (m_position < position) {
+            const unsigned long long int size = position - m_position < SNAPSHOT_SECTION_ALIGNMENT ?
+                        position - m_position : SNAPSHOT_SECTION_ALIGNMENT;
+            write(zeros, size);
+        }
+    }
+};
+
+ModelSnapshot::ModelSnapshot():
+    m_header(0),
+    m_rowStarts(0),
+    m_rowIndices(0),
+    m_rowValues(0),
+    m_columnStarts(0),
+    m_columnIndices(0),
+    m_columnValues(0),
+    m_costs(0)
+{
+
+}
+
+ModelSnapshot::~ModelSnapshot()
+{
+
+}
+
+void ModelSnapshot::write(const Model & model, const std::string & fileName)
+{
+    const Matrix & matrix = model.getMatrix();
+    const unsigned int rowCount = matrix.rowCount();
+    const unsigned int columnCount = matrix.columnCount();
+    unsigned int index;
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.m_magic, SNAPSHOT_MAGIC, sizeof(header.m_magic));
+    header.m_version = SNAPSHOT_VERSION;
+    header.m_byteOrder = SNAPSHOT_BYTE_ORDER;
+    const std::string hash = model.getHash();
+    strncpy(header.m_hash, hash.c_str(), sizeof(header.m_hash) - 1);
+    header.m_rowCount = rowCount;
+    header.m_columnCount = columnCount;
+    header.m_objectiveType = model.getObjectiveType() == MINIMIZE ? 0 : 1;
+    header.m_costConstant = Numerical::DoubleToIEEEDouble(model.getCostConstant());
+    header.m_sortedVectors = 1;
+
+    SnapshotWriter writer(fileName, sizeof(Header), header.m_sectionOffsets, header.m_sectionSizes);
+
+    writer.beginSection(MODEL_NAME);
+    writer.write(model.getName().data(), model.getName().size());
+    writer.endSection();
+
+    // the matrix, first rowwise then columnwise
+    unsigned int orientation;
+    for (orientation = 0; orientation < 2; orientation++) {
+        const unsigned int count = orientation == 0 ? rowCount : columnCount;
+        std::vector<unsigned long long int> starts(count + 1);
+        starts[0] = 0;
+        for (index = 0; index < count; index++) {
+            const SparseVector & vector = orientation == 0 ? matrix.row(index) : matrix.column(index);
+            starts[index + 1] = starts[index] + vector.nonZeros();
+        }
+        header.m_nonZeros = starts[count];
+        writer.beginSection(orientation == 0 ? ROW_STARTS : COLUMN_STARTS);
+        writer.write(starts.data(), starts.size() * sizeof(unsigned long long int));
+        writer.endSection();
+
+        writer.beginSection(orientation == 0 ? ROW_INDICES : COLUMN_INDICES);
+        for (index = 0; index < count; index++) {
+            const SparseVector & vector = orientation == 0 ? matrix.row(index) : matrix.column(index);
+            SparseVector::NonzeroIterator iter = vector.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = vector.endNonzero();
+            bool first = true;
+            unsigned int previousIndex = 0;
+            for (; iter != iterEnd; ++iter) {
+                const unsigned int nonzeroIndex = iter.getIndex();
+                if (first == false && nonzeroIndex <= previousIndex) {
+                    header.m_sortedVectors = 0;
+                }
+                first = false;
+                previousIndex = nonzeroIndex;
+                writer.write(&nonzeroIndex, sizeof(nonzeroIndex));
+            }
+        }
+        writer.endSection();
+
+        writer.beginSection(orientation == 0 ? ROW_VALUES : COLUMN_VALUES);
+        for (index = 0; index < count; index++) {
+            const SparseVector & vector = orientation == 0 ? matrix.row(index) : matrix.column(index);
+            SparseVector::NonzeroIterator iter = vector.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = vector.endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const double value = Numerical::DoubleToIEEEDouble(*iter);
+                writer.write(&value, sizeof(value));
+            }
+        }
+        writer.endSection();
+    }
+
+    writer.beginSection(COSTS);
+    for (index = 0; index < columnCount; index++) {
+        const double cost = Numerical::DoubleToIEEEDouble(model.getCostVector().at(index));
+        writer.write(&cost, sizeof(cost));
+    }
+    writer.endSection();
+
+    writer.beginSection(VARIABLE_BOUNDS);
+    for (index = 0; index < columnCount; index++) {
+        const Variable & variable = model.getVariable(index);
+        const double bounds[2] = {Numerical::DoubleToIEEEDouble(variable.getLowerBound()),
+                                  Numerical::DoubleToIEEEDouble(variable.getUpperBound())};
+        writer.write(bounds, sizeof(bounds));
+    }
+    writer.endSection();
+
+    writer.beginSection(CONSTRAINT_BOUNDS);
+    for (index = 0; index < rowCount; index++) {
+        const Constraint & constraint = model.getConstraint(index);
+        const double bounds[2] = {Numerical::DoubleToIEEEDouble(constraint.getLowerBound()),
+                                  Numerical::DoubleToIEEEDouble(constraint.getUpperBound())};
+        writer.write(bounds, sizeof(bounds));
+    }
+    writer.endSection();
+
+    // the names, the start array is followed by the characters
+    for (orientation = 0; orientation < 2; orientation++) {
+        const unsigned int count = orientation == 0 ? columnCount : rowCount;
+        std::vector<unsigned long long int> starts(count + 1);
+        starts[0] = 0;
+        for (index = 0; index < count; index++) {
+            const char * name = orientation == 0 ? model.getVariable(index).getName() :
+                                                   model.getConstraint(index).getName();
+            starts[index + 1] = starts[index] + strlen(name);
+        }
+        writer.beginSection(orientation == 0 ? VARIABLE_NAME_STARTS : CONSTRAINT_NAME_STARTS);
+        writer.write(starts.data(), starts.size() * sizeof(unsigned long long int));
+        writer.endSection();
+
+        writer.beginSection(orientation == 0 ? VARIABLE_NAMES : CONSTRAINT_NAMES);
+        for (index = 0; index < count; index++) {
+            const char * name = orientation == 0 ? model.getVariable(index).getName() :
+                                                   model.getConstraint(index).getName();
+            writer.write(name, starts[index + 1] - starts[index]);
+        }
+        writer.endSection();
+    }
+
+    header.m_fileSize = writer.getPosition();
+    writer.finish(&header, sizeof(Header));
+}
+
+void ModelSnapshot::loadFromFile(const std::string & fileName)
+{
+    if (m_header != 0) {
+        m_file.close();
+        m_header = 0;
+    }
+    m_variables.clear();
+    m_constraints.clear();
+
+    if (m_file.mapForRead(fileName.c_str()) == false) {
+        const size_t size = File::getFileSize(fileName.c_str());
+        m_file.openForRead(fileName.c_str(), size, size);
+    }
+    m_header = reinterpret_cast<const Header*>(m_file.getBuffer());
+    const unsigned long long int fileSize = m_file.getEnd() - m_file.getBuffer();
+    if (fileSize < sizeof(Header)) {
+        throw InvalidSnapshotException("The snapshot " + fileName + " is too short");
+    }
+    if (memcmp(m_header->m_magic, SNAPSHOT_MAGIC, sizeof(m_header->m_magic)) != 0) {
+        throw InvalidSnapshotException(fileName + " is not a model snapshot");
+    }
+    if (m_header->m_version != SNAPSHOT_VERSION || m_header->m_byteOrder != SNAPSHOT_BYTE_ORDER) {
+        throw InvalidSnapshotException("The snapshot " + fileName + " has incompatible format");
+    }
+    if (m_header->m_fileSize != fileSize) {
+        throw InvalidSnapshotException("The snapshot " + fileName + " is truncated");
+    }
+    const size_t hashLength = strnlen(m_header->m_hash, sizeof(m_header->m_hash));
+    if (hashLength == 0 || hashLength == sizeof(m_header->m_hash)) {
+        throw InvalidSnapshotException("The snapshot " + fileName + " has invalid model hash");
+    }
+
+    unsigned int section;
+    for (section = 0; section < SECTION_COUNT; section++) {
+        const unsigned long long int offset = m_header->m_sectionOffsets[section];
+        if (offset < sizeof(Header) || offset % SNAPSHOT_SECTION_ALIGNMENT != 0 ||
+                offset > fileSize || m_header->m_sectionSizes[section] > fileSize - offset) {
+            throw InvalidSnapshotException("The snapshot " + fileName + " is corrupted");
+        }
+    }
+
+    const unsigned int rowCount = m_header->m_rowCount;
+    const unsigned int columnCount = m_header->m_columnCount;
+    const unsigned long long int nonZeros = m_header->m_nonZeros;
+    checkSectionSize(ROW_STARTS, (rowCount + 1ULL) * sizeof(unsigned long long int));
+    checkSectionSize(ROW_INDICES, nonZeros * sizeof(unsigned int));
+    checkSectionSize(ROW_VALUES, nonZeros * sizeof(double));
+    checkSectionSize(COLUMN_STARTS, (columnCount + 1ULL) * sizeof(unsigned long long int));
+    checkSectionSize(COLUMN_INDICES, nonZeros * sizeof(unsigned int));
+    checkSectionSize(COLUMN_VALUES, nonZeros * sizeof(double));
+    checkSectionSize(COSTS, columnCount * sizeof(double));
+    checkSectionSize(VARIABLE_BOUNDS, columnCount * 2ULL * sizeof(double));
+    checkSectionSize(CONSTRAINT_BOUNDS, rowCount * 2ULL * sizeof(double));
+    checkSectionSize(VARIABLE_NAME_STARTS, (columnCount + 1ULL) * sizeof(unsigned long long int));
+    checkSectionSize(CONSTRAINT_NAME_STARTS, (rowCount + 1ULL) * sizeof(unsigned long long int));
+
+    m_rowStarts = reinterpret_cast<const unsigned long long int*>(getSection(ROW_STARTS));
+    m_rowIndices = reinterpret_cast<const unsigned int*>(getSection(ROW_INDICES));
+    m_rowValues = reinterpret_cast<const double*>(getSection(ROW_VALUES));
+    m_columnStarts = reinterpret_cast<const unsigned long long int*>(getSection(COLUMN_STARTS));
+    m_columnIndices = reinterpret_cast<const unsigned int*>(getSection(COLUMN_INDICES));
+    m_columnValues = reinterpret_cast<const double*>(getSection(COLUMN_VALUES));
+    m_costs = reinterpret_cast<const double*>(getSection(COSTS));
+    const unsigned long long int * variableNameStarts =
+            reinterpret_cast<const unsigned long long int*>(getSection(VARIABLE_NAME_STARTS));
+    const unsigned long long int * constraintNameStarts =
+            reinterpret_cast<const unsigned long long int*>(getSection(CONSTRAINT_NAME_STARTS));
+    checkStarts(m_rowStarts, rowCount, nonZeros);
+    checkStarts(m_columnStarts, columnCount, nonZeros);
+    checkStarts(variableNameStarts, columnCount, m_header->m_sectionSizes[VARIABLE_NAMES]);
+    checkStarts(constraintNameStarts, rowCount, m_header->m_sectionSizes[CONSTRAINT_NAMES]);
+    checkIndices(m_rowIndices, m_rowStarts, rowCount, columnCount, m_header->m_sortedVectors != 0);
+    checkIndices(m_columnIndices, m_columnStarts, columnCount, rowCount, m_header->m_sortedVectors != 0);
+
+    m_hash.assign(m_header->m_hash, hashLength);
+    m_name.assign(getSection(MODEL_NAME), m_header->m_sectionSizes[MODEL_NAME]);
+
+    unsigned int index;
+    const double * bounds = reinterpret_cast<const double*>(getSection(VARIABLE_BOUNDS));
+    const char * names = getSection(VARIABLE_NAMES);
+    std::string name;
+    m_variables.resize(columnCount);
+    for (index = 0; index < columnCount; index++) {
+        name.assign(names + variableNameStarts[index], variableNameStarts[index + 1] - variableNameStarts[index]);
+        try {
+            m_variables[index] = Variable::createVariable(name.c_str(), bounds[index * 2], bounds[index * 2 + 1]);
+        } catch (const Variable::VariableException &) {
+            throw InvalidSnapshotException("The snapshot " + fileName + " has invalid variable bounds");
+        }
+    }
+
+    bounds = reinterpret_cast<const double*>(getSection(CONSTRAINT_BOUNDS));
+    names = getSection(CONSTRAINT_NAMES);
+    m_constraints.resize(rowCount);
+    for (index = 0; index < rowCount; index++) {
+        name.assign(names + constraintNameStarts[index], constraintNameStarts[index + 1] - constraintNameStarts[index]);
+        try {
+            m_constraints[index] = Constraint::createConstraint(name.c_str(), bounds[index * 2], bounds[index * 2 + 1]);
+        } catch (const Constraint::ConstraintException &) {
+            throw InvalidSnapshotException("The snapshot " + fileName + " has invalid constraint bounds");
+        }
+    }
+}
+
+bool ModelSnapshot::isSnapshotFile(const std::string & fileName)
+{
+    return fileName.size() > 4 && (fileName.compare(fileName.size() - 4, 4, ".PSN") == 0 ||
+                                   fileName.compare(fileName.size() - 4, 4, ".psn") == 0);
+}
+
+const std::string & ModelSnapshot::getModelHash() const
+{
+    return m_hash;
+}
+
+unsigned int ModelSnapshot::getColumnCount() const
+{
+    return m_header->m_columnCount;
+}
+
+unsigned int ModelSnapshot::getRowCount() const
+{
+    return m_header->m_rowCount;
+}
+
+void ModelSnapshot::buildRow(unsigned int index, SparseVector * rowVector,
+                             std::vector<unsigned int> * nonzeros) const
+{
+    __UNUSED(nonzeros);
+    buildVector(rowVector, m_header->m_columnCount, m_rowIndices, m_rowValues,
+                m_rowStarts[index], m_rowStarts[index + 1]);
+}
+
+void ModelSnapshot::buildColumn(unsigned int index, SparseVector * columnVector,
+                                std::vector<unsigned int> * nonzeros) const
+{
+    __UNUSED(nonzeros);
+    buildVector(columnVector, m_header->m_rowCount, m_columnIndices, m_columnValues,
+                m_columnStarts[index], m_columnStarts[index + 1]);
+}
+
+bool ModelSnapshot::hasRowwiseRepresentation() const
+{
+    return true;
+}
+
+bool ModelSnapshot::hasColumnwiseRepresentation() const
+{
+    return true;
+}
+
+bool ModelSnapshot::hasSortedVectors() const
+{
+    return m_header->m_sortedVectors != 0;
+}
+
+const Variable & ModelSnapshot::getVariable(unsigned int index) const
+{
+    return m_variables[index];
+}
+
+const Constraint & ModelSnapshot::getConstraint(unsigned int index) const
+{
+    return m_constraints[index];
+}
+
+void ModelSnapshot::buildCostVector(DenseVector * costVector) const
+{
+    costVector->reInit(m_header->m_columnCount);
+    unsigned int index;
+    for (index = 0; index < m_header->m_columnCount; index++) {
+        if (m_costs[index] != 0.0) {
+            costVector->set(index, m_costs[index]);
+        }
+    }
+}
+
+double ModelSnapshot::getObjectiveConstant() const
+{
+    return m_header->m_costConstant;
+}
+
+std::string ModelSnapshot::getName() const
+{
+    return m_name;
+}
+
+OBJECTIVE_TYPE ModelSnapshot::getObjectiveType() const
+{
+    return m_header->m_objectiveType == 0 ? MINIMIZE : MAXIMIZE;
+}
+
+const char * ModelSnapshot::getSection(SECTION section) const
+{
+    return m_file.getBuffer() + m_header->m_sectionOffsets[section];
+}
+
+void ModelSnapshot::checkSectionSize(SECTION section, unsigned long long int size) const
+{
+    if (m_header->m_sectionSizes[section] != size) {
+        throw InvalidSnapshotException("The snapshot has invalid section size");
+    }
+}
+
+void ModelSnapshot::checkStarts(const unsigned long long int * starts, unsigned int count,
+                                unsigned long long int total)
+{
+    if (starts[0] != 0 || starts[count] != total) {
+        throw InvalidSnapshotException("The snapshot has invalid start array");
+    }
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        if (starts[index] > starts[index + 1]) {
+            throw InvalidSnapshotException("The snapshot has invalid start array");
+        }
+    }
+}
+
+void ModelSnapshot::checkIndices(const unsigned int * indices, const unsigned long long int * starts,
+                                 unsigned int count, unsigned int length, bool sorted)
+{
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        unsigned long long int position;
+        for (position = starts[index]; position < starts[index + 1]; position++) {
+            if (indices[position] >= length ||
+                    (sorted && position > starts[index] && indices[position] <= indices[position - 1])) {
+                throw InvalidSnapshotException("The snapshot has invalid vector index");
+            }
+        }
+    }
+}
+
+void ModelSnapshot::buildVector(SparseVector * vector, unsigned int length,
+                                const unsigned int * indices, const double * values,
+                                unsigned long long int begin, unsigned long long int end)
+{
+    vector->prepareForData(end - begin, length);
+    for (; begin < end; begin++) {
+        vector->newNonZero(values[begin], indices[begin]);
+    }
+}
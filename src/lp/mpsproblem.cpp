@@ -18,11 +18,20 @@
 #include <utils/numerical.h>
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 
 #define DEFAULT_MPS_ERROR_PRINT_LIMIT 10
 
+/**
+ * Files of at least this size are memory mapped, and their COLUMNS section is parsed in parallel.
+ */
+#ifndef MPS_PARALLEL_FILE_SIZE_LIMIT
+#define MPS_PARALLEL_FILE_SIZE_LIMIT (64 * 1024 * 1024)
+#endif
+
 MpsModelBuilder::MpsModelBuilder() {
     m_bufferSize = 20 * 1024;
     m_buffer = 0;
@@ -608,30 +617,8 @@ void MpsModelBuilder::saveColumn(Column * actualColumnPtr,
                                  std::vector<Column> ** lastVectorPtr,
                                  bool *columnPattern) {
     Column & actualColumn = *actualColumnPtr;
-    std::vector<Column> * & lastVector = *lastVectorPtr;
-    (*lastVector)[ m_columns.m_lastCounter ] = actualColumn;
-
-    ////////////////////////////////////////////////////
-    // Column * column = &(*lastVector)[ m_columns.m_lastCounter ];
-    // LPINFO( *(column->m_beginIndexIter) );
-    // std::list<unsigned int*>::const_iterator indexIter0 = column->m_beginIndexIter;
-    // LPINFO( *indexIter0 );
-    ////////////////////////////////////////////////////
-
-    m_columns.m_totalCounter++;
-    m_columns.m_lastCounter++;
-
-
-    if (m_columns.m_lastCounter >= m_columns.m_lastSize) {
-        m_columns.m_lastSize *= 2;
-        m_columns.m_listSize++;
-        m_columns.m_lastCounter = 0;
-        lastVector = new std::vector<Column>;
-        lastVector->resize(m_columns.m_lastSize);
-
-        m_columns.m_columns.push_back(lastVector);
+    storeColumn(actualColumn, lastVectorPtr);
 
-    }
     unsigned int * indexPtr = actualColumn.m_firstIndex;
     std::list<unsigned int*>::const_iterator indexIter = actualColumn.m_beginIndexIter;
     unsigned int * endPtr = *indexIter + sm_valueBufferSize;
@@ -658,7 +645,28 @@ void MpsModelBuilder::saveColumn(Column * actualColumnPtr,
 
 }
 
-bool MpsModelBuilder::parseRecordStart(double * value,
+void MpsModelBuilder::storeColumn(const Column & column,
+                                  std::vector<Column> ** lastVectorPtr) {
+    std::vector<Column> * & lastVector = *lastVectorPtr;
+    (*lastVector)[ m_columns.m_lastCounter ] = column;
+
+    m_columns.m_totalCounter++;
+    m_columns.m_lastCounter++;
+
+    if (m_columns.m_lastCounter >= m_columns.m_lastSize) {
+        m_columns.m_lastSize *= 2;
+        m_columns.m_listSize++;
+        m_columns.m_lastCounter = 0;
+        lastVector = new std::vector<Column>;
+        lastVector->resize(m_columns.m_lastSize);
+
+        m_columns.m_columns.push_back(lastVector);
+
+    }
+}
+
+bool MpsModelBuilder::parseRecordStart(const char * & buffer,
+                                       double * value,
                                        MpsName * id1,
                                        MpsName * id2,
                                        EmptySection4 * startSection,
@@ -667,17 +675,17 @@ bool MpsModelBuilder::parseRecordStart(double * value,
     char number[MPS_FIELD_3_LENGTH + 1] = {0};
     bool wrong = false;
 
-    if (unlikely(*m_buffer != ' ')) {
+    if (unlikely(*buffer != ' ')) {
         return false;
     }
 
-    const MpsColumnRecordFirst * record = reinterpret_cast<const MpsColumnRecordFirst *>(m_buffer);
-    m_buffer += sizeof(MpsColumnRecordFirst);
+    const MpsColumnRecordFirst * record = reinterpret_cast<const MpsColumnRecordFirst *>(buffer);
+    buffer += sizeof(MpsColumnRecordFirst);
 
-    for (index = 0; index < MPS_FIELD_3_LENGTH && m_buffer[index] >= ' '; index++) {
-        number[index] = m_buffer[index];
+    for (index = 0; index < MPS_FIELD_3_LENGTH && buffer[index] >= ' '; index++) {
+        number[index] = buffer[index];
     }
-    m_buffer += index;
+    buffer += index;
     for (; index < MPS_FIELD_3_LENGTH; index++) {
         number[index] = ' ';
     }
@@ -690,7 +698,7 @@ bool MpsModelBuilder::parseRecordStart(double * value,
     *id1 = record->m_columnName;
 
     unsigned int spaces = 0;
-    while (spaces < 3 && m_buffer[spaces] == ' ') {
+    while (spaces < 3 && buffer[spaces] == ' ') {
         spaces++;
     }
     wrong = wrong || (spaces < 3 && spaces > 0);
@@ -700,7 +708,7 @@ bool MpsModelBuilder::parseRecordStart(double * value,
         cout << "WRONG " << spaces << endl;
     }*/
 
-    m_buffer += spaces;
+    buffer += spaces;
     CHECK_NAME_FULL(record->m_rowName.m_bits, wrong);
 
     if (unlikely(wrong == true)) {
@@ -711,17 +719,17 @@ bool MpsModelBuilder::parseRecordStart(double * value,
     *value = parseDouble(number);
 
     spaces = 0;
-    while (spaces < 2 && *m_buffer == ' ') { // TODO: tul hosszu ellen vedekezes
-        m_buffer++;
+    while (spaces < 2 && *buffer == ' ') { // TODO: tul hosszu ellen vedekezes
+        buffer++;
         spaces++;
     }
 
     bool endLine = false;
-    while (*m_buffer < ' ') { // TODO: tul hosszu ellen vedekezes
-        m_buffer++;
+    while (*buffer < ' ') { // TODO: tul hosszu ellen vedekezes
+        buffer++;
         endLine = true;
     }
-    *newLine = !(*m_buffer > ' ' && endLine == false && ((spaces | 0x2) == 0x2));
+    *newLine = !(*buffer > ' ' && endLine == false && ((spaces | 0x2) == 0x2));
 
     return true;
 }
@@ -818,13 +826,14 @@ bool MpsModelBuilder::parseBoundRecord(double * value,
     return true;
 }
 
-bool MpsModelBuilder::parseRecordEnd(double * value,
+bool MpsModelBuilder::parseRecordEnd(const char * & buffer,
+                                     double * value,
                                      MpsName * id) {
     unsigned int index;
     char number[MPS_FIELD_3_LENGTH + 1] = {0};
 
-    const MpsColumnRecordSecond * record = reinterpret_cast<const MpsColumnRecordSecond *>(m_buffer);
-    m_buffer += sizeof(MpsColumnRecordSecond);
+    const MpsColumnRecordSecond * record = reinterpret_cast<const MpsColumnRecordSecond *>(buffer);
+    buffer += sizeof(MpsColumnRecordSecond);
 
     bool wrong = record->m_spaces.m_bits != 0x2020;
 
@@ -834,20 +843,20 @@ bool MpsModelBuilder::parseRecordEnd(double * value,
         return false;
     }
 
-    for (index = 0; index < MPS_FIELD_3_LENGTH && m_buffer[index] >= ' '; index++) {
-        number[index] = m_buffer[index];
+    for (index = 0; index < MPS_FIELD_3_LENGTH && buffer[index] >= ' '; index++) {
+        number[index] = buffer[index];
     }
-    m_buffer += index;
+    buffer += index;
     for (; index < MPS_FIELD_3_LENGTH; index++) {
         number[index] = ' ';
     }
 
-    while (*m_buffer == ' ') {
-        m_buffer++;
+    while (*buffer == ' ') {
+        buffer++;
     }
 
-    while (*m_buffer < ' ') {
-        m_buffer++;
+    while (*buffer < ' ') {
+        buffer++;
     }
 
 
@@ -930,7 +939,7 @@ void MpsModelBuilder::readColumns() {
                 wrong = false;
                 rowIndexPtr1 = 0;
                 rowIndexPtr2 = 0;
-                if (likely(parseRecordStart(&value1, &columnName, &rowIndex.m_name, &startSection, &endLine) == true)) {
+                if (likely(parseRecordStart(m_buffer, &value1, &columnName, &rowIndex.m_name, &startSection, &endLine) == true)) {
 
                     if (unlikely(startSection.m_bits != 0x20202020)) {
                         wrong = true;
@@ -961,7 +970,7 @@ void MpsModelBuilder::readColumns() {
                     }
 
                     if (endLine == false) {
-                        if (likely(parseRecordEnd(&value2, &rowIndex.m_name))) {
+                        if (likely(parseRecordEnd(m_buffer, &value2, &rowIndex.m_name))) {
                             rowIndexPtr2 = m_rowsTable.get( rowIndex );
                             if (unlikely(rowIndexPtr2 == 0)) {
                                 if (likely(m_costVectorName.m_bits == rowIndex.m_name.m_bits)) {
@@ -1049,6 +1058,245 @@ void MpsModelBuilder::readColumns() {
     delete [] columnPattern;
 }
 
+void MpsModelBuilder::parseColumnsChunk(ColumnsChunk * chunk) {
+    const char * buffer = chunk->m_begin;
+    RowIndex rowIndex;
+    MpsName columnName;
+    EmptySection4 startSection;
+    bool endLine;
+    double value1 = 0.0;
+    double value2 = 0.0;
+
+    chunk->m_stop = chunk->m_end;
+    chunk->m_sectionEnd = false;
+    chunk->m_irregular = false;
+    chunk->m_lines = 0;
+
+    // the same steps as the fast path of readColumns(), anything else
+    // is left to the sequential parser
+    while (buffer < chunk->m_end) {
+        if (*buffer != ' ') {
+            chunk->m_stop = buffer;
+            chunk->m_sectionEnd = true;
+            return;
+        }
+        if (unlikely(parseRecordStart(buffer, &value1, &columnName, &rowIndex.m_name,
+                                      &startSection, &endLine) == false ||
+                     startSection.m_bits != 0x20202020)) {
+            chunk->m_irregular = true;
+            return;
+        }
+        if (chunk->m_columns.empty() || chunk->m_columns.back().m_name.m_bits != columnName.m_bits) {
+            ColumnRun run;
+            run.m_name = columnName;
+            run.m_firstNonzero = chunk->m_values.size();
+            run.m_nonzeros = 0;
+            run.m_line = chunk->m_lines;
+            chunk->m_columns.push_back(run);
+        }
+        const unsigned int columnIndex = chunk->m_columns.size() - 1;
+
+        const RowIndex * rowIndexPtr1 = m_rowsTable.get( rowIndex );
+        if (unlikely(rowIndexPtr1 == 0)) {
+            if (likely(m_costVectorName.m_bits == rowIndex.m_name.m_bits)) {
+                chunk->m_costVector.push_back( std::make_pair( value1, columnIndex ) );
+            } else if (value1 != 0.0) {
+                chunk->m_irregular = true;
+                return;
+            }
+        } else if (value1 != 0.0) {
+            chunk->m_values.push_back(value1);
+            chunk->m_indices.push_back(rowIndexPtr1->m_row->m_index);
+            chunk->m_columns.back().m_nonzeros++;
+        }
+
+        if (endLine == false) {
+            if (unlikely(parseRecordEnd(buffer, &value2, &rowIndex.m_name) == false)) {
+                chunk->m_irregular = true;
+                return;
+            }
+            const RowIndex * rowIndexPtr2 = m_rowsTable.get( rowIndex );
+            if (unlikely(rowIndexPtr2 == 0)) {
+                if (likely(m_costVectorName.m_bits == rowIndex.m_name.m_bits)) {
+                    chunk->m_costVector.push_back( std::make_pair( value2, columnIndex ) );
+                }
+            } else if (value2 != 0.0) {
+                chunk->m_values.push_back(value2);
+                chunk->m_indices.push_back(rowIndexPtr2->m_row->m_index);
+                chunk->m_columns.back().m_nonzeros++;
+            }
+        }
+        chunk->m_lines++;
+    }
+    chunk->m_stop = buffer;
+}
+
+bool MpsModelBuilder::readColumnsParallel(unsigned int threadCount) {
+    const char * sectionBegin = m_buffer;
+    const char * dataEnd = m_inputFile.getEnd();
+    if (threadCount < 2 || sectionBegin >= dataEnd) {
+        return false;
+    }
+
+    // split at record boundaries: a record ends with its line feed and the
+    // following control characters, like in parseRecordStart and parseRecordEnd
+    std::vector<ColumnsChunk> chunks(threadCount);
+    const size_t chunkSize = (dataEnd - sectionBegin) / threadCount;
+    const char * begin = sectionBegin;
+    unsigned int chunkIndex;
+    for (chunkIndex = 0; chunkIndex < threadCount; chunkIndex++) {
+        const char * end = dataEnd;
+        if (chunkIndex + 1 < threadCount) {
+            end = std::max(begin, sectionBegin + chunkSize * (chunkIndex + 1));
+            end = static_cast<const char*>(memchr(end, '\n', dataEnd - end));
+            if (end == 0) {
+                end = dataEnd;
+            } else {
+                while (end < dataEnd && *end < ' ') {
+                    end++;
+                }
+            }
+        }
+        chunks[chunkIndex].m_begin = begin;
+        chunks[chunkIndex].m_end = end;
+        begin = end;
+    }
+
+    std::vector<std::thread> threads;
+    for (chunkIndex = 1; chunkIndex < threadCount; chunkIndex++) {
+        threads.push_back(std::thread(&MpsModelBuilder::parseColumnsChunk, this, &chunks[chunkIndex]));
+    }
+    parseColumnsChunk(&chunks[0]);
+    for (std::thread & thread: threads) {
+        thread.join();
+    }
+
+    // the chunks until the end of the section must be complete and adjacent
+    bool sectionEnd = false;
+    unsigned int usedChunks = 0;
+    unsigned long long int nonzeros = 0;
+    unsigned int lines = 0;
+    for (chunkIndex = 0; chunkIndex < threadCount; chunkIndex++) {
+        const ColumnsChunk & chunk = chunks[chunkIndex];
+        if (chunk.m_irregular || (chunkIndex > 0 && chunks[chunkIndex - 1].m_stop != chunk.m_begin)) {
+            return false;
+        }
+        nonzeros += chunk.m_values.size();
+        lines += chunk.m_lines;
+        usedChunks++;
+        if (chunk.m_sectionEnd) {
+            sectionEnd = true;
+            break;
+        }
+    }
+    if (!sectionEnd || lines == 0 || nonzeros >= UINT_MAX) {
+        return false;
+    }
+
+    // allocate the value and index blocks like readColumns() does
+    const unsigned int blockCount = nonzeros / sm_valueBufferSize + 1;
+    std::vector< std::list<double*>::const_iterator > valueBlocks(blockCount);
+    std::vector< std::list<unsigned int*>::const_iterator > indexBlocks(blockCount);
+    unsigned int blockIndex;
+    for (blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+        m_values.push_back( alloc<double, 64>( sm_valueBufferSize ) );
+        m_indices.push_back( alloc<unsigned int, 64>( sm_valueBufferSize ) );
+        valueBlocks[blockIndex] = --m_values.end();
+        indexBlocks[blockIndex] = --m_indices.end();
+    }
+    m_actualValue = m_values.back() + nonzeros % sm_valueBufferSize;
+    m_actualValueEnd = m_values.back() + sm_valueBufferSize;
+    m_actualIndex = m_indices.back() + nonzeros % sm_valueBufferSize;
+    m_actualIndexEnd = m_indices.back() + sm_valueBufferSize;
+
+    std::vector<unsigned int> firstNonzeros(usedChunks);
+    unsigned int firstNonzero = 0;
+    for (chunkIndex = 0; chunkIndex < usedChunks; chunkIndex++) {
+        firstNonzeros[chunkIndex] = firstNonzero;
+        firstNonzero += chunks[chunkIndex].m_values.size();
+    }
+
+    auto copyChunk = [&](unsigned int chunkIndex) {
+        const ColumnsChunk & chunk = chunks[chunkIndex];
+        unsigned int position = firstNonzeros[chunkIndex];
+        unsigned int index = 0;
+        while (index < chunk.m_values.size()) {
+            const unsigned int offset = position % sm_valueBufferSize;
+            const unsigned int count = std::min<unsigned int>(sm_valueBufferSize - offset,
+                                                              chunk.m_values.size() - index);
+            panOptMemcpy(*valueBlocks[position / sm_valueBufferSize] + offset,
+                         chunk.m_values.data() + index, count * sizeof(double));
+            panOptMemcpy(*indexBlocks[position / sm_valueBufferSize] + offset,
+                         chunk.m_indices.data() + index, count * sizeof(unsigned int));
+            position += count;
+            index += count;
+        }
+    };
+    threads.clear();
+    for (chunkIndex = 1; chunkIndex < usedChunks; chunkIndex++) {
+        threads.push_back(std::thread(copyChunk, chunkIndex));
+    }
+    copyChunk(0);
+    for (std::thread & thread: threads) {
+        thread.join();
+    }
+
+    // merge the columns in order, a column can continue in the next chunk
+    m_columns.m_listSize = 1;
+    m_columns.m_lastSize = 10;
+    m_columns.m_lastCounter = 0;
+    m_columns.m_totalCounter = 0;
+    std::vector<Column> * lastVector = new std::vector<Column>;
+    lastVector->resize(m_columns.m_lastSize);
+    m_columns.m_columns.push_back(lastVector);
+
+    Column actualColumn;
+    actualColumn.m_name.m_bits = 0;
+    actualColumn.m_lowerBound = 0.0;
+    actualColumn.m_isInteger = false;
+    actualColumn.m_upperBound = 1.0 / 0.0;
+    actualColumn.m_nonzeros = 0;
+    actualColumn.m_index = 0;
+    unsigned int firstLine = m_currentLine;
+    for (chunkIndex = 0; chunkIndex < usedChunks; chunkIndex++) {
+        const ColumnsChunk & chunk = chunks[chunkIndex];
+        unsigned int runIndex;
+        for (runIndex = 0; runIndex < chunk.m_columns.size(); runIndex++) {
+            const ColumnRun & run = chunk.m_columns[runIndex];
+            if (actualColumn.m_name.m_bits != 0 && actualColumn.m_name.m_bits == run.m_name.m_bits) {
+                // runIndex == 0, the last column of the previous chunk continues
+                actualColumn.m_nonzeros += run.m_nonzeros;
+                continue;
+            }
+            if (actualColumn.m_name.m_bits != 0) {
+                storeColumn(actualColumn, &lastVector);
+                actualColumn.m_index++;
+            }
+            const unsigned int position = firstNonzeros[chunkIndex] + run.m_firstNonzero;
+            actualColumn.m_name = run.m_name;
+            actualColumn.m_line = firstLine + run.m_line;
+            actualColumn.m_nonzeros = run.m_nonzeros;
+            actualColumn.m_beginValueIter = valueBlocks[position / sm_valueBufferSize];
+            actualColumn.m_beginIndexIter = indexBlocks[position / sm_valueBufferSize];
+            actualColumn.m_firstValue = *actualColumn.m_beginValueIter + position % sm_valueBufferSize;
+            actualColumn.m_firstIndex = *actualColumn.m_beginIndexIter + position % sm_valueBufferSize;
+        }
+
+        const unsigned int firstColumn = actualColumn.m_index + 1 - chunk.m_columns.size();
+        std::vector<std::pair<double, unsigned int> >::const_iterator costIter = chunk.m_costVector.begin();
+        std::vector<std::pair<double, unsigned int> >::const_iterator costIterEnd = chunk.m_costVector.end();
+        for (; costIter != costIterEnd; ++costIter) {
+            m_costVector.push_back( std::make_pair( costIter->first, firstColumn + costIter->second ) );
+        }
+        firstLine += chunk.m_lines;
+    }
+    storeColumn(actualColumn, &lastVector);
+
+    m_currentLine = firstLine;
+    m_buffer = chunks[usedChunks - 1].m_stop;
+    return true;
+}
+
 void MpsModelBuilder::finishColumns() {
 
     m_columnsMap.resize( m_columns.m_totalCounter, 0 );
@@ -1121,7 +1369,7 @@ void MpsModelBuilder::readRhsOrRanges(double Row::*range) {
                 wrong = false;
                 rowIndexPtr1 = 0;
                 rowIndexPtr2 = 0;
-                if (likely(parseRecordStart(&value1, &currentRhsName, &rowIndex.m_name, &startSection, &endLine) == true)) {
+                if (likely(parseRecordStart(m_buffer, &value1, &currentRhsName, &rowIndex.m_name, &startSection, &endLine) == true)) {
 
                     if (unlikely(rhsName.m_bits == 0)) {
                         rhsName = currentRhsName;
@@ -1142,7 +1390,7 @@ void MpsModelBuilder::readRhsOrRanges(double Row::*range) {
                     }
 
                     if (endLine == false) {
-                        if (likely(parseRecordEnd(&value2, &rowIndex.m_name))) {
+                        if (likely(parseRecordEnd(m_buffer, &value2, &rowIndex.m_name))) {
                             rowIndexPtr2 = m_rowsTable.get( rowIndex );
                             if (unlikely(rowIndexPtr2 == 0)) {
                                 if (likely(m_costVectorName.m_bits == rowIndex.m_name.m_bits)) {
@@ -1442,10 +1690,16 @@ void MpsModelBuilder::loadFromFile(const std::string & fileName) {
     m_sectionAlreadyProcessed.init(m_errorPrintLimit, m_levelCounters);
 
     m_currentLine = 0;
-    m_inputFile.openForRead(fileName.c_str(), m_bufferSize, 100);
-
-    m_buffer = m_inputFile.getBuffer();
-    m_bufferEnd = m_buffer + m_bufferSize;
+    if (File::getFileSize(fileName.c_str()) >= MPS_PARALLEL_FILE_SIZE_LIMIT &&
+            m_inputFile.mapForRead(fileName.c_str())) {
+        m_buffer = m_inputFile.getBuffer();
+        // the terminating zero is readable, as in the case of the buffered read
+        m_bufferEnd = m_inputFile.getEnd() + 1;
+    } else {
+        m_inputFile.openForRead(fileName.c_str(), m_bufferSize, 100);
+        m_buffer = m_inputFile.getBuffer();
+        m_bufferEnd = m_buffer + m_bufferSize;
+    }
 
     // skip comments and empty records
     while (skipComments()) {}
@@ -1480,7 +1734,9 @@ void MpsModelBuilder::loadFromFile(const std::string & fileName) {
 
     skipEndLine();
 
-    readColumns();
+    if (!m_inputFile.isMapped() || !readColumnsParallel(std::thread::hardware_concurrency())) {
+        readColumns();
+    }
 
     finishColumns();
 
@@ -1516,6 +1772,8 @@ void MpsModelBuilder::loadFromFile(const std::string & fileName) {
 
     } while (section != MPS_ENDATA);
 
+    m_inputFile.close();
+
 }
 
 // ********************************************************
@@ -276,9 +276,11 @@ void Presolver::presolve() {
     if(m_mode == DEFAULT) {
         clearModules();
         addModule( new DualBoundsModule(this));
+        addModule( new DominatedColumnModule(this));
         addModule( new ImpliedBoundsModule(this));
         addModule( new SingletonRowsModule(this));
         addModule( new SingletonColumnsModule(this));
+        addModule( new DoubletonEquationModule(this));
         addModule( new LinearAlgebraicModule(this));
     }
 
@@ -38,6 +38,32 @@ void MakeSparserModule::printStatistics() {
 
 PresolverModule::~PresolverModule() { }
 
+void PresolverModule::computeDualActivityBounds(int index, Numerical::Double * impliedLB, Numerical::Double * impliedUB) const {
+    const DenseVector * impliedDualLower = m_parent->getImpliedDualLower();
+    const DenseVector * impliedDualUpper = m_parent->getImpliedDualUpper();
+    *impliedLB = 0;
+    *impliedUB = 0;
+    const Variable& curVariable = (*m_parent->getVariables())[index];
+    SparseVector::NonzeroIterator it = curVariable.getVector()->beginNonzero();
+    SparseVector::NonzeroIterator itEnd = curVariable.getVector()->endNonzero();
+    for(; it < itEnd; ++it) {
+        int curRow = it.getIndex();
+        if(*it > 0) {
+            *impliedLB = Numerical::stableAdd(*impliedLB, *it * impliedDualLower->at(curRow));
+            *impliedUB = Numerical::stableAdd(*impliedUB, *it * impliedDualUpper->at(curRow));
+        } else {
+            *impliedLB = Numerical::stableAdd(*impliedLB, *it * impliedDualUpper->at(curRow));
+            *impliedUB = Numerical::stableAdd(*impliedUB, *it * impliedDualLower->at(curRow));
+        }
+    }
+    if(m_parent->getExtraDualLowerSum()->at(index) != 0) {
+        *impliedLB = -Numerical::Infinity;
+    }
+    if(m_parent->getExtraDualUpperSum()->at(index) != 0) {
+        *impliedUB = Numerical::Infinity;
+    }
+}
+
 SingletonRowsModule::SingletonRowsModule(Presolver * parent) :
     PresolverModule(parent)
 {
@@ -721,8 +747,6 @@ void DualBoundsModule::executeMethod() {
                 break;
             }
         }
-        impliedLB = 0;
-        impliedUB = 0;
         int index = begin.getIndex();
         const Variable& curVariable = (*m_parent->getVariables())[index];
         const auto& varLowerBound = curVariable.getLowerBound();
@@ -733,22 +757,7 @@ void DualBoundsModule::executeMethod() {
         SparseVector::NonzeroIterator itC = it;
         SparseVector::NonzeroIterator itCEnd = itEnd;
         //Calculating the implied dual constraint bounds
-        for(; it < itEnd; ++it) {
-            int curRow = it.getIndex();
-            if(*it > 0) {
-                impliedLB = Numerical::stableAdd(impliedLB, *it * m_impliedDualLower->at(curRow));
-                impliedUB = Numerical::stableAdd(impliedUB, *it * m_impliedDualUpper->at(curRow));
-            } else {
-                impliedLB = Numerical::stableAdd(impliedLB, *it * m_impliedDualUpper->at(curRow));
-                impliedUB = Numerical::stableAdd(impliedUB, *it * m_impliedDualLower->at(curRow));
-            }
-        }
-        if(m_extraDualLowerSum->at(index) != 0) {
-            impliedLB = -Numerical::Infinity;
-        }
-        if(m_extraDualUpperSum->at(index) != 0) {
-            impliedUB = Numerical::Infinity;
-        }
+        computeDualActivityBounds(index, &impliedLB, &impliedUB);
 
         const DenseVector& costVector = m_parent->getModel()->getCostVector();
 
@@ -868,6 +877,245 @@ void DualBoundsModule::executeMethod() {
     }
 }
 
+DominatedColumnModule::DominatedColumnModule(Presolver *parent) :
+    PresolverModule(parent)
+{
+    m_name = "Dominated column module";
+    m_removedNzr = 0;
+}
+
+DominatedColumnModule::~DominatedColumnModule() { }
+
+void DominatedColumnModule::printStatistics() {
+    LPINFO("[Presolver] Module " << getName() << " stats: eliminated rows - " << getRemovedConstraintCount() << ", eliminated columns - " << getRemovedVariableCount() << ", eliminated nonzeros - " << m_removedNzr);
+}
+
+void DominatedColumnModule::executeMethod() {
+    const double & feasibilityTolerance = m_parent->getFeasibilityTolerance();
+    const DenseVector & costVector = m_parent->getModel()->getCostVector();
+    int columnCount = m_parent->getModel()->variableCount();
+
+    std::vector<double> fixValues(columnCount, 0.0);
+    int fixCount = 0;
+
+    for(int index = 0; index < columnCount; index++) {
+        const Variable& curVariable = (*m_parent->getVariables())[index];
+        const auto & varLowerBound = curVariable.getLowerBound();
+        const auto & varUpperBound = curVariable.getUpperBound();
+        const SparseVector * column = curVariable.getVector();
+        if(column->nonZeros() == 0) {
+            //Empty columns are handled by the singleton columns module
+            continue;
+        }
+
+        //The reduced cost of the column lies in [c - impliedUB, c - impliedLB]
+        Numerical::Double impliedLB;
+        Numerical::Double impliedUB;
+        computeDualActivityBounds(index, &impliedLB, &impliedUB);
+        const Numerical::Double & cost = costVector.at(index);
+        Numerical::Double fixValue = 0;
+        bool fix = false;
+        if(impliedUB != Numerical::Infinity) {
+            Numerical::Double minReducedCost = Numerical::stableAdd(cost, -impliedUB);
+            //Dominated column: the reduced cost is positive in every dual feasible solution
+            //Weakly dominated column: the reduced cost is nonnegative, the variable can stay at its lower bound
+            if(minReducedCost > feasibilityTolerance ||
+               (minReducedCost >= -feasibilityTolerance && varUpperBound == Numerical::Infinity)) {
+                if(varLowerBound == -Numerical::Infinity) {
+                    if(minReducedCost > feasibilityTolerance) {
+                        throw Presolver::PresolverException("The problem is dual infeasible.");
+                        return;
+                    }
+                } else {
+                    fixValue = varLowerBound;
+                    fix = true;
+                }
+            }
+        }
+        if(!fix && impliedLB != -Numerical::Infinity) {
+            Numerical::Double maxReducedCost = Numerical::stableAdd(cost, -impliedLB);
+            if(maxReducedCost < -feasibilityTolerance ||
+               (maxReducedCost <= feasibilityTolerance && varLowerBound == -Numerical::Infinity)) {
+                if(varUpperBound == Numerical::Infinity) {
+                    if(maxReducedCost < -feasibilityTolerance) {
+                        throw Presolver::PresolverException("The problem is dual infeasible.");
+                        return;
+                    }
+                } else {
+                    fixValue = varUpperBound;
+                    fix = true;
+                }
+            }
+        }
+
+        if(fix) {
+            //Fixing to zero is denoted by infinity
+            fixValues[index] = fixValue == 0 ? Numerical::Infinity : fixValue;
+            m_removedNzr += column->nonZeros();
+            fixCount++;
+        }
+    }
+
+    if(fixCount > 0) {
+        m_parent->fixVariables(fixValues, fixCount);
+        m_removedVariables += fixCount;
+    }
+}
+
+DoubletonEquationModule::DoubletonEquationModule(Presolver *parent) :
+    PresolverModule(parent)
+{
+    m_name = "Doubleton equation module";
+    m_removedNzr = 0;
+}
+
+DoubletonEquationModule::~DoubletonEquationModule() { }
+
+void DoubletonEquationModule::printStatistics() {
+    LPINFO("[Presolver] Module " << getName() << " stats: eliminated rows - " << getRemovedConstraintCount() << ", eliminated columns - " << getRemovedVariableCount() << ", eliminated nonzeros - " << m_removedNzr);
+}
+
+void DoubletonEquationModule::executeMethod() {
+    const double & feasibilityTolerance = m_parent->getFeasibilityTolerance();
+    //The eliminated variable is chosen by fill-in, if its coefficient is not too small compared to the other one
+    const Numerical::Double pivotThreshold = 0.01;
+    Model * model = m_parent->getModel();
+    int rowCount = model->constraintCount();
+
+    std::vector<int> removedRows(rowCount, 0);
+    int removedCount = 0;
+    std::vector<std::pair<int, Numerical::Double> > substitutedRows;
+
+    for(int index = 0; index < rowCount; index++) {
+        const Constraint& curConstraint = (*m_parent->getConstraints())[index];
+        if(removedRows[index] != 0 ||
+           curConstraint.getType() != Constraint::EQUALITY ||
+           curConstraint.getVector()->nonZeros() != 2) {
+            continue;
+        }
+
+        //example: 4 = 2*x + 4*y;  x is expressed as x = 2 - 2*y
+        SparseVector::NonzeroIterator it = curConstraint.getVector()->beginNonzero();
+        int eliminatedIdx = it.getIndex();
+        Numerical::Double eliminatedCoeff = *it;
+        ++it;
+        int keptIdx = it.getIndex();
+        Numerical::Double keptCoeff = *it;
+
+        int eliminatedNonzeros = (*m_parent->getVariables())[eliminatedIdx].getVector()->nonZeros();
+        int keptNonzeros = (*m_parent->getVariables())[keptIdx].getVector()->nonZeros();
+        if((keptNonzeros < eliminatedNonzeros &&
+            Numerical::fabs(keptCoeff) >= pivotThreshold * Numerical::fabs(eliminatedCoeff)) ||
+           Numerical::fabs(eliminatedCoeff) < pivotThreshold * Numerical::fabs(keptCoeff)) {
+            std::swap(eliminatedIdx, keptIdx);
+            std::swap(eliminatedCoeff, keptCoeff);
+        }
+
+        const Numerical::Double rhs = curConstraint.getUpperBound();
+        const Numerical::Double constant = rhs / eliminatedCoeff;
+        const Numerical::Double ratio = keptCoeff / eliminatedCoeff;
+
+        //Transfer the bounds of the eliminated variable to the kept one:
+        //lower <= constant - ratio * kept <= upper
+        const Variable& eliminatedVariable = (*m_parent->getVariables())[eliminatedIdx];
+        Variable& keptVariable = (*m_parent->getVariables())[keptIdx];
+        Numerical::Double transferredLower;
+        Numerical::Double transferredUpper;
+        if(ratio > 0) {
+            transferredLower = (constant - eliminatedVariable.getUpperBound()) / ratio;
+            transferredUpper = (constant - eliminatedVariable.getLowerBound()) / ratio;
+        } else {
+            transferredLower = (constant - eliminatedVariable.getLowerBound()) / ratio;
+            transferredUpper = (constant - eliminatedVariable.getUpperBound()) / ratio;
+        }
+        Numerical::Double newLowerBound = keptVariable.getLowerBound();
+        Numerical::Double newUpperBound = keptVariable.getUpperBound();
+        if(transferredLower > newLowerBound) {
+            newLowerBound = transferredLower;
+        }
+        if(transferredUpper < newUpperBound) {
+            newUpperBound = transferredUpper;
+        }
+        if(newLowerBound - newUpperBound > feasibilityTolerance) {
+            throw Presolver::PresolverException("The problem is primal infeasible.");
+            return;
+        }
+        if(newLowerBound > newUpperBound) {
+            newUpperBound = newLowerBound;
+        }
+        bool wasBounded = keptVariable.getType() == Variable::BOUNDED;
+        keptVariable.setBounds(newLowerBound, newUpperBound);
+        if(newLowerBound > m_parent->getImpliedLower()->at(keptIdx)) {
+            m_parent->getImpliedLower()->set(keptIdx, newLowerBound);
+        }
+        if(newUpperBound < m_parent->getImpliedUpper()->at(keptIdx)) {
+            m_parent->getImpliedUpper()->set(keptIdx, newUpperBound);
+        }
+        if(!wasBounded && keptVariable.getType() == Variable::BOUNDED) {
+            m_parent->getExtraDualLowerSum()->set(keptIdx, m_parent->getExtraDualLowerSum()->at(keptIdx) + 1);
+        }
+
+        //Substitute the eliminated variable out of the other constraints
+        substitutedRows.clear();
+        SparseVector::NonzeroIterator itColumn = eliminatedVariable.getVector()->beginNonzero();
+        SparseVector::NonzeroIterator itColumnEnd = eliminatedVariable.getVector()->endNonzero();
+        for(; itColumn < itColumnEnd; ++itColumn) {
+            //The rows eliminated earlier are not updated, they are removed at the end
+            if((int)itColumn.getIndex() != index && removedRows[itColumn.getIndex()] == 0) {
+                substitutedRows.push_back(std::make_pair(itColumn.getIndex(), *itColumn));
+            }
+        }
+        for(auto rowIt = substitutedRows.begin(), rowItEnd = substitutedRows.end(); rowIt != rowItEnd; ++rowIt) {
+            int rowIdx = rowIt->first;
+            Constraint& curRow = (*m_parent->getConstraints())[rowIdx];
+            int nonzeros = curRow.getVector()->nonZeros();
+            Numerical::Double keptValue = Numerical::stableAdd(curRow.getVector()->at(keptIdx), -rowIt->second * ratio);
+            model->setMatrixElement(rowIdx, eliminatedIdx, 0);
+            model->setMatrixElement(rowIdx, keptIdx, keptValue);
+            Numerical::Double shift = rowIt->second * constant;
+            curRow.setBounds(Numerical::stableAdd(curRow.getLowerBound(), -shift),
+                             Numerical::stableAdd(curRow.getUpperBound(), -shift));
+            int curNzrDiff = nonzeros - (int)curRow.getVector()->nonZeros();
+            m_parent->getRowNonzeros()->set(rowIdx, m_parent->getRowNonzeros()->at(rowIdx) - curNzrDiff);
+            //The row lost the eliminated variable, the rest of the change is the fill-in or cancellation of the kept one
+            m_parent->getColumnNonzeros()->set(keptIdx, m_parent->getColumnNonzeros()->at(keptIdx) + 1 - curNzrDiff);
+            m_removedNzr += curNzrDiff;
+        }
+
+        //Update the cost vector
+        Numerical::Double costCoeff = m_parent->getCostCoefficient(eliminatedIdx);
+        if(costCoeff != 0) {
+            model->addToCostCoefficient(keptIdx, -costCoeff * ratio);
+            model->setCostConstant(Numerical::stableAdd(model->getCostConstant(), -costCoeff * constant));
+        }
+
+        //The substitute vector is applied to the solution without the eliminated variable
+        int varCount = model->variableCount();
+        DenseVector * substituteVector = new DenseVector(varCount + 3);
+        substituteVector->set(keptIdx < eliminatedIdx ? keptIdx : keptIdx - 1, -ratio);
+        substituteVector->set(varCount, constant);
+        substituteVector->set(varCount + 1, eliminatedIdx);
+        substituteVector->set(varCount + 2, Presolver::FIXED_VARIABLE);
+        m_parent->getSubstituteVectors()->push_back(substituteVector);
+
+        removedRows[index] = 1;
+        removedCount++;
+        m_removedConstraints++;
+        m_removedNzr += 2;
+        m_parent->getColumnNonzeros()->set(keptIdx, m_parent->getColumnNonzeros()->at(keptIdx) - 1);
+
+        model->removeVariable(eliminatedIdx);
+        m_parent->getColumnNonzeros()->remove(eliminatedIdx);
+        m_parent->getImpliedLower()->remove(eliminatedIdx);
+        m_parent->getImpliedUpper()->remove(eliminatedIdx);
+        m_parent->getExtraDualLowerSum()->remove(eliminatedIdx);
+        m_parent->getExtraDualUpperSum()->remove(eliminatedIdx);
+        m_removedVariables++;
+    }
+
+    m_parent->removeConstraints(removedRows, removedCount);
+}
+
 LinearAlgebraicModule::LinearAlgebraicModule(Presolver *parent) :
     PresolverModule(parent)
 {
@@ -15,11 +15,43 @@
 //=================================================================================================
 
 #include <lp/scaler.h>
+#include <simplex/simplexparameterhandler.h>
 #include <utils/timer.h>
+#include <utils/thread.h>
 #include <debug.h>
-#include <fstream>
 
-#include <cstdio>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/**
+ * Below this number of nonzeros the multipliers are computed on the calling thread.
+ */
+static const unsigned int PARALLEL_NONZERO_LIMIT = 100000;
+
+/**
+ * Benichou scaling stops when the variance falls below this value.
+ */
+static const Numerical::Double BENICHOU_VARIANCE_LIMIT = 2.0;
+
+/**
+ * Number of conjugate gradient iterations per scaling pass in Curtis-Reid scaling.
+ */
+static const unsigned int CURTIS_REID_ITERATIONS_PER_PASS = 10;
+
+Scaler::Scaler():
+    m_type(BENICHOU),
+    m_maxIterations(SimplexParameterHandler::getInstance().getIntegerParameterValue("Starting.Scaling.max_iterations")),
+    m_convergenceTolerance(SimplexParameterHandler::getInstance().getDoubleParameterValue("Starting.Scaling.convergence_tolerance")),
+    m_threadCount(1)
+{
+    const std::string & type = SimplexParameterHandler::getInstance().getStringParameterValue("Starting.Scaling.type");
+    if (type == "CURTIS_REID") {
+        m_type = CURTIS_REID;
+    } else if (type == "EQUILIBRATION") {
+        m_type = EQUILIBRATION;
+    }
+}
 
 const std::vector<Numerical::Double> & Scaler::getRowMultipliers() const {
     return m_rowMultipliers;
@@ -29,203 +61,383 @@ const std::vector<Numerical::Double> & Scaler::getColumnMultipliers() const {
     return m_columnMultipliers;
 }
 
+const char * Scaler::getName() const {
+    switch (m_type) {
+    case CURTIS_REID:
+        return "Curtis-Reid";
+    case EQUILIBRATION:
+        return "Equilibration";
+    default:
+        return "Benichou";
+    }
+}
+
 void Scaler::scale(Matrix *matrix, const char * name) {
+    __UNUSED(name);
     LPINFO("Scaling problem...");
 
-    m_rowMultipliers.resize( matrix->rowCount(), 1.0 );
-    m_columnMultipliers.resize( matrix->columnCount(), 1.0 );
+    m_rowMultipliers.assign( matrix->rowCount(), 1.0 );
+    m_columnMultipliers.assign( matrix->columnCount(), 1.0 );
+
+    m_threadCount = 1;
+    if (matrix->nonZeros() >= PARALLEL_NONZERO_LIMIT) {
+        int threads = SimplexParameterHandler::getInstance().getIntegerParameterValue("Starting.Scaling.number_of_threads");
+        if (threads <= 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        m_threadCount = threads > 0 ? threads : 1;
+    }
 
     Timer timer;
     timer.start();
-    benichou(matrix, name);
-
+    switch (m_type) {
+    case CURTIS_REID:
+        curtisReid(*matrix);
+        break;
+    case EQUILIBRATION:
+        equilibration(*matrix);
+        break;
+    default:
+        benichou(*matrix);
+        break;
+    }
+    applyMultipliers(matrix);
     timer.stop();
 
-    //    LPINFO("Variance: " << variance);
 #ifndef NDEBUG
-    LPINFO("Time: " << timer.getCPULastElapsed());
+    LPINFO("Time: " << timer.getLastElapsed());
 #endif
 }
 
-void Scaler::benichou(Matrix * matrix, const char *name) {
-    __UNUSED(name);
-    const unsigned int nonZeros = matrix->nonZeros();
-    const unsigned int rowCount = matrix->rowCount();
-    const unsigned int columnCount = matrix->columnCount();
-    std::vector<Numerical::Double> rowMultipliers;
-    std::vector<Numerical::Double> columnMultipliers;
-    rowMultipliers.resize(rowCount, 1);
-    columnMultipliers.resize(columnCount, 1);
-
-    unsigned int stepCount = 0;
-    Numerical::Double variance;
-    variance = getVarianceBenichou(matrix, &rowMultipliers);
-    std::vector<Numerical::Double> variances;
-    variances.push_back(variance);
+void Scaler::benichou(const Matrix & matrix) {
+    Numerical::Double variance = getVariance(matrix);
 #ifndef NDEBUG
     LPINFO("Variance: " << variance);
 #endif
 
-    //std::ofstream ofs("benichou.csv", std::ios_base::app);
-    //ofs << name << ";";
+    unsigned int stepCount = 0;
+    while (variance > BENICHOU_VARIANCE_LIMIT && stepCount < m_maxIterations) {
+        geometricRowPass(matrix);
+        geometricColumnPass(matrix);
 
-    Timer timer;
-    timer.start();
+        const Numerical::Double newVariance = getVariance(matrix);
+#ifndef NDEBUG
+        LPINFO("Variance: " << newVariance);
+#endif
+        stepCount++;
+        const bool converged = variance - newVariance < m_convergenceTolerance * variance;
+        variance = newVariance;
+        if (converged) {
+            break;
+        }
+    }
 
+    equilibration(matrix);
+#ifndef NDEBUG
+    LPINFO("Variance: " << getVariance(matrix));
+#endif
+}
 
-    // matrix->show();
-    unsigned int index;
-    while (variance > 2 && stepCount < 5) {
-        Numerical::Double absSum = 0;
-        Numerical::Double squareSum = 0;
-        Numerical::Double squareTemp;
-        Numerical::Double min;
-        Numerical::Double max;
-
-        // rowwise
-        for (index = 0; index < rowCount; index++) {
-            matrix->scaleRowAndGetResults(index, columnMultipliers,
-                                          rowMultipliers[index],
-                                          &squareTemp, &min, &max);
-            m_rowMultipliers[index] *= rowMultipliers[index];
+void Scaler::curtisReid(const Matrix & matrix) {
+    const unsigned int rowCount = matrix.rowCount();
+    const unsigned int columnCount = matrix.columnCount();
+
+    // Normal equations of min sum (log2|a_ij| + rho_i + gamma_j)^2:
+    //   n_i * rho_i + sum_j gamma_j = -sum_j log2|a_ij|   (row i)
+    //   m_j * gamma_j + sum_i rho_i = -sum_i log2|a_ij|   (column j)
+    std::vector<double> rowX(rowCount, 0.0), columnX(columnCount, 0.0);
+    std::vector<double> rowR(rowCount), columnR(columnCount);
+    std::vector<double> rowZ(rowCount), columnZ(columnCount);
+    std::vector<double> rowP(rowCount), columnP(columnCount);
+    std::vector<double> rowQ(rowCount), columnQ(columnCount);
+
+    parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            double sum = 0.0;
+            SparseVector::NonzeroIterator iter = matrix.row(index).beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = matrix.row(index).endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                sum += std::log2(Numerical::fabs(*iter));
+            }
+            rowR[index] = -sum;
         }
-        for (index = 0; index < columnCount; index++) {
-            if (matrix->column(index).nonZeros() == 0) {
-                columnMultipliers[index] = 1.0;
-                continue;
+    });
+    parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            double sum = 0.0;
+            SparseVector::NonzeroIterator iter = matrix.column(index).beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = matrix.column(index).endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                sum += std::log2(Numerical::fabs(*iter));
             }
-            matrix->scaleColumnAndGetResults(index, rowMultipliers,
-                                             1,
-                                             &squareTemp, &min, &max);
-            columnMultipliers[index] = roundPowerOf2(1.0 / Numerical::sqrt(min * max));
-
+            columnR[index] = -sum;
         }
-
-        for (index = 0; index < rowCount; index++) {
-            rowMultipliers[index] = 1;
+    });
+
+    // Jacobi preconditioner, the diagonal holds the nonzero counts
+    auto precondition = [&]() {
+        parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                const unsigned int nonZeros = matrix.row(index).nonZeros();
+                rowZ[index] = nonZeros > 0 ? rowR[index] / nonZeros : 0.0;
+            }
+        });
+        parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                const unsigned int nonZeros = matrix.column(index).nonZeros();
+                columnZ[index] = nonZeros > 0 ? columnR[index] / nonZeros : 0.0;
+            }
+        });
+    };
+
+    std::vector<double> partialSums(std::max(m_threadCount, 1u));
+    auto dotProduct = [&](const std::vector<double> & rowA, const std::vector<double> & columnA,
+            const std::vector<double> & rowB, const std::vector<double> & columnB) {
+        double result = 0.0;
+        unsigned int chunks = parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int chunk) {
+            double sum = 0.0;
+            for (unsigned int index = begin; index < end; index++) {
+                sum += rowA[index] * rowB[index];
+            }
+            partialSums[chunk] = sum;
+        });
+        for (unsigned int chunk = 0; chunk < chunks; chunk++) {
+            result += partialSums[chunk];
         }
-
-        // columnwise
-        for (index = 0; index < columnCount; index++) {
-            matrix->scaleColumnAndGetResults(index, rowMultipliers,
-                                             columnMultipliers[index],
-                                             &squareTemp, &min, &max);
-            m_columnMultipliers[index] *= columnMultipliers[index];
+        chunks = parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int chunk) {
+            double sum = 0.0;
+            for (unsigned int index = begin; index < end; index++) {
+                sum += columnA[index] * columnB[index];
+            }
+            partialSums[chunk] = sum;
+        });
+        for (unsigned int chunk = 0; chunk < chunks; chunk++) {
+            result += partialSums[chunk];
         }
-
-        for (index = 0; index < rowCount; index++) {
-            if (matrix->row(index).nonZeros() == 0) {
-                rowMultipliers[index] = 1.0;
-                continue;
+        return result;
+    };
+
+    precondition();
+    rowP = rowZ;
+    columnP = columnZ;
+    double rz = dotProduct(rowR, columnR, rowZ, columnZ);
+    const double initialRz = rz;
+    const double tolerance = m_convergenceTolerance * m_convergenceTolerance * initialRz;
+
+    const unsigned int maxIterations = m_maxIterations * CURTIS_REID_ITERATIONS_PER_PASS;
+    unsigned int iteration = 0;
+    while (rz > tolerance && iteration < maxIterations) {
+        parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                const SparseVector & row = matrix.row(index);
+                double sum = row.nonZeros() * rowP[index];
+                SparseVector::NonzeroIterator iter = row.beginNonzero();
+                SparseVector::NonzeroIterator iterEnd = row.endNonzero();
+                for (; iter != iterEnd; ++iter) {
+                    sum += columnP[iter.getIndex()];
+                }
+                rowQ[index] = sum;
             }
-            absSum += matrix->scaleRowAndGetResults(index, columnMultipliers,
-                                                    1,
-                                                    &squareTemp, &min, &max);
-            squareSum += squareTemp;
-
-            rowMultipliers[index] = roundPowerOf2(1.0 / Numerical::sqrt(min * max));
+        });
+        parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                const SparseVector & column = matrix.column(index);
+                double sum = column.nonZeros() * columnP[index];
+                SparseVector::NonzeroIterator iter = column.beginNonzero();
+                SparseVector::NonzeroIterator iterEnd = column.endNonzero();
+                for (; iter != iterEnd; ++iter) {
+                    sum += rowP[iter.getIndex()];
+                }
+                columnQ[index] = sum;
+            }
+        });
 
+        const double pq = dotProduct(rowP, columnP, rowQ, columnQ);
+        if (pq <= 0.0) {
+            break;
         }
-        for (index = 0; index < columnCount; index++) {
-            columnMultipliers[index] = 1;
-        }
-        variance = (squareSum - (absSum * absSum) / nonZeros) / nonZeros;
-        variances.push_back(variance);
+        const double alpha = rz / pq;
+        parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                rowX[index] += alpha * rowP[index];
+                rowR[index] -= alpha * rowQ[index];
+            }
+        });
+        parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                columnX[index] += alpha * columnP[index];
+                columnR[index] -= alpha * columnQ[index];
+            }
+        });
+
+        precondition();
+        const double newRz = dotProduct(rowR, columnR, rowZ, columnZ);
+        const double beta = newRz / rz;
+        rz = newRz;
+        parallelFor(rowCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                rowP[index] = rowZ[index] + beta * rowP[index];
+            }
+        });
+        parallelFor(columnCount, [&](unsigned int begin, unsigned int end, unsigned int) {
+            for (unsigned int index = begin; index < end; index++) {
+                columnP[index] = columnZ[index] + beta * columnP[index];
+            }
+        });
+        iteration++;
+    }
 #ifndef NDEBUG
-        LPINFO("Variance: " << variance);
+    LPINFO("Curtis-Reid iterations: " << iteration);
 #endif
-        stepCount++;
-    }
 
-    for (index = 0; index < rowCount; index++) {
-        if (matrix->row(index).nonZeros() == 0) {
-            rowMultipliers[index] = 1.0;
-            continue;
-        }
-        Numerical::Double multiplier = roundPowerOf2(1.0 / matrix->row(index).absMaxElement());
-        rowMultipliers[index] = multiplier;
-        matrix->scaleOnlyRowwise(index, multiplier);
-        m_rowMultipliers[index] *= multiplier;
+    for (unsigned int index = 0; index < rowCount; index++) {
+        m_rowMultipliers[index] = std::ldexp(1.0, (int)std::floor(rowX[index] + 0.5));
     }
-    for (index = 0; index < columnCount; index++) {
-        if (matrix->column(index).nonZeros() == 0) {
-            columnMultipliers[index] = 1.0;
-            continue;
-        }
-        matrix->scaleOnlyColumnwiseLambdas(index, rowMultipliers);
-        Numerical::Double multiplier = roundPowerOf2(1.0 / matrix->column(index).absMaxElement());
-        columnMultipliers[index] = multiplier;
-        matrix->scaleOnlyColumnwise(index, multiplier);
-        m_columnMultipliers[index] *= multiplier;
-    }
-    for (index = 0; index < rowCount; index++) {
-        matrix->scaleOnlyRowwiseLambdas(index, columnMultipliers);
+    for (unsigned int index = 0; index < columnCount; index++) {
+        m_columnMultipliers[index] = std::ldexp(1.0, (int)std::floor(columnX[index] + 0.5));
     }
+}
 
-    variance = getVarianceBenichou(matrix, &rowMultipliers);
-    variances.push_back(variance);
-#ifndef NDEBUG
-    LPINFO("Variance: " << variance);
-#endif
-
-    // ez nem igazan segit, majd ha lesz steepest edge meg devex, akkor ujra
-    // meg kell nezni
-    /*for (index = 0; index < rowCount; index++) {
-        rowMultipliers[index] = roundPowerOf2(1.0 + (rand() % 100000000) /    100000000000.0);
-        matrix->scaleOnlyRowwise(index, rowMultipliers[index]);
-        m_rowMultipliers[index] *= rowMultipliers[index];
-        //LPINFO(rowMultipliers[index]);
-    }
-    for (index = 0; index < columnCount; index++) {
-        matrix->scaleOnlyColumnwiseLambdas(index, rowMultipliers);
-        columnMultipliers[index] = roundPowerOf2(1.0 + (rand() % 100000000) / 100000000000.0);
-        matrix->scaleOnlyColumnwise(index, columnMultipliers[index]);
-        m_columnMultipliers[index] *= columnMultipliers[index];
+void Scaler::equilibration(const Matrix & matrix) {
+    parallelFor(matrix.rowCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            const SparseVector & row = matrix.row(index);
+            Numerical::Double max = 0;
+            SparseVector::NonzeroIterator iter = row.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = row.endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const Numerical::Double absValue = Numerical::fabs(*iter) * m_columnMultipliers[iter.getIndex()];
+                if (max < absValue) {
+                    max = absValue;
+                }
+            }
+            if (max > 0) {
+                m_rowMultipliers[index] = roundPowerOf2(1.0 / max);
+            }
+        }
+    });
+    parallelFor(matrix.columnCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            const SparseVector & column = matrix.column(index);
+            Numerical::Double max = 0;
+            SparseVector::NonzeroIterator iter = column.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = column.endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const Numerical::Double absValue = Numerical::fabs(*iter) * m_rowMultipliers[iter.getIndex()];
+                if (max < absValue) {
+                    max = absValue;
+                }
+            }
+            if (max > 0) {
+                m_columnMultipliers[index] = roundPowerOf2(1.0 / max);
+            }
+        }
+    });
+}
 
-    }
-    for (index = 0; index < rowCount; index++) {
-        matrix->scaleOnlyRowwiseLambdas(index, columnMultipliers);
-    }*/
+void Scaler::geometricRowPass(const Matrix & matrix) {
+    parallelFor(matrix.rowCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            const SparseVector & row = matrix.row(index);
+            if (row.nonZeros() == 0) {
+                m_rowMultipliers[index] = 1.0;
+                continue;
+            }
+            Numerical::Double min = Numerical::Infinity;
+            Numerical::Double max = 0;
+            SparseVector::NonzeroIterator iter = row.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = row.endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const Numerical::Double absValue = Numerical::fabs(*iter) * m_columnMultipliers[iter.getIndex()];
+                if (min > absValue) {
+                    min = absValue;
+                }
+                if (max < absValue) {
+                    max = absValue;
+                }
+            }
+            m_rowMultipliers[index] = roundPowerOf2(1.0 / Numerical::sqrt(min * max));
+        }
+    });
+}
 
-    variance = getVarianceBenichou(matrix, &rowMultipliers);
-    variances.push_back(variance);
-#ifndef NDEBUG
-    LPINFO("Variance: " << variance);
-#endif
+void Scaler::geometricColumnPass(const Matrix & matrix) {
+    parallelFor(matrix.columnCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            const SparseVector & column = matrix.column(index);
+            if (column.nonZeros() == 0) {
+                m_columnMultipliers[index] = 1.0;
+                continue;
+            }
+            Numerical::Double min = Numerical::Infinity;
+            Numerical::Double max = 0;
+            SparseVector::NonzeroIterator iter = column.beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = column.endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const Numerical::Double absValue = Numerical::fabs(*iter) * m_rowMultipliers[iter.getIndex()];
+                if (min > absValue) {
+                    min = absValue;
+                }
+                if (max < absValue) {
+                    max = absValue;
+                }
+            }
+            m_columnMultipliers[index] = roundPowerOf2(1.0 / Numerical::sqrt(min * max));
+        }
+    });
+}
 
-    timer.stop();
-    /*ofs << timer.getCPULastElapsed() << ";" << variances.size() << ";";
-    for (index = 0; index < variances.size(); index++) {
-        ofs << variances[index] << ";";
+Numerical::Double Scaler::getVariance(const Matrix & matrix) const {
+    const unsigned int nonZeros = matrix.nonZeros();
+    if (nonZeros == 0) {
+        return 0;
     }
-    ofs << std::endl;
-    ofs.close();*/
-    // matrix->show();
-}
+    std::vector<Numerical::Double> absSums(m_threadCount);
+    std::vector<Numerical::Double> squareSums(m_threadCount);
+    const unsigned int chunks = parallelFor(matrix.rowCount(),
+                                            [&](unsigned int begin, unsigned int end, unsigned int chunk) {
+        Numerical::Double absSum = 0;
+        Numerical::Double squareSum = 0;
+        for (unsigned int index = begin; index < end; index++) {
+            const Numerical::Double rowMultiplier = m_rowMultipliers[index];
+            SparseVector::NonzeroIterator iter = matrix.row(index).beginNonzero();
+            SparseVector::NonzeroIterator iterEnd = matrix.row(index).endNonzero();
+            for (; iter != iterEnd; ++iter) {
+                const Numerical::Double absValue = Numerical::fabs(*iter) *
+                        rowMultiplier * m_columnMultipliers[iter.getIndex()];
+                absSum += absValue;
+                squareSum += absValue * absValue;
+            }
+        }
+        absSums[chunk] = absSum;
+        squareSums[chunk] = squareSum;
+    });
 
-Numerical::Double Scaler::getVarianceBenichou(Matrix * matrix,
-                                              std::vector<Numerical::Double> * rowMultpiliersPtr) {
-    unsigned int index;
     Numerical::Double absSum = 0;
     Numerical::Double squareSum = 0;
-    Numerical::Double squareTemp;
-    Numerical::Double min;
-    Numerical::Double max;
-
-    const unsigned int nonZeros = matrix->nonZeros();
-    const unsigned int rowCount = matrix->rowCount();
+    for (unsigned int chunk = 0; chunk < chunks; chunk++) {
+        absSum += absSums[chunk];
+        squareSum += squareSums[chunk];
+    }
+    return (squareSum - (absSum * absSum) / nonZeros) / nonZeros;
+}
 
-    for (index = 0; index < rowCount; index++) {
-        if (matrix->row(index).nonZeros() == 0) {
-            (*rowMultpiliersPtr)[index] = 1.0;
-            continue;
+void Scaler::applyMultipliers(Matrix * matrix) const {
+    parallelFor(matrix->rowCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            matrix->scaleOnlyRowwiseLambdas(index, m_columnMultipliers, m_rowMultipliers[index]);
+        }
+    });
+    parallelFor(matrix->columnCount(), [&](unsigned int begin, unsigned int end, unsigned int) {
+        for (unsigned int index = begin; index < end; index++) {
+            matrix->scaleOnlyColumnwiseLambdas(index, m_rowMultipliers, m_columnMultipliers[index]);
         }
-        absSum += matrix->row(index).absMaxSumsAndMinMax(&squareTemp, &min, &max);
-        (*rowMultpiliersPtr)[index] = roundPowerOf2(1.0 / Numerical::sqrt(min * max));
+    });
+}
 
-        squareSum += squareTemp;
-    }
-    return (squareSum - (absSum * absSum) / nonZeros) / nonZeros;
+unsigned int Scaler::parallelFor(unsigned int count,
+                                 const std::function<void(unsigned int, unsigned int, unsigned int)> & function) const {
+    return ThreadSupervisor::parallelFor(m_threadCount, count, function);
 }
 
 Numerical::Double Scaler::roundPowerOf2(Numerical::Double value) const {
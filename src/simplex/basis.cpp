@@ -22,11 +22,13 @@
 #include <simplex/simplexmodel.h>
 #include <simplex/simplexparameterhandler.h>
 #include <fstream>
+#include <algorithm>
 
 thread_local const SimplexModel* Basis::m_model = nullptr;
 thread_local std::vector<int>* Basis::m_basisHead = nullptr;
 thread_local IndexList<const Numerical::Double*>* Basis::m_variableStates = nullptr;
 thread_local const DenseVector* Basis::m_basicVariableValues = nullptr;
+thread_local std::vector<SparseVector*>* Basis::m_etaPool = nullptr;
 
 int etaExpSum = 0;
 double etaExpSquareSum = 0;
@@ -100,6 +102,95 @@ void Basis::setNewHead() {
 SparseVector* Basis::createEta(const SparseVector& vector, int pivotPosition)
 {
     SparseVector* eta = new SparseVector(vector.length());
+    computeEta(eta, vector, pivotPosition);
+    return eta;
+}
+
+SparseVector* Basis::createUpdateEta(const SparseVector& vector, int pivotPosition)
+{
+    std::vector<SparseVector*> * etaPool = m_etaPool;
+    if (etaPool == nullptr || etaPool->empty()) {
+        return createEta(vector, pivotPosition);
+    }
+    //Best fit: the smallest released eta which is large enough, or the largest one
+    const unsigned int capacity = vector.nonZeros() + SparseVector::sm_elbowRoom;
+    unsigned int selected = 0;
+    unsigned int index;
+    for (index = 1; index < etaPool->size(); index++) {
+        const unsigned int candidateCapacity = (*etaPool)[index]->m_capacity;
+        const unsigned int selectedCapacity = (*etaPool)[selected]->m_capacity;
+        if (selectedCapacity < capacity ? candidateCapacity > selectedCapacity :
+                (candidateCapacity >= capacity && candidateCapacity < selectedCapacity)) {
+            selected = index;
+        }
+    }
+    SparseVector* eta = (*etaPool)[selected];
+    (*etaPool)[selected] = etaPool->back();
+    etaPool->pop_back();
+    if (eta->m_capacity < capacity) {
+        //The capacity grows geometrically and leaves room for the denser etas of the later cycles,
+        //so the pool adapts to the updates in a few cycles
+        eta->prepareForData(std::min(2 * std::max(vector.nonZeros(), eta->m_capacity), vector.length()),
+                            vector.length());
+    }
+    try {
+        computeEta(eta, vector, pivotPosition);
+    } catch (const NumericalException &) {
+        etaPool->push_back(eta);
+        throw;
+    }
+    return eta;
+}
+
+void Basis::releaseUpdateEta(SparseVector* eta)
+{
+    if (m_etaPool == nullptr) {
+        m_etaPool = new std::vector<SparseVector*>();
+        m_etaPool->reserve(SimplexParameterHandler::getInstance().getIntegerParameterValue("Factorization.reinversion_frequency"));
+    }
+    m_etaPool->push_back(eta);
+}
+
+void Basis::reserveUpdateEtas()
+{
+    const unsigned int updateCount = SimplexParameterHandler::getInstance().getIntegerParameterValue("Factorization.reinversion_frequency");
+    if (m_etaPool == nullptr) {
+        m_etaPool = new std::vector<SparseVector*>();
+        m_etaPool->reserve(updateCount);
+    }
+    //Every eta gets twice the capacity of the densest eta of the previous cycle, so the etas of
+    //the next cycle fit even if the basis becomes denser, and the reallocations are done here
+    //instead of the iterations
+    const unsigned int length = m_basisHead->size();
+    unsigned int nonZeros = 0;
+    for (const SparseVector* eta: *m_etaPool) {
+        nonZeros = std::max(nonZeros, eta->nonZeros());
+    }
+    nonZeros = std::min(2 * nonZeros, length);
+    for (SparseVector* eta: *m_etaPool) {
+        eta->prepareForData(nonZeros, length);
+    }
+    while (m_etaPool->size() < updateCount) {
+        SparseVector* eta = new SparseVector(length);
+        eta->prepareForData(nonZeros, length);
+        m_etaPool->push_back(eta);
+    }
+}
+
+void Basis::releaseEtaPool()
+{
+    if (m_etaPool == nullptr) {
+        return;
+    }
+    for (SparseVector* eta: *m_etaPool) {
+        delete eta;
+    }
+    delete m_etaPool;
+    m_etaPool = nullptr;
+}
+
+void Basis::computeEta(SparseVector* eta, const SparseVector& vector, int pivotPosition)
+{
     eta->prepareForData(vector.nonZeros(), vector.length());
     //TODO Ezt vajon lehet gyorsabban?
     Numerical::Double atPivot = vector.at(pivotPosition);
@@ -128,7 +219,6 @@ SparseVector* Basis::createEta(const SparseVector& vector, int pivotPosition)
             }
         }
         DEVINFO(D::PFIMAKER, "Eta vector created with pivot " << pivotPosition);
-        return eta;
     }
 }
 
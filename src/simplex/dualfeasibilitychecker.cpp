@@ -23,6 +23,7 @@
 #include <simplex/simplex.h>
 #include <simplex/simplexparameterhandler.h>
 #include <simplex/pfibasis.h>
+#include <utils/profiler.h>
 
 DualFeasibilityChecker::DualFeasibilityChecker(const SimplexModel& model,
                                                IndexList<const Numerical::Double *> *variableStates,
@@ -39,6 +40,7 @@ DualFeasibilityChecker::DualFeasibilityChecker(const SimplexModel& model,
 }
 
 bool DualFeasibilityChecker::computeFeasibility(Numerical::Double tolerance){
+    PROFILE_ZONE("Feasibility check");
 //this function determines M/F/P sets, phase I objective function value
     m_reducedCostFeasibilities->clearPartition(Simplex::FEASIBLE);
     m_reducedCostFeasibilities->clearPartition(Simplex::MINUS);
@@ -80,6 +82,7 @@ bool DualFeasibilityChecker::computeFeasibility(Numerical::Double tolerance){
 }
 
 void DualFeasibilityChecker::feasibilityCorrection(DenseVector* basicVariableValues, Numerical::Double tolerance) {
+    PROFILE_ZONE("Feasibility correction");
     unsigned int rowCount = m_model.getRowCount();
     unsigned int columnCount = m_model.getColumnCount();
 
@@ -128,6 +131,7 @@ void DualFeasibilityChecker::feasibilityCorrection(DenseVector* basicVariableVal
 bool DualFeasibilityChecker::updateFeasibilities(const std::vector<std::pair<int, char> > &updateFeasibilitySets,
                                                  const std::vector<int>& becomesFeasible)
 {
+    PROFILE_ZONE("Feasibility update");
     //TODO: reservek koknstruktorbol
     LPINFO("UPDATE FEASIBILITIES");
     for (unsigned int index = 0; index < updateFeasibilitySets.size(); index++) {
@@ -28,13 +28,15 @@ DualPricing::DualPricing(const DenseVector &basicVariableValues,
                          const IndexList<> & reducedCostFeasibilities,
                          const std::vector<int> & basisHead,
                          const SimplexModel & simplexModel,
-                         const Basis & basis):
+                         const Basis & basis,
+                         ScratchBuffers & scratchBuffers):
     m_basicVariableValues(basicVariableValues),
     m_basicVariableFeasibilities(basicVariableFeasibilities),
     m_reducedCostFeasibilities(reducedCostFeasibilities),
     m_basisHead(basisHead),
     m_simplexModel(simplexModel),
     m_basis(basis),
+    m_scratchBuffers(scratchBuffers),
     m_reducedCost(0.0),
     m_primalInfeasibility(0),
     m_feasibilityTolerance(SimplexParameterHandler::getInstance().getDoubleParameterValue("Tolerances.e_feasibility")),
@@ -149,7 +151,8 @@ void DualPricing::initPhase1() {
 //        nonzeros += m_phase1ReducedCosts[index] != 0.0;
 //    }
 
-    DenseVector temp(matrix.rowCount());
+    DenseVector & temp = m_scratchBuffers.getDenseVector(ScratchBuffers::PRICING_PHASE1_AUXILIARY,
+                                                         matrix.rowCount());
     for (index = 0; index < matrix.rowCount(); index++) {
         temp.set(index, m_phase1ReducedCostSummarizers[index].getResult(true, false));
     }
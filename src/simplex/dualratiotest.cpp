@@ -21,6 +21,7 @@
 #include <simplex/dualratiotest.h>
 #include <simplex/simplexparameterhandler.h>
 #include <simplex/simplex.h>
+#include <utils/profiler.h>
 #include <random>
 #define LPINOF LPINFO
 
@@ -74,6 +75,7 @@ DualRatiotest::DualRatiotest(const SimplexModel & model,
 
 void DualRatiotest::generateSignedBreakpointsPhase1(const DenseVector& alpha)
 {
+    PROFILE_ZONE("Breakpoint generation");
     //computing ratios
     IndexList<>::PartitionIterator it;
     IndexList<>::PartitionIterator endit;
@@ -483,6 +485,7 @@ void DualRatiotest::performRatiotestPhase1(const DenseVector& alpha,
 
 void DualRatiotest::generateSignedBreakpointsPhase2(const DenseVector &alpha)
 {
+    PROFILE_ZONE("Breakpoint generation");
     //computing ratios
     auto it = m_variableStates.getPartitionIterator();
     auto endit = m_variableStates.getPartitionIterator();
@@ -536,6 +539,7 @@ void DualRatiotest::generateSignedBreakpointsPhase2(const DenseVector &alpha)
 void DualRatiotest::generateExpandedBreakpointsPhase2(const DenseVector &alpha,
                                                       Numerical::Double workingTolerance)
 {
+    PROFILE_ZONE("Breakpoint generation");
     //computing ratios
     auto it = m_variableStates.getPartitionIterator();
     auto endit = m_variableStates.getPartitionIterator();
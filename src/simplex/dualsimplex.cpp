@@ -26,9 +26,11 @@
 #include <simplex/pricing/dualdevexpricing.h>
 #include <simplex/pricing/dualsteepestedgepricing.h>
 #include <simplex/simplexcontroller.h>
+#include <simplex/simplexengine.h>
 
 #include <simplex/simplexparameterhandler.h>
 #include <simplex/numericalmonitor.h>
+#include <utils/profiler.h>
 
 const static char * INCOMING_NAME = "Incoming";
 const static char * OUTGOING_NAME = "Outgoing";
@@ -60,6 +62,7 @@ DualSimplex::DualSimplex(Basis *basis):
     m_askForAnotherRowCounter(0)
 {
     //m_dualTheta.setDebugMode(true);
+    m_pivotRowOfBasisInverse.setNonzeroTracking(true);
 }
 
 DualSimplex::~DualSimplex()
@@ -256,6 +259,7 @@ Entry DualSimplex::getIterationEntry(const string &name, ITERATION_REPORT_FIELD_
 }
 
 void DualSimplex::computeFeasibility() {
+    PROFILE_ZONE("Dual feasibility");
     if(m_feasibilityChecker == nullptr){
         m_feasibilityChecker = new DualFeasibilityChecker(*m_simplexModel,
                                                           &m_variableStates,
@@ -290,49 +294,76 @@ void DualSimplex::computeFeasibility() {
     }
 }
 
+template <class PRICING>
+void DualSimplex::createPricing() {
+    m_pricing = new PRICING (m_basicVariableValues,
+                             &m_basicVariableFeasibilities,
+                             m_reducedCostFeasibilities,
+                             m_basisHead,
+                             *m_simplexModel,
+                             *m_basis,
+                             m_scratchBuffers);
+    Simplex::m_pricing = m_pricing;
+}
+
+template <>
+void DualSimplex::createPricing<DualDantzigPricing>() {
+    m_pricing = new DualDantzigPricing (m_basicVariableValues,
+                                        &m_basicVariableFeasibilities,
+                                        m_reducedCostFeasibilities,
+                                        m_basisHead,
+                                        *m_simplexModel,
+                                        *m_basis,
+                                        m_scratchBuffers,
+                                        false); // TODO: kell-e shadow steepest edge vagy sem?
+    Simplex::m_pricing = m_pricing;
+}
+
+template <>
+void DualSimplex::createPricing<DualPricing>() {
+    std::string pricingType = SimplexParameterHandler::getInstance().getStringParameterValue("Pricing.type");
+
+    if (pricingType == "DANTZIG") {
+        createPricing<DualDantzigPricing>();
+    }
+    if (pricingType == "DEVEX") {
+        createPricing<DualDevexPricing>();
+    }
+    if (pricingType == "STEEPEST_EDGE") {
+        createPricing<DualSteepestEdgePricing>();
+    }
+}
+
 void DualSimplex::price() {
-    if(m_pricing == nullptr){
-        std::string pricingType = SimplexParameterHandler::getInstance().getStringParameterValue("Pricing.type");
+    priceImpl<Basis, DualPricing>();
+}
 
-        if (pricingType == "DANTZIG") {
-            m_pricing = new DualDantzigPricing (m_basicVariableValues,
-                                                &m_basicVariableFeasibilities,
-                                                m_reducedCostFeasibilities,
-                                                m_basisHead,
-                                                *m_simplexModel,
-                                                *m_basis,
-                                                false); // TODO: kell-e shadow steepest edge vagy sem?
+void DualSimplex::selectPivot() {
+    selectPivotImpl<Basis, DualPricing>();
+}
 
-        }
-        if (pricingType == "DEVEX") {
-            m_pricing = new DualDevexPricing (m_basicVariableValues,
-                                              &m_basicVariableFeasibilities,
-                                              m_reducedCostFeasibilities,
-                                              m_basisHead,
-                                              *m_simplexModel,
-                                              *m_basis);
-        }
-        if (pricingType == "STEEPEST_EDGE") {
-            m_pricing = new DualSteepestEdgePricing (m_basicVariableValues,
-                                                     &m_basicVariableFeasibilities,
-                                                     m_reducedCostFeasibilities,
-                                                     m_basisHead,
-                                                     *m_simplexModel,
-                                                     *m_basis);
-        }
+void DualSimplex::update() {
+    updateImpl<Basis, DualPricing>();
+}
 
-        Simplex::m_pricing = m_pricing;
+template <class BASIS, class PRICING>
+void DualSimplex::priceImpl() {
+    PROFILE_ZONE("Dual price");
+    if(m_pricing == nullptr){
+        createPricing<PRICING>();
     }
+    PRICING * pricing = static_cast<PRICING *>(m_pricing);
 
+    PROFILE_ZONE("Pricing scan");
     if(!m_feasible){
-        m_outgoingIndex = m_pricing->performPricingPhase1();
+        m_outgoingIndex = pricing->performPricingPhase1();
         if(m_outgoingIndex == -1){
             throw DualInfeasibleException("The problem is DUAL INFEASIBLE!");
         }
     } else {
-        m_outgoingIndex = m_pricing->performPricingPhase2();
+        m_outgoingIndex = pricing->performPricingPhase2();
         if(m_outgoingIndex == -1){
-            if(m_pricing->hasLockedVariable()){
+            if(pricing->hasLockedVariable()){
                 throw DualUnboundedException("The problem is DUAL UNBOUNDED!");
             }else{
                 throw OptimalException("OPTIMAL SOLUTION found!");
@@ -341,7 +372,9 @@ void DualSimplex::price() {
     }
 }
 
-void DualSimplex::selectPivot() {
+template <class BASIS, class PRICING>
+void DualSimplex::selectPivotImpl() {
+    PROFILE_ZONE("Dual select pivot");
     if(m_ratiotest == nullptr){
         m_ratiotest = new DualRatiotest(*m_simplexModel,
                                         m_reducedCosts,
@@ -351,9 +384,9 @@ void DualSimplex::selectPivot() {
 
     m_incomingIndex = -1;
     while(m_incomingIndex == -1 ){
-        computeTransformedRow();
+        computeTransformedRowImpl<BASIS>();
         if(!m_feasible){
-            Numerical::Double reducedCost = m_pricing->getReducedCost();
+            Numerical::Double reducedCost = static_cast<PRICING *>(m_pricing)->getReducedCost();
             m_ratiotest->performRatiotestPhase1(m_pivotRow, reducedCost, m_phaseIObjectiveValue);
         } else {
             m_ratiotest->performRatiotestPhase2(m_basisHead[m_outgoingIndex], m_pivotRow, m_workingTolerance);
@@ -371,8 +404,8 @@ void DualSimplex::selectPivot() {
             LPERROR("Ask for another row, row is unstable: "<<m_outgoingIndex);
 #endif
             m_askForAnotherRowCounter ++;
-            m_pricing->lockLastIndex();
-            price();
+            static_cast<PRICING *>(m_pricing)->lockLastIndex();
+            priceImpl<BASIS, PRICING>();
         }
     }
     m_dualTheta = m_ratiotest->getDualSteplength();
@@ -391,7 +424,10 @@ void DualSimplex::selectPivot() {
 
 }
 
-void DualSimplex::update() {
+template <class BASIS, class PRICING>
+void DualSimplex::updateImpl() {
+    PROFILE_ZONE("Dual update");
+    const BASIS * basis = static_cast<const BASIS *>(m_basis);
     unsigned int rowCount = m_simplexModel->getRowCount();
     unsigned int columnCount = m_simplexModel->getColumnCount();
     bool secondPhase = m_feasible;
@@ -402,14 +438,14 @@ void DualSimplex::update() {
 
         for(; it < itend; ++it){
             //                LPWARNING("BOUNDFLIPPING at: "<<*it);
-            DenseVector alpha(rowCount);
+            DenseVector & alpha = m_scratchBuffers.getDenseVector(ScratchBuffers::BOUNDFLIP_COLUMN, rowCount);
             if(*it < columnCount){
                 alpha = m_simplexModel->getMatrix().column(*it);
             } else {
                 alpha.set(*it - columnCount, 1);
             }
 
-            m_basis->Ftran(alpha);
+            basis->Ftran(alpha);
 
             const Variable& variable = m_simplexModel->getVariable(*it);
             //Alpha is not available, since we are in the dual
@@ -443,7 +479,7 @@ void DualSimplex::update() {
         }
 
 
-        m_basis->Ftran(m_pivotColumn);
+        basis->Ftran(m_pivotColumn);
 
 
         //Log the outgoing variable information
@@ -523,9 +559,9 @@ void DualSimplex::update() {
         //Do some updates before the basis change
         //Update the pricing
 
-        m_pricing->update(m_incomingIndex, m_outgoingIndex,
-                          m_pivotColumn, m_pivotRow,
-                          m_pivotRowOfBasisInverse);
+        static_cast<PRICING *>(m_pricing)->update(m_incomingIndex, m_outgoingIndex,
+                                                  m_pivotColumn, m_pivotRow,
+                                                  m_pivotRowOfBasisInverse);
 
 
         //Update the reduced costs
@@ -536,15 +572,16 @@ void DualSimplex::update() {
         }
         //Perform the basis change
 
-        SparseVector scattered;
+        SparseVector & scattered = m_scratchBuffers.getSparseVector(ScratchBuffers::BASIS_CHANGE_COLUMN,
+                                                                     m_pivotColumn.length());
         scattered = m_pivotColumn;
 
-        m_basis->append(scattered, m_outgoingIndex, m_incomingIndex, outgoingState);
+        static_cast<BASIS *>(m_basis)->append(scattered, m_outgoingIndex, m_incomingIndex, outgoingState);
 
         detectExcessivelyInstability();
 
         if (m_pricing) {
-            m_pricing->checkAndFix();
+            static_cast<PRICING *>(m_pricing)->checkAndFix();
         }
         m_basicVariableValues.set(m_outgoingIndex, *(m_variableStates.getAttachedData(m_incomingIndex)) + m_primalTheta);
         m_variableStates.move(m_incomingIndex, Simplex::BASIC, &(m_basicVariableValues.at(m_outgoingIndex)));
@@ -672,6 +709,12 @@ void DualSimplex::releaseLocks(){
 }
 
 void DualSimplex::computeTransformedRow() {
+    computeTransformedRowImpl<Basis>();
+}
+
+template <class BASIS>
+void DualSimplex::computeTransformedRowImpl() {
+    PROFILE_ZONE("Pivot row");
 
     unsigned int rowCount = m_simplexModel->getRowCount();
     unsigned int columnCount = m_simplexModel->getColumnCount();
@@ -685,7 +728,7 @@ void DualSimplex::computeTransformedRow() {
     }
     m_pivotRowOfBasisInverse.set(m_outgoingIndex, 1);
 
-    m_basis->Btran(m_pivotRowOfBasisInverse);
+    static_cast<const BASIS *>(m_basis)->Btran(m_pivotRowOfBasisInverse);
 
     /*Vector otherRow(rowCount);
     otherRow.setNewNonzero(m_outgoingIndex, 1.00001);
@@ -736,12 +779,24 @@ void DualSimplex::computeTransformedRow() {
     // --------------------------------
 
     // rowwise version
-    std::vector<Numerical::Summarizer> results( rowCount + columnCount );
-    DenseVector::NonzeroIterator pivotRowIter = m_pivotRowOfBasisInverse.beginNonzero();
-    DenseVector::NonzeroIterator pivotRowIterEnd = m_pivotRowOfBasisInverse.endNonzero();
-    for (; pivotRowIter != pivotRowIterEnd; ++pivotRowIter) {
-        const Numerical::Double lambda = *pivotRowIter;
-        const SparseVector & row = m_simplexModel->getMatrix().row( pivotRowIter.getIndex() );
+    if (m_pivotRowSums.size() != rowCount + columnCount) {
+        m_pivotRowSums.assign(rowCount + columnCount, Numerical::Summarizer());
+        m_pivotRowSumMarks.assign(rowCount + columnCount, 0);
+        m_pivotRowSumIndices.clear();
+        m_pivotRowSumIndices.reserve(rowCount + columnCount);
+    }
+    // the rows are visited in ascending order in both forms of the row of the basis inverse
+    const bool sparseBasisInverseRow = m_pivotRowOfBasisInverse.isSparse();
+    const unsigned int * basisInverseIndices = sparseBasisInverseRow ? m_pivotRowOfBasisInverse.getNonzeroIndices() : nullptr;
+    const unsigned int basisInverseCount = sparseBasisInverseRow ? m_pivotRowOfBasisInverse.getNonzeroIndexCount() : rowCount;
+    unsigned int candidate;
+    for (candidate = 0; candidate < basisInverseCount; candidate++) {
+        const unsigned int rowIndex = sparseBasisInverseRow ? basisInverseIndices[candidate] : candidate;
+        const Numerical::Double lambda = m_pivotRowOfBasisInverse.at(rowIndex);
+        if (lambda == 0.0) {
+            continue;
+        }
+        const SparseVector & row = m_simplexModel->getMatrix().row( rowIndex );
         // structural variables
         SparseVector::NonzeroIterator rowIter = row.beginNonzero();
         SparseVector::NonzeroIterator rowIterEnd = row.endNonzero();
@@ -752,22 +807,32 @@ void DualSimplex::computeTransformedRow() {
             }
             //m_reducedCosts.set(index, Numerical::stableAdd( m_reducedCosts.at( index ), - lambda * *rowIter));
 
-            results[ index ].add( lambda * *rowIter );
-            //LPWARNING( index << ".: " << results[index].getResult() );
+            if (m_pivotRowSumMarks[ index ] == 0) {
+                m_pivotRowSumMarks[ index ] = 1;
+                m_pivotRowSumIndices.push_back(index);
+            }
+            m_pivotRowSums[ index ].add( lambda * *rowIter );
+            //LPWARNING( index << ".: " << m_pivotRowSums[index].getResult() );
+        }
+        const unsigned int index = rowIndex + columnCount;
+        if (m_pivotRowSumMarks[ index ] == 0) {
+            m_pivotRowSumMarks[ index ] = 1;
+            m_pivotRowSumIndices.push_back(index);
         }
-        const unsigned int index = pivotRowIter.getIndex() + columnCount;
-        results[ index ].add( *pivotRowIter );
+        m_pivotRowSums[ index ].add( lambda );
 
     }
     //m_pivotRow->clear();
-    unsigned int index;
-    for (index = 0; index < results.size(); index++) {
-        Numerical::Double result = results[index].getResult();
+    for (unsigned int index: m_pivotRowSumIndices) {
+        Numerical::Double result = m_pivotRowSums[index].getResult();
         if (result != 0.0) {
             //TODO: Ez miert sima set?
             m_pivotRow.set(index, result);
         }
+        m_pivotRowSums[index].clear();
+        m_pivotRowSumMarks[index] = 0;
     }
+    m_pivotRowSumIndices.clear();
     //    m_pivotRow->set( m_basisHead[ m_outgoingIndex ], 1.0 );
 }
 
@@ -959,3 +1024,11 @@ void DualSimplex::detectExcessivelyInstability()
 
     //std::cin.get();
 }
+
+//The basis and pricing combinations of SimplexController::createSimplex()
+template class SimplexEngine<DualSimplex, PfiBasis, DualDantzigPricing>;
+template class SimplexEngine<DualSimplex, PfiBasis, DualDevexPricing>;
+template class SimplexEngine<DualSimplex, PfiBasis, DualSteepestEdgePricing>;
+template class SimplexEngine<DualSimplex, LuBasis, DualDantzigPricing>;
+template class SimplexEngine<DualSimplex, LuBasis, DualDevexPricing>;
+template class SimplexEngine<DualSimplex, LuBasis, DualSteepestEdgePricing>;
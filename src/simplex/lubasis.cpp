@@ -24,6 +24,7 @@
 #include <simplex/simplex.h>
 
 #include <simplex/simplexparameterhandler.h>
+#include <utils/profiler.h>
 
 thread_local int LuBasis::m_inversionCount = 0;
 
@@ -78,7 +79,7 @@ void LuBasis::registerThread() {
 }
 
 void LuBasis::releaseThread() {
-
+    releaseEtaPool();
 }
 
 void LuBasis::prepareForModel(const Model &model)
@@ -93,6 +94,7 @@ void LuBasis::releaseModel()
 
 void LuBasis::invert()
 {
+    PROFILE_ZONE("LU invert");
     m_transformationCount = 0;
     m_inversionCount++;
 
@@ -116,10 +118,11 @@ void LuBasis::invert()
     }
 
     for (std::vector<ETM>::iterator it = m_updateETMs->begin(); it < m_updateETMs->end(); ++it) {
-        delete it->eta;
+        releaseUpdateEta(it->eta);
     }
 
     m_updateETMs->clear();
+    reserveUpdateEtas();
 
     m_pivots.clear();
     m_pivotIndices.resize(m_basisHead->size());
@@ -282,6 +285,7 @@ void LuBasis::copyBasis()
 
 void LuBasis::invertC()
 {
+    PROFILE_ZONE("LU invertC");
     //The upper triangular part is called C part
     DEVINFO(D::PFIMAKER, "Search for the C part and invert it");
     unsigned int cNum = 0;
@@ -345,6 +349,7 @@ void LuBasis::invertC()
 
 void LuBasis::invertR()
 {
+    PROFILE_ZONE("LU invertR");
     //The upper triangular part is called R part
     DEVINFO(D::PFIMAKER, "Search for the R part and invert it");
     unsigned int rNum = 0;
@@ -413,6 +418,7 @@ void LuBasis::invertR()
 
 void LuBasis::invertM()
 {
+    PROFILE_ZONE("LU invertM");
     DEVINFO(D::PFIMAKER, "Search for the M part and invert it");
     unsigned int mNum = 0;
 
@@ -725,7 +731,7 @@ void LuBasis::append(const SparseVector &vector, int pivotRow, int incoming, Sim
 #endif
             cerr.unsetf(ios_base::floatfield);
         }
-        m_updateETMs->emplace_back(createEta(vector, pivotRow), pivotRow);
+        m_updateETMs->emplace_back(createUpdateEta(vector, pivotRow), pivotRow);
         m_inverseNonzeros += m_updateETMs->back().eta->nonZeros();
         m_variableStates->move(outgoing,Simplex::NONBASIC_AT_LB, &(outgoingVariable.getLowerBound()));
     } else if (outgoingState == Simplex::NONBASIC_AT_UB) {
@@ -738,7 +744,7 @@ void LuBasis::append(const SparseVector &vector, int pivotRow, int incoming, Sim
 #endif
             cerr.unsetf(ios_base::floatfield);
         }
-        m_updateETMs->emplace_back(createEta(vector, pivotRow), pivotRow);
+        m_updateETMs->emplace_back(createUpdateEta(vector, pivotRow), pivotRow);
         m_inverseNonzeros += m_updateETMs->back().eta->nonZeros();
         m_variableStates->move(outgoing,Simplex::NONBASIC_AT_UB, &(outgoingVariable.getUpperBound()));
     } else if ( outgoingState == Simplex::NONBASIC_FIXED) {
@@ -750,7 +756,7 @@ void LuBasis::append(const SparseVector &vector, int pivotRow, int incoming, Sim
 #endif
             cerr.unsetf(ios_base::floatfield);
         }
-        m_updateETMs->emplace_back(createEta(vector, pivotRow), pivotRow);
+        m_updateETMs->emplace_back(createUpdateEta(vector, pivotRow), pivotRow);
         m_inverseNonzeros += m_updateETMs->back().eta->nonZeros();
         m_variableStates->move(outgoing,Simplex::NONBASIC_FIXED, &(outgoingVariable.getLowerBound()));
     } else {
@@ -766,6 +772,7 @@ void LuBasis::append(const SparseVector &vector, int pivotRow, int incoming, Sim
 
 void LuBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const
 {
+    PROFILE_ZONE("LU Ftran (dense)");
     __UNUSED(mode);
     //FTRANL
     unsigned int basisSize = m_basisHead->size();
@@ -832,6 +839,7 @@ void LuBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const
 
 void LuBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const
 {
+    PROFILE_ZONE("LU Ftran (sparse)");
     __UNUSED(mode);
     //FTRANL
     unsigned int basisSize = m_basisHead->size();
@@ -898,6 +906,7 @@ void LuBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const
 
 void LuBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
 {
+    PROFILE_ZONE("LU Btran (dense)");
     __UNUSED(mode);
 
     //PFI UPDATE
@@ -982,6 +991,7 @@ void LuBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
 
 void LuBasis::Btran(SparseVector &vector, BTRAN_MODE mode) const
 {
+    PROFILE_ZONE("LU Btran (sparse)");
     __UNUSED(mode);
 
     //PFI UPDATE
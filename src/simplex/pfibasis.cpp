@@ -26,8 +26,11 @@
 #include <simplex/simplex.h>
 #include <simplex/simplexparameterhandler.h>
 
+#include <linalg/linalgparameterhandler.h>
+
 #include <utils/architecture.h>
 #include <utils/erroranalyzerdouble.h>
+#include <utils/profiler.h>
 
 double expDiffSquareSum = 0;
 double expDiffSum = 0;
@@ -48,16 +51,14 @@ std::vector<std::vector<ETM>*> PfiBasis::m_updatesManager;
 std::vector<IndexedDenseVector*> PfiBasis::m_updateHelperManager;
 std::mutex PfiBasis::m_updateLock;
 
-Numerical::Double lostValueAdd(Numerical::Double a, Numerical::Double b) {
+static long double lostValue(Numerical::Double a, Numerical::Double b) {
     double sum = a + b;
     long double sum2 = (long double)a + (long double)b;
-    long double lost = fabs(sum2 - sum);
-    static long double max = 0;
-    if (lost > max) {
-      //  LPINFO(max << " " << a << " " << b);
-        max = lost;
-       // std::cin.get();
-    }
+    return fabs(sum2 - sum);
+}
+
+Numerical::Double lostValueAdd(Numerical::Double a, Numerical::Double b) {
+    long double lost = lostValue(a, b);
     return lost * (1 << 14); //10000;
     // levonjuk a nagyobb abszolut erteku elem eredeti erteket
 
@@ -67,12 +68,42 @@ Numerical::Double lostValueAdd(Numerical::Double a, Numerical::Double b) {
     //return (Numerical::fabs(a) > Numerical::fabs(b) ? b : a) - lost;
 }
 
+/**
+ * Adds the product of the pivot value and an eta element to the original value in the
+ * given add mode. The add mode and the statistics policy are compile time constants, so
+ * the eta loops of FTRAN contain only the required operations.
+ */
+template <Numerical::ADD_TYPE ADD_MODE, bool STATISTICS>
+static inline Numerical::Double etaAdd(std::atomic<double> & maxLostValue,
+                                       Numerical::Double originalValue, Numerical::Double product) {
+    if (STATISTICS) {
+        //The threads of the parallel dual share the basis, so the maximum is raised atomically
+        double lost = lostValue(originalValue, product);
+        double currentMax = maxLostValue.load(std::memory_order_relaxed);
+        while (lost > currentMax &&
+               !maxLostValue.compare_exchange_weak(currentMax, lost, std::memory_order_relaxed)) {
+        }
+    }
+    switch (ADD_MODE) {
+    case Numerical::ADD_FAST:
+        return originalValue + product;
+    case Numerical::ADD_ABS:
+        return Numerical::stableAddAbs(originalValue, product);
+    default:
+        return Numerical::stableAdd(originalValue, product);
+    }
+}
+
 PfiBasis::PfiBasis() :
     Basis(),
     m_nontriangularMethod(getNontriangularMethod(SimplexParameterHandler::getInstance().getStringParameterValue("Factorization.PFI.nontriangular_method"))),
     m_nontriangularPivotRule(getNontriangularPivotRule(
                                  SimplexParameterHandler::getInstance().getStringParameterValue("Factorization.PFI.nontriangular_pivot_rule"))),
-    m_threshold(SimplexParameterHandler::getInstance().getDoubleParameterValue("Factorization.pivot_threshold"))
+    m_threshold(SimplexParameterHandler::getInstance().getDoubleParameterValue("Factorization.pivot_threshold")),
+    m_ftranAddMode(getAddMode(LinalgParameterHandler::getInstance().getStringParameterValue("ftran_add_mode"))),
+    m_btranAddMode(getAddMode(LinalgParameterHandler::getInstance().getStringParameterValue("btran_add_mode"))),
+    m_etaStatistics(LinalgParameterHandler::getInstance().getBoolParameterValue("eta_statistics")),
+    m_maxLostValue(0)
 {
     m_transformationCount = 0;
     m_transformationAverage = 0;
@@ -80,12 +111,17 @@ PfiBasis::PfiBasis() :
     const int & numberOfThreads = SimplexParameterHandler::getInstance().getIntegerParameterValue("Parallel.number_of_threads");
     m_updatesManager.reserve(numberOfThreads);
     m_updateHelperManager.reserve(numberOfThreads);
+    selectTransformationKernels();
 }
 
 PfiBasis::~PfiBasis() {
     //Already released in the simplex controller to support MILP usage
     //    releaseModel();
 
+    if (m_etaStatistics) {
+        LPINFO("Largest rounding loss of the FTRAN eta updates: " << m_maxLostValue.load());
+    }
+
     while(!m_updatesManager.empty()){
         delete m_updatesManager.back();
         m_updatesManager.pop_back();
@@ -98,6 +134,44 @@ PfiBasis::~PfiBasis() {
 }
 
 
+void PfiBasis::selectTransformationKernels() {
+    switch (m_ftranAddMode) {
+    case Numerical::ADD_FAST:
+        m_ftranDense = m_etaStatistics ? &PfiBasis::ftranDense<Numerical::ADD_FAST, true> :
+                                         &PfiBasis::ftranDense<Numerical::ADD_FAST, false>;
+        m_ftranSparse = m_etaStatistics ? &PfiBasis::ftranSparse<Numerical::ADD_FAST, true> :
+                                          &PfiBasis::ftranSparse<Numerical::ADD_FAST, false>;
+        break;
+    case Numerical::ADD_ABS:
+        m_ftranDense = m_etaStatistics ? &PfiBasis::ftranDense<Numerical::ADD_ABS, true> :
+                                         &PfiBasis::ftranDense<Numerical::ADD_ABS, false>;
+        m_ftranSparse = m_etaStatistics ? &PfiBasis::ftranSparse<Numerical::ADD_ABS, true> :
+                                          &PfiBasis::ftranSparse<Numerical::ADD_ABS, false>;
+        break;
+    case Numerical::ADD_ABS_REL:
+        m_ftranDense = m_etaStatistics ? &PfiBasis::ftranDense<Numerical::ADD_ABS_REL, true> :
+                                         &PfiBasis::ftranDense<Numerical::ADD_ABS_REL, false>;
+        m_ftranSparse = m_etaStatistics ? &PfiBasis::ftranSparse<Numerical::ADD_ABS_REL, true> :
+                                          &PfiBasis::ftranSparse<Numerical::ADD_ABS_REL, false>;
+        break;
+    }
+
+    switch (m_btranAddMode) {
+    case Numerical::ADD_FAST:
+        m_btranDense = &PfiBasis::btranDense<Numerical::ADD_FAST>;
+        m_btranSparse = &PfiBasis::btranSparse<Numerical::ADD_FAST>;
+        break;
+    case Numerical::ADD_ABS:
+        m_btranDense = &PfiBasis::btranDense<Numerical::ADD_ABS>;
+        m_btranSparse = &PfiBasis::btranSparse<Numerical::ADD_ABS>;
+        break;
+    case Numerical::ADD_ABS_REL:
+        m_btranDense = &PfiBasis::btranDense<Numerical::ADD_ABS_REL>;
+        m_btranSparse = &PfiBasis::btranSparse<Numerical::ADD_ABS_REL>;
+        break;
+    }
+}
+
 void PfiBasis::registerThread() {
     if(m_updates == nullptr){
         if(m_updatesManager.empty()){
@@ -128,6 +202,7 @@ void PfiBasis::releaseThread() {
         delete iter->eta;
     }
     m_updates->clear();
+    releaseEtaPool();
     m_updateLock.lock();
     m_updatesManager.push_back(m_updates);
     m_updates = nullptr;
@@ -141,9 +216,10 @@ void PfiBasis::clearUpdates() {
         throw PanOptException("Thread is not registered to manage basis updates!");
     }
     for (std::vector<ETM>::iterator iter = m_updates->begin(); iter < m_updates->end(); ++iter) {
-        delete iter->eta;
+        releaseUpdateEta(iter->eta);
     }
     m_updates->clear();
+    reserveUpdateEtas();
 }
 
 void PfiBasis::prepareForModel(const Model &model)
@@ -371,6 +447,7 @@ void PfiBasis::buildColumnCountIndexLists(int size, int maxColumnCount) {
 }
 
 void PfiBasis::invert() {
+    PROFILE_ZONE("PFI invert");
     m_transformationCount = 0;
     m_inversionCount++;
 
@@ -485,6 +562,7 @@ std::string doubleToHex(double num) {
 }
 
 void PfiBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const {
+    PROFILE_ZONE("PFI Ftran (dense)");
     __UNUSED(mode);
 #ifndef NDEBUG
     //In debug mode the dimensions of the basis and the given vector v are compared.
@@ -496,6 +574,27 @@ void PfiBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const {
         LPERROR("Dimension of the basis: " << m_basisHead->size());
     }
 #endif //!NDEBUG
+    (this->*m_ftranDense)(vector);
+}
+
+void PfiBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const {
+    PROFILE_ZONE("PFI Ftran (sparse)");
+    __UNUSED(mode);
+#ifndef NDEBUG
+    //In debug mode the dimensions of the basis and the given vector v are compared.
+    //If the dimension mismatches, then the operation cannot be performed.
+    //This can't happen in the "normal" case, so in release mode this check is unnecessary.
+    if (vector.length() != m_basisHead->size()) {
+        LPERROR("FTRAN failed, vector dimension mismatch! ");
+        LPERROR("Dimension of the vector to be transformed: " << vector.length());
+        LPERROR("Dimension of the basis: " << m_basisHead->size());
+    }
+#endif //!NDEBUG
+    (this->*m_ftranSparse)(vector);
+}
+
+template <Numerical::ADD_TYPE ADD_MODE, bool STATISTICS>
+void PfiBasis::ftranDense(DenseVector &vector) const {
     //The ftran operation.
     Numerical::Double * denseVector = vector.m_data;
 
@@ -517,8 +616,10 @@ void PfiBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const {
             if (*ptrEta != 0.0) {
                 Numerical::Double val;
                 if (*ptrIndex != pivotPosition) {
-                    lostValueAdd(originalValue, pivotValue * *ptrEta);
-                    val = Numerical::stableAddAbs(originalValue, pivotValue * *ptrEta);
+                    val = etaAdd<ADD_MODE, STATISTICS>(m_maxLostValue, originalValue, pivotValue * *ptrEta);
+                    if (vector.m_sparse && originalValue == 0.0 && val != 0.0) {
+                        vector.addNonzeroIndex(*ptrIndex);
+                    }
                 } else {
                     val = pivotValue * *ptrEta;
                 }
@@ -547,8 +648,10 @@ void PfiBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const {
             if (*ptrEta != 0.0) {
                 Numerical::Double val;
                 if (*ptrIndex != pivotPosition) {
-                    lostValueAdd(originalValue, pivotValue * *ptrEta);
-                    val = Numerical::stableAddAbs(originalValue, pivotValue * *ptrEta);
+                    val = etaAdd<ADD_MODE, STATISTICS>(m_maxLostValue, originalValue, pivotValue * *ptrEta);
+                    if (vector.m_sparse && originalValue == 0.0 && val != 0.0) {
+                        vector.addNonzeroIndex(*ptrIndex);
+                    }
                 } else {
                     val = pivotValue * *ptrEta;
                 }
@@ -560,18 +663,8 @@ void PfiBasis::Ftran(DenseVector &vector, FTRAN_MODE mode) const {
     }
 }
 
-void PfiBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const {
-    __UNUSED(mode);
-#ifndef NDEBUG
-    //In debug mode the dimensions of the basis and the given vector v are compared.
-    //If the dimension mismatches, then the operation cannot be performed.
-    //This can't happen in the "normal" case, so in release mode this check is unnecessary.
-    if (vector.length() != m_basisHead->size()) {
-        LPERROR("FTRAN failed, vector dimension mismatch! ");
-        LPERROR("Dimension of the vector to be transformed: " << vector.length());
-        LPERROR("Dimension of the basis: " << m_basisHead->size());
-    }
-#endif //!NDEBUG
+template <Numerical::ADD_TYPE ADD_MODE, bool STATISTICS>
+void PfiBasis::ftranSparse(SparseVector &vector) const {
     //The ftran operation.
 
     // 1. lepes: ha kell akkor atvaltjuk dense-re
@@ -597,7 +690,7 @@ void PfiBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const {
             if (*ptrEta != 0.0) {
                 Numerical::Double val;
                 if (*ptrIndex != pivotPosition) {
-                    val = Numerical::stableAddAbs(originalValue, pivotValue * *ptrEta);
+                    val = etaAdd<ADD_MODE, STATISTICS>(m_maxLostValue, originalValue, pivotValue * *ptrEta);
                     if (originalValue == 0.0 && val != 0.0) {
                         vector.m_nonZeros++;
                     } else if (originalValue != 0.0 && val == 0.0) {
@@ -635,7 +728,7 @@ void PfiBasis::Ftran(SparseVector &vector, FTRAN_MODE mode) const {
             if (*ptrEta != 0.0) {
                 Numerical::Double val;
                 if (*ptrIndex != pivotPosition) {
-                    val = Numerical::stableAddAbs(originalValue, pivotValue * *ptrEta);
+                    val = etaAdd<ADD_MODE, STATISTICS>(m_maxLostValue, originalValue, pivotValue * *ptrEta);
                     if (originalValue == 0.0 && val != 0.0) {
                         vector.m_nonZeros++;
                     } else if (originalValue != 0.0 && val == 0.0) {
@@ -845,6 +938,25 @@ void PfiBasis::analyzeStability() const
 
 void PfiBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
 {
+    PROFILE_ZONE("PFI Btran (dense)");
+    __UNUSED(mode);
+
+#ifndef NDEBUG
+    //In debug mode the dimensions of the basis and the given vector v are compared.
+    //If the dimension mismatches, then the operation cannot be performed.
+    //This can't happen in the "normal" case, so in release mode this check is unnecessary.
+    if (vector.length() != m_basisHead->size()) {
+        LPERROR("BTRAN failed, vector dimension mismatch! ");
+        LPERROR("Dimension of the vector to be transformed: " << vector.length());
+        LPERROR("Dimension of the basis: " << m_basisHead->size());
+    }
+#endif //!NDEBUG
+    (this->*m_btranDense)(vector);
+}
+
+void PfiBasis::Btran(SparseVector &vector, BTRAN_MODE mode) const
+{
+    PROFILE_ZONE("PFI Btran (sparse)");
     __UNUSED(mode);
 
 #ifndef NDEBUG
@@ -857,6 +969,11 @@ void PfiBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
         LPERROR("Dimension of the basis: " << m_basisHead->size());
     }
 #endif //!NDEBUG
+    (this->*m_btranSparse)(vector);
+}
+
+template <Numerical::ADD_TYPE ADD_MODE>
+void PfiBasis::btranDense(DenseVector &vector) const {
     //The btran operation.
     auto denseVector = vector.m_data;
 
@@ -875,15 +992,24 @@ void PfiBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
         const unsigned int * ptrIndexEnd = ptrIndex + iter->eta->m_nonZeros;
 
         while (ptrIndex < ptrIndexEnd) {
-            summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            if (ADD_MODE == Numerical::ADD_FAST) {
+                dotProduct += denseVector[*ptrIndex] * *ptrValue;
+            } else {
+                summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            }
             ptrIndex++;
             ptrValue++;
         }
 
-        dotProduct = summarizer.getResult();
+        if (ADD_MODE != Numerical::ADD_FAST) {
+            dotProduct = summarizer.getResult(true, ADD_MODE == Numerical::ADD_ABS_REL);
+        }
 
-        // store the dot product, and update the nonzero counter
+        // store the dot product, and update the nonzero index list
         const int pivot = iter->index;
+        if (vector.m_sparse && dotProduct != 0.0) {
+            vector.addNonzeroIndex(pivot);
+        }
         denseVector[pivot] = dotProduct;
     }
 
@@ -903,34 +1029,30 @@ void PfiBasis::Btran(DenseVector &vector, BTRAN_MODE mode) const
         const unsigned int * ptrIndexEnd = ptrIndex + iter->eta->m_nonZeros;
 
         while (ptrIndex < ptrIndexEnd) {
-            summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            if (ADD_MODE == Numerical::ADD_FAST) {
+                dotProduct += denseVector[*ptrIndex] * *ptrValue;
+            } else {
+                summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            }
             ptrIndex++;
             ptrValue++;
         }
 
-        dotProduct = summarizer.getResult();
+        if (ADD_MODE != Numerical::ADD_FAST) {
+            dotProduct = summarizer.getResult(true, ADD_MODE == Numerical::ADD_ABS_REL);
+        }
 
-        // store the dot product, and update the nonzero counter
+        // store the dot product, and update the nonzero index list
         const int pivot = iter->index;
+        if (vector.m_sparse && dotProduct != 0.0) {
+            vector.addNonzeroIndex(pivot);
+        }
         denseVector[pivot] = dotProduct;
     }
 }
 
-void PfiBasis::Btran(SparseVector &vector, BTRAN_MODE mode) const
-{
-    __UNUSED(mode);
-
-#ifndef NDEBUG
-    //In debug mode the dimensions of the basis and the given vector v are compared.
-    //If the dimension mismatches, then the operation cannot be performed.
-    //This can't happen in the "normal" case, so in release mode this check is unnecessary.
-    if (vector.length() != m_basisHead->size()) {
-        LPERROR("BTRAN failed, vector dimension mismatch! ");
-        LPERROR("Dimension of the vector to be transformed: " << vector.length());
-        LPERROR("Dimension of the basis: " << m_basisHead->size());
-    }
-#endif //!NDEBUG
-
+template <Numerical::ADD_TYPE ADD_MODE>
+void PfiBasis::btranSparse(SparseVector &vector) const {
     //The btran operation.
 
     // 1. convert the input vector to dense form if necessary
@@ -953,12 +1075,18 @@ void PfiBasis::Btran(SparseVector &vector, BTRAN_MODE mode) const
         const unsigned int * ptrIndexEnd = ptrIndex + iter->eta->nonZeros();
 
         while (ptrIndex < ptrIndexEnd) {
-            summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            if (ADD_MODE == Numerical::ADD_FAST) {
+                dotProduct += denseVector[*ptrIndex] * *ptrValue;
+            } else {
+                summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            }
             ptrIndex++;
             ptrValue++;
         }
 
-        dotProduct = summarizer.getResult();
+        if (ADD_MODE != Numerical::ADD_FAST) {
+            dotProduct = summarizer.getResult(true, ADD_MODE == Numerical::ADD_ABS_REL);
+        }
 
         // store the dot product, and update the nonzero counter
         const int pivot = iter->index;
@@ -985,12 +1113,18 @@ void PfiBasis::Btran(SparseVector &vector, BTRAN_MODE mode) const
         const unsigned int * ptrIndexEnd = ptrIndex + iter->eta->nonZeros();
 
         while (ptrIndex < ptrIndexEnd) {
-            summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            if (ADD_MODE == Numerical::ADD_FAST) {
+                dotProduct += denseVector[*ptrIndex] * *ptrValue;
+            } else {
+                summarizer.add(denseVector[*ptrIndex] * *ptrValue);
+            }
             ptrIndex++;
             ptrValue++;
         }
 
-        dotProduct = summarizer.getResult();
+        if (ADD_MODE != Numerical::ADD_FAST) {
+            dotProduct = summarizer.getResult(true, ADD_MODE == Numerical::ADD_ABS_REL);
+        }
 
         // store the dot product, and update the nonzero counter
         const int pivot = iter->index;
@@ -1090,7 +1224,8 @@ void PfiBasis::updateColumns(unsigned int rowindex, unsigned int columnindex) {
 
 void PfiBasis::pivot(const SparseVector& column, int pivotRow, std::vector<ETM>* etaFile) {
     ETM newETM;
-    newETM.eta = createEta(column, pivotRow);
+    //The etas of the updates are recycled at the reinversions
+    newETM.eta = etaFile == m_updates ? createUpdateEta(column, pivotRow) : createEta(column, pivotRow);
     newETM.index = pivotRow;
     //newETM.matrixColumnIndex = incoming;
     m_inverseNonzeros += newETM.eta->nonZeros();
@@ -1098,6 +1233,7 @@ void PfiBasis::pivot(const SparseVector& column, int pivotRow, std::vector<ETM>*
 }
 
 void PfiBasis::invertR() {
+    PROFILE_ZONE("PFI invertR");
 
     //The upper triangular part is called R part
     DEVINFO(D::PFIMAKER, "Search for the R part and invert it");
@@ -1143,6 +1279,7 @@ void PfiBasis::invertR() {
 }
 
 void PfiBasis::findC() {
+    PROFILE_ZONE("PFI findC");
     //The lower triangular part is called C part
     DEVINFO(D::PFIMAKER, "Search for C part");
     unsigned int cNum = 0;
@@ -1192,6 +1329,7 @@ void PfiBasis::findC() {
 }
 
 void PfiBasis::invertM() {
+    PROFILE_ZONE("PFI invertM");
 
     //The middle (non-triangular) part is called M part
     DEVINFO(D::PFIMAKER, "Organize the M part and invert the columns");
@@ -1426,6 +1564,7 @@ void PfiBasis::invertM() {
 }
 
 void PfiBasis::invertC() {
+    PROFILE_ZONE("PFI invertC");
     //The lower triangular part is called C part
     DEVINFO(D::PFIMAKER, "Invert the C part");
     for (std::vector<const SparseVector*>::reverse_iterator it = m_cColumns->rbegin(); it < m_cColumns->rend(); ++it) {
@@ -27,13 +27,15 @@ DualDantzigPricing::DualDantzigPricing(const DenseVector &basicVariableValues,
                                        const std::vector<int> & basisHead,
                                        const SimplexModel & simplexModel,
                                        const Basis & basis,
+                                       ScratchBuffers & scratchBuffers,
                                        bool shadowSteepestEdgeWeights):
     DualPricing(basicVariableValues,
                 basicVariableFeasibilities,
                 reducedCostFeasibilities,
                 basisHead,
                 simplexModel,
-                basis)
+                basis,
+                scratchBuffers)
 {
     if (shadowSteepestEdgeWeights) {
         m_shadowSteepestEdge = new DualSteepestEdgePricing(basicVariableValues,
@@ -41,7 +43,8 @@ DualDantzigPricing::DualDantzigPricing(const DenseVector &basicVariableValues,
                                                            reducedCostFeasibilities,
                                                            basisHead,
                                                            simplexModel,
-                                                           basis);
+                                                           basis,
+                                                           scratchBuffers);
     } else {
         m_shadowSteepestEdge = nullptr;
     }
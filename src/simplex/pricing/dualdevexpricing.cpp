@@ -26,13 +26,15 @@ DualDevexPricing::DualDevexPricing(const DenseVector &basicVariableValues,
                                    const IndexList<> & reducedCostFeasibilities,
                                    const std::vector<int> & basisHead,
                                    const SimplexModel & simplexModel,
-                                   const Basis & basis):
+                                   const Basis & basis,
+                                   ScratchBuffers & scratchBuffers):
     DualPricing(basicVariableValues,
                 basicVariableFeasibilities,
                 reducedCostFeasibilities,
                 basisHead,
                 simplexModel,
-                basis)
+                basis,
+                scratchBuffers)
 {
     unsigned int size = simplexModel.getColumnCount() + simplexModel.getRowCount();
     m_referenceFramework.resize(size);
@@ -26,13 +26,15 @@ DualSteepestEdgePricing::DualSteepestEdgePricing(const DenseVector &basicVariabl
                                                  const IndexList<> & reducedCostFeasibilities,
                                                  const std::vector<int> & basisHead,
                                                  const SimplexModel & simplexModel,
-                                                 const Basis & basis):
+                                                 const Basis & basis,
+                                                 ScratchBuffers & scratchBuffers):
     DualPricing(basicVariableValues,
                 basicVariableFeasibilities,
                 reducedCostFeasibilities,
                 basisHead,
                 simplexModel,
-                basis)
+                basis,
+                scratchBuffers)
 {
     m_previousPhase = 0;
     m_weightsReady = false;
@@ -175,7 +177,8 @@ void DualSteepestEdgePricing::update(int incomingIndex,
     unsigned int rowCount = m_simplexModel.getRowCount();
 
     if (unlikely(m_basis.isFresh() )) {
-        std::vector<Numerical::Double> newWeights = m_weights;
+        std::vector<Numerical::Double> & newWeights = m_scratchBuffers.getDoubleArray(ScratchBuffers::PRICING_WEIGHTS);
+        newWeights.assign(m_weights.begin(), m_weights.end());
         unsigned int index;
         for (index = 0; index < rowCount; index++) {
             if (m_shadowBasisHead[index] != m_basisHead[index]) {
@@ -188,13 +191,14 @@ void DualSteepestEdgePricing::update(int incomingIndex,
                 m_basisPositions[variableIndex] = index;
             }
         }
-        m_weights = newWeights;
+        m_weights.swap(newWeights);
         m_shadowBasisHead = m_basisHead;
         checkAndFix();
     }
 
     unsigned int index;
-    DenseVector tau = pivotRowOfBasisInverse;
+    DenseVector & tau = m_scratchBuffers.getDenseVector(ScratchBuffers::PRICING_TAU, rowCount);
+    tau = pivotRowOfBasisInverse;
     m_basis.Ftran(tau);
 
 
@@ -242,8 +246,7 @@ void DualSteepestEdgePricing::checkAndFix()
     unsigned int rowCount = m_simplexModel.getRowCount();
 
     for (auto index: m_recomuteIndices) {
-        DenseVector row(rowCount);
-        row.clear();
+        DenseVector & row = m_scratchBuffers.getDenseVector(ScratchBuffers::PRICING_ROW, rowCount);
         row.set(index, 1.0);
         m_basis.Btran(row);
         Numerical::Double norm = row.euclidNorm2();
@@ -264,6 +267,7 @@ void DualSteepestEdgePricing::initWeights() {
     m_basisPositions.resize(rowCount + columnCount);
     m_updateCounters.resize(rowCount + columnCount, 0);
     m_isBasicVariable.resize(rowCount + columnCount, 0);
+    m_recomuteIndices.reserve(rowCount);
     unsigned int index;
     DenseVector row(rowCount);
     for (index = 0; index < rowCount; index++) {
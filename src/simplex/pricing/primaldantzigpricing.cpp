@@ -29,6 +29,7 @@ PrimalDantzigPricing::PrimalDantzigPricing(const DenseVector &basicVariableValue
                                            const std::vector<int> & basisHead,
                                            const SimplexModel & model,
                                            const Basis & basis,
+                                           ScratchBuffers & scratchBuffers,
                                            const DenseVector &reducedCosts):
     PrimalPricing(basicVariableValues,
                   basicVariableFeasibilities,
@@ -37,6 +38,7 @@ PrimalDantzigPricing::PrimalDantzigPricing(const DenseVector &basicVariableValue
                   basisHead,
                   model,
                   basis,
+                  scratchBuffers,
                   reducedCosts)
 {
     m_reducedCost = 0.0;
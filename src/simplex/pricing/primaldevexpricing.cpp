@@ -24,6 +24,7 @@ PrimalDevexPricing::PrimalDevexPricing(const DenseVector &basicVariableValues,
                                        const std::vector<int> & basisHead,
                                        const SimplexModel & model,
                                        const Basis & basis,
+                                       ScratchBuffers & scratchBuffers,
                                        const DenseVector &reducedCosts):
     PrimalPricing(basicVariableValues,
                   basicVariableFeasibilities,
@@ -32,6 +33,7 @@ PrimalDevexPricing::PrimalDevexPricing(const DenseVector &basicVariableValues,
                   basisHead,
                   model,
                   basis,
+                  scratchBuffers,
                   reducedCosts)
 {
     m_reducedCost = 0.0;
@@ -233,15 +235,17 @@ void PrimalDevexPricing::update(int incomingIndex,
     }
 
     auto alpha_q_p = (*incomingAlpha)[outgoingIndex];
-    SparseVector multiplier = SparseVector::createUnitVector(rows, outgoingIndex);
+    SparseVector & multiplier = m_scratchBuffers.getSparseVector(ScratchBuffers::PRICING_MULTIPLIER, rows);
+    multiplier.newNonZero(1.0, outgoingIndex);
     m_basis.Btran(multiplier);
 
     // TODO: erre a reszre gyorsitast irni, mint a regi panoptban
-    // pl nem itt kell letrehozni ezt a ket vektort
     // kell egy indexvektor is majd, ami jeloli, hogy hol vannak nem nullak
     // a ket vektorban
-    std::vector<Numerical::Double> positiveSums(columns, 0.0);
-    std::vector<Numerical::Double> negativeSums(columns, 0.0);
+    std::vector<Numerical::Double> & positiveSums = m_scratchBuffers.getDoubleArray(ScratchBuffers::PRICING_POSITIVE_SUMS);
+    std::vector<Numerical::Double> & negativeSums = m_scratchBuffers.getDoubleArray(ScratchBuffers::PRICING_NEGATIVE_SUMS);
+    positiveSums.assign(columns, 0.0);
+    negativeSums.assign(columns, 0.0);
 
     auto multIter = multiplier.beginNonzero();
     auto multIterEnd = multiplier.endNonzero();
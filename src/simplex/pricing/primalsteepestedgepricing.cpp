@@ -29,6 +29,7 @@ PrimalSteepestEdgePricing::PrimalSteepestEdgePricing(const DenseVector &basicVar
                                                      const std::vector<int> & basisHead,
                                                      const SimplexModel & model,
                                                      const Basis & basis,
+                                                     ScratchBuffers & scratchBuffers,
                                                      const DenseVector &reducedCosts):
     PrimalPricing(basicVariableValues,
                   basicVariableFeasibilities,
@@ -37,6 +38,7 @@ PrimalSteepestEdgePricing::PrimalSteepestEdgePricing(const DenseVector &basicVar
                   basisHead,
                   model,
                   basis,
+                  scratchBuffers,
                   reducedCosts)
 {
     m_reducedCost = 0.0;
@@ -232,13 +234,17 @@ void PrimalSteepestEdgePricing::update(int incomingIndex,
     m_weights[incomingIndex] = incomingAlpha->euclidNorm2() + 1.0;
     auto incomingGamma = m_weights[incomingIndex];
 
-    SparseVector temp = SparseVector::createVectorFromDenseArray( &incomingAlpha->at(0), incomingAlpha->length() );
+    SparseVector & temp = m_scratchBuffers.getSparseVector(ScratchBuffers::PRICING_ALPHA,
+                                                           incomingAlpha->length());
+    temp = *incomingAlpha;
     m_basis.Btran(temp);
 
     auto alpha_q_p = incomingAlpha->at(outgoingIndex);
     m_weights[outgoingVariable] = (1.0 / (alpha_q_p * alpha_q_p)) * m_weights[incomingIndex];
 
-    SparseVector multiplier = SparseVector::createUnitVector( incomingAlpha->length(), outgoingIndex );
+    SparseVector & multiplier = m_scratchBuffers.getSparseVector(ScratchBuffers::PRICING_MULTIPLIER,
+                                                                 incomingAlpha->length());
+    multiplier.newNonZero(1.0, outgoingIndex);
     m_basis.Btran(multiplier);
 
     auto iter = m_variableStates.getIterator();
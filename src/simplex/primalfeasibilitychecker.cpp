@@ -20,6 +20,7 @@
 #include <simplex/primalfeasibilitychecker.h>
 #include <simplex/simplex.h>
 #include <simplex/simplexparameterhandler.h>
+#include <utils/profiler.h>
 
 PrimalFeasibilityChecker::PrimalFeasibilityChecker(const SimplexModel& model,
                                                    const DenseVector & basicVariableValues,
@@ -32,6 +33,7 @@ PrimalFeasibilityChecker::PrimalFeasibilityChecker(const SimplexModel& model,
 {}
 
 bool PrimalFeasibilityChecker::computeFeasibility(Numerical::Double tolerance){
+    PROFILE_ZONE("Feasibility check");
 //this function determines M/F/P sets, phaseI objective value
     m_basicVariableFeasibilities->clearPartition(Simplex::MINUS);
     m_basicVariableFeasibilities->clearPartition(Simplex::PLUS);
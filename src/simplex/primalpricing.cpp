@@ -29,6 +29,7 @@ PrimalPricing::PrimalPricing(const DenseVector &basicVariableValues,
                              const std::vector<int> & basisHead,
                              const SimplexModel & model,
                              const Basis & basis,
+                             ScratchBuffers & scratchBuffers,
                              const DenseVector &reducedCosts):
     m_basicVariableValues(basicVariableValues),
     m_basicVariableFeasibilities(basicVariableFeasibilities),
@@ -37,6 +38,7 @@ PrimalPricing::PrimalPricing(const DenseVector &basicVariableValues,
     m_basisHead(basisHead),
     m_simplexModel(model),
     m_basis(basis),
+    m_scratchBuffers(scratchBuffers),
     m_reducedCosts(reducedCosts),
     m_dualInfeasibility(0),
     m_feasibilityTolerance(SimplexParameterHandler::getInstance().getDoubleParameterValue("Tolerances.e_feasibility")),
@@ -124,7 +126,7 @@ void PrimalPricing::initPhase1() {
 
     unsigned int rowCount = m_basisHead.size();
     // get the h vector
-    DenseVector auxVector( rowCount);
+    DenseVector & auxVector = m_scratchBuffers.getDenseVector(ScratchBuffers::PRICING_PHASE1_AUXILIARY, rowCount);
     const IndexList<> & basicVariableFeasibilities = m_basicVariableFeasibilities;
     IndexList<>::Iterator iter, iterEnd;
     basicVariableFeasibilities.getIterators(&iter, &iterEnd, Simplex::MINUS);
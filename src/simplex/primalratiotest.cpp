@@ -21,6 +21,7 @@
 #include <simplex/primalratiotest.h>
 #include <simplex/simplex.h>
 #include <simplex/simplexparameterhandler.h>
+#include <utils/profiler.h>
 #include <random>
 
 PrimalRatiotest::PrimalRatiotest(const SimplexModel &model,
@@ -61,6 +62,7 @@ PrimalRatiotest::PrimalRatiotest(const SimplexModel &model,
 
 void PrimalRatiotest::generateSignedBreakpointsPhase1(const DenseVector &alpha, int incomingVariableIndex)
 {
+    PROFILE_ZONE("Breakpoint generation");
     IndexList<>::PartitionIterator it;
     IndexList<>::PartitionIterator endit;
     Numerical::Double epsilon = 0;
@@ -276,7 +278,8 @@ void PrimalRatiotest::performRatiotestPhase1(int incomingVariableIndex,
 {
     m_boundflips.clear();
 
-    m_breakpointHandler.init(2 * alpha.nonZeros());
+    //the maximal number of breakpoints, so the array is reserved in the first iteration only
+    m_breakpointHandler.init(2 * alpha.length());
     Numerical::Double functionSlope = Numerical::fabs(phaseIReducedCost);
     unsigned int iterationCounter = 0;
 
@@ -381,13 +384,20 @@ void PrimalRatiotest::performRatiotestPhase1(int incomingVariableIndex,
 
 void PrimalRatiotest::generateSignedBreakpointsPhase2(const DenseVector &alpha)
 {
+    PROFILE_ZONE("Breakpoint generation");
     Numerical::Double epsilon = 0;
     if(m_ePivotGeneration){
         epsilon = m_pivotTolerance;
     }
 
+    //the zero alphas can not define a breakpoint, so only the listed nonzeros are visited
+    //if the alpha vector is sparse, in the same ascending order
+    const unsigned int * nonzeroIndices = alpha.isSparse() ? alpha.getNonzeroIndices() : nullptr;
+    const unsigned int candidateCount = nonzeroIndices ? alpha.getNonzeroIndexCount() : m_basicVariableValues.length();
+
     //prefer the removal of fixed variables
-    for (unsigned int basisIndex = 0; basisIndex < m_basicVariableValues.length(); basisIndex++) {
+    for (unsigned int candidate = 0; candidate < candidateCount; candidate++) {
+        const unsigned int basisIndex = nonzeroIndices ? nonzeroIndices[candidate] : candidate;
         const Variable& variable = m_model.getVariable(m_basishead[basisIndex]);
 
         if (variable.getType() == Variable::FIXED) {
@@ -401,7 +411,8 @@ void PrimalRatiotest::generateSignedBreakpointsPhase2(const DenseVector &alpha)
         }
     }
 
-    for (unsigned int basisIndex = 0; basisIndex < m_basicVariableValues.length(); basisIndex++) {
+    for (unsigned int candidate = 0; candidate < candidateCount; candidate++) {
+        const unsigned int basisIndex = nonzeroIndices ? nonzeroIndices[candidate] : candidate;
         const Variable& variable = m_model.getVariable(m_basishead[basisIndex]);
         Numerical::Double signedAlpha = m_sigma * alpha.at(basisIndex);
 
@@ -419,8 +430,16 @@ void PrimalRatiotest::generateSignedBreakpointsPhase2(const DenseVector &alpha)
 
 void PrimalRatiotest::generateExpandedBreakpointsPhase2(const DenseVector &alpha, Numerical::Double workingTolerance)
 {
+    PROFILE_ZONE("Breakpoint generation");
+
+    //the zero alphas can not define a breakpoint, so only the listed nonzeros are visited
+    //if the alpha vector is sparse, in the same ascending order
+    const unsigned int * nonzeroIndices = alpha.isSparse() ? alpha.getNonzeroIndices() : nullptr;
+    const unsigned int candidateCount = nonzeroIndices ? alpha.getNonzeroIndexCount() : m_basicVariableValues.length();
+
     //prefer the removal of fixed variables
-    for (unsigned int basisIndex = 0; basisIndex < m_basicVariableValues.length(); basisIndex++) {
+    for (unsigned int candidate = 0; candidate < candidateCount; candidate++) {
+        const unsigned int basisIndex = nonzeroIndices ? nonzeroIndices[candidate] : candidate;
         const Variable& variable = m_model.getVariable(m_basishead[basisIndex]);
 
         if (variable.getType() == Variable::FIXED) {
@@ -433,7 +452,8 @@ void PrimalRatiotest::generateExpandedBreakpointsPhase2(const DenseVector &alpha
             }
         }
     }
-    for (unsigned int basisIndex = 0; basisIndex < m_basicVariableValues.length(); basisIndex++) {
+    for (unsigned int candidate = 0; candidate < candidateCount; candidate++) {
+        const unsigned int basisIndex = nonzeroIndices ? nonzeroIndices[candidate] : candidate;
         const Variable& variable = m_model.getVariable(m_basishead[basisIndex]);
         Numerical::Double signedAlpha = m_sigma * alpha.at(basisIndex);
         const Numerical::Double & basicVariableValue = m_basicVariableValues.at(basisIndex);
@@ -458,7 +478,7 @@ void PrimalRatiotest::performRatiotestPhase2(int incomingVariableIndex,
                                              Numerical::Double workingTolerance){
     m_boundflips.clear();
 
-    m_breakpointHandler.init(alpha.nonZeros());
+    m_breakpointHandler.init(alpha.length());
 
     m_outgoingVariableIndex = -1;
     m_primalSteplength = 0;
@@ -24,8 +24,10 @@
 #include <simplex/pricing/primalsteepestedgepricing.h>
 #include <simplex/pricing/primaldevexpricing.h>
 #include <simplex/simplexcontroller.h>
+#include <simplex/simplexengine.h>
 
 #include <simplex/simplexparameterhandler.h>
+#include <utils/profiler.h>
 
 const static char * INCOMING_NAME = "Incoming";
 const static char * OUTGOING_NAME = "Outgoing";
@@ -171,6 +173,7 @@ Entry PrimalSimplex::getIterationEntry(const string &name, ITERATION_REPORT_FIEL
 }
 
 void PrimalSimplex::computeFeasibility() {
+    PROFILE_ZONE("Primal feasibility");
     if(m_feasibilityChecker == nullptr){
         m_feasibilityChecker = new PrimalFeasibilityChecker(*m_simplexModel,
                                                             m_basicVariableValues,
@@ -196,51 +199,64 @@ void PrimalSimplex::computeFeasibility() {
     }
 }
 
+template <class PRICING>
+void PrimalSimplex::createPricing() {
+    m_pricing = new PRICING(m_basicVariableValues,
+                            m_basicVariableFeasibilities,
+                            &m_reducedCostFeasibilities,
+                            m_variableStates,
+                            m_basisHead,
+                            *m_simplexModel,
+                            *m_basis,
+                            m_scratchBuffers,
+                            m_reducedCosts);
+    Simplex::m_pricing = m_pricing;
+}
+
+template <>
+void PrimalSimplex::createPricing<PrimalPricing>() {
+    std::string pricingType = SimplexParameterHandler::getInstance().getStringParameterValue("Pricing.type");
+    if (pricingType == "DANTZIG") {
+        createPricing<PrimalDantzigPricing>();
+    }
+    if (pricingType == "STEEPEST_EDGE") {
+        createPricing<PrimalSteepestEdgePricing>();
+    }
+    if (pricingType == "DEVEX") {
+        createPricing<PrimalDevexPricing>();
+    }
+}
+
 void PrimalSimplex::price() {
+    priceImpl<Basis, PrimalPricing>();
+}
+
+void PrimalSimplex::selectPivot() {
+    selectPivotImpl<Basis, PrimalPricing>();
+}
+
+void PrimalSimplex::update() {
+    updateImpl<Basis, PrimalPricing>();
+}
+
+template <class BASIS, class PRICING>
+void PrimalSimplex::priceImpl() {
+    PROFILE_ZONE("Primal price");
     if(m_pricing == nullptr){
-        std::string pricingType = SimplexParameterHandler::getInstance().getStringParameterValue("Pricing.type");
-        if (pricingType == "DANTZIG") {
-            m_pricing = new PrimalDantzigPricing(m_basicVariableValues,
-                                                 m_basicVariableFeasibilities,
-                                                 &m_reducedCostFeasibilities,
-                                                 m_variableStates,
-                                                 m_basisHead,
-                                                 *m_simplexModel,
-                                                 *m_basis,
-                                                 m_reducedCosts);
-        }
-        if (pricingType == "STEEPEST_EDGE") {
-            m_pricing = new PrimalSteepestEdgePricing(m_basicVariableValues,
-                                                      m_basicVariableFeasibilities,
-                                                      &m_reducedCostFeasibilities,
-                                                      m_variableStates,
-                                                      m_basisHead,
-                                                      *m_simplexModel,
-                                                      *m_basis,
-                                                      m_reducedCosts);
-        }
-        if (pricingType == "DEVEX") {
-            m_pricing = new PrimalDevexPricing(m_basicVariableValues,
-                                               m_basicVariableFeasibilities,
-                                               &m_reducedCostFeasibilities,
-                                               m_variableStates,
-                                               m_basisHead,
-                                               *m_simplexModel,
-                                               *m_basis,
-                                               m_reducedCosts);
-        }
-        Simplex::m_pricing = m_pricing;
+        createPricing<PRICING>();
     }
+    PRICING * pricing = static_cast<PRICING *>(m_pricing);
 
+    PROFILE_ZONE("Pricing scan");
     if(!m_feasible){
-        m_incomingIndex = m_pricing->performPricingPhase1();
+        m_incomingIndex = pricing->performPricingPhase1();
         if(m_incomingIndex == -1){
             throw PrimalInfeasibleException("The problem is PRIMAL INFEASIBLE!");
         }
     } else {
-        m_incomingIndex = m_pricing->performPricingPhase2();
+        m_incomingIndex = pricing->performPricingPhase2();
         if(m_incomingIndex == -1){
-            if(m_pricing->hasLockedVariable()){
+            if(pricing->hasLockedVariable()){
                 throw PrimalUnboundedException("The problem is PRIMAL UNBOUNDED!");
             }else{
                 throw OptimalException("OPTIMAL SOLUTION found!");
@@ -255,7 +271,9 @@ void PrimalSimplex::price() {
     }
 }
 
-void PrimalSimplex::selectPivot() {
+template <class BASIS, class PRICING>
+void PrimalSimplex::selectPivotImpl() {
+    PROFILE_ZONE("Primal select pivot");
     if(m_ratiotest == nullptr){
         m_ratiotest = new PrimalRatiotest(*m_simplexModel,
                                           m_basicVariableValues,
@@ -276,10 +294,11 @@ void PrimalSimplex::selectPivot() {
         } else {
             m_pivotColumn.set(m_incomingIndex - columnCount, 1);
         }
-        m_basis->Ftran(m_pivotColumn);
+        static_cast<const BASIS *>(m_basis)->Ftran(m_pivotColumn);
 
         if(!m_feasible){
-            m_ratiotest->performRatiotestPhase1(m_incomingIndex, m_pivotColumn, m_pricing->getReducedCost(), m_phaseIObjectiveValue);
+            m_ratiotest->performRatiotestPhase1(m_incomingIndex, m_pivotColumn, static_cast<PRICING *>(m_pricing)->getReducedCost(),
+                                                m_phaseIObjectiveValue);
         } else {
             m_ratiotest->performRatiotestPhase2(m_incomingIndex, m_pivotColumn, m_reducedCosts.at(m_incomingIndex), m_workingTolerance);
         }
@@ -296,8 +315,8 @@ void PrimalSimplex::selectPivot() {
 #ifndef NDEBUG
             LPWARNING("Ask for another column, column is unstable: "<<m_incomingIndex);
 #endif
-            m_pricing->lockLastIndex();
-            price();
+            static_cast<PRICING *>(m_pricing)->lockLastIndex();
+            priceImpl<BASIS, PRICING>();
         }
     }
 
@@ -310,7 +329,9 @@ void PrimalSimplex::selectPivot() {
     }
 }
 
-void PrimalSimplex::update() {
+template <class BASIS, class PRICING>
+void PrimalSimplex::updateImpl() {
+    PROFILE_ZONE("Primal update");
     if (!m_ratiotest->isWolfeActive()) {
         std::vector<unsigned int>::const_iterator it = m_ratiotest->getBoundflips().begin();
         std::vector<unsigned int>::const_iterator itend = m_ratiotest->getBoundflips().end();
@@ -363,7 +384,7 @@ void PrimalSimplex::update() {
             throw PanOptException("Invalid variable type");
         }
 
-        m_pricing->update( m_incomingIndex, m_outgoingIndex, &m_pivotColumn, 0);
+        static_cast<PRICING *>(m_pricing)->update( m_incomingIndex, m_outgoingIndex, &m_pivotColumn, 0);
 
         m_objectiveValue += m_primalReducedCost * m_primalTheta;
 
@@ -375,9 +396,10 @@ void PrimalSimplex::update() {
         }
 
         //The incoming variable is NONBASIC thus the attached data gives the appropriate bound or zero
-        SparseVector gathered;
+        SparseVector & gathered = m_scratchBuffers.getSparseVector(ScratchBuffers::BASIS_CHANGE_COLUMN,
+                                                                    m_pivotColumn.length());
         gathered = m_pivotColumn;
-        m_basis->append(gathered, m_outgoingIndex, m_incomingIndex, outgoingState);
+        static_cast<BASIS *>(m_basis)->append(gathered, m_outgoingIndex, m_incomingIndex, outgoingState);
         m_basicVariableValues.set(m_outgoingIndex, *(m_variableStates.getAttachedData(m_incomingIndex)) + m_primalTheta);
         m_variableStates.move(m_incomingIndex, Simplex::BASIC, &(m_basicVariableValues.at(m_outgoingIndex)));
     }
@@ -518,7 +540,7 @@ void PrimalSimplex::updateReducedCosts() {
         return;
     }
     const unsigned int structuralVariableCount = m_simplexModel->getMatrix().columnCount();
-    DenseVector ro( m_simplexModel->getRowCount());
+    DenseVector & ro = m_scratchBuffers.getDenseVector(ScratchBuffers::REDUCED_COST_ROW, m_simplexModel->getRowCount());
     ro.set( m_outgoingIndex, 1.0 );
 
     m_basis->Btran(ro);
@@ -549,3 +571,11 @@ void PrimalSimplex::resetTolerances() {
         m_workingTolerance = m_masterTolerance * m_toleranceMultiplier;
     }
 }
+
+//The basis and pricing combinations of SimplexController::createSimplex()
+template class SimplexEngine<PrimalSimplex, PfiBasis, PrimalDantzigPricing>;
+template class SimplexEngine<PrimalSimplex, PfiBasis, PrimalDevexPricing>;
+template class SimplexEngine<PrimalSimplex, PfiBasis, PrimalSteepestEdgePricing>;
+template class SimplexEngine<PrimalSimplex, LuBasis, PrimalDantzigPricing>;
+template class SimplexEngine<PrimalSimplex, LuBasis, PrimalDevexPricing>;
+template class SimplexEngine<PrimalSimplex, LuBasis, PrimalSteepestEdgePricing>;
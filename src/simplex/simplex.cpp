@@ -31,6 +31,8 @@
 #include <simplex/basisheadpanopt.h>
 #include <simplex/checker.h>
 #include <lp/presolver.h>
+#include <utils/profiler.h>
+#include <qd/dd_real.h>
 #include <algorithm>
 
 const static char * ITERATION_INDEX_NAME = "Iteration";
@@ -42,6 +44,14 @@ const static char * SOLUTION_PRICE_TIMER_NAME = "Pricing time";
 const static char * SOLUTION_SELECT_PIVOT_TIMER_NAME = "Pivot selection time";
 const static char * SOLUTION_UPDATE_TIMER_NAME = "Update time";
 
+// The names of the phases measured by the performance counters, in the order of Simplex::PERF_COUNTER_PHASE
+const static char * PERF_COUNTER_PHASE_NAMES[] = {"Inversion", "Compute basic solution", "Compute reduced costs",
+                                                  "Pricing", "Pivot selection", "Update"};
+const static char * PERF_COUNTER_IPC_NAME = " IPC";
+const static char * PERF_COUNTER_LLC_MISSES_NAME = " LLC misses";
+const static char * PERF_COUNTER_BRANCH_MISSES_NAME = " branch misses";
+const static char * PERF_COUNTER_MEMORY_TRAFFIC_NAME = " memory traffic [MB]";
+
 const static char * EXPORT_PROBLEM_NAME = "export_problem_name";
 const static char * EXPORT_SOLUTION = "export_solution";
 const static char * EXPORT_FALLBACK = "export_fallback";
@@ -88,6 +98,8 @@ Simplex::Simplex(Basis* basis):
     m_loadFilename(SimplexParameterHandler::getInstance().getStringParameterValue("Global.LoadBasis.filename")),
     m_loadFormat(SimplexParameterHandler::getInstance().getStringParameterValue("Global.LoadBasis.format")),
     m_pivotTolerance(SimplexParameterHandler::getInstance().getDoubleParameterValue("Tolerances.e_pivot")),
+    m_refinementPasses(SimplexParameterHandler::getInstance().getIntegerParameterValue("NumericalInstability.refinement_passes")),
+    m_refinementTolerance(SimplexParameterHandler::getInstance().getDoubleParameterValue("NumericalInstability.e_refinement")),
     m_masterTolerance(0),
     m_toleranceStep(0),
     m_workingTolerance(0),
@@ -103,7 +115,14 @@ Simplex::Simplex(Basis* basis):
     m_expand(SimplexParameterHandler::getInstance().getStringParameterValue("Ratiotest.Expand.type")),
     m_recomputeReducedCosts(true)
 {
-
+    m_pivotColumn.setNonzeroTracking(true);
+    m_pivotRow.setNonzeroTracking(true);
+    if (SimplexParameterHandler::getInstance().getBoolParameterValue("Global.performance_counters")) {
+        unsigned int phase;
+        for (phase = 0; phase < PERF_PHASE_COUNT; phase++) {
+            m_perfCounters[phase].setEnabled(true);
+        }
+    }
 }
 
 Simplex::~Simplex() {
@@ -162,6 +181,28 @@ std::vector<IterationReportField> Simplex::getIterationReportFields(
                                                   4, IterationReportField::IRF_FIXED);
             result.push_back(updateTimerField);
         }
+        if (m_perfCounters[PERF_INVERSION].isEnabled()) {
+            unsigned int phase;
+            for (phase = 0; phase < PERF_PHASE_COUNT; phase++) {
+                const std::string phaseName = PERF_COUNTER_PHASE_NAMES[phase];
+                result.push_back(IterationReportField(phaseName + PERF_COUNTER_IPC_NAME, 20, 1, IterationReportField::IRF_RIGHT,
+                                                      IterationReportField::IRF_FLOAT, *this,
+                                                      3, IterationReportField::IRF_FIXED));
+                if (PerfCounters::isSupported(PerfCounters::LLC_MISSES)) {
+                    result.push_back(IterationReportField(phaseName + PERF_COUNTER_LLC_MISSES_NAME, 20, 1, IterationReportField::IRF_RIGHT,
+                                                          IterationReportField::IRF_FLOAT, *this,
+                                                          0, IterationReportField::IRF_FIXED));
+                    result.push_back(IterationReportField(phaseName + PERF_COUNTER_MEMORY_TRAFFIC_NAME, 20, 1, IterationReportField::IRF_RIGHT,
+                                                          IterationReportField::IRF_FLOAT, *this,
+                                                          2, IterationReportField::IRF_FIXED));
+                }
+                if (PerfCounters::isSupported(PerfCounters::BRANCH_MISSES)) {
+                    result.push_back(IterationReportField(phaseName + PERF_COUNTER_BRANCH_MISSES_NAME, 20, 1, IterationReportField::IRF_RIGHT,
+                                                          IterationReportField::IRF_FLOAT, *this,
+                                                          0, IterationReportField::IRF_FIXED));
+                }
+            }
+        }
         break;
     }
 
@@ -266,6 +307,21 @@ Entry Simplex::getIterationEntry(const string &name, ITERATION_REPORT_FIELD_TYPE
             reply.m_double = m_selectPivotTimer.getCPUTotalElapsed();
         } else if (name == SOLUTION_UPDATE_TIMER_NAME) {
             reply.m_double = m_updateTimer.getCPUTotalElapsed();
+        } else {
+            unsigned int phase;
+            for (phase = 0; phase < PERF_PHASE_COUNT; phase++) {
+                const std::string phaseName = PERF_COUNTER_PHASE_NAMES[phase];
+                const PerfCounterPhase & counters = m_perfCounters[phase];
+                if (name == phaseName + PERF_COUNTER_IPC_NAME) {
+                    reply.m_double = counters.getInstructionsPerCycle();
+                } else if (name == phaseName + PERF_COUNTER_LLC_MISSES_NAME) {
+                    reply.m_double = counters.getCount(PerfCounters::LLC_MISSES);
+                } else if (name == phaseName + PERF_COUNTER_MEMORY_TRAFFIC_NAME) {
+                    reply.m_double = counters.getBytesMoved() / (1024.0 * 1024.0);
+                } else if (name == phaseName + PERF_COUNTER_BRANCH_MISSES_NAME) {
+                    reply.m_double = counters.getCount(PerfCounters::BRANCH_MISSES);
+                }
+            }
         }
         break;
 
@@ -426,28 +482,7 @@ void Simplex::setSimplexState(const Simplex & simplex)
 
 void Simplex::iterate(int iterationIndex)
 {
-    m_iterationIndex = iterationIndex;
-    m_feasibleIteration = m_feasible;
-
-    m_priceTimer.start();
-    price();
-    m_priceTimer.stop();
-
-    m_selectPivotTimer.start();
-    selectPivot();
-    m_selectPivotTimer.stop();
-
-    m_updateTimer.start();
-    update();
-    m_updateTimer.stop();
-    computeWorkingTolerance();
-
-    if(!m_feasible){
-        m_recomputeReducedCosts = true;
-    }
-
-    //The iteration is complete, count it in the iteration number
-    m_iterationIndex++;
+    performIteration(this, iterationIndex);
 }
 
 void Simplex::saveBasisToFile(const char * fileName, BasisHeadIO * basisWriter, bool releaseWriter) {
@@ -711,9 +746,12 @@ const DenseVector Simplex::getReducedCosts() const {
 
 
 void Simplex::reinvert() {
+    PROFILE_ZONE("Reinversion");
     releaseLocks();
     m_inversionTimer.start();
+    m_perfCounters[PERF_INVERSION].start();
     m_basis->invert();
+    m_perfCounters[PERF_INVERSION].stop();
     m_inversionTimer.stop();
 
     //    Checker::checkBasisWithFtran(*this);
@@ -722,9 +760,12 @@ void Simplex::reinvert() {
     //    Checker::checkBasisWithReducedCost(*this);
 
     m_computeBasicSolutionTimer.start();
+    m_perfCounters[PERF_COMPUTE_BASIC_SOLUTION].start();
     computeBasicSolution();
+    m_perfCounters[PERF_COMPUTE_BASIC_SOLUTION].stop();
     m_computeBasicSolutionTimer.stop();
     m_computeReducedCostsTimer.start();
+    m_perfCounters[PERF_COMPUTE_REDUCED_COSTS].start();
 
     //if only degenerate iterations since last inversion, reduced cost values are not recomputed
     //If an exception is thrown incoming or outgoing index is -1, and the reduced costs must be recomputed
@@ -734,16 +775,18 @@ void Simplex::reinvert() {
     //    }
     if(m_expand != "INACTIVE"){
         if(m_recomputeReducedCosts){
-            computeReducedCosts();
+            computeReducedCosts(true);
         }
     } else {
-        computeReducedCosts();
+        computeReducedCosts(true);
     }
     //No need to update in an else, since the update() function already did the update
+    m_perfCounters[PERF_COMPUTE_REDUCED_COSTS].stop();
     m_computeReducedCostsTimer.stop();
 }
 
 void Simplex::computeBasicSolution() {
+    PROFILE_ZONE("Basic solution");
     m_basicVariableValues = m_simplexModel->getRhs();
     m_objectiveValue = - m_simplexModel->getCostConstant();
 
@@ -770,6 +813,7 @@ void Simplex::computeBasicSolution() {
     //    This also sets the basic solution since the pointers of the basic variables point to the basic variable values vector
 
     m_basis->Ftran(m_basicVariableValues);
+    refineBasicSolution();
 
     m_variableStates.getIterators(&it, &itend, Simplex::BASIC);
     for(; it != itend; ++it) {
@@ -779,7 +823,8 @@ void Simplex::computeBasicSolution() {
     }
 }
 
-void Simplex::computeReducedCosts() {
+void Simplex::computeReducedCosts(bool refine) {
+    PROFILE_ZONE("Reduced costs");
     m_recomputeReducedCosts = false;
 
     m_reducedCosts.clear();
@@ -787,7 +832,7 @@ void Simplex::computeReducedCosts() {
     unsigned int columnCount = m_simplexModel->getColumnCount();
 
     //Get the c_B vector
-    DenseVector simplexMultiplier(rowCount);
+    DenseVector & simplexMultiplier = m_scratchBuffers.getDenseVector(ScratchBuffers::SIMPLEX_MULTIPLIER, rowCount);
     const DenseVector& costVector = m_simplexModel->getCostVector();
     for(unsigned int i = 0; i<m_basisHead.size(); i++){
         if(costVector.at(m_basisHead[i]) != 0.0){
@@ -797,6 +842,9 @@ void Simplex::computeReducedCosts() {
     //Compute simplex multiplier
 
     m_basis->Btran(simplexMultiplier);
+    if (refine) {
+        refineSimplexMultiplier(&simplexMultiplier);
+    }
 
     //For each variable
     for(unsigned int i = 0; i < rowCount + columnCount; i++) {
@@ -826,6 +874,142 @@ void Simplex::computeReducedCosts() {
     }
 }
 
+void Simplex::refineBasicSolution() {
+    const unsigned int rowCount = m_simplexModel->getRowCount();
+    const unsigned int columnCount = m_simplexModel->getColumnCount();
+    const DenseVector & rhs = m_simplexModel->getRhs();
+    if (m_refinementPasses <= 0) {
+        return;
+    }
+    std::vector<dd_real> & residuals = m_scratchBuffers.getDdRealArray(ScratchBuffers::REFINEMENT_RESIDUALS);
+    residuals.resize(rowCount);
+    double lastResidual = Numerical::Infinity;
+    DenseVector & previousValues = m_scratchBuffers.getDenseVector(ScratchBuffers::REFINEMENT_PREVIOUS_VALUES, rowCount);
+    int pass;
+    for (pass = 0; pass <= m_refinementPasses; pass++) {
+        //r = b - A * x - x_L, the products are exact in double-double
+        unsigned int rowIndex;
+        for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+            residuals[rowIndex] = Numerical::DoubleToIEEEDouble(rhs.at(rowIndex));
+        }
+        auto it = m_variableStates.getIterator();
+        auto itend = m_variableStates.getIterator();
+        //This iterates through Simplex::BASIC, Simplex::NONBASIC_AT_LB, Simplex::NONBASIC_AT_UB and Simplex::NONBASIC_FIXED
+        m_variableStates.getIterators(&it, &itend, Simplex::BASIC, 4);
+        for (; it != itend; ++it) {
+            const double value = Numerical::DoubleToIEEEDouble(*(it.getAttached()));
+            if (value == 0.0) {
+                continue;
+            }
+            if (it.getData() < columnCount) {
+                const SparseVector & column = m_simplexModel->getMatrix().column(it.getData());
+                SparseVector::NonzeroIterator columnIt = column.beginNonzero();
+                SparseVector::NonzeroIterator columnItEnd = column.endNonzero();
+                for (; columnIt < columnItEnd; ++columnIt) {
+                    residuals[columnIt.getIndex()] -= dd_real::mul(Numerical::DoubleToIEEEDouble(*columnIt), value);
+                }
+            } else {
+                residuals[it.getData() - columnCount] -= value;
+            }
+        }
+
+        //The residuals are measured relative to the right hand side
+        double maxResidual = 0.0;
+        DenseVector & correction = m_scratchBuffers.getDenseVector(ScratchBuffers::REFINEMENT_CORRECTION, rowCount);
+        for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+            const double residual = to_double(residuals[rowIndex]);
+            if (residual != 0.0) {
+                correction.set(rowIndex, residual);
+                maxResidual = std::max(maxResidual, std::fabs(residual) /
+                                       (1.0 + std::fabs(Numerical::DoubleToIEEEDouble(rhs.at(rowIndex)))));
+            }
+        }
+        //The correction of an ill-conditioned basis can increase the residual, then the values before it are restored
+        if (maxResidual >= lastResidual) {
+            for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+                if (m_basicVariableValues.at(rowIndex) != previousValues.at(rowIndex)) {
+                    m_basicVariableValues.set(rowIndex, previousValues.at(rowIndex));
+                }
+            }
+            break;
+        }
+        if (maxResidual <= m_refinementTolerance || pass == m_refinementPasses) {
+            break;
+        }
+
+        //x_B += B^{-1} * r, the pointers of the basic variables follow the new values
+        m_basis->Ftran(correction);
+        previousValues = m_basicVariableValues;
+        for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+            if (correction.at(rowIndex) != 0.0) {
+                m_basicVariableValues.set(rowIndex, m_basicVariableValues.at(rowIndex) + correction.at(rowIndex));
+            }
+        }
+        lastResidual = maxResidual;
+    }
+}
+
+void Simplex::refineSimplexMultiplier(DenseVector * simplexMultiplier) {
+    const unsigned int rowCount = m_simplexModel->getRowCount();
+    const unsigned int columnCount = m_simplexModel->getColumnCount();
+    const DenseVector & costVector = m_simplexModel->getCostVector();
+    if (m_refinementPasses <= 0) {
+        return;
+    }
+    double lastResidual = Numerical::Infinity;
+    DenseVector & previousValues = m_scratchBuffers.getDenseVector(ScratchBuffers::REFINEMENT_PREVIOUS_VALUES, rowCount);
+    int pass;
+    for (pass = 0; pass <= m_refinementPasses; pass++) {
+        //s = c_B - B^T * y, the products are exact in double-double
+        double maxResidual = 0.0;
+        DenseVector & correction = m_scratchBuffers.getDenseVector(ScratchBuffers::REFINEMENT_CORRECTION, rowCount);
+        unsigned int basisIndex;
+        for (basisIndex = 0; basisIndex < rowCount; basisIndex++) {
+            const unsigned int variableIndex = m_basisHead[basisIndex];
+            const double cost = Numerical::DoubleToIEEEDouble(costVector.at(variableIndex));
+            dd_real residual = cost;
+            if (variableIndex < columnCount) {
+                const SparseVector & column = m_simplexModel->getMatrix().column(variableIndex);
+                SparseVector::NonzeroIterator columnIt = column.beginNonzero();
+                SparseVector::NonzeroIterator columnItEnd = column.endNonzero();
+                for (; columnIt < columnItEnd; ++columnIt) {
+                    residual -= dd_real::mul(Numerical::DoubleToIEEEDouble(simplexMultiplier->at(columnIt.getIndex())),
+                                             Numerical::DoubleToIEEEDouble(*columnIt));
+                }
+            } else {
+                residual -= Numerical::DoubleToIEEEDouble(simplexMultiplier->at(variableIndex - columnCount));
+            }
+            const double value = to_double(residual);
+            if (value != 0.0) {
+                correction.set(basisIndex, value);
+                maxResidual = std::max(maxResidual, std::fabs(value) / (1.0 + std::fabs(cost)));
+            }
+        }
+        unsigned int rowIndex;
+        if (maxResidual >= lastResidual) {
+            for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+                if (simplexMultiplier->at(rowIndex) != previousValues.at(rowIndex)) {
+                    simplexMultiplier->set(rowIndex, previousValues.at(rowIndex));
+                }
+            }
+            break;
+        }
+        if (maxResidual <= m_refinementTolerance || pass == m_refinementPasses) {
+            break;
+        }
+
+        //y += B^{-T} * s
+        m_basis->Btran(correction);
+        previousValues = *simplexMultiplier;
+        for (rowIndex = 0; rowIndex < rowCount; rowIndex++) {
+            if (correction.at(rowIndex) != 0.0) {
+                simplexMultiplier->set(rowIndex, simplexMultiplier->at(rowIndex) + correction.at(rowIndex));
+            }
+        }
+        lastResidual = maxResidual;
+    }
+}
+
 Numerical::Double Simplex::sensitivityAnalysisRhs() const
 {
     LPINFO("SENSITIVITY ANALYSIS");
@@ -21,9 +21,13 @@
 #include <simplex/simplexparameterhandler.h>
 #include <simplex/pfibasis.h>
 #include <simplex/lubasis.h>
+#include <simplex/simplexengine.h>
 #include <utils/thread.h>
 #include <thread>
+#include <cstring>
 #include <simplex/simplexthread.h>
+#include <utils/profiler.h>
+#include <utils/memoryman.h>
 
 const static char * ITERATION_TIME_NAME = "Time";
 const static char * ITERATION_INVERSION_NAME = "Inv";
@@ -61,10 +65,15 @@ SimplexController::SimplexController():
     m_exportType(SimplexParameterHandler::getInstance().getStringParameterValue("Global.Export.type")),
     m_enableExport(SimplexParameterHandler::getInstance().getBoolParameterValue("Global.Export.enable")),
     m_exportFilename(SimplexParameterHandler::getInstance().getStringParameterValue("Global.Export.filename")),
+    m_enableTrace(SimplexParameterHandler::getInstance().getBoolParameterValue("Global.Trace.enable")),
+    m_traceFilename(SimplexParameterHandler::getInstance().getStringParameterValue("Global.Trace.filename")),
+    m_traceFormat(SimplexParameterHandler::getInstance().getStringParameterValue("Global.Trace.format")),
+    m_iterationTrace(nullptr),
     m_triggeredReinversion(0),
     m_iterations(0),
     m_isOptimal(false)
 {
+    memset(&m_solveStatistics, 0, sizeof(m_solveStatistics));
     std::string factorizationType = SimplexParameterHandler::getInstance().getStringParameterValue("Factorization.type");
     if (factorizationType == "PFI"){
         m_basis = new PfiBasis();
@@ -93,6 +102,47 @@ SimplexController::~SimplexController()
         delete m_basis;
         m_basis = 0;
     }
+    if(m_iterationTrace){
+        delete m_iterationTrace;
+        m_iterationTrace = nullptr;
+    }
+}
+
+template <class SIMPLEX, class DANTZIG, class DEVEX, class STEEPEST_EDGE>
+SIMPLEX * SimplexController::createSimplex() const
+{
+    if (SimplexParameterHandler::getInstance().getBoolParameterValue("Global.simplex_engine")) {
+        const std::string & pricingType = SimplexParameterHandler::getInstance().getStringParameterValue("Pricing.type");
+        if (PfiBasis * pfiBasis = dynamic_cast<PfiBasis *>(m_basis)) {
+            if (pricingType == "DANTZIG") {
+                return new SimplexEngine<SIMPLEX, PfiBasis, DANTZIG>(pfiBasis);
+            } else if (pricingType == "DEVEX") {
+                return new SimplexEngine<SIMPLEX, PfiBasis, DEVEX>(pfiBasis);
+            } else if (pricingType == "STEEPEST_EDGE") {
+                return new SimplexEngine<SIMPLEX, PfiBasis, STEEPEST_EDGE>(pfiBasis);
+            }
+        } else if (LuBasis * luBasis = dynamic_cast<LuBasis *>(m_basis)) {
+            if (pricingType == "DANTZIG") {
+                return new SimplexEngine<SIMPLEX, LuBasis, DANTZIG>(luBasis);
+            } else if (pricingType == "DEVEX") {
+                return new SimplexEngine<SIMPLEX, LuBasis, DEVEX>(luBasis);
+            } else if (pricingType == "STEEPEST_EDGE") {
+                return new SimplexEngine<SIMPLEX, LuBasis, STEEPEST_EDGE>(luBasis);
+            }
+        }
+    }
+    //Generic fallback with the virtual basis and pricing calls
+    return new SIMPLEX(m_basis);
+}
+
+PrimalSimplex * SimplexController::createPrimalSimplex() const
+{
+    return createSimplex<PrimalSimplex, PrimalDantzigPricing, PrimalDevexPricing, PrimalSteepestEdgePricing>();
+}
+
+DualSimplex * SimplexController::createDualSimplex() const
+{
+    return createSimplex<DualSimplex, DualDantzigPricing, DualDevexPricing, DualSteepestEdgePricing>();
 }
 
 std::vector<IterationReportField> SimplexController::getIterationReportFields(
@@ -227,6 +277,70 @@ Entry SimplexController::getIterationEntry(const string &name, ITERATION_REPORT_
     return reply;
 }
 
+void SimplexController::createIterationTrace()
+{
+    const int capacity = SimplexParameterHandler::getInstance().getIntegerParameterValue("Global.Trace.capacity");
+    m_iterationTrace = new IterationTrace(capacity > 0 ? capacity : 1);
+    m_traceFields.m_iteration = m_iterationTrace->registerField("iteration", IterationTrace::IT_INT);
+    m_traceFields.m_algorithm = m_iterationTrace->registerField("algorithm", IterationTrace::IT_INT);
+    m_traceFields.m_phase = m_iterationTrace->registerField("phase", IterationTrace::IT_INT);
+    m_traceFields.m_objective = m_iterationTrace->registerField("objective", IterationTrace::IT_FLOAT);
+    m_traceFields.m_infeasibility = m_iterationTrace->registerField("infeasibility", IterationTrace::IT_FLOAT);
+    m_traceFields.m_incoming = m_iterationTrace->registerField("incoming", IterationTrace::IT_INT);
+    m_traceFields.m_outgoing = m_iterationTrace->registerField("outgoing", IterationTrace::IT_INT);
+    m_traceFields.m_reinversion = m_iterationTrace->registerField("reinversion", IterationTrace::IT_INT);
+    m_traceFields.m_etaCount = m_iterationTrace->registerField("eta_count", IterationTrace::IT_INT);
+    m_traceFields.m_time = m_iterationTrace->registerField("time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_inversionTime = m_iterationTrace->registerField("inversion_time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_computeBasicSolutionTime = m_iterationTrace->registerField("basic_solution_time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_computeReducedCostsTime = m_iterationTrace->registerField("reduced_costs_time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_priceTime = m_iterationTrace->registerField("price_time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_selectPivotTime = m_iterationTrace->registerField("select_pivot_time", IterationTrace::IT_FLOAT);
+    m_traceFields.m_updateTime = m_iterationTrace->registerField("update_time", IterationTrace::IT_FLOAT);
+}
+
+void SimplexController::traceIteration()
+{
+    const Simplex & simplex = *m_currentSimplex;
+    IterationTrace::Record record = m_iterationTrace->addRecord();
+    record.setInteger(m_traceFields.m_iteration, m_iterationIndex);
+    record.setInteger(m_traceFields.m_algorithm, m_currentAlgorithm);
+    record.setInteger(m_traceFields.m_phase, simplex.m_feasibleIteration ? 2 : 1);
+    if (simplex.m_simplexModel->getObjectiveType() == MINIMIZE) {
+        record.setFloat(m_traceFields.m_objective, Numerical::DoubleToIEEEDouble(simplex.m_objectiveValue));
+    } else {
+        record.setFloat(m_traceFields.m_objective, Numerical::DoubleToIEEEDouble(-simplex.m_objectiveValue));
+    }
+    record.setFloat(m_traceFields.m_infeasibility, Numerical::DoubleToIEEEDouble(simplex.m_phaseIObjectiveValue));
+    record.setInteger(m_traceFields.m_incoming, simplex.m_incomingIndex);
+    record.setInteger(m_traceFields.m_outgoing, simplex.m_outgoingIndex);
+    record.setInteger(m_traceFields.m_reinversion, m_freshBasis ? 1 : 0);
+    record.setInteger(m_traceFields.m_etaCount, m_basis->getUpdateEtaCount());
+    record.setFloat(m_traceFields.m_time, sm_solveTimer.getCPURunningTime());
+    record.setFloat(m_traceFields.m_inversionTime, simplex.m_inversionTimer.getCPUTotalElapsed());
+    record.setFloat(m_traceFields.m_computeBasicSolutionTime, simplex.m_computeBasicSolutionTimer.getCPUTotalElapsed());
+    record.setFloat(m_traceFields.m_computeReducedCostsTime, simplex.m_computeReducedCostsTimer.getCPUTotalElapsed());
+    record.setFloat(m_traceFields.m_priceTime, simplex.m_priceTimer.getCPUTotalElapsed());
+    record.setFloat(m_traceFields.m_selectPivotTime, simplex.m_selectPivotTimer.getCPUTotalElapsed());
+    record.setFloat(m_traceFields.m_updateTime, simplex.m_updateTimer.getCPUTotalElapsed());
+}
+
+void SimplexController::collectSolveStatistics()
+{
+    Simplex * simplexes[] = {m_primalSimplex, m_dualSimplex};
+    for (Simplex * simplex: simplexes) {
+        if (simplex == NULL) {
+            continue;
+        }
+        m_solveStatistics.m_inversionTime += simplex->m_inversionTimer.getCPUTotalElapsed();
+        m_solveStatistics.m_computeBasicSolutionTime += simplex->m_computeBasicSolutionTimer.getCPUTotalElapsed();
+        m_solveStatistics.m_computeReducedCostsTime += simplex->m_computeReducedCostsTimer.getCPUTotalElapsed();
+        m_solveStatistics.m_priceTime += simplex->m_priceTimer.getCPUTotalElapsed();
+        m_solveStatistics.m_selectPivotTime += simplex->m_selectPivotTimer.getCPUTotalElapsed();
+        m_solveStatistics.m_updateTime += simplex->m_updateTimer.getCPUTotalElapsed();
+    }
+}
+
 const Numerical::Double &SimplexController::getObjectiveValue() const
 {
     return m_currentAlgorithm == Simplex::PRIMAL ? m_primalSimplex->getObjectiveValue() :
@@ -267,12 +381,12 @@ void SimplexController::solve(const Model &model)
 {
     if (SimplexParameterHandler::getInstance().getStringParameterValue("Global.starting_algorithm") == "PRIMAL") {
         m_currentAlgorithm = Simplex::PRIMAL;
-        m_primalSimplex = new PrimalSimplex(m_basis);
+        m_primalSimplex = createPrimalSimplex();
         m_currentSimplex = m_primalSimplex;
         LPINFO("Solving problem with primal simplex method...");
     } else if (SimplexParameterHandler::getInstance().getStringParameterValue("Global.starting_algorithm") == "DUAL") {
         m_currentAlgorithm = Simplex::DUAL;
-        m_dualSimplex = new DualSimplex(m_basis);
+        m_dualSimplex = createDualSimplex();
         m_currentSimplex = m_dualSimplex;
         LPINFO("Solving problem with dual simplex method...");
     }
@@ -311,6 +425,9 @@ void SimplexController::solve(const Model &model)
             sequentialSolve(model);
         }
     }
+#ifdef PROFILER
+    Profiler::getInstance().writeReport();
+#endif
     m_basis->releaseModel();
 }
 
@@ -334,6 +451,14 @@ void SimplexController::sequentialSolve(const Model &model)
     unsigned int reinversionCounter = reinversionFrequency;
     const std::string & switching = simplexParameters.getStringParameterValue("Global.switch_algorithm");
 
+    if (m_enableTrace) {
+        if (m_iterationTrace == nullptr) {
+            createIterationTrace();
+        }
+        m_iterationTrace->clear();
+    }
+    memset(&m_solveStatistics, 0, sizeof(m_solveStatistics));
+
     try{
         m_currentSimplex->setModel(model);
 
@@ -359,6 +484,9 @@ void SimplexController::sequentialSolve(const Model &model)
         iterationReport->writeStartReport();
 
         Numerical::Double lastObjective = 0;
+        //The first cycle of an algorithm sizes its buffers, the later iterations must not allocate
+        const Simplex * cycleSimplex = nullptr;
+        unsigned int completedCycles = 0;
         //Simplex iterations
         for (m_iterationIndex = 0; m_iterationIndex <= iterationLimit &&
              (sm_solveTimer.getCPURunningTime()) < timeLimit;) {
@@ -377,6 +505,7 @@ void SimplexController::sequentialSolve(const Model &model)
                 m_currentSimplex->reinvert();
                 reinversionCounter = 0;
                 m_freshBasis = true;
+                m_solveStatistics.m_reinversions++;
 
                 if (switching == "SWITCH_BEFORE_INV") {
                     if (m_iterationIndex > 1){
@@ -396,12 +525,26 @@ void SimplexController::sequentialSolve(const Model &model)
                     }
                 }
                 m_currentSimplex->computeFeasibility();
+                if (m_currentSimplex == cycleSimplex) {
+                    completedCycles++;
+                } else {
+                    cycleSimplex = m_currentSimplex;
+                    completedCycles = 0;
+                }
             }
             try{
+                const unsigned long long int allocationCount = MemoryManager::getAllocationCount();
                 //iterate
                 m_currentSimplex->iterate(m_iterationIndex);
+                if (completedCycles > 0) {
+                    m_solveStatistics.m_steadyStateIterations++;
+                    m_solveStatistics.m_steadyStateAllocations += MemoryManager::getAllocationCount() - allocationCount;
+                }
 
                 m_iterations++;
+                if (m_basis->getInverseNonzeros() > m_solveStatistics.m_maxInverseNonzeros) {
+                    m_solveStatistics.m_maxInverseNonzeros = m_basis->getInverseNonzeros();
+                }
 
                 if(!m_currentSimplex->m_feasible){
                     lastObjective = m_currentSimplex->getPhaseIObjectiveValue();
@@ -411,6 +554,9 @@ void SimplexController::sequentialSolve(const Model &model)
                 reinversionCounter++;
 
                 m_iterationIndex++;
+                if(m_iterationTrace){
+                    traceIteration();
+                }
                 if(m_debugLevel>1 || (m_debugLevel==1 && m_freshBasis)){
                     iterationReport->writeIterationReport();
                 }
@@ -499,6 +645,7 @@ void SimplexController::sequentialSolve(const Model &model)
         LPERROR("Unknown exception");
     }
     sm_solveTimer.stop();
+    collectSolveStatistics();
 
     iterationReport->createSolutionReport();
     iterationReport->writeSolutionReport();
@@ -508,6 +655,14 @@ void SimplexController::sequentialSolve(const Model &model)
         iterationReport->writeExportReport(m_exportFilename);
     }
 
+    if(m_iterationTrace){
+        try{
+            m_iterationTrace->exportToFile(m_traceFilename, m_traceFormat);
+        } catch ( const PanOptException & exception ) {
+            LPERROR("Iteration trace error: " << exception.getMessage());
+        }
+    }
+
     m_basis->releaseThread();
 
     if(iterationReport){
@@ -528,6 +683,10 @@ void SimplexController::parallelSolve(const Model &model)
     const int & iterationLimit = simplexParameters.getIntegerParameterValue("Global.iteration_limit");
     const double & timeLimit = simplexParameters.getDoubleParameterValue("Global.time_limit");
     const int & reinversionFrequency = simplexParameters.getIntegerParameterValue("Factorization.reinversion_frequency");
+    //The replicas are spread over the NUMA nodes, if the system has more than one
+    const unsigned int numaNodeCount = ThreadSupervisor::getNumaNodeCount();
+    const bool numaBinding = simplexParameters.getBoolParameterValue("Parallel.enable_numa_binding") &&
+            numaNodeCount > 1;
 
     if (simplexParameters.getStringParameterValue("Global.starting_algorithm") == "PRIMAL") {
         m_currentAlgorithm = Simplex::PRIMAL;
@@ -542,11 +701,12 @@ void SimplexController::parallelSolve(const Model &model)
     simplexThreads.reserve(m_numberOfThreads);
     for(int i=0; i < m_numberOfThreads; ++i){
         if(m_currentAlgorithm == Simplex::PRIMAL){
-            simplexes.push_back(new PrimalSimplex(m_basis));
+            simplexes.push_back(createPrimalSimplex());
         }else{
-            simplexes.push_back(new DualSimplex(m_basis));
+            simplexes.push_back(createDualSimplex());
         }
         simplexThreads.emplace_back(simplexes[i]);
+        simplexThreads[i].setNumaNode(numaBinding ? (int)(i % numaNodeCount) : -1);
     }
 
     m_basis->registerThread();
@@ -567,7 +727,11 @@ void SimplexController::parallelSolve(const Model &model)
                 iterationReports[i]->addProviderForExport(*this);
             }
 
-            simplexes[i]->setModel(model);
+            //The large arrays of the replica are allocated and first touched on its node
+            Simplex * simplex = simplexes[i];
+            simplexThreads[i].runOnNumaNode([simplex, &model]() {
+                simplex->setModel(model);
+            });
 
             simplexes[i]->setIterationReport(iterationReports[i]);
 
@@ -827,9 +991,6 @@ void SimplexController::parallelSolve(const Model &model)
 }
 
 void SimplexController::parallelSequentialSolve(const Model *model) {
-#ifndef CLASSIC_NEW_DELETE
-    MemoryManager::startParallel();
-#endif
     SimplexController* wrapper = new SimplexController();
     ThreadSupervisor::registerMyThread();
     InitPanOpt::threadInit();
@@ -847,12 +1008,12 @@ void SimplexController::switchAlgorithm(const Model &model, IterationReport* ite
     return;
     //init algorithms to be able to switch
     if (m_primalSimplex == NULL){
-        m_primalSimplex = new PrimalSimplex(m_basis);
+        m_primalSimplex = createPrimalSimplex();
         m_primalSimplex->setModel(model);
         m_primalSimplex->setIterationReport(iterationReport);
     }
     if (m_dualSimplex == NULL){
-        m_dualSimplex = new DualSimplex(m_basis);
+        m_dualSimplex = createDualSimplex();
         m_dualSimplex->setModel(model);
         m_dualSimplex->setIterationReport(iterationReport);
     }
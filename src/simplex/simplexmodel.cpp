@@ -68,7 +68,7 @@ void SimplexModel::makeComputationalForm()
 
     //Set the logical variables
     for (i=0; i < rowCount; i++) {
-        m_variables[columnCount + i].setName(constraints[i].getName());
+        m_variables[columnCount + i].setName(constraints[i].getPooledName());
 
         switch (constraints[i].getType()) {
         case Constraint::LESS_OR_EQUAL: {
@@ -91,6 +91,7 @@ void SimplexParameterHandler::writeParameterFile(){
         root.addComment("Global.SaveBasis", SIMPLEX_PARAMETERS_GLOBAL_SAVEBASIS_COMMENT);
         root.addComment("Global.LoadBasis", SIMPLEX_PARAMETERS_GLOBAL_LOADBASIS_COMMENT);
         root.addComment("Global.Export", SIMPLEX_PARAMETERS_GLOBAL_EXPORT_COMMENT);
+        root.addComment("Global.Trace", SIMPLEX_PARAMETERS_GLOBAL_TRACE_COMMENT);
 
         // TODO:
         // - atrakni az egeszet a parameterhandler-be
@@ -111,6 +112,18 @@ void SimplexParameterHandler::initParameters()
     setParameterValue("NumericalInstability.enable_numerical_instability_detection",
                       DefaultParameters::NumericalInstability::ENABLE_NUMERICAL_INSTABILITY_DETECTION);
 
+    createParameter("NumericalInstability.refinement_passes",
+                    Entry::INTEGER,
+                    REFINEMENT_PASSES_COMMENT);
+    setParameterValue("NumericalInstability.refinement_passes",
+                      DefaultParameters::NumericalInstability::REFINEMENT_PASSES);
+
+    createParameter("NumericalInstability.e_refinement",
+                    Entry::DOUBLE,
+                    E_REFINEMENT_COMMENT);
+    setParameterValue("NumericalInstability.e_refinement",
+                      DefaultParameters::NumericalInstability::E_REFINEMENT);
+
     //Parallel
     createParameter("Parallel.enable_parallelization",
                     Entry::BOOL,
@@ -130,6 +143,12 @@ void SimplexParameterHandler::initParameters()
     setParameterValue("Parallel.number_of_threads",
                       DefaultParameters::Parallel::NUMBER_OF_THREADS);
 
+    createParameter("Parallel.enable_numa_binding",
+                    Entry::BOOL,
+                    ENABLE_NUMA_BINDING_COMMENT);
+    setParameterValue("Parallel.enable_numa_binding",
+                      DefaultParameters::Parallel::ENABLE_NUMA_BINDING);
+
     //Tolerances
     createParameter("Tolerances.e_pivot",
                     Entry::DOUBLE,
@@ -167,6 +186,24 @@ void SimplexParameterHandler::initParameters()
     setParameterValue("Starting.Scaling.type",
                       DefaultParameters::Starting::Scaling::TYPE);
 
+    createParameter("Starting.Scaling.max_iterations",
+                    Entry::INTEGER,
+                    STARTING_SCALING_MAX_ITERATIONS_COMMENT);
+    setParameterValue("Starting.Scaling.max_iterations",
+                      DefaultParameters::Starting::Scaling::MAX_ITERATIONS);
+
+    createParameter("Starting.Scaling.convergence_tolerance",
+                    Entry::DOUBLE,
+                    STARTING_SCALING_CONVERGENCE_TOLERANCE_COMMENT);
+    setParameterValue("Starting.Scaling.convergence_tolerance",
+                      DefaultParameters::Starting::Scaling::CONVERGENCE_TOLERANCE);
+
+    createParameter("Starting.Scaling.number_of_threads",
+                    Entry::INTEGER,
+                    STARTING_SCALING_NUMBER_OF_THREADS_COMMENT);
+    setParameterValue("Starting.Scaling.number_of_threads",
+                      DefaultParameters::Starting::Scaling::NUMBER_OF_THREADS);
+
     createParameter("Starting.Basis.starting_nonbasic_states",
                     Entry::STRING,
                     STARTING_BASIS_STARTING_NONBASIC_STATES_COMMENT);
@@ -495,17 +532,55 @@ void SimplexParameterHandler::initParameters()
     setParameterValue("Global.batch_size",
                       DefaultParameters::Global::BATCH_SIZE);
 
+    createParameter("Global.performance_counters",
+                    Entry::BOOL,
+                    GLOBAL_PERFORMANCE_COUNTERS_COMMENT);
+    setParameterValue("Global.performance_counters",
+                      DefaultParameters::Global::PERFORMANCE_COUNTERS);
+
+    createParameter("Global.simplex_engine",
+                    Entry::BOOL,
+                    GLOBAL_SIMPLEX_ENGINE_COMMENT);
+    setParameterValue("Global.simplex_engine",
+                      DefaultParameters::Global::SIMPLEX_ENGINE);
+
     createParameter("Global.Export.type",
                     Entry::STRING,
                     GLOBAL_EXPORT_TYPE_COMMENT);
     setParameterValue("Global.Export.type",
                       DefaultParameters::Global::Export::TYPE);
+
+    createParameter("Global.Trace.enable",
+                    Entry::BOOL,
+                    GLOBAL_TRACE_ENABLE_COMMENT);
+    setParameterValue("Global.Trace.enable",
+                      DefaultParameters::Global::Trace::ENABLE);
+
+    createParameter("Global.Trace.capacity",
+                    Entry::INTEGER,
+                    GLOBAL_TRACE_CAPACITY_COMMENT);
+    setParameterValue("Global.Trace.capacity",
+                      DefaultParameters::Global::Trace::CAPACITY);
+
+    createParameter("Global.Trace.filename",
+                    Entry::STRING,
+                    GLOBAL_TRACE_FILENAME_COMMENT);
+    setParameterValue("Global.Trace.filename",
+                      std::string(DefaultParameters::Global::Trace::FILENAME));
+
+    createParameter("Global.Trace.format",
+                    Entry::STRING,
+                    GLOBAL_TRACE_FORMAT_COMMENT);
+    setParameterValue("Global.Trace.format",
+                      std::string(DefaultParameters::Global::Trace::FORMAT));
 }
 
 bool SimplexParameterHandler::validateParameterValue(const std::string &parameter, const std::string &value)
 {
     if (parameter == "Starting.Scaling.type") {
         if (value == "BENICHOU") return true;
+        else if (value == "CURTIS_REID") return true;
+        else if (value == "EQUILIBRATION") return true;
         else return false;
     } else if (parameter == "Starting.Basis.starting_nonbasic_states") {
         if (value == "NONBASIC_TO_LOWER") return true;
@@ -593,6 +668,10 @@ bool SimplexParameterHandler::validateParameterValue(const std::string &paramete
         if (value == "PARAMETER_STUDY") return true;
         if (value == "RATIOTEST_STUDY") return true;
         else return false;
+    } else if (parameter == "Global.Trace.format") {
+        if (value == "CSV") return true;
+        else if (value == "JSON") return true;
+        else return false;
     }
     return true;
 }
@@ -47,9 +47,6 @@ void SimplexSolver::solve(const Model &model)
 
 void SimplexSolver::parallelSolve(const Model * model)
 {
-#ifndef CLASSIC_NEW_DELETE
-    MemoryManager::startParallel();
-#endif
     ThreadSupervisor::registerMyThread();
     InitPanOpt::init();
 
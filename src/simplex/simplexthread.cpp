@@ -17,6 +17,8 @@
 #include <simplex/simplexthread.h>
 #include <simplex/simplexparameterhandler.h>
 #include <simplex/checker.h>
+#include <exception>
+#include <thread>
 
 SimplexThread::SimplexThread(Simplex *currentSimplex)
     : m_result(SimplexThread::FINISHED),
@@ -24,6 +26,7 @@ SimplexThread::SimplexThread(Simplex *currentSimplex)
       m_exceptionType(SimplexThread::OPTIMAL),
       m_iterationNumber(0),
       m_currentSimplex(currentSimplex),
+      m_numaNode(-1),
       m_saveBasis(SimplexParameterHandler::getInstance().getBoolParameterValue("Global.SaveBasis.basis")),
       m_debugLevel(SimplexParameterHandler::getInstance().getIntegerParameterValue("Global.debug_level"))
 {}
@@ -34,6 +37,9 @@ SimplexThread::~SimplexThread()
 void SimplexThread::performIterations(Basis* basis, IterationReport* iterationReport, int mainIterations, int iterationNumber)
 {
     ThreadSupervisor::registerMyThread();
+    if (m_numaNode >= 0) {
+        ThreadSupervisor::bindMyThreadToNumaNode(m_numaNode);
+    }
     InitPanOpt::threadInit();
     basis->registerThread();
     basis->setSimplexState(m_currentSimplex);
@@ -115,3 +121,33 @@ void SimplexThread::performIterations(Basis* basis, IterationReport* iterationRe
     InitPanOpt::threadRelease();
     ThreadSupervisor::unregisterMyThread();
 }
+
+void SimplexThread::setNumaNode(int node)
+{
+    m_numaNode = node;
+}
+
+void SimplexThread::runOnNumaNode(const std::function<void()> & function)
+{
+    if (m_numaNode < 0) {
+        function();
+        return;
+    }
+    std::exception_ptr exception;
+    std::thread thread([&]() {
+        ThreadSupervisor::registerMyThread();
+        ThreadSupervisor::bindMyThreadToNumaNode(m_numaNode);
+        InitPanOpt::threadInit();
+        try {
+            function();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        InitPanOpt::threadRelease();
+        ThreadSupervisor::unregisterMyThread();
+    });
+    thread.join();
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
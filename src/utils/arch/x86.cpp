@@ -15,6 +15,7 @@
 //=================================================================================================
 
 #include <utils/arch/x86.h>
+#include <utils/arch/x86simd.h>
 #ifdef UNIX
 #include <sys/sysinfo.h>
 #endif
@@ -22,6 +23,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <exception>
 #include <utils/platform.h>
 #include <utils/exceptions.h>
 #include <utils/nodefile.h>
@@ -44,6 +46,7 @@ void ArchitectureX86::detect() {
         setCPUData();
         setCacheData();
         setFeatureList();
+        setExtendedFeatureList();
         setCPUTopologyData();
     } else {
 #ifndef NDEBUG
@@ -86,6 +89,23 @@ void ArchitectureX86::setDotProduct() {
         sm_denseToSparseDotProductUnstablePtr = DENSE_TO_SPARSE_DOTPRODUCT_UNSTABLE_SSE2;
         sm_denseToSparseDotProductStablePtr = DENSE_TO_SPARSE_DOTPRODUCT_STABLE_SSE2;
     }
+#ifdef X86_SIMD_KERNELS
+    if (featureExists("AVX512F")) {
+        sm_denseToDenseDotProductUnstablePtr = denseToDenseDotProductUnstableAVX512;
+        sm_denseToDenseDotProductStablePtr = denseToDenseDotProductStableAVX512;
+        sm_denseToSparseDotProductUnstablePtr = denseToSparseDotProductUnstableAVX512;
+        sm_denseToSparseDotProductStablePtr = denseToSparseDotProductStableAVX512;
+        sm_indexedDenseToIndexedDenseDotProductUnstablePtr = indexedDenseToIndexedDenseDotProductUnstableAVX512;
+        sm_indexedDenseToIndexedDenseDotProductStablePtr = indexedDenseToIndexedDenseDotProductStableAVX512;
+    } else if (featureExists("AVX2") && featureExists("FMA")) {
+        sm_denseToDenseDotProductUnstablePtr = denseToDenseDotProductUnstableAVX2;
+        sm_denseToDenseDotProductStablePtr = denseToDenseDotProductStableAVX2;
+        sm_denseToSparseDotProductUnstablePtr = denseToSparseDotProductUnstableAVX2;
+        sm_denseToSparseDotProductStablePtr = denseToSparseDotProductStableAVX2;
+        sm_indexedDenseToIndexedDenseDotProductUnstablePtr = indexedDenseToIndexedDenseDotProductUnstableAVX2;
+        sm_indexedDenseToIndexedDenseDotProductStablePtr = indexedDenseToIndexedDenseDotProductStableAVX2;
+    }
+#endif
 #endif
 }
 
@@ -106,6 +126,23 @@ void ArchitectureX86::setAdd() {
         sm_addDenseToDenseCachePtr = DENSE_TO_DENSE_ADD_SSE2_CACHE;
         sm_addDenseToDenseNoCachePtr = DENSE_TO_DENSE_ADD_SSE2_NOCACHE;
     }
+#ifdef X86_SIMD_KERNELS
+    if (featureExists("AVX512F")) {
+        sm_addDenseToDenseAbsRelCachePtr = denseToDenseAddAbsRelAVX512Cache;
+        sm_addDenseToDenseAbsRelNoCachePtr = denseToDenseAddAbsRelAVX512NoCache;
+        sm_addDenseToDenseAbsCachePtr = denseToDenseAddAbsAVX512Cache;
+        sm_addDenseToDenseAbsNoCachePtr = denseToDenseAddAbsAVX512NoCache;
+        sm_addDenseToDenseCachePtr = denseToDenseAddAVX512Cache;
+        sm_addDenseToDenseNoCachePtr = denseToDenseAddAVX512NoCache;
+    } else if (featureExists("AVX2") && featureExists("FMA")) {
+        sm_addDenseToDenseAbsRelCachePtr = denseToDenseAddAbsRelAVX2Cache;
+        sm_addDenseToDenseAbsRelNoCachePtr = denseToDenseAddAbsRelAVX2NoCache;
+        sm_addDenseToDenseAbsCachePtr = denseToDenseAddAbsAVX2Cache;
+        sm_addDenseToDenseAbsNoCachePtr = denseToDenseAddAbsAVX2NoCache;
+        sm_addDenseToDenseCachePtr = denseToDenseAddAVX2Cache;
+        sm_addDenseToDenseNoCachePtr = denseToDenseAddAVX2NoCache;
+    }
+#endif
 #endif
 }
 
@@ -422,21 +459,58 @@ void ArchitectureX86::setFeatureList() {
         loadFeature(regs.m_edx, 30, "3DNOWEXT");
         loadFeature(regs.m_edx, 31, "3DNOW");
     }
-    if ( featureExists("AVX") && featureExists("OSXSAVE") ) {
-        // check that the OS has enabled AVX
-        if (/*AVX_ENABLED_BY_OS()*/true) {
 #ifndef NDEBUG
-            std::cout << std::endl << "AVX enabled by OS" << std::endl;
+    std::cout << std::endl;
 #endif
-        } else {
-#ifndef NDEBUG
-            std::cout << std::endl << "AVX disabled by OS" << std::endl;
+}
+
+unsigned long long int ArchitectureX86::getEnabledRegisterStates() const {
+#if defined(__GNUC__)
+    unsigned int eax;
+    unsigned int edx;
+    // xgetbv with ecx = 0 returns XCR0, the register states saved by the operating system
+    __asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return ((unsigned long long int)edx << 32) | eax;
+#else
+    return ~0ULL;
 #endif
-            m_features.erase( m_features.find("AVX") );
-        }
+}
+
+void ArchitectureX86::setExtendedFeatureList() {
+    // the structured extended features are the same on Intel and AMD
+    if (m_largestFunction >= 7) {
+        Registers regs;
+        regs.m_eax = 7;
+        regs.m_ebx = regs.m_ecx = regs.m_edx = 0;
+        regs = cpuid(regs);
+        loadFeature(regs.m_ebx, 3, "BMI1");
+        loadFeature(regs.m_ebx, 5, "AVX2");
+        loadFeature(regs.m_ebx, 8, "BMI2");
+        loadFeature(regs.m_ebx, 16, "AVX512F");
+        loadFeature(regs.m_ebx, 17, "AVX512DQ");
+        loadFeature(regs.m_ebx, 28, "AVX512CD");
+        loadFeature(regs.m_ebx, 30, "AVX512BW");
+        loadFeature(regs.m_ebx, 31, "AVX512VL");
+    }
+
+    // the wide registers can be used only if the operating system saves them
+    const unsigned long long int states = featureExists("OSXSAVE") ? getEnabledRegisterStates() : 0;
+    // SSE and AVX state
+    if ((states & 0x06) != 0x06) {
+        m_features.erase("AVX");
+        m_features.erase("AVX2");
+        m_features.erase("FMA");
+    }
+    // opmask, upper ZMM0-15 and ZMM16-31 state
+    if ((states & 0xE6) != 0xE6) {
+        m_features.erase("AVX512F");
+        m_features.erase("AVX512DQ");
+        m_features.erase("AVX512CD");
+        m_features.erase("AVX512BW");
+        m_features.erase("AVX512VL");
     }
 #ifndef NDEBUG
-    std::cout << std::endl;
+    std::cout << "AVX " << (featureExists("AVX") ? "enabled" : "disabled") << " by OS" << std::endl;
 #endif
 }
 
@@ -798,7 +872,6 @@ void ArchitectureX86::loadParameters()
 {
     NodeFile node;
     try {
-        generateParameterFile();
         node.loadFromFile("archX86.PAR");
     } catch (const FileNotFoundException & ex) {
         generateParameterFile();
@@ -809,6 +882,23 @@ void ArchitectureX86::loadParameters()
     if (root.getValue("Architecture") != "X86") {
         // TODO: invalid architecture exception
     }
+    // the thresholds are missing from the files of the earlier versions, they are not calibrated
+    try {
+        sm_nonTemporalCopyLimit = std::stoull(root.getValue("NonTemporalCopyLimit"));
+        sm_nonTemporalAddLimit = std::stoull(root.getValue("NonTemporalAddLimit"));
+        sm_sparseAddDensityLimit = std::stod(root.getValue("SparseAddDensityLimit"));
+    } catch (const PanOptException & exception) {
+        __UNUSED(exception);
+        sm_nonTemporalCopyLimit = 0;
+        sm_nonTemporalAddLimit = 0;
+        sm_sparseAddDensityLimit = 0;
+    } catch (const std::exception & exception) {
+        // a value which is not a number
+        __UNUSED(exception);
+        sm_nonTemporalCopyLimit = 0;
+        sm_nonTemporalAddLimit = 0;
+        sm_sparseAddDensityLimit = 0;
+    }
     /*unsigned int l1CacheLimit = root.getValue("L1CacheLimit");
     unsigned int l2CacheLimit = root.getValue("L2CacheLimit");
     unsigned int l3CacheLimit = root.getValue("L3CacheLimit");
@@ -830,6 +920,10 @@ void ArchitectureX86::generateParameterFile() const
     outputFile << "L2CacheLimit = 0" << std::endl;
     outputFile << "L3CacheLimit = 0" << std::endl;
     outputFile << "ThreadLimit = 0" << std::endl;
+    // the dispatch thresholds measured by --calibrate, 0 means not calibrated
+    outputFile << "NonTemporalCopyLimit = " << sm_nonTemporalCopyLimit << std::endl;
+    outputFile << "NonTemporalAddLimit = " << sm_nonTemporalAddLimit << std::endl;
+    outputFile << "SparseAddDensityLimit = " << sm_sparseAddDensityLimit << std::endl;
 
     //outputFile << "DisabledFeatures {" << std::endl << std::endl << "}" << std::endl;
 
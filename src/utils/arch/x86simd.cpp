@@ -0,0 +1,546 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file x86simd.cpp
+ */
+
+#include <utils/arch/x86simd.h>
+
+#ifdef X86_SIMD_KERNELS
+
+#include <immintrin.h>
+#include <cstdint>
+
+// The stable kernels have to round the product and the sum separately like the portable
+// versions, so the compiler must not contract them into fused multiply-adds.
+#pragma GCC optimize ("fp-contract=off")
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+namespace {
+
+/**
+ * The variants of the dense add kernels.
+ */
+enum ADD_KERNEL {
+    ADD_KERNEL_FAST,
+    ADD_KERNEL_ABS,
+    ADD_KERNEL_ABS_REL
+};
+
+/**
+ * The scalar version of the stable add, for the remainders of the vector loops.
+ * This is Numerical::stableAdd and Numerical::stableAddAbs with the given tolerances.
+ */
+template <ADD_KERNEL KERNEL>
+inline Numerical::Double scalarAdd(Numerical::Double a, Numerical::Double b, Numerical::Double lambda,
+                                   Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    const Numerical::Double term = b * lambda;
+    const Numerical::Double result = a + term;
+    if (KERNEL == ADD_KERNEL_FAST) {
+        return result;
+    }
+    const Numerical::Double absResult = result < 0.0 ? -result : result;
+    if (KERNEL == ADD_KERNEL_ABS_REL) {
+        const Numerical::Double absA = a < 0.0 ? -a : a;
+        const Numerical::Double absTerm = term < 0.0 ? -term : term;
+        if ((absA + absTerm) * relTolerance > absResult) {
+            return 0.0;
+        }
+    }
+    return absResult < absTolerance ? 0.0 : result;
+}
+
+inline void scalarStableSum(Numerical::Double product, Numerical::Double * pos, Numerical::Double * neg) {
+    if (product < 0.0) {
+        *neg += product;
+    } else {
+        *pos += product;
+    }
+}
+
+/***********************************************
+ * AVX2 and FMA
+ **********************************************/
+
+AVX2_TARGET inline Numerical::Double horizontalSumAVX2(__m256d vector) {
+    __m128d low = _mm256_castpd256_pd128(vector);
+    const __m128d high = _mm256_extractf128_pd(vector, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+/**
+ * Adds the negative lanes of the products to neg, and the others to pos.
+ */
+AVX2_TARGET inline void stableSumAVX2(__m256d products, __m256d * pos, __m256d * neg) {
+    const __m256d negative = _mm256_cmp_pd(products, _mm256_setzero_pd(), _CMP_LT_OQ);
+    *neg = _mm256_add_pd(*neg, _mm256_and_pd(negative, products));
+    *pos = _mm256_add_pd(*pos, _mm256_andnot_pd(negative, products));
+}
+
+AVX2_TARGET inline __m256d gatherAVX2(const Numerical::Double * base, const unsigned int * indices) {
+    const __m128i offsets = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices));
+    // the masked form with a zero source, the plain one reads an undefined register
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, offsets, all, sizeof(Numerical::Double));
+}
+
+template <ADD_KERNEL KERNEL, bool STREAM>
+AVX2_TARGET inline void denseToDenseAddAVX2(const Numerical::Double * a, const Numerical::Double * b,
+                                            Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                            Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    size_t index = 0;
+    if (STREAM) {
+        // the non-temporal stores need aligned addresses
+        while (index < count && (reinterpret_cast<uintptr_t>(c + index) & 31) != 0) {
+            c[index] = scalarAdd<KERNEL>(a[index], b[index], lambda, absTolerance, relTolerance);
+            index++;
+        }
+    }
+    const __m256d lambdas = _mm256_set1_pd(lambda);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d absTolerances = _mm256_set1_pd(absTolerance);
+    const __m256d relTolerances = _mm256_set1_pd(relTolerance);
+    for (; index + 4 <= count; index += 4) {
+        const __m256d first = _mm256_loadu_pd(a + index);
+        const __m256d second = _mm256_loadu_pd(b + index);
+        __m256d result;
+        if (KERNEL == ADD_KERNEL_FAST) {
+            result = _mm256_fmadd_pd(second, lambdas, first);
+        } else {
+            // the product is rounded first, like in the scalar stable add
+            const __m256d term = _mm256_mul_pd(second, lambdas);
+            result = _mm256_add_pd(first, term);
+            const __m256d absResult = _mm256_andnot_pd(signMask, result);
+            __m256d zero = _mm256_cmp_pd(absResult, absTolerances, _CMP_LT_OQ);
+            if (KERNEL == ADD_KERNEL_ABS_REL) {
+                const __m256d absSum = _mm256_add_pd(_mm256_andnot_pd(signMask, first),
+                                                     _mm256_andnot_pd(signMask, term));
+                zero = _mm256_or_pd(zero, _mm256_cmp_pd(_mm256_mul_pd(absSum, relTolerances),
+                                                        absResult, _CMP_GT_OQ));
+            }
+            result = _mm256_andnot_pd(zero, result);
+        }
+        if (STREAM) {
+            _mm256_stream_pd(c + index, result);
+        } else {
+            _mm256_storeu_pd(c + index, result);
+        }
+    }
+    for (; index < count; index++) {
+        c[index] = scalarAdd<KERNEL>(a[index], b[index], lambda, absTolerance, relTolerance);
+    }
+    if (STREAM) {
+        _mm_sfence();
+    }
+}
+
+/***********************************************
+ * AVX-512
+ **********************************************/
+
+/**
+ * Returns the mask of the first count lanes, count is at most 8.
+ */
+inline __mmask8 tailMask(size_t count) {
+    return (__mmask8)((1u << count) - 1);
+}
+
+/**
+ * Sums the lanes through the memory, it runs once per kernel call.
+ */
+AVX512_TARGET inline Numerical::Double horizontalSumAVX512(__m512d vector) {
+    Numerical::Double lanes[8];
+    _mm512_storeu_pd(lanes, vector);
+    return ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+}
+
+AVX512_TARGET inline void stableSumAVX512(__m512d products, __m512d * pos, __m512d * neg) {
+    const __mmask8 negative = _mm512_cmp_pd_mask(products, _mm512_setzero_pd(), _CMP_LT_OQ);
+    *neg = _mm512_mask_add_pd(*neg, negative, *neg, products);
+    *pos = _mm512_mask_add_pd(*pos, (__mmask8)~negative, *pos, products);
+}
+
+/**
+ * Loads 8 indices, or the ones selected by the mask of the last block; the others are zero.
+ */
+AVX512_TARGET inline __m256i loadIndicesAVX512(const unsigned int * indices, __mmask8 mask) {
+    if (mask == 0xFF) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices));
+    }
+    unsigned int tail[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    unsigned int index;
+    for (index = 0; (mask >> index) & 1; index++) {
+        tail[index] = indices[index];
+    }
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail));
+}
+
+AVX512_TARGET inline __m512d gatherAVX512(const Numerical::Double * base, __m256i offsets, __mmask8 mask) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, offsets, base, sizeof(Numerical::Double));
+}
+
+template <ADD_KERNEL KERNEL>
+AVX512_TARGET inline __m512d addAVX512(__m512d first, __m512d second, __m512d lambdas,
+                                       __m512d absTolerances, __m512d relTolerances) {
+    if (KERNEL == ADD_KERNEL_FAST) {
+        return _mm512_fmadd_pd(second, lambdas, first);
+    }
+    const __m512d term = _mm512_mul_pd(second, lambdas);
+    const __m512d result = _mm512_add_pd(first, term);
+    const __m512d absResult = _mm512_abs_pd(result);
+    __mmask8 zero = _mm512_cmp_pd_mask(absResult, absTolerances, _CMP_LT_OQ);
+    if (KERNEL == ADD_KERNEL_ABS_REL) {
+        const __m512d absSum = _mm512_add_pd(_mm512_abs_pd(first), _mm512_abs_pd(term));
+        zero |= _mm512_cmp_pd_mask(_mm512_mul_pd(absSum, relTolerances), absResult, _CMP_GT_OQ);
+    }
+    return _mm512_maskz_mov_pd((__mmask8)~zero, result);
+}
+
+template <ADD_KERNEL KERNEL, bool STREAM>
+AVX512_TARGET inline void denseToDenseAddAVX512(const Numerical::Double * a, const Numerical::Double * b,
+                                                Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    size_t index = 0;
+    if (STREAM) {
+        while (index < count && (reinterpret_cast<uintptr_t>(c + index) & 63) != 0) {
+            c[index] = scalarAdd<KERNEL>(a[index], b[index], lambda, absTolerance, relTolerance);
+            index++;
+        }
+    }
+    const __m512d lambdas = _mm512_set1_pd(lambda);
+    const __m512d absTolerances = _mm512_set1_pd(absTolerance);
+    const __m512d relTolerances = _mm512_set1_pd(relTolerance);
+    for (; index + 8 <= count; index += 8) {
+        const __m512d result = addAVX512<KERNEL>(_mm512_loadu_pd(a + index), _mm512_loadu_pd(b + index),
+                                                 lambdas, absTolerances, relTolerances);
+        if (STREAM) {
+            _mm512_stream_pd(c + index, result);
+        } else {
+            _mm512_storeu_pd(c + index, result);
+        }
+    }
+    if (index < count) {
+        const __mmask8 mask = tailMask(count - index);
+        const __m512d result = addAVX512<KERNEL>(_mm512_maskz_loadu_pd(mask, a + index),
+                                                 _mm512_maskz_loadu_pd(mask, b + index),
+                                                 lambdas, absTolerances, relTolerances);
+        _mm512_mask_storeu_pd(c + index, mask, result);
+    }
+    if (STREAM) {
+        _mm_sfence();
+    }
+}
+
+}
+
+/***********************************************
+ * AVX2 and FMA
+ **********************************************/
+
+AVX2_TARGET Numerical::Double denseToDenseDotProductUnstableAVX2(const Numerical::Double * vec1,
+                                                                 const Numerical::Double * vec2,
+                                                                 size_t count) {
+    __m256d sum1 = _mm256_setzero_pd();
+    __m256d sum2 = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 8 <= count; index += 8) {
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(vec1 + index), _mm256_loadu_pd(vec2 + index), sum1);
+        sum2 = _mm256_fmadd_pd(_mm256_loadu_pd(vec1 + index + 4), _mm256_loadu_pd(vec2 + index + 4), sum2);
+    }
+    if (index + 4 <= count) {
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(vec1 + index), _mm256_loadu_pd(vec2 + index), sum1);
+        index += 4;
+    }
+    Numerical::Double result = horizontalSumAVX2(_mm256_add_pd(sum1, sum2));
+    for (; index < count; index++) {
+        result += vec1[index] * vec2[index];
+    }
+    return result;
+}
+
+AVX2_TARGET Numerical::Double denseToDenseDotProductStableAVX2(const Numerical::Double * vec1,
+                                                               const Numerical::Double * vec2,
+                                                               size_t count,
+                                                               Numerical::Double * negPtr) {
+    __m256d pos = _mm256_setzero_pd();
+    __m256d neg = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 4 <= count; index += 4) {
+        stableSumAVX2(_mm256_mul_pd(_mm256_loadu_pd(vec1 + index), _mm256_loadu_pd(vec2 + index)), &pos, &neg);
+    }
+    Numerical::Double positive = horizontalSumAVX2(pos);
+    Numerical::Double negative = horizontalSumAVX2(neg);
+    for (; index < count; index++) {
+        scalarStableSum(vec1[index] * vec2[index], &positive, &negative);
+    }
+    *negPtr = negative;
+    return positive;
+}
+
+AVX2_TARGET Numerical::Double denseToSparseDotProductUnstableAVX2(const Numerical::Double * dense,
+                                                                  const Numerical::Double * sparse,
+                                                                  const unsigned int * indices,
+                                                                  size_t count) {
+    __m256d sum1 = _mm256_setzero_pd();
+    __m256d sum2 = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 8 <= count; index += 8) {
+        sum1 = _mm256_fmadd_pd(gatherAVX2(dense, indices + index), _mm256_loadu_pd(sparse + index), sum1);
+        sum2 = _mm256_fmadd_pd(gatherAVX2(dense, indices + index + 4), _mm256_loadu_pd(sparse + index + 4), sum2);
+    }
+    if (index + 4 <= count) {
+        sum1 = _mm256_fmadd_pd(gatherAVX2(dense, indices + index), _mm256_loadu_pd(sparse + index), sum1);
+        index += 4;
+    }
+    Numerical::Double result = horizontalSumAVX2(_mm256_add_pd(sum1, sum2));
+    for (; index < count; index++) {
+        result += dense[indices[index]] * sparse[index];
+    }
+    return result;
+}
+
+AVX2_TARGET Numerical::Double denseToSparseDotProductStableAVX2(const Numerical::Double * dense,
+                                                                const Numerical::Double * sparse,
+                                                                const unsigned int * indices,
+                                                                size_t count,
+                                                                Numerical::Double * negPtr) {
+    __m256d pos = _mm256_setzero_pd();
+    __m256d neg = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 4 <= count; index += 4) {
+        stableSumAVX2(_mm256_mul_pd(gatherAVX2(dense, indices + index), _mm256_loadu_pd(sparse + index)), &pos, &neg);
+    }
+    Numerical::Double positive = horizontalSumAVX2(pos);
+    Numerical::Double negative = horizontalSumAVX2(neg);
+    for (; index < count; index++) {
+        scalarStableSum(dense[indices[index]] * sparse[index], &positive, &negative);
+    }
+    *negPtr = negative;
+    return positive;
+}
+
+AVX2_TARGET Numerical::Double indexedDenseToIndexedDenseDotProductUnstableAVX2(const Numerical::Double * dense1,
+                                                                               const Numerical::Double * dense2,
+                                                                               const unsigned int * indices,
+                                                                               size_t nonZeroCount) {
+    __m256d sum = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 4 <= nonZeroCount; index += 4) {
+        sum = _mm256_fmadd_pd(gatherAVX2(dense1, indices + index), gatherAVX2(dense2, indices + index), sum);
+    }
+    Numerical::Double result = horizontalSumAVX2(sum);
+    for (; index < nonZeroCount; index++) {
+        result += dense1[indices[index]] * dense2[indices[index]];
+    }
+    return result;
+}
+
+AVX2_TARGET Numerical::Double indexedDenseToIndexedDenseDotProductStableAVX2(const Numerical::Double * dense1,
+                                                                             const Numerical::Double * dense2,
+                                                                             const unsigned int * indices,
+                                                                             size_t nonZeroCount,
+                                                                             Numerical::Double * negPtr) {
+    __m256d pos = _mm256_setzero_pd();
+    __m256d neg = _mm256_setzero_pd();
+    size_t index;
+    for (index = 0; index + 4 <= nonZeroCount; index += 4) {
+        stableSumAVX2(_mm256_mul_pd(gatherAVX2(dense1, indices + index), gatherAVX2(dense2, indices + index)),
+                      &pos, &neg);
+    }
+    Numerical::Double positive = horizontalSumAVX2(pos);
+    Numerical::Double negative = horizontalSumAVX2(neg);
+    for (; index < nonZeroCount; index++) {
+        scalarStableSum(dense1[indices[index]] * dense2[indices[index]], &positive, &negative);
+    }
+    *negPtr = negative;
+    return positive;
+}
+
+AVX2_TARGET void denseToDenseAddAVX2Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                          Numerical::Double * c, size_t count, Numerical::Double lambda) {
+    denseToDenseAddAVX2<ADD_KERNEL_FAST, false>(a, b, c, count, lambda, 0.0, 0.0);
+}
+
+AVX2_TARGET void denseToDenseAddAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                            Numerical::Double * c, size_t count, Numerical::Double lambda) {
+    denseToDenseAddAVX2<ADD_KERNEL_FAST, true>(a, b, c, count, lambda, 0.0, 0.0);
+}
+
+AVX2_TARGET void denseToDenseAddAbsAVX2Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                             Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                             Numerical::Double absTolerance) {
+    denseToDenseAddAVX2<ADD_KERNEL_ABS, false>(a, b, c, count, lambda, absTolerance, 0.0);
+}
+
+AVX2_TARGET void denseToDenseAddAbsAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                               Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                               Numerical::Double absTolerance) {
+    denseToDenseAddAVX2<ADD_KERNEL_ABS, true>(a, b, c, count, lambda, absTolerance, 0.0);
+}
+
+AVX2_TARGET void denseToDenseAddAbsRelAVX2Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                                Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    denseToDenseAddAVX2<ADD_KERNEL_ABS_REL, false>(a, b, c, count, lambda, absTolerance, relTolerance);
+}
+
+AVX2_TARGET void denseToDenseAddAbsRelAVX2NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                                  Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                  Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    denseToDenseAddAVX2<ADD_KERNEL_ABS_REL, true>(a, b, c, count, lambda, absTolerance, relTolerance);
+}
+
+/***********************************************
+ * AVX-512
+ **********************************************/
+
+AVX512_TARGET Numerical::Double denseToDenseDotProductUnstableAVX512(const Numerical::Double * vec1,
+                                                                     const Numerical::Double * vec2,
+                                                                     size_t count) {
+    __m512d sum1 = _mm512_setzero_pd();
+    __m512d sum2 = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index + 16 <= count; index += 16) {
+        sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(vec1 + index), _mm512_loadu_pd(vec2 + index), sum1);
+        sum2 = _mm512_fmadd_pd(_mm512_loadu_pd(vec1 + index + 8), _mm512_loadu_pd(vec2 + index + 8), sum2);
+    }
+    for (; index < count; index += 8) {
+        const __mmask8 mask = tailMask(count - index < 8 ? count - index : 8);
+        sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, vec1 + index), _mm512_maskz_loadu_pd(mask, vec2 + index),
+                               sum1);
+    }
+    return horizontalSumAVX512(_mm512_add_pd(sum1, sum2));
+}
+
+AVX512_TARGET Numerical::Double denseToDenseDotProductStableAVX512(const Numerical::Double * vec1,
+                                                                   const Numerical::Double * vec2,
+                                                                   size_t count,
+                                                                   Numerical::Double * negPtr) {
+    __m512d pos = _mm512_setzero_pd();
+    __m512d neg = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index < count; index += 8) {
+        const __mmask8 mask = tailMask(count - index < 8 ? count - index : 8);
+        stableSumAVX512(_mm512_mul_pd(_mm512_maskz_loadu_pd(mask, vec1 + index),
+                                      _mm512_maskz_loadu_pd(mask, vec2 + index)), &pos, &neg);
+    }
+    *negPtr = horizontalSumAVX512(neg);
+    return horizontalSumAVX512(pos);
+}
+
+AVX512_TARGET Numerical::Double denseToSparseDotProductUnstableAVX512(const Numerical::Double * dense,
+                                                                      const Numerical::Double * sparse,
+                                                                      const unsigned int * indices,
+                                                                      size_t count) {
+    __m512d sum = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index < count; index += 8) {
+        const __mmask8 mask = tailMask(count - index < 8 ? count - index : 8);
+        const __m256i offsets = loadIndicesAVX512(indices + index, mask);
+        sum = _mm512_fmadd_pd(gatherAVX512(dense, offsets, mask), _mm512_maskz_loadu_pd(mask, sparse + index), sum);
+    }
+    return horizontalSumAVX512(sum);
+}
+
+AVX512_TARGET Numerical::Double denseToSparseDotProductStableAVX512(const Numerical::Double * dense,
+                                                                    const Numerical::Double * sparse,
+                                                                    const unsigned int * indices,
+                                                                    size_t count,
+                                                                    Numerical::Double * negPtr) {
+    __m512d pos = _mm512_setzero_pd();
+    __m512d neg = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index < count; index += 8) {
+        const __mmask8 mask = tailMask(count - index < 8 ? count - index : 8);
+        const __m256i offsets = loadIndicesAVX512(indices + index, mask);
+        stableSumAVX512(_mm512_mul_pd(gatherAVX512(dense, offsets, mask),
+                                      _mm512_maskz_loadu_pd(mask, sparse + index)), &pos, &neg);
+    }
+    *negPtr = horizontalSumAVX512(neg);
+    return horizontalSumAVX512(pos);
+}
+
+AVX512_TARGET Numerical::Double indexedDenseToIndexedDenseDotProductUnstableAVX512(const Numerical::Double * dense1,
+                                                                                   const Numerical::Double * dense2,
+                                                                                   const unsigned int * indices,
+                                                                                   size_t nonZeroCount) {
+    __m512d sum = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index < nonZeroCount; index += 8) {
+        const __mmask8 mask = tailMask(nonZeroCount - index < 8 ? nonZeroCount - index : 8);
+        const __m256i offsets = loadIndicesAVX512(indices + index, mask);
+        sum = _mm512_fmadd_pd(gatherAVX512(dense1, offsets, mask), gatherAVX512(dense2, offsets, mask), sum);
+    }
+    return horizontalSumAVX512(sum);
+}
+
+AVX512_TARGET Numerical::Double indexedDenseToIndexedDenseDotProductStableAVX512(const Numerical::Double * dense1,
+                                                                                 const Numerical::Double * dense2,
+                                                                                 const unsigned int * indices,
+                                                                                 size_t nonZeroCount,
+                                                                                 Numerical::Double * negPtr) {
+    __m512d pos = _mm512_setzero_pd();
+    __m512d neg = _mm512_setzero_pd();
+    size_t index;
+    for (index = 0; index < nonZeroCount; index += 8) {
+        const __mmask8 mask = tailMask(nonZeroCount - index < 8 ? nonZeroCount - index : 8);
+        const __m256i offsets = loadIndicesAVX512(indices + index, mask);
+        stableSumAVX512(_mm512_mul_pd(gatherAVX512(dense1, offsets, mask), gatherAVX512(dense2, offsets, mask)),
+                        &pos, &neg);
+    }
+    *negPtr = horizontalSumAVX512(neg);
+    return horizontalSumAVX512(pos);
+}
+
+AVX512_TARGET void denseToDenseAddAVX512Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                              Numerical::Double * c, size_t count, Numerical::Double lambda) {
+    denseToDenseAddAVX512<ADD_KERNEL_FAST, false>(a, b, c, count, lambda, 0.0, 0.0);
+}
+
+AVX512_TARGET void denseToDenseAddAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                                Numerical::Double * c, size_t count, Numerical::Double lambda) {
+    denseToDenseAddAVX512<ADD_KERNEL_FAST, true>(a, b, c, count, lambda, 0.0, 0.0);
+}
+
+AVX512_TARGET void denseToDenseAddAbsAVX512Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                                 Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                 Numerical::Double absTolerance) {
+    denseToDenseAddAVX512<ADD_KERNEL_ABS, false>(a, b, c, count, lambda, absTolerance, 0.0);
+}
+
+AVX512_TARGET void denseToDenseAddAbsAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                                   Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                   Numerical::Double absTolerance) {
+    denseToDenseAddAVX512<ADD_KERNEL_ABS, true>(a, b, c, count, lambda, absTolerance, 0.0);
+}
+
+AVX512_TARGET void denseToDenseAddAbsRelAVX512Cache(const Numerical::Double * a, const Numerical::Double * b,
+                                                    Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                    Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    denseToDenseAddAVX512<ADD_KERNEL_ABS_REL, false>(a, b, c, count, lambda, absTolerance, relTolerance);
+}
+
+AVX512_TARGET void denseToDenseAddAbsRelAVX512NoCache(const Numerical::Double * a, const Numerical::Double * b,
+                                                      Numerical::Double * c, size_t count, Numerical::Double lambda,
+                                                      Numerical::Double absTolerance, Numerical::Double relTolerance) {
+    denseToDenseAddAVX512<ADD_KERNEL_ABS_REL, true>(a, b, c, count, lambda, absTolerance, relTolerance);
+}
+
+#endif // X86_SIMD_KERNELS
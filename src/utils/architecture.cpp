@@ -17,7 +17,11 @@
 #include <globals.h>
 #include <utils/architecture.h>
 #include <utils/primitives.h>
+#include <debug.h>
 #include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <iomanip>
 
 Architecture::MemCpyCache Architecture::sm_memCpyCachePtr;
 Architecture::MemCpyNoCache Architecture::sm_memCpyNoCachePtr;
@@ -36,6 +40,65 @@ Architecture::AddDenseToDense Architecture::sm_addDenseToDenseNoCachePtr;
 
 size_t Architecture::sm_largestCacheSize;
 
+size_t Architecture::sm_nonTemporalCopyLimit = 0;
+size_t Architecture::sm_nonTemporalAddLimit = 0;
+double Architecture::sm_sparseAddDensityLimit = 0;
+
+namespace {
+
+/**
+ * The smallest and largest buffer sizes of the non-temporal crossover measurements.
+ */
+const size_t CALIBRATION_MIN_SIZE = 16 * 1024;
+const size_t CALIBRATION_MAX_SIZE = 256 * 1024 * 1024;
+
+/**
+ * Length of the vectors in the density crossover measurement.
+ */
+const unsigned int CALIBRATION_DENSITY_LENGTH = 100000;
+
+/**
+ * Returns the shortest running time of the function in seconds, the function is called
+ * repeatedly until it processes about 64 MiB, and the measurement is repeated three times.
+ */
+template <class FUNCTION>
+double measureKernel(FUNCTION function, size_t bytes) {
+    const unsigned int repetitions = std::max<size_t>(1, 64 * 1024 * 1024 / std::max<size_t>(bytes, 1));
+    double best = 0;
+    unsigned int run;
+    for (run = 0; run < 3; run++) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        unsigned int repetition;
+        for (repetition = 0; repetition < repetitions; repetition++) {
+            function();
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                / repetitions;
+        if (run == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/**
+ * Returns the smallest measured size from which the second kernel is faster at every
+ * larger size, or twice the largest measured size if there is no such size.
+ */
+size_t getCrossover(const std::vector<size_t> & sizes,
+                    const std::vector<double> & firstTimes,
+                    const std::vector<double> & secondTimes) {
+    size_t result = sizes.back() * 2;
+    unsigned int index = sizes.size();
+    while (index > 0 && secondTimes[index - 1] < firstTimes[index - 1]) {
+        index--;
+        result = sizes[index];
+    }
+    return result;
+}
+
+}
+
 Architecture::Architecture():
     m_cpuCount(0),
     m_coreCount(0),
@@ -167,3 +230,107 @@ ArchitectureInterface::AddDenseToDense Architecture::getAddDenseToDenseNoCache()
 size_t Architecture::getLargestCacheSize() {
     return sm_largestCacheSize;
 }
+
+size_t Architecture::getNonTemporalCopyLimit() {
+    return sm_nonTemporalCopyLimit != 0 ? sm_nonTemporalCopyLimit : sm_largestCacheSize;
+}
+
+size_t Architecture::getNonTemporalAddLimit() {
+    return sm_nonTemporalAddLimit != 0 ? sm_nonTemporalAddLimit : sm_largestCacheSize;
+}
+
+double Architecture::getSparseAddDensityLimit() {
+    return sm_sparseAddDensityLimit;
+}
+
+void Architecture::calibrate() {
+    LPINFO("Calibrating the kernel dispatch thresholds");
+    // the buffers are large enough to leave every cache at the largest size
+    std::vector<size_t> sizes;
+    size_t size;
+    for (size = CALIBRATION_MIN_SIZE; size <= CALIBRATION_MAX_SIZE; size *= 2) {
+        sizes.push_back(size);
+        if (size >= 4 * sm_largestCacheSize && size >= 16 * 1024 * 1024) {
+            break;
+        }
+    }
+    const size_t count = sizes.back() / sizeof(Numerical::Double);
+    Numerical::Double * source = alloc<Numerical::Double, 32>(count);
+    Numerical::Double * destination = alloc<Numerical::Double, 32>(count);
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        source[index] = 1.0 + (index % 7) * 0.25;
+        destination[index] = 2.0 - (index % 5) * 0.125;
+    }
+
+    std::vector<double> copyCacheTimes, copyNoCacheTimes, addCacheTimes, addNoCacheTimes;
+    LPINFO(std::setw(14) << "Size" << std::setw(14) << "memcpy" << std::setw(14) << "memcpy NT"
+           << std::setw(14) << "add" << std::setw(14) << "add NT");
+    for (size_t bytes: sizes) {
+        const size_t length = bytes / sizeof(Numerical::Double);
+        copyCacheTimes.push_back(measureKernel([&]() {
+            sm_memCpyCachePtr(destination, source, bytes);
+        }, bytes));
+        copyNoCacheTimes.push_back(measureKernel([&]() {
+            sm_memCpyNoCachePtr(destination, source, bytes);
+        }, bytes));
+        // the same in-place call as DenseVector::addDenseToDenseAbsRel, lambda alternates its sign
+        Numerical::Double lambda = 1.0 / 1024;
+        addCacheTimes.push_back(measureKernel([&]() {
+            sm_addDenseToDenseAbsRelCachePtr(destination, source, destination, length, lambda,
+                                             Numerical::AbsoluteTolerance, Numerical::RelativeTolerance);
+            lambda = -lambda;
+        }, bytes));
+        addNoCacheTimes.push_back(measureKernel([&]() {
+            sm_addDenseToDenseAbsRelNoCachePtr(destination, source, destination, length, lambda,
+                                               Numerical::AbsoluteTolerance, Numerical::RelativeTolerance);
+            lambda = -lambda;
+        }, bytes));
+        LPINFO(std::setw(14) << bytes << std::setw(14) << copyCacheTimes.back() * 1e6
+               << std::setw(14) << copyNoCacheTimes.back() * 1e6 << std::setw(14) << addCacheTimes.back() * 1e6
+               << std::setw(14) << addNoCacheTimes.back() * 1e6);
+    }
+    sm_nonTemporalCopyLimit = getCrossover(sizes, copyCacheTimes, copyNoCacheTimes);
+    sm_nonTemporalAddLimit = getCrossover(sizes, addCacheTimes, addNoCacheTimes);
+
+    // the index list add is the loop of DenseVector::addTrackedDenseToDenseAbsRel
+    const double densities[] = {0.005, 0.01, 0.02, 0.05, 0.1, 0.15, 0.2, 0.3, 0.45, 0.6, 0.8, 1.0};
+    const unsigned int length = CALIBRATION_DENSITY_LENGTH;
+    const size_t bytes = length * sizeof(Numerical::Double);
+    std::vector<unsigned int> indices;
+    Numerical::Double lambda = 1.0 / 1024;
+    const double denseTime = measureKernel([&]() {
+        sm_addDenseToDenseAbsRelCachePtr(destination, source, destination, length, lambda,
+                                         Numerical::AbsoluteTolerance, Numerical::RelativeTolerance);
+        lambda = -lambda;
+    }, bytes);
+    sm_sparseAddDensityLimit = densities[0] / 2;
+    LPINFO(std::setw(14) << "Density" << std::setw(14) << "indexed add" << std::setw(14) << "dense add");
+    for (double density: densities) {
+        // evenly spread indices, the ascending order of the sorted index lists
+        indices.clear();
+        const unsigned int nonZeros = std::max<unsigned int>(1, length * density);
+        for (index = 0; index < nonZeros; index++) {
+            indices.push_back((unsigned long long int)index * length / nonZeros);
+        }
+        const double indexedTime = measureKernel([&]() {
+            for (unsigned int nonZeroIndex: indices) {
+                destination[nonZeroIndex] = Numerical::stableAdd(destination[nonZeroIndex],
+                                                                 source[nonZeroIndex] * lambda);
+            }
+            lambda = -lambda;
+        }, nonZeros * sizeof(Numerical::Double));
+        LPINFO(std::setw(14) << density << std::setw(14) << indexedTime * 1e6 << std::setw(14) << denseTime * 1e6);
+        if (indexedTime >= denseTime) {
+            break;
+        }
+        sm_sparseAddDensityLimit = density;
+    }
+
+    ::release(source);
+    ::release(destination);
+
+    LPINFO("Non-temporal copy limit: " << sm_nonTemporalCopyLimit << " bytes");
+    LPINFO("Non-temporal add limit: " << sm_nonTemporalAddLimit << " bytes");
+    LPINFO("Index list add density limit: " << sm_sparseAddDensityLimit);
+}
@@ -19,6 +19,7 @@
  */
 #include <utils/breakpointhandler.h>
 #include <simplex/simplexparameterhandler.h>
+#include <utils/profiler.h>
 
 BreakpointHandler::BreakpointHandler():
     m_sortingMethod(BreakpointHandler::SELECTION),
@@ -44,6 +45,7 @@ const BreakpointHandler::BreakPoint* BreakpointHandler::getBreakpoint(unsigned i
             return &m_breakpoints[m_size-1-index];
         //sort next breakpoints
         } else{
+            PROFILE_ZONE("Breakpoint sort");
             for(unsigned i = m_size-m_unsorted; i<=index; i++){
                 m_unsorted--;
                 swapBreakpoints(0,m_unsorted);
@@ -75,6 +77,7 @@ void BreakpointHandler::finalizeBreakpoints()
 
 void BreakpointHandler::initSorting()
 {
+    PROFILE_ZONE("Breakpoint sort");
     //currently heapsort is always selected
 //    if ( m_breakpoints.size()-1 < 1){
 //        m_sortingMethod = SELECTION;
@@ -98,9 +101,10 @@ void BreakpointHandler::clear()
 
 const std::vector<const BreakpointHandler::BreakPoint*> &BreakpointHandler::getExpandSecondPass()
 {
-    //reserve the maximal possible number: total number of breakpoints
+    //reserve the maximal possible number: the capacity reserved for the breakpoints in init(),
+    //so the array is not reallocated when the number of breakpoints grows
     m_secondPassRatios.clear();
-    m_secondPassRatios.reserve(m_size);
+    m_secondPassRatios.reserve(m_breakpoints.capacity());
     const BreakPoint * breakpoint = NULL;
 
     Numerical::Double theta_1 = Numerical::Infinity;
@@ -24,6 +24,19 @@
 #include <utils/file.h>
 #include <debug.h>
 
+#ifdef UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Number of zero pages mapped after the content of a memory mapped file.
+ * The parsers may look ahead a record length after the last character.
+ */
+#define MAPPED_GUARD_PAGES 2
+
 File::File()
 {
     m_fd = 0;
@@ -34,6 +47,8 @@ File::File()
     m_last_block = false;
     m_ptr = 0;
     m_end = 0;
+    m_mapped = false;
+    m_mappedSize = 0;
 }
 
 File::~File()
@@ -60,6 +75,77 @@ void File::openForRead(const char * fileName, int bufferSize, int recordSize)
     *m_end = 0;
 }
 
+bool File::mapForRead(const char * fileName)
+{
+#ifdef UNIX
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        throw FileNotFoundException("Error when opening file!", fileName);
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = status.st_size;
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t mappedSize = (size / pageSize + MAPPED_GUARD_PAGES) * pageSize;
+
+    // reserve a zero filled region, and map the file to its beginning
+    void * region = mmap(0, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    void * content = mmap(region, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    ::close(fd);
+    if (content == MAP_FAILED) {
+        munmap(region, mappedSize);
+        return false;
+    }
+    madvise(content, size, MADV_WILLNEED);
+
+    m_mapped = true;
+    m_mappedSize = mappedSize;
+    m_buffer = static_cast<char*>(content);
+    m_size = size;
+    m_last_block = true;
+    m_ptr = m_buffer;
+    m_end = m_buffer + m_size;
+    return true;
+#else
+    __UNUSED(fileName);
+    return false;
+#endif
+}
+
+size_t File::getFileSize(const char * fileName)
+{
+    FILE * fd = fopen(fileName, "rb");
+    if (fd == 0) {
+        return 0;
+    }
+    size_t size = 0;
+    if (fseek(fd, 0, SEEK_END) == 0) {
+        long position = ftell(fd);
+        if (position > 0) {
+            size = position;
+        }
+    }
+    fclose(fd);
+    return size;
+}
+
+bool File::isMapped() const
+{
+    return m_mapped;
+}
+
+const char * File::getEnd() const
+{
+    return m_end;
+}
+
 const char * File::getBuffer() const
 {
     return m_ptr;
@@ -120,6 +206,14 @@ const char * File::nextBlock(const char * ptr)
 
 void File::close()
 {
+#ifdef UNIX
+    if (m_mapped) {
+        munmap(m_buffer, m_mappedSize);
+        m_buffer = 0;
+        m_mapped = false;
+        return;
+    }
+#endif
     fclose(m_fd);
     delete [] m_buffer;
     m_buffer = 0;
@@ -162,11 +162,8 @@ void IterationReport::getRow(const std::vector<IterationReportField> & fields,
     row->clear();
     STL_FOREACH(std::vector<IterationReportField>,
                 fields, fieldIter) {
-        IterationReportField field = *fieldIter;
-        Entry newEntry;
-        std::string name = field.getName();
-        newEntry = field.getProvider().getIterationEntry(name, type);
-        row->push_back(newEntry);
+        const IterationReportField & field = *fieldIter;
+        row->push_back(field.getProvider().getIterationEntry(field.getName(), type));
     }
 }
 
@@ -293,7 +290,7 @@ void IterationReport::showHeader() {
 }
 
 void IterationReport::writeIterationReport() {
-    std::vector<Entry> newRow;
+    std::vector<Entry> & newRow = m_iterationRow;
     getRow(m_iterationFields, &newRow, IterationReportProvider::IRF_ITERATION);
 
     if (m_lastDebugLevel != m_debugLevel || m_providerChanged) {
@@ -309,7 +306,7 @@ void IterationReport::writeIterationReport() {
     unsigned int fieldCounter = 0;
     for (index = 0; index < newRow.size(); index++) {
         std::ostringstream entryString;
-        IterationReportField field = m_iterationFields[index];
+        const IterationReportField & field = m_iterationFields[index];
         if (m_debugLevel < field.getDebugLevel()) {
             continue;
         }
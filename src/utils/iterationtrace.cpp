@@ -0,0 +1,158 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file iterationtrace.cpp
+ */
+
+#include <utils/iterationtrace.h>
+#include <utils/exceptions.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+IterationTrace::IterationTrace(unsigned int capacity):
+    m_capacity(capacity > 0 ? capacity : 1),
+    m_next(0),
+    m_totalRecordCount(0)
+{
+
+}
+
+unsigned int IterationTrace::registerField(const std::string & name, FIELD_TYPE type)
+{
+    unsigned int index;
+    for (index = 0; index < m_names.size(); index++) {
+        if (m_names[index] == name) {
+            return index;
+        }
+    }
+    if (m_totalRecordCount > 0) {
+        throw PanOptException("Trace fields cannot be registered after the first record: " + name);
+    }
+    m_names.push_back(name);
+    m_types.push_back(type);
+    m_slots.clear();
+    return index;
+}
+
+IterationTrace::Record IterationTrace::addRecord()
+{
+    const size_t rowSize = m_names.size();
+    if (unlikely(m_slots.empty())) {
+        m_slots.resize(rowSize * m_capacity + 1);
+    }
+    Slot * row = &m_slots[rowSize * m_next];
+    memset(row, 0, rowSize * sizeof(Slot));
+    m_next++;
+    if (m_next == m_capacity) {
+        m_next = 0;
+    }
+    m_totalRecordCount++;
+    return Record(row);
+}
+
+void IterationTrace::clear()
+{
+    m_next = 0;
+    m_totalRecordCount = 0;
+}
+
+unsigned int IterationTrace::getRecordCount() const
+{
+    return m_totalRecordCount < m_capacity ? m_totalRecordCount : m_capacity;
+}
+
+void IterationTrace::writeValue(std::ostream & out, const Slot & slot, FIELD_TYPE type, bool json) const
+{
+    if (type == IT_INT) {
+        out << slot.m_integer;
+    } else if (json && !std::isfinite(slot.m_float)) {
+        // JSON has no representation for infinities and NaNs
+        out << "null";
+    } else {
+        out << slot.m_float;
+    }
+}
+
+void IterationTrace::writeCsv(std::ostream & out) const
+{
+    const unsigned int fieldCount = m_names.size();
+    unsigned int field;
+    for (field = 0; field < fieldCount; field++) {
+        out << (field > 0 ? "," : "") << m_names[field];
+    }
+    out << "\n";
+
+    const std::streamsize precision = out.precision(std::numeric_limits<double>::digits10);
+    const unsigned int count = getRecordCount();
+    unsigned int row = count < m_capacity ? 0 : m_next;
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        const Slot * slots = &m_slots[row * fieldCount];
+        for (field = 0; field < fieldCount; field++) {
+            if (field > 0) {
+                out << ",";
+            }
+            writeValue(out, slots[field], m_types[field], false);
+        }
+        out << "\n";
+        row = row + 1 == m_capacity ? 0 : row + 1;
+    }
+    out.precision(precision);
+}
+
+void IterationTrace::writeJson(std::ostream & out) const
+{
+    const unsigned int fieldCount = m_names.size();
+    const std::streamsize precision = out.precision(std::numeric_limits<double>::digits10);
+    const unsigned int count = getRecordCount();
+    unsigned int row = count < m_capacity ? 0 : m_next;
+    unsigned int index;
+    out << "[";
+    for (index = 0; index < count; index++) {
+        const Slot * slots = &m_slots[row * fieldCount];
+        out << (index > 0 ? ",\n" : "\n") << "  {";
+        unsigned int field;
+        for (field = 0; field < fieldCount; field++) {
+            out << (field > 0 ? ", " : "") << "\"" << m_names[field] << "\": ";
+            writeValue(out, slots[field], m_types[field], true);
+        }
+        out << "}";
+        row = row + 1 == m_capacity ? 0 : row + 1;
+    }
+    out << "\n]\n";
+    out.precision(precision);
+}
+
+void IterationTrace::exportToFile(const std::string & filename, const std::string & format) const
+{
+    if (format != "CSV" && format != "JSON") {
+        throw PanOptException("Unknown iteration trace format: " + format);
+    }
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        throw PanOptException("Iteration trace file cannot be opened: " + filename);
+    }
+    if (format == "CSV") {
+        writeCsv(out);
+    } else {
+        writeJson(out);
+    }
+}
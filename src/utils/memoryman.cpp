@@ -22,55 +22,388 @@
 #include <cstdio>
 #include <initpanopt.h>
 #include <cstring>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <new>
 #include <macros.h>
+#include <debug.h>
 #include <utils/architecture.h>
 
-#ifndef CLASSIC_NEW_DELETE
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
-thread_local ChunkStack * MemoryManager::sm_smallStacks = nullptr;
+namespace {
 
-thread_local ChunkStack * MemoryManager::sm_largeStacks = nullptr;
+/**
+ * The size of the block header, the payload follows it on the next cache line boundary.
+ */
+const size_t HEADER_SIZE = 16;
 
-thread_local Buffer * Pool::sm_head = nullptr;
+/**
+ * The number of the pooled size classes, and the class index of the direct allocations.
+ */
+const unsigned int SIZE_CLASS_COUNT = 44;
+const unsigned int DIRECT_CLASS = SIZE_CLASS_COUNT;
 
-ChunkStack * MemoryManager::sm_sequentialSmallStacks = nullptr;
+/**
+ * A thread cache exchanges at most this many blocks, and about BATCH_BYTES bytes with the depot.
+ */
+const unsigned int MAX_BATCH = 32;
+const size_t BATCH_BYTES = 64 * 1024;
 
-ChunkStack * MemoryManager::sm_sequentialLargeStacks = nullptr;
+/**
+ * The minimal size of the slabs carved by the depot.
+ */
+const size_t SLAB_SIZE = 256 * 1024;
 
-Buffer * Pool::sm_sequentialHead = nullptr;
+/**
+ * The direct allocations of at least this size are backed by huge pages, 0 disables them.
+ * It is set once at the initialization, before the solver threads are started.
+ */
+size_t hugePageThreshold = 0;
 
-bool MemoryManager::sm_initialized = false;
+struct BlockHeader {
+    // Next free block in the free lists, or the system allocation of a direct block
+    BlockHeader * m_next;
+    unsigned int m_sizeClass;
+};
 
-#endif
+static_assert(sizeof(BlockHeader) <= HEADER_SIZE, "The block header does not fit");
 
-void release(void * ptr) {
+/**
+ * Free blocks and unmerged statistics of a thread.
+ * It has no constructor and destructor, so it is usable during the whole life of the thread.
+ */
+struct ThreadCache {
+    BlockHeader * m_free[SIZE_CLASS_COUNT];
+    unsigned int m_freeCount[SIZE_CLASS_COUNT];
+    unsigned long long int m_allocations[SIZE_CLASS_COUNT + 1];
+    unsigned long long int m_releases[SIZE_CLASS_COUNT + 1];
+    unsigned long long int m_directBytes;
+    unsigned long long int m_hugePageAllocations;
+    // All allocations of the thread, it is not merged to the depot
+    unsigned long long int m_allocationCount;
+};
 
-#ifndef CACHE_LINE_ALIGNMENT
-    delete [] ptr;
-    return;
-#endif
+thread_local ThreadCache threadCache;
 
-    if (ptr == nullptr) {
-        return;
+/**
+ * Returns the cached blocks of the thread to the depot when the thread exits.
+ */
+struct ThreadCacheReleaser {
+    bool m_used;
+    ~ThreadCacheReleaser() {
+        MemoryManager::releaseThreadCache();
     }
-    //delete [] ptr;
-    //return;
+};
+
+thread_local ThreadCacheReleaser threadCacheReleaser;
+
+/**
+ * Registers the ThreadCacheReleaser of the thread, it is called only on the slow paths.
+ */
+inline void registerThreadCache() {
+    threadCacheReleaser.m_used = true;
+}
+
+/**
+ * The shared free lists, slabs and merged statistics.
+ * Every member has a constant initializer, so the depot is usable before the dynamic
+ * initialization, for example in the library constructor.
+ */
+struct Depot {
+    std::mutex m_lock;
+    BlockHeader * m_free[SIZE_CLASS_COUNT] = {};
+    char * m_slabPosition[SIZE_CLASS_COUNT] = {};
+    char * m_slabEnd[SIZE_CLASS_COUNT] = {};
+    unsigned long long int m_allocations[SIZE_CLASS_COUNT + 1] = {};
+    unsigned long long int m_releases[SIZE_CLASS_COUNT + 1] = {};
+    unsigned long long int m_refills[SIZE_CLASS_COUNT + 1] = {};
+    unsigned long long int m_returns[SIZE_CLASS_COUNT + 1] = {};
+    unsigned long long int m_reservedBytes[SIZE_CLASS_COUNT + 1] = {};
+    unsigned long long int m_hugePageAllocations = 0;
+};
+
+Depot depot;
+
+/**
+ * Size classes: 64, 128, 192 and 256 bytes, then four classes in every power of two,
+ * the header included.
+ */
+inline unsigned int getSizeClass(size_t size) {
+    const size_t units = (size + HEADER_SIZE + MemoryManager::sm_alignment - 1) / MemoryManager::sm_alignment;
+    if (units <= 4) {
+        return units - 1;
+    }
+    const unsigned int shift = 61 - __builtin_clzll(units - 1);
+    return 4 * shift + ((units - 1) >> shift);
+}
+
+inline size_t getBlockBytes(unsigned int sizeClass) {
+    if (sizeClass < 4) {
+        return (sizeClass + 1) * MemoryManager::sm_alignment;
+    }
+    const unsigned int shift = sizeClass / 4 - 1;
+    return ((size_t)(sizeClass % 4 + 5) << shift) * MemoryManager::sm_alignment;
+}
+
+inline unsigned int getBatchSize(unsigned int sizeClass) {
+    const size_t count = BATCH_BYTES / getBlockBytes(sizeClass);
+    return count < 1 ? 1 : (count > MAX_BATCH ? MAX_BATCH : count);
+}
+
+/**
+ * Returns the address of the first block header of a new slab, the payloads are aligned.
+ * malloc aligns to 16 bytes only, so the first payload can start almost two cache lines
+ * after the start of the allocation.
+ */
+char * allocateSlab(size_t bytes) {
+    char * slab = static_cast<char*>(malloc(bytes + 2 * MemoryManager::sm_alignment));
+    if (slab == nullptr) {
+        throw std::bad_alloc();
+    }
+    const size_t misalignment = reinterpret_cast<size_t>(slab) % MemoryManager::sm_alignment;
+    return slab + (MemoryManager::sm_alignment - misalignment) % MemoryManager::sm_alignment
+            + MemoryManager::sm_alignment - HEADER_SIZE;
+}
+
+/**
+ * Moves a batch of blocks from the depot to the cache of the thread, and carves new
+ * blocks if the depot has not enough.
+ */
+void refill(unsigned int sizeClass) {
+    ThreadCache & cache = threadCache;
+    registerThreadCache();
+    const size_t blockBytes = getBlockBytes(sizeClass);
+    const unsigned int batch = getBatchSize(sizeClass);
+    std::lock_guard<std::mutex> lock(depot.m_lock);
+    depot.m_refills[sizeClass]++;
+    unsigned int count;
+    for (count = 0; count < batch; count++) {
+        BlockHeader * header = depot.m_free[sizeClass];
+        if (header != nullptr) {
+            depot.m_free[sizeClass] = header->m_next;
+        } else {
+            if (depot.m_slabPosition[sizeClass] + blockBytes > depot.m_slabEnd[sizeClass]) {
+                const size_t slabBytes = blockBytes < SLAB_SIZE ? SLAB_SIZE / blockBytes * blockBytes : blockBytes;
+                depot.m_slabPosition[sizeClass] = allocateSlab(slabBytes);
+                depot.m_slabEnd[sizeClass] = depot.m_slabPosition[sizeClass] + slabBytes;
+                depot.m_reservedBytes[sizeClass] += slabBytes + 2 * MemoryManager::sm_alignment;
+            }
+            header = reinterpret_cast<BlockHeader*>(depot.m_slabPosition[sizeClass]);
+            header->m_sizeClass = sizeClass;
+            depot.m_slabPosition[sizeClass] += blockBytes;
+        }
+        header->m_next = cache.m_free[sizeClass];
+        cache.m_free[sizeClass] = header;
+    }
+    cache.m_freeCount[sizeClass] += batch;
+}
+
+/**
+ * Returns a batch of blocks from the cache of the thread to the depot.
+ */
+void returnBatch(unsigned int sizeClass) {
+    ThreadCache & cache = threadCache;
+    const unsigned int batch = getBatchSize(sizeClass);
+    BlockHeader * first = cache.m_free[sizeClass];
+    BlockHeader * last = first;
+    unsigned int count;
+    for (count = 1; count < batch; count++) {
+        last = last->m_next;
+    }
+    cache.m_free[sizeClass] = last->m_next;
+    cache.m_freeCount[sizeClass] -= batch;
+
+    std::lock_guard<std::mutex> lock(depot.m_lock);
+    depot.m_returns[sizeClass]++;
+    last->m_next = depot.m_free[sizeClass];
+    depot.m_free[sizeClass] = first;
+}
 
-    char * ptr2 = (char*)ptr;
-    ptr2 -= sizeof(void*);
-#ifdef CLASSIC_NEW_DELETE
-    delete [] *((char**)ptr2);
+/**
+ * Allocates whole huge pages, and advises the system to back them with transparent huge pages.
+ * The pages are not touched, except the first one by the block header.
+ */
+char * allocateHugePages(size_t bytes) {
+#ifdef MADV_HUGEPAGE
+    const size_t hugeBytes = (bytes + MemoryManager::sm_hugePageSize - 1) / MemoryManager::sm_hugePageSize
+            * MemoryManager::sm_hugePageSize;
+    void * system = nullptr;
+    if (posix_memalign(&system, MemoryManager::sm_hugePageSize, hugeBytes) != 0) {
+        return nullptr;
+    }
+    // it is only an advice, the memory is usable with normal pages too
+    madvise(system, hugeBytes, MADV_HUGEPAGE);
+    threadCache.m_hugePageAllocations++;
+    return static_cast<char*>(system);
 #else
-    MemoryManager::release(*((char**)ptr2));
+    __UNUSED(bytes);
+    return nullptr;
 #endif
 }
 
+void * allocateDirect(size_t size) {
+    const size_t bytes = size + 2 * MemoryManager::sm_alignment;
+    char * system = nullptr;
+    if (hugePageThreshold != 0 && size >= hugePageThreshold) {
+        system = allocateHugePages(bytes);
+    }
+    if (system == nullptr) {
+        system = static_cast<char*>(malloc(bytes));
+    }
+    if (system == nullptr) {
+        throw std::bad_alloc();
+    }
+    const size_t misalignment = reinterpret_cast<size_t>(system) % MemoryManager::sm_alignment;
+    char * payload = system + (MemoryManager::sm_alignment - misalignment) % MemoryManager::sm_alignment
+            + MemoryManager::sm_alignment;
+    BlockHeader * header = reinterpret_cast<BlockHeader*>(payload - HEADER_SIZE);
+    header->m_next = reinterpret_cast<BlockHeader*>(system);
+    header->m_sizeClass = DIRECT_CLASS;
+    ThreadCache & cache = threadCache;
+    registerThreadCache();
+    cache.m_allocations[DIRECT_CLASS]++;
+    cache.m_allocationCount++;
+    cache.m_directBytes += size;
+    return payload;
+}
+
+}
+
+void * MemoryManager::allocate(size_t size) {
+    if (unlikely(size > sm_maxPooledSize)) {
+        return allocateDirect(size);
+    }
+    const unsigned int sizeClass = getSizeClass(size);
+    ThreadCache & cache = threadCache;
+    if (unlikely(cache.m_free[sizeClass] == nullptr)) {
+        refill(sizeClass);
+    }
+    BlockHeader * header = cache.m_free[sizeClass];
+    cache.m_free[sizeClass] = header->m_next;
+    cache.m_freeCount[sizeClass]--;
+    cache.m_allocations[sizeClass]++;
+    cache.m_allocationCount++;
+    return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+unsigned long long int MemoryManager::getAllocationCount() {
+    return threadCache.m_allocationCount;
+}
+
+void MemoryManager::countAllocation() {
+    threadCache.m_allocationCount++;
+}
+
+void MemoryManager::release(void * pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    BlockHeader * header = reinterpret_cast<BlockHeader*>(static_cast<char*>(pointer) - HEADER_SIZE);
+    const unsigned int sizeClass = header->m_sizeClass;
+    ThreadCache & cache = threadCache;
+    cache.m_releases[sizeClass]++;
+    if (unlikely(sizeClass == DIRECT_CLASS)) {
+        registerThreadCache();
+        free(header->m_next);
+        return;
+    }
+    header->m_next = cache.m_free[sizeClass];
+    cache.m_free[sizeClass] = header;
+    if (unlikely(header->m_next == nullptr)) {
+        // the first cached block of the class, the thread may never allocate
+        registerThreadCache();
+    }
+    if (unlikely(++cache.m_freeCount[sizeClass] > 2 * getBatchSize(sizeClass))) {
+        returnBatch(sizeClass);
+    }
+}
+
+void MemoryManager::releaseThreadCache() {
+    ThreadCache & cache = threadCache;
+    std::lock_guard<std::mutex> lock(depot.m_lock);
+    unsigned int sizeClass;
+    for (sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; sizeClass++) {
+        while (cache.m_free[sizeClass] != nullptr) {
+            BlockHeader * header = cache.m_free[sizeClass];
+            cache.m_free[sizeClass] = header->m_next;
+            header->m_next = depot.m_free[sizeClass];
+            depot.m_free[sizeClass] = header;
+        }
+        cache.m_freeCount[sizeClass] = 0;
+    }
+    for (sizeClass = 0; sizeClass <= SIZE_CLASS_COUNT; sizeClass++) {
+        depot.m_allocations[sizeClass] += cache.m_allocations[sizeClass];
+        depot.m_releases[sizeClass] += cache.m_releases[sizeClass];
+        cache.m_allocations[sizeClass] = 0;
+        cache.m_releases[sizeClass] = 0;
+    }
+    depot.m_reservedBytes[DIRECT_CLASS] += cache.m_directBytes;
+    cache.m_directBytes = 0;
+    depot.m_hugePageAllocations += cache.m_hugePageAllocations;
+    cache.m_hugePageAllocations = 0;
+}
+
+std::vector<MemoryStatistics> MemoryManager::getStatistics() {
+    const ThreadCache & cache = threadCache;
+    std::vector<MemoryStatistics> result(SIZE_CLASS_COUNT + 1);
+    std::lock_guard<std::mutex> lock(depot.m_lock);
+    unsigned int sizeClass;
+    for (sizeClass = 0; sizeClass <= SIZE_CLASS_COUNT; sizeClass++) {
+        MemoryStatistics & statistics = result[sizeClass];
+        statistics.m_blockSize = sizeClass < SIZE_CLASS_COUNT ? getBlockBytes(sizeClass) - HEADER_SIZE : 0;
+        statistics.m_allocations = depot.m_allocations[sizeClass] + cache.m_allocations[sizeClass];
+        statistics.m_releases = depot.m_releases[sizeClass] + cache.m_releases[sizeClass];
+        statistics.m_refills = depot.m_refills[sizeClass];
+        statistics.m_returns = depot.m_returns[sizeClass];
+        statistics.m_reservedBytes = depot.m_reservedBytes[sizeClass];
+        statistics.m_hugePageAllocations = 0;
+    }
+    result[DIRECT_CLASS].m_reservedBytes += cache.m_directBytes;
+    result[DIRECT_CLASS].m_hugePageAllocations = depot.m_hugePageAllocations + cache.m_hugePageAllocations;
+    return result;
+}
+
+void MemoryManager::printStatistics() {
+    const std::vector<MemoryStatistics> statistics = getStatistics();
+    LPINFO("Memory manager statistics");
+    LPINFO(std::setw(10) << "Block size" << std::setw(14) << "Allocations" << std::setw(14) << "Releases"
+           << std::setw(10) << "Refills" << std::setw(10) << "Returns" << std::setw(14) << "Reserved"
+           << std::setw(12) << "Huge pages");
+    for (const MemoryStatistics & sizeClass: statistics) {
+        if (sizeClass.m_allocations == 0 && sizeClass.m_releases == 0) {
+            continue;
+        }
+        std::ostringstream blockSize;
+        if (sizeClass.m_blockSize == 0) {
+            blockSize << "direct";
+        } else {
+            blockSize << sizeClass.m_blockSize;
+        }
+        LPINFO(std::setw(10) << blockSize.str() << std::setw(14) << sizeClass.m_allocations
+               << std::setw(14) << sizeClass.m_releases << std::setw(10) << sizeClass.m_refills
+               << std::setw(10) << sizeClass.m_returns << std::setw(14) << sizeClass.m_reservedBytes
+               << std::setw(12) << sizeClass.m_hugePageAllocations);
+    }
+}
+
+void MemoryManager::setHugePageThreshold(size_t size) {
+    hugePageThreshold = size;
+}
+
+void release(void * ptr) {
+    MemoryManager::release(ptr);
+}
+
 void panOptMemcpy(void * dest,
                   const void * src,
                   size_t size) {
     //memcpy(dest, src, size);
     //return;
-    if (likely(size < Architecture::getLargestCacheSize() )) {
+    if (likely(size < Architecture::getNonTemporalCopyLimit() )) {
         Architecture::getMemCpyCache()(dest, src, size);
     } else {
         Architecture::getMemCpyNoCache()(dest, src, size);
@@ -0,0 +1,102 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file namepool.cpp
+ */
+
+#include <utils/namepool.h>
+#include <cstdlib>
+#include <new>
+
+NamePool::NamePool():
+    m_next(0),
+    m_end(0),
+    m_size(0),
+    m_references(0)
+{
+
+}
+
+NamePool::~NamePool()
+{
+    // the blocks bypass the memory manager, since they can outlive it
+    std::vector<char*>::iterator iter = m_blocks.begin();
+    std::vector<char*>::iterator iterEnd = m_blocks.end();
+    for (; iter != iterEnd; ++iter) {
+        free(*iter);
+    }
+}
+
+void NamePool::acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_references++;
+}
+
+void NamePool::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_references--;
+    if (m_references > 0) {
+        return;
+    }
+    std::vector<char*>::iterator iter = m_blocks.begin();
+    std::vector<char*>::iterator iterEnd = m_blocks.end();
+    for (; iter != iterEnd; ++iter) {
+        free(*iter);
+    }
+    m_blocks.clear();
+    m_next = 0;
+    m_end = 0;
+    m_size = 0;
+}
+
+NamePool & NamePool::getInstance()
+{
+    static NamePool instance;
+    return instance;
+}
+
+PooledName NamePool::add(const char * name)
+{
+    if (name == 0 || name[0] == 0) {
+        return PooledName();
+    }
+    const size_t length = strlen(name) + 1;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (unlikely(m_next + length > m_end)) {
+        const size_t blockSize = length > BLOCK_SIZE ? length : BLOCK_SIZE;
+        char * block = static_cast<char*>(malloc(blockSize));
+        if (block == 0) {
+            throw std::bad_alloc();
+        }
+        m_blocks.push_back(block);
+        m_next = block;
+        m_end = block + blockSize;
+    }
+    char * result = m_next;
+    memcpy(result, name, length);
+    m_next += length;
+    m_size += length;
+    return PooledName(result);
+}
+
+size_t NamePool::getSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
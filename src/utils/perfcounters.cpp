@@ -0,0 +1,255 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file perfcounters.cpp
+ */
+
+#include <utils/perfcounters.h>
+#include <debug.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#if defined(UNIX) && defined(__linux__)
+#define PERF_EVENTS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef PERF_EVENTS
+
+/**
+ * The perf_event configuration of the counters, in the order of PerfCounters::COUNTER.
+ */
+const unsigned long long int COUNTER_CONFIGS[PerfCounters::COUNTER_COUNT] = {
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+const char * COUNTER_NAMES[PerfCounters::COUNTER_COUNT] = {
+    "instructions",
+    "cycles",
+    "LLC misses",
+    "branch misses"
+};
+
+/**
+ * The counter group of a thread.
+ */
+struct ThreadCounters {
+    bool m_opened;
+    int m_leader;
+    int m_fds[PerfCounters::COUNTER_COUNT];
+    // the position of each counter in the group read, -1 if unsupported
+    int m_positions[PerfCounters::COUNTER_COUNT];
+    int m_counterCount;
+
+    ThreadCounters(): m_opened(false), m_leader(-1), m_counterCount(0) {
+        unsigned int index;
+        for (index = 0; index < PerfCounters::COUNTER_COUNT; index++) {
+            m_fds[index] = -1;
+            m_positions[index] = -1;
+        }
+    }
+
+    ~ThreadCounters() {
+        unsigned int index;
+        for (index = 0; index < PerfCounters::COUNTER_COUNT; index++) {
+            if (m_fds[index] >= 0) {
+                close(m_fds[index]);
+            }
+        }
+    }
+};
+
+thread_local ThreadCounters sm_threadCounters;
+
+/**
+ * Set when the missing counters have been reported once.
+ */
+std::atomic<bool> sm_warned(false);
+
+int openCounter(unsigned long long int config, int groupFd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    // user space only, this is allowed with the default perf_event_paranoid settings
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+ThreadCounters & getThreadCounters()
+{
+    ThreadCounters & counters = sm_threadCounters;
+    if (likely(counters.m_opened)) {
+        return counters;
+    }
+    counters.m_opened = true;
+    unsigned int index;
+    for (index = 0; index < PerfCounters::COUNTER_COUNT; index++) {
+        const int fd = openCounter(COUNTER_CONFIGS[index], counters.m_leader);
+        if (fd < 0) {
+            if (!sm_warned.exchange(true)) {
+                LPWARNING("Hardware performance counter of " << COUNTER_NAMES[index] << " is not available: " << strerror(errno));
+            }
+            if (counters.m_leader == -1) {
+                // without the instruction counter the group is useless
+                return counters;
+            }
+            continue;
+        }
+        if (counters.m_leader == -1) {
+            counters.m_leader = fd;
+        }
+        counters.m_fds[index] = fd;
+        counters.m_positions[index] = counters.m_counterCount++;
+    }
+    ioctl(counters.m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters.m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return counters;
+}
+
+#endif
+
+}
+
+bool PerfCounters::isAvailable()
+{
+#ifdef PERF_EVENTS
+    return getThreadCounters().m_leader != -1;
+#else
+    return false;
+#endif
+}
+
+bool PerfCounters::isSupported(COUNTER counter)
+{
+#ifdef PERF_EVENTS
+    return getThreadCounters().m_positions[counter] != -1;
+#else
+    __UNUSED(counter);
+    return false;
+#endif
+}
+
+bool PerfCounters::read(Values * values)
+{
+    memset(values, 0, sizeof(Values));
+#ifdef PERF_EVENTS
+    const ThreadCounters & counters = getThreadCounters();
+    if (counters.m_leader == -1) {
+        return false;
+    }
+    // number of counters, time enabled, time running, values
+    unsigned long long int buffer[3 + COUNTER_COUNT];
+    if (::read(counters.m_leader, buffer, sizeof(buffer)) <= 0) {
+        return false;
+    }
+    const unsigned long long int timeEnabled = buffer[1];
+    const unsigned long long int timeRunning = buffer[2];
+    unsigned int index;
+    for (index = 0; index < COUNTER_COUNT; index++) {
+        if (counters.m_positions[index] == -1) {
+            continue;
+        }
+        unsigned long long int count = buffer[3 + counters.m_positions[index]];
+        // the counters are scaled if the kernel had to multiplex them
+        if (timeRunning > 0 && timeRunning < timeEnabled) {
+            count = (unsigned long long int)((double)count * timeEnabled / timeRunning);
+        }
+        values->m_counts[index] = count;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned int PerfCounters::getCacheLineSize()
+{
+#if defined(PERF_EVENTS) && defined(_SC_LEVEL1_DCACHE_LINESIZE)
+    const long size = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    if (size > 0) {
+        return size;
+    }
+#endif
+    return 64;
+}
+
+PerfCounterPhase::PerfCounterPhase():
+    m_enabled(false),
+    m_running(false)
+{
+    reset();
+}
+
+void PerfCounterPhase::setEnabled(bool enabled)
+{
+    m_enabled = enabled && PerfCounters::isAvailable();
+}
+
+void PerfCounterPhase::reset()
+{
+    memset(&m_start, 0, sizeof(m_start));
+    memset(&m_total, 0, sizeof(m_total));
+    m_running = false;
+}
+
+void PerfCounterPhase::accumulate()
+{
+    if (!m_running) {
+        return;
+    }
+    PerfCounters::Values end;
+    if (PerfCounters::read(&end)) {
+        unsigned int index;
+        for (index = 0; index < PerfCounters::COUNTER_COUNT; index++) {
+            // the scaling of multiplexed counters can make them decrease slightly
+            if (end.m_counts[index] > m_start.m_counts[index]) {
+                m_total.m_counts[index] += end.m_counts[index] - m_start.m_counts[index];
+            }
+        }
+    }
+    m_running = false;
+}
+
+double PerfCounterPhase::getInstructionsPerCycle() const
+{
+    const unsigned long long int cycles = m_total.m_counts[PerfCounters::CYCLES];
+    if (cycles == 0) {
+        return 0;
+    }
+    return (double)m_total.m_counts[PerfCounters::INSTRUCTIONS] / cycles;
+}
+
+double PerfCounterPhase::getBytesMoved() const
+{
+    return (double)m_total.m_counts[PerfCounters::LLC_MISSES] * PerfCounters::getCacheLineSize();
+}
@@ -22,6 +22,23 @@ union Number {
     unsigned long long int m_bits;
 };
 
+/**
+ * Adds the product to the positive or to the negative sum depending on its sign bit.
+ * It uses only bit masks, so the loops of the stable dot products have no data dependent
+ * branches, and the compiler can vectorize them.
+ */
+static inline void addBySign(Numerical::Double product,
+                             Numerical::Double & pos,
+                             Numerical::Double & neg) {
+    Number number, positive, negative;
+    number.m_num = product;
+    const unsigned long long int mask = 0ULL - (number.m_bits >> 63);
+    positive.m_bits = number.m_bits & ~mask;
+    negative.m_bits = number.m_bits & mask;
+    pos += positive.m_num;
+    neg += negative.m_num;
+}
+
 bool __prim_debug = false;
 
 void doNothing_seriously_nothing() {
@@ -71,24 +88,22 @@ Numerical::Double denseToDenseDotProductStable(const Numerical::Double * __restr
                                                size_t count,
                                                Numerical::Double * __restrict__ negPtr) {
 #if DOUBLE_TYPE == DOUBLE_CLASSIC
-    Numerical::Double negpos1[2] = {0.0, 0.0};
-    Numerical::Double negpos2[2] = {0.0, 0.0};
-    Number num1, num2;
-    unsigned int index;
-    unsigned int one = count % 2;
-    count -= one;
-    for (index = 0; index < count; index += 2) {
-        num1.m_num = vec1[index] * vec2[index];
-        num2.m_num = vec1[index + 1] * vec2[index + 1];
-        *(negpos1 + (num1.m_bits >> 63)) += num1.m_num;
-        *(negpos2 + (num2.m_bits >> 63)) += num2.m_num;
+    Numerical::Double pos1 = 0.0, pos2 = 0.0, pos3 = 0.0, pos4 = 0.0;
+    Numerical::Double neg1 = 0.0, neg2 = 0.0, neg3 = 0.0, neg4 = 0.0;
+    size_t index;
+    const size_t rest = count % 4;
+    count -= rest;
+    for (index = 0; index < count; index += 4) {
+        addBySign(vec1[index] * vec2[index], pos1, neg1);
+        addBySign(vec1[index + 1] * vec2[index + 1], pos2, neg2);
+        addBySign(vec1[index + 2] * vec2[index + 2], pos3, neg3);
+        addBySign(vec1[index + 3] * vec2[index + 3], pos4, neg4);
     }
-    if (one == 1) {
-        num1.m_num = vec1[count] * vec2[count];
-        *(negpos1 + (num1.m_bits >> 63)) += num1.m_num;
+    for (index = count; index < count + rest; index++) {
+        addBySign(vec1[index] * vec2[index], pos1, neg1);
     }
-    *negPtr = negpos1[1] + negpos2[1];
-    return negpos1[0] + negpos2[0];
+    *negPtr = (neg1 + neg2) + (neg3 + neg4);
+    return (pos1 + pos2) + (pos3 + pos4);
 #else
     unsigned int index;
     Numerical::Double neg = 0.0;
@@ -112,48 +127,22 @@ Numerical::Double denseToSparseDotProductStable(const Numerical::Double * __rest
                                                 size_t count,
                                                 Numerical::Double * __restrict__ negPtr) {
 #if DOUBLE_TYPE == DOUBLE_CLASSIC
-    Numerical::Double negpos1[2] = {0.0, 0.0};
-    Numerical::Double negpos2[2] = {0.0, 0.0};
-    Number num1, num2;
-    unsigned int index;
-    unsigned int one = count % 2;
-
-    /*if (__prim_debug) {
-        LPINFO("SIZE = " << count);
-    }*/
-
-    count -= one;
-    for (index = 0; index < count; index += 2) {
-        /*if (__prim_debug) {
-            LPINFO(index << " - " << index + 1);
-        }*/
-        num1.m_num = dense[ indices[index] ] * sparse[index];
-        num2.m_num = dense[ indices[index + 1] ] * sparse[index + 1];
-        /*if (__prim_debug) {
-            LPINFO(dense[ indices[index] ] << " * " << sparse[index]);
-            LPINFO(dense[ indices[index + 1] ] << " * " << sparse[index + 1]);
-        }*/
-        *(negpos1 + (num1.m_bits >> 63)) += num1.m_num;
-        *(negpos1 + (num2.m_bits >> 63)) += num2.m_num;
+    Numerical::Double pos1 = 0.0, pos2 = 0.0, pos3 = 0.0, pos4 = 0.0;
+    Numerical::Double neg1 = 0.0, neg2 = 0.0, neg3 = 0.0, neg4 = 0.0;
+    size_t index;
+    const size_t rest = count % 4;
+    count -= rest;
+    for (index = 0; index < count; index += 4) {
+        addBySign(dense[ indices[index] ] * sparse[index], pos1, neg1);
+        addBySign(dense[ indices[index + 1] ] * sparse[index + 1], pos2, neg2);
+        addBySign(dense[ indices[index + 2] ] * sparse[index + 2], pos3, neg3);
+        addBySign(dense[ indices[index + 3] ] * sparse[index + 3], pos4, neg4);
     }
-
-    if (one == 1) {
-        /*    if (__prim_debug == true) {
-            LPINFO(count);
-        }*/
-        num1.m_num = dense[ indices[count] ] * sparse[count];
-        *(negpos1 + (num1.m_bits >> 63)) += num1.m_num;
-    }
-
-    /*if (__prim_debug) {
-        LPERROR(negpos1[1] << " + " << negpos2[1] << " = " << negpos1[1] + negpos2[1]);
-        LPERROR(negpos1[0] << " + " << negpos2[0] << " = " << negpos1[0] + negpos2[0]);
+    for (index = count; index < count + rest; index++) {
+        addBySign(dense[ indices[index] ] * sparse[index], pos1, neg1);
     }
-    if (__prim_debug) {
-        std::cin.get();
-    }*/
-    *negPtr = negpos1[1] + negpos2[1];
-    return negpos1[0] + negpos2[0];
+    *negPtr = (neg1 + neg2) + (neg3 + neg4);
+    return (pos1 + pos2) + (pos3 + pos4);
 #else
     unsigned int index;
     Numerical::Double neg = 0.0;
@@ -200,29 +189,27 @@ Numerical::Double indexedDenseToIndexedDenseDotProductStable(const Numerical::Do
                                                              size_t nonZeroCount,
                                                              Numerical::Double * __restrict__ negPtr) {
 #if DOUBLE_TYPE == DOUBLE_CLASSIC
-    Numerical::Double negpos[2] = {0.0, 0.0};
-    Number num1, num2;
-    unsigned int nonZeroIndex;
-    unsigned int one = nonZeroCount % 2;
-
-    nonZeroCount -= one;
-    for (nonZeroIndex = 0; nonZeroIndex < nonZeroCount; nonZeroIndex += 2) {
+    Numerical::Double pos1 = 0.0, pos2 = 0.0, pos3 = 0.0, pos4 = 0.0;
+    Numerical::Double neg1 = 0.0, neg2 = 0.0, neg3 = 0.0, neg4 = 0.0;
+    size_t nonZeroIndex;
+    const size_t rest = nonZeroCount % 4;
+    nonZeroCount -= rest;
+    for (nonZeroIndex = 0; nonZeroIndex < nonZeroCount; nonZeroIndex += 4) {
         const unsigned int index1 = indices[nonZeroIndex];
-        num1.m_num = dense1[ index1 ] * dense2[index1];
         const unsigned int index2 = indices[nonZeroIndex + 1];
-        num2.m_num = dense1[ index2 ] * dense2[index2];
-        *(negpos + (num1.m_bits >> 63)) += num1.m_num;
-        *(negpos + (num2.m_bits >> 63)) += num2.m_num;
+        const unsigned int index3 = indices[nonZeroIndex + 2];
+        const unsigned int index4 = indices[nonZeroIndex + 3];
+        addBySign(dense1[index1] * dense2[index1], pos1, neg1);
+        addBySign(dense1[index2] * dense2[index2], pos2, neg2);
+        addBySign(dense1[index3] * dense2[index3], pos3, neg3);
+        addBySign(dense1[index4] * dense2[index4], pos4, neg4);
     }
-
-    if (one == 1) {
-        const unsigned int index = indices[nonZeroCount];
-        num1.m_num = dense1[index] * dense2[index];
-        *(negpos + (num1.m_bits >> 63)) += num1.m_num;
+    for (nonZeroIndex = nonZeroCount; nonZeroIndex < nonZeroCount + rest; nonZeroIndex++) {
+        const unsigned int index = indices[nonZeroIndex];
+        addBySign(dense1[index] * dense2[index], pos1, neg1);
     }
-
-    *negPtr = negpos[1];
-    return negpos[0];
+    *negPtr = (neg1 + neg2) + (neg3 + neg4);
+    return (pos1 + pos2) + (pos3 + pos4);
 #else
     unsigned int nonZeroIndex;
     Numerical::Double neg = 0.0;
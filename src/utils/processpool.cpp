@@ -0,0 +1,219 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file processpool.cpp
+ */
+
+#include <utils/processpool.h>
+#include <utils/exceptions.h>
+#include <debug.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifdef UNIX
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+ProcessPool::ProcessPool(unsigned int processCount, unsigned int timeout):
+    m_processCount(processCount > 0 ? processCount : 1),
+    m_timeout(timeout)
+{
+
+}
+
+void ProcessPool::copyFile(const std::string & fileName, std::ostream & target)
+{
+    std::ifstream source(fileName.c_str(), std::ios::binary);
+    if (source.is_open() && source.peek() != std::ifstream::traits_type::eof()) {
+        target << source.rdbuf();
+    }
+}
+
+/**
+ * Runs a task, and returns true if it succeeded.
+ */
+static bool runTask(const ProcessPool::Task & task, unsigned int index, const std::string & resultName)
+{
+    try {
+        return task(index, resultName);
+    } catch (const PanOptException & exception) {
+        LPERROR(exception.getMessage());
+    } catch (const std::exception & exception) {
+        LPERROR(exception.what());
+    }
+    return false;
+}
+
+#ifdef UNIX
+
+namespace {
+
+struct Worker {
+    pid_t m_pid;
+    std::chrono::steady_clock::time_point m_start;
+    bool m_running;
+    bool m_finished;
+    bool m_killed;
+    ProcessPool::TASK_RESULT m_result;
+};
+
+}
+
+void ProcessPool::run(unsigned int count, const std::vector<unsigned long long int> & priorities,
+                      const Task & task, const Report & report)
+{
+    char tempDirTemplate[] = "/tmp/panopt.XXXXXX";
+    const char * tempDir = mkdtemp(tempDirTemplate);
+    if (tempDir == 0) {
+        LPERROR("Unable to create a temporary directory for the worker processes");
+        return;
+    }
+    std::vector<Worker> workers(count);
+    std::vector<unsigned int> schedule(count);
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        workers[index].m_pid = 0;
+        workers[index].m_running = false;
+        workers[index].m_finished = false;
+        workers[index].m_killed = false;
+        workers[index].m_result = FAILED;
+        schedule[index] = index;
+    }
+    if (priorities.size() == count) {
+        std::stable_sort(schedule.begin(), schedule.end(), [&priorities](unsigned int left, unsigned int right) {
+            return priorities[left] > priorities[right];
+        });
+    }
+    const std::string logPrefix = std::string(tempDir) + "/";
+
+    unsigned int started = 0;
+    unsigned int running = 0;
+    unsigned int reported = 0;
+    while (reported < count) {
+        while (running < m_processCount && started < count) {
+            const unsigned int taskIndex = schedule[started++];
+            Worker & worker = workers[taskIndex];
+            const std::string logName = logPrefix + std::to_string(taskIndex) + ".log";
+            const std::string resultName = logPrefix + std::to_string(taskIndex) + ".out";
+            std::cout.flush();
+            std::cerr.flush();
+            fflush(0);
+            worker.m_start = std::chrono::steady_clock::now();
+            worker.m_pid = fork();
+            if (worker.m_pid < 0) {
+                LPERROR("Unable to start a worker process");
+                worker.m_finished = true;
+                continue;
+            }
+            if (worker.m_pid == 0) {
+                const int logFd = open(logName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if (logFd >= 0) {
+                    dup2(logFd, STDOUT_FILENO);
+                    dup2(logFd, STDERR_FILENO);
+                    close(logFd);
+                }
+                const bool succeeded = runTask(task, taskIndex, resultName);
+                std::cout.flush();
+                std::cerr.flush();
+                fflush(0);
+                // the singletons belong to the parent, they must not be released by the worker
+                _exit(succeeded ? EXIT_SUCCESS : EXIT_FAILURE);
+            }
+            worker.m_running = true;
+            running++;
+        }
+
+        bool changed = false;
+        int status;
+        pid_t pid;
+        while (running > 0 && (pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            for (index = 0; index < count; index++) {
+                Worker & worker = workers[index];
+                if (worker.m_running && worker.m_pid == pid) {
+                    if (worker.m_killed) {
+                        worker.m_result = TIMED_OUT;
+                    } else if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+                        worker.m_result = SUCCEEDED;
+                    } else {
+                        worker.m_result = FAILED;
+                    }
+                    worker.m_running = false;
+                    worker.m_finished = true;
+                    running--;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+
+        if (m_timeout > 0) {
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            for (index = 0; index < count; index++) {
+                Worker & worker = workers[index];
+                if (worker.m_running && !worker.m_killed &&
+                        now - worker.m_start >= std::chrono::seconds(m_timeout)) {
+                    kill(worker.m_pid, SIGKILL);
+                    worker.m_killed = true;
+                }
+            }
+        }
+
+        while (reported < count && workers[reported].m_finished) {
+            const std::string logName = logPrefix + std::to_string(reported) + ".log";
+            const std::string resultName = logPrefix + std::to_string(reported) + ".out";
+            report(reported, workers[reported].m_result, logName, resultName);
+            remove(logName.c_str());
+            remove(resultName.c_str());
+            reported++;
+            changed = true;
+        }
+
+        if (!changed) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    rmdir(tempDir);
+}
+
+#else
+
+void ProcessPool::run(unsigned int count, const std::vector<unsigned long long int> &,
+                      const Task & task, const Report & report)
+{
+    // without fork() the tasks share the process, so they run one after the other
+    if (count > 1) {
+        LPWARNING("Process pool is not supported on this platform, the " << count << " tasks are solved sequentially");
+    }
+    unsigned int index;
+    for (index = 0; index < count; index++) {
+        const std::string resultName = std::string("panopt_task_") + std::to_string(index) + ".out";
+        const bool succeeded = runTask(task, index, resultName);
+        report(index, succeeded ? SUCCEEDED : FAILED, std::string(), resultName);
+        remove(resultName.c_str());
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file profiler.cpp
+ */
+
+#include <utils/profiler.h>
+#include <debug.h>
+
+#include <iomanip>
+#include <sstream>
+
+struct Profiler::ThreadData {
+    /**
+     * The call tree of the thread, the first node is the root.
+     */
+    std::vector<Node> m_nodes;
+
+    /**
+     * The node of the innermost open zone.
+     */
+    unsigned int m_current;
+
+    ThreadData(): m_current(0) {
+        Node root = {0, 0, 0, 0, 0, 0};
+        m_nodes.push_back(root);
+    }
+
+    ~ThreadData() {
+        Profiler::getInstance().merge(this);
+    }
+};
+
+static thread_local Profiler::ThreadData sm_threadData;
+
+Profiler::Profiler():
+    m_startTicks(getTicks()),
+    m_startTime(std::chrono::steady_clock::now())
+{
+    Node root = {0, 0, 0, 0, 0, 0};
+    m_nodes.push_back(root);
+}
+
+Profiler & Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+unsigned int Profiler::registerZone(const char * name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned int index;
+    for (index = 0; index < m_zoneNames.size(); index++) {
+        if (m_zoneNames[index] == name) {
+            return index;
+        }
+    }
+    m_zoneNames.push_back(name);
+    return index;
+}
+
+unsigned int Profiler::getChild(std::vector<Node> * nodes, unsigned int parent, unsigned int zone)
+{
+    // the root is never a child, so 0 marks the end of the sibling lists
+    unsigned int child = (*nodes)[parent].m_firstChild;
+    unsigned int last = 0;
+    while (child != 0) {
+        if ((*nodes)[child].m_zone == zone) {
+            return child;
+        }
+        last = child;
+        child = (*nodes)[child].m_nextSibling;
+    }
+    Node node = {zone, parent, 0, 0, 0, 0};
+    child = nodes->size();
+    nodes->push_back(node);
+    if (last == 0) {
+        (*nodes)[parent].m_firstChild = child;
+    } else {
+        (*nodes)[last].m_nextSibling = child;
+    }
+    return child;
+}
+
+void Profiler::enter(unsigned int zone)
+{
+    ThreadData & data = sm_threadData;
+    data.m_current = getChild(&data.m_nodes, data.m_current, zone);
+}
+
+void Profiler::leave(unsigned long long int ticks)
+{
+    ThreadData & data = sm_threadData;
+    Node & node = data.m_nodes[data.m_current];
+    node.m_calls++;
+    node.m_ticks += ticks;
+    data.m_current = node.m_parent;
+}
+
+void Profiler::merge(ThreadData * data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the nodes are created before their children, so the parents are mapped first
+    std::vector<unsigned int> target(data->m_nodes.size(), 0);
+    unsigned int index;
+    for (index = 1; index < data->m_nodes.size(); index++) {
+        Node & node = data->m_nodes[index];
+        target[index] = getChild(&m_nodes, target[node.m_parent], node.m_zone);
+        m_nodes[target[index]].m_calls += node.m_calls;
+        m_nodes[target[index]].m_ticks += node.m_ticks;
+        // the nodes are kept, since zones may still be open on the thread
+        node.m_calls = 0;
+        node.m_ticks = 0;
+    }
+}
+
+void Profiler::writeNode(unsigned int node, unsigned int depth, double secondsPerTick) const
+{
+    unsigned long long int childTicks = 0;
+    unsigned int child;
+    for (child = m_nodes[node].m_firstChild; child != 0; child = m_nodes[child].m_nextSibling) {
+        childTicks += m_nodes[child].m_ticks;
+    }
+    if (node != 0 && m_nodes[node].m_calls > 0) {
+        const Node & current = m_nodes[node];
+        const unsigned long long int parentTicks = m_nodes[current.m_parent].m_ticks;
+        std::ostringstream line;
+        line << std::setw(depth * 2) << "" << std::left << std::setw(40 - depth * 2)
+             << m_zoneNames[current.m_zone] << std::right
+             << std::setw(12) << current.m_calls
+             << std::fixed << std::setprecision(6)
+             << std::setw(14) << current.m_ticks * secondsPerTick
+             << std::setw(14) << (current.m_ticks - childTicks) * secondsPerTick;
+        if (current.m_parent != 0 && parentTicks > 0) {
+            line << std::setprecision(1) << std::setw(9) << 100.0 * current.m_ticks / parentTicks << "%";
+        }
+        LPINFO(line.str());
+    }
+    for (child = m_nodes[node].m_firstChild; child != 0; child = m_nodes[child].m_nextSibling) {
+        writeNode(child, node == 0 ? 0 : depth + 1, secondsPerTick);
+    }
+}
+
+void Profiler::writeReport()
+{
+    merge(&sm_threadData);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const unsigned long long int ticks = getTicks() - m_startTicks;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+    const double secondsPerTick = ticks > 0 ? seconds / ticks : 0.0;
+
+    LPINFO("***** PROFILE REPORT *****");
+    std::ostringstream header;
+    header << std::left << std::setw(40) << "Zone" << std::right << std::setw(12) << "Calls"
+           << std::setw(14) << "Total [s]" << std::setw(14) << "Self [s]" << std::setw(10) << "Parent";
+    LPINFO(header.str());
+    writeNode(0, 0, secondsPerTick);
+
+    std::vector<Node>::iterator iter = m_nodes.begin();
+    std::vector<Node>::iterator iterEnd = m_nodes.end();
+    for (; iter != iterEnd; ++iter) {
+        iter->m_calls = 0;
+        iter->m_ticks = 0;
+    }
+    m_startTicks = getTicks();
+    m_startTime = std::chrono::steady_clock::now();
+}
@@ -15,6 +15,14 @@
 //=================================================================================================
 
 #include <utils/thread.h>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 std::mutex ThreadSupervisor::sm_mutex;
 
@@ -22,6 +30,45 @@ std::set<unsigned int> * ThreadSupervisor::sm_threadIds = nullptr;
 
 thread_local unsigned int ThreadSupervisor::sm_myThreadId = 0;
 
+std::vector<std::vector<unsigned int> > * ThreadSupervisor::sm_numaNodes = nullptr;
+
+namespace {
+
+/**
+ * Parses a list in the format of the sysfs cpulist files, for example "0-3,8,10-11".
+ */
+std::vector<unsigned int> parseIndexList(const std::string & list) {
+    std::vector<unsigned int> result;
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        unsigned int first = 0;
+        unsigned int last = 0;
+        char separator = 0;
+        std::istringstream rangeStream(range);
+        if (!(rangeStream >> first)) {
+            continue;
+        }
+        last = first;
+        if (rangeStream >> separator && separator == '-') {
+            rangeStream >> last;
+        }
+        for (; first <= last; first++) {
+            result.push_back(first);
+        }
+    }
+    return result;
+}
+
+std::string readLine(const std::string & fileName) {
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+}
+
 unsigned int ThreadSupervisor::registerMyThread() {
     sm_mutex.lock();
     sm_myThreadId = 0;
@@ -39,13 +86,84 @@ void ThreadSupervisor::unregisterMyThread() {
     sm_mutex.unlock();
 }
 
+unsigned int ThreadSupervisor::parallelFor(unsigned int threadCount, unsigned int count,
+                                           const std::function<void(unsigned int, unsigned int, unsigned int)> & function) {
+    const unsigned int chunks = threadCount < count ? threadCount : count;
+    if (chunks <= 1) {
+        function(0, count, 0);
+        return 1;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    const unsigned int chunkSize = count / chunks;
+    const unsigned int remainder = count % chunks;
+    unsigned int begin = 0;
+    unsigned int chunk;
+    for (chunk = 0; chunk < chunks; chunk++) {
+        const unsigned int end = begin + chunkSize + (chunk < remainder ? 1 : 0);
+        if (chunk + 1 < chunks) {
+            threads.push_back(std::thread(function, begin, end, chunk));
+        } else {
+            function(begin, end, chunk);
+        }
+        begin = end;
+    }
+    for (std::thread & thread: threads) {
+        thread.join();
+    }
+    return chunks;
+}
+
+unsigned int ThreadSupervisor::getNumaNodeCount() {
+    if (sm_numaNodes == nullptr || sm_numaNodes->empty()) {
+        return 1;
+    }
+    return sm_numaNodes->size();
+}
+
+bool ThreadSupervisor::bindMyThreadToNumaNode(unsigned int node) {
+#ifdef __linux__
+    if (sm_numaNodes == nullptr || sm_numaNodes->empty()) {
+        return false;
+    }
+    const std::vector<unsigned int> & processors = (*sm_numaNodes)[node % sm_numaNodes->size()];
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned int processor: processors) {
+        if (processor < CPU_SETSIZE) {
+            CPU_SET(processor, &set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    __UNUSED(node);
+    return false;
+#endif
+}
+
 void ThreadSupervisor::_globalInit()
 {
     sm_threadIds = new std::set<unsigned int>;
+
+    // the nodes without processors are skipped, no thread can run on them
+    sm_numaNodes = new std::vector<std::vector<unsigned int> >;
+#ifdef __linux__
+    const std::string nodeDirectory = "/sys/devices/system/node/";
+    for (unsigned int node: parseIndexList(readLine(nodeDirectory + "online"))) {
+        std::vector<unsigned int> processors = parseIndexList(
+                    readLine(nodeDirectory + "node" + std::to_string(node) + "/cpulist"));
+        if (!processors.empty()) {
+            sm_numaNodes->push_back(processors);
+        }
+    }
+#endif
 }
 
 void ThreadSupervisor::_globalRelease()
 {
     delete sm_threadIds;
     sm_threadIds = nullptr;
+
+    delete sm_numaNodes;
+    sm_numaNodes = nullptr;
 }
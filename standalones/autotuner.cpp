@@ -0,0 +1,485 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#include <globals.h>
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sys/stat.h>
+#include <dirent.h>
+
+#include <initpanopt.h>
+#include <lp/model.h>
+#include <lp/modelsnapshot.h>
+#include <simplex/simplexparameterhandler.h>
+#include <linalg/linalgparameterhandler.h>
+#include <simplex/simplexcontroller.h>
+#include <utils/timer.h>
+#include <utils/processpool.h>
+
+#include <standalones/standaloneutils.h>
+
+/**
+ * A tuned parameter and its candidate values.
+ */
+struct TunedParameter {
+    std::string name;
+    std::vector<std::string> values;
+};
+
+/**
+ * A configuration raced by the autotuner: one value for each tuned parameter.
+ */
+struct Candidate {
+    std::vector<std::string> values;
+    double logScore;
+    unsigned int models;
+    bool alive;
+};
+
+/**
+ * The measures of a solve.
+ */
+struct Measure {
+    bool solved;
+    double time;
+    unsigned int iterations;
+};
+
+/**
+ * The settings of the race.
+ */
+struct RaceSettings {
+    unsigned int jobs;
+    unsigned int timeout;
+    unsigned int minModels;
+    double dropRatio;
+};
+
+void printHelp() {
+    std::cout << "Usage: PannonOptimizerAutotuner [OPTION] \n" <<
+                 "Race candidate parameter configurations over a set of models, drop the slow \n"<<
+                 "configurations early, and write the winner into simplex.PAR and linalg.PAR. \n"<<
+                 "\n"<<
+                 "   -f, --file      \t Add an MPS or snapshot file to the model set.\n"<<
+                 "   -d, --directory \t Add every MPS and snapshot file of the directory to the model set.\n"<<
+                 "   -fl, --file-list \t Add the files listed in the text file to the model set.\n"<<
+                 "   -c, --candidate \t Tune a parameter with NAME VALUES, where VALUES is a comma\n"<<
+                 "                   \t separated list, e.g. `-c Pricing.type DANTZIG,DEVEX`.\n"<<
+                 "                   \t The candidates are all the combinations of the values.\n"<<
+                 "   -j, --jobs      \t The number of solves running at once (default: 1).\n"<<
+                 "   -t, --timeout   \t The time limit of a solve in seconds (default: none).\n"<<
+                 "   -m, --min-models \t The number of models solved before dropping candidates (default: 3).\n"<<
+                 "   -r, --drop-ratio \t Drop a candidate if its score is worse than the best one by this\n"<<
+                 "                   \t factor (default: 1.3).\n"<<
+                 "   -pc, --per-class \t Tune separately for each model class, and write the winners into\n"<<
+                 "                   \t simplex.PAR_CLASS and linalg.PAR_CLASS. The class is given by the\n"<<
+                 "                   \t size (small, medium, large) and shape (tall, square, wide) of the model.\n"<<
+                 "                   \t The solver reads these files with its `--per-class` option.\n"<<
+                 "   -h, --help      \t Displays this help.\n"<<
+                 "\n"<<
+                 "The score of a candidate is the geometric mean of its solve time and iteration count\n"<<
+                 "relative to the best candidate of each model. Unsolved models count as twice the worst.\n"<<
+                 "The models are presolved and scaled with the current parameters, before the race,\n"<<
+                 "so the Starting parameters cannot be tuned.\n"<<
+                 "\n";
+}
+
+bool isModelFile(const std::string & path) {
+    return (path.size()>=4 && (path.substr(path.size()-4 , 4).compare(".MPS") == 0 ||
+                               path.substr(path.size()-4 , 4).compare(".mps") == 0)) ||
+            ModelSnapshot::isSnapshotFile(path);
+}
+
+void addDir(const std::string & dirPath, std::vector<std::string> & files) {
+    DIR *dir;
+    struct dirent *ent;
+    std::vector<std::string> entries;
+    if ((dir = opendir (dirPath.c_str())) != NULL) {
+        while ((ent = readdir (dir)) != NULL) {
+            std::string entry(ent->d_name);
+            if(isModelFile(entry)) {
+                entries.push_back(dirPath + PATH_SEPARATOR + entry);
+            }
+        }
+        closedir (dir);
+    } else {
+        std::cout << "Error opening the directory " << dirPath << ".\n";
+    }
+    std::sort(entries.begin(), entries.end());
+    files.insert(files.end(), entries.begin(), entries.end());
+}
+
+void addFileList(const std::string & fileListPath, std::vector<std::string> & files) {
+    std::string line;
+    std::ifstream fileList(fileListPath);
+    if(fileList.is_open()) {
+        while(getline(fileList,line) ) {
+            if(isModelFile(line)) {
+                files.push_back(line);
+            } else if(!line.empty()) {
+                std::cout << "Invalid record in the list: "<<line << "\n";
+            }
+        }
+    } else {
+        std::cout << "Unable to open file list.\n";
+    }
+}
+
+/**
+ * Returns the handler of a parameter, or 0 if there is no parameter with the given name.
+ */
+ParameterHandler * getHandler(const std::string & name) {
+    if(LinalgParameterHandler::getInstance().hasParameter(name)) {
+        return &LinalgParameterHandler::getInstance();
+    }
+    if(SimplexParameterHandler::getInstance().hasParameter(name)) {
+        return &SimplexParameterHandler::getInstance();
+    }
+    return 0;
+}
+
+bool applyCandidate(const std::vector<TunedParameter> & parameters, const std::vector<std::string> & values) {
+    bool linalgChanged = false;
+    for(unsigned int i = 0; i < parameters.size(); i++) {
+        ParameterHandler * handler = getHandler(parameters[i].name);
+        if(!setParameter(*handler, parameters[i].name, values[i])) {
+            return false;
+        }
+        linalgChanged = linalgChanged || handler == &LinalgParameterHandler::getInstance();
+    }
+    if(linalgChanged) {
+        InitPanOpt::applyLinalgParameters();
+    }
+    return true;
+}
+
+std::string candidateToString(const std::vector<TunedParameter> & parameters, const Candidate & candidate) {
+    std::string result;
+    for(unsigned int i = 0; i < parameters.size(); i++) {
+        if(i > 0) {
+            result += " ";
+        }
+        result += parameters[i].name + "=" + candidate.values[i];
+    }
+    return result;
+}
+
+void generateCandidates(const std::vector<TunedParameter> & parameters, unsigned int parameterIndex,
+                        std::vector<std::string> & values, std::vector<Candidate> & candidates) {
+    if(parameterIndex == parameters.size()) {
+        Candidate candidate;
+        candidate.values = values;
+        candidate.logScore = 0;
+        candidate.models = 0;
+        candidate.alive = true;
+        candidates.push_back(candidate);
+        return;
+    }
+    for(unsigned int i = 0; i < parameters[parameterIndex].values.size(); i++) {
+        values[parameterIndex] = parameters[parameterIndex].values[i];
+        generateCandidates(parameters, parameterIndex + 1, values, candidates);
+    }
+}
+
+/**
+ * Solves the model with the alive candidates in worker processes.
+ */
+void evaluateModel(const Model & model, const std::vector<TunedParameter> & parameters,
+                   const std::vector<Candidate> & candidates, const std::vector<unsigned int> & alive,
+                   const RaceSettings & settings, std::vector<Measure> & measures) {
+    measures.assign(alive.size(), Measure());
+    ProcessPool pool(settings.jobs, settings.timeout);
+    pool.run(alive.size(), std::vector<unsigned long long int>(),
+             [&](unsigned int index, const std::string & resultName) {
+        if(!applyCandidate(parameters, candidates[alive[index]].values)) {
+            return false;
+        }
+        Timer timer;
+        timer.start();
+        SimplexController simplexController;
+        simplexController.solve(model);
+        timer.stop();
+        std::ofstream result(resultName.c_str());
+        result << (simplexController.isOptimal() ? 1 : 0) << " " << std::setprecision(9)
+               << timer.getTotalElapsed() << " " << simplexController.getIterationCount() << "\n";
+        return true;
+    }, [&](unsigned int index, ProcessPool::TASK_RESULT result, const std::string &,
+           const std::string & resultName) {
+        Measure & measure = measures[index];
+        measure.solved = false;
+        measure.time = 0;
+        measure.iterations = 0;
+        if(result == ProcessPool::SUCCEEDED) {
+            std::ifstream in(resultName.c_str());
+            int optimal = 0;
+            if(in >> optimal >> measure.time >> measure.iterations) {
+                measure.solved = optimal == 1;
+            }
+        }
+    });
+}
+
+/**
+ * Races the candidates over the models, and returns the index of the winner.
+ * After every model the candidates whose score is worse than the best score by the
+ * drop ratio are eliminated, so most of the solves are spent on good candidates.
+ */
+unsigned int race(const std::vector<std::string> & files, const std::vector<TunedParameter> & parameters,
+                  std::vector<Candidate> & candidates, const RaceSettings & settings) {
+    for(unsigned int i = 0; i < candidates.size(); i++) {
+        candidates[i].logScore = 0;
+        candidates[i].models = 0;
+        candidates[i].alive = true;
+    }
+    for(unsigned int fileIndex = 0; fileIndex < files.size(); fileIndex++) {
+        std::vector<unsigned int> alive;
+        for(unsigned int i = 0; i < candidates.size(); i++) {
+            if(candidates[i].alive) {
+                alive.push_back(i);
+            }
+        }
+        if(alive.size() <= 1) {
+            break;
+        }
+        Model model;
+        if(!loadModel(files[fileIndex], model, false) || !prepareModel(model)) {
+            continue;
+        }
+        std::vector<Measure> measures;
+        evaluateModel(model, parameters, candidates, alive, settings, measures);
+
+        // the unsolved runs count as twice the worst solved run, or the time limit
+        double bestTime = 0;
+        double worstTime = 0;
+        unsigned int bestIterations = 0;
+        unsigned int worstIterations = 0;
+        bool anySolved = false;
+        for(unsigned int i = 0; i < measures.size(); i++) {
+            if(!measures[i].solved) {
+                continue;
+            }
+            // the timer is too coarse for tiny models
+            const double time = std::max(measures[i].time, 1e-3);
+            const unsigned int iterations = std::max(measures[i].iterations, 1u);
+            if(!anySolved || time < bestTime) {
+                bestTime = time;
+            }
+            if(!anySolved || iterations < bestIterations) {
+                bestIterations = iterations;
+            }
+            worstTime = std::max(worstTime, time);
+            worstIterations = std::max(worstIterations, iterations);
+            anySolved = true;
+        }
+        if(!anySolved) {
+            LPWARNING(files[fileIndex] << " is not solved by any candidate, it is skipped");
+            continue;
+        }
+        const double penaltyTime = settings.timeout > 0 ? std::max(2.0 * settings.timeout, 2 * worstTime) : 2 * worstTime;
+        for(unsigned int i = 0; i < measures.size(); i++) {
+            Candidate & candidate = candidates[alive[i]];
+            double time = penaltyTime;
+            double iterations = 2.0 * worstIterations;
+            if(measures[i].solved) {
+                time = std::max(measures[i].time, 1e-3);
+                iterations = std::max(measures[i].iterations, 1u);
+            }
+            candidate.logScore += log(time / bestTime) + log(iterations / bestIterations);
+            candidate.models++;
+            LPINFO(files[fileIndex] << " [" << candidateToString(parameters, candidate) << "]: " <<
+                   (measures[i].solved ? "solved" : "unsolved") << ", " << measures[i].time << " s, " <<
+                   measures[i].iterations << " iterations");
+        }
+
+        unsigned int solvedModels = candidates[alive[0]].models;
+        if(solvedModels < settings.minModels) {
+            continue;
+        }
+        double bestScore = 0;
+        for(unsigned int i = 0; i < alive.size(); i++) {
+            const double score = candidates[alive[i]].logScore / (2 * candidates[alive[i]].models);
+            if(i == 0 || score < bestScore) {
+                bestScore = score;
+            }
+        }
+        for(unsigned int i = 0; i < alive.size(); i++) {
+            Candidate & candidate = candidates[alive[i]];
+            const double score = candidate.logScore / (2 * candidate.models);
+            if(score > bestScore + log(settings.dropRatio)) {
+                candidate.alive = false;
+                LPINFO("Dropped [" << candidateToString(parameters, candidate) << "], score: " << exp(score));
+            }
+        }
+    }
+
+    unsigned int winner = 0;
+    double bestScore = 0;
+    bool found = false;
+    for(unsigned int i = 0; i < candidates.size(); i++) {
+        if(!candidates[i].alive) {
+            continue;
+        }
+        const double score = candidates[i].models > 0 ? candidates[i].logScore / (2 * candidates[i].models) : 0;
+        if(!found || score < bestScore) {
+            winner = i;
+            bestScore = score;
+            found = true;
+        }
+    }
+    return winner;
+}
+
+/**
+ * Writes the parameter files with the values of the winner candidate. The other
+ * parameters keep their current values.
+ */
+void writeWinner(const std::vector<TunedParameter> & parameters, const Candidate & winner,
+                 const std::string & suffix) {
+    std::vector<std::string> originalValues;
+    for(unsigned int i = 0; i < parameters.size(); i++) {
+        originalValues.push_back(getHandler(parameters[i].name)->writeParameter(parameters[i].name));
+    }
+    applyCandidate(parameters, winner.values);
+    ParameterHandler & linalgHandler = LinalgParameterHandler::getInstance();
+    ParameterHandler & simplexHandler = SimplexParameterHandler::getInstance();
+    const std::string linalgFileName = linalgHandler.getFileName();
+    const std::string simplexFileName = simplexHandler.getFileName();
+    linalgHandler.setFileName(std::string("linalg.PAR") + suffix);
+    linalgHandler.writeParameterFile();
+    simplexHandler.setFileName(std::string("simplex.PAR") + suffix);
+    simplexHandler.writeParameterFile();
+    linalgHandler.setFileName(linalgFileName);
+    simplexHandler.setFileName(simplexFileName);
+    applyCandidate(parameters, originalValues);
+    std::cout << "Winner" << (suffix.empty() ? "" : " of class " + suffix.substr(1)) << ": " <<
+                 candidateToString(parameters, winner) << "\n";
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> files;
+    std::vector<TunedParameter> parameters;
+    RaceSettings settings;
+    settings.jobs = 1;
+    settings.timeout = 0;
+    settings.minModels = 3;
+    settings.dropRatio = 1.3;
+    bool perClass = false;
+
+    if(argc < 2) {
+        printHelp();
+        return EXIT_SUCCESS;
+    }
+    for(int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        const bool hasOperand = i + 1 < argc;
+        if(arg.compare("-h") == 0 || arg.compare("--help") == 0) {
+            printHelp();
+            return EXIT_SUCCESS;
+        } else if(hasOperand && (arg.compare("-f") == 0 || arg.compare("--file") == 0)) {
+            files.push_back(argv[++i]);
+        } else if(hasOperand && (arg.compare("-d") == 0 || arg.compare("--directory") == 0)) {
+            if(!isDir(argv[i+1])) {
+                std::cout << "Invalid directory: " << argv[i+1] << "\n";
+                return EXIT_FAILURE;
+            }
+            addDir(argv[++i], files);
+        } else if(hasOperand && (arg.compare("-fl") == 0 || arg.compare("--file-list") == 0)) {
+            addFileList(argv[++i], files);
+        } else if(i + 2 < argc && (arg.compare("-c") == 0 || arg.compare("--candidate") == 0)) {
+            TunedParameter parameter;
+            parameter.name = argv[i+1];
+            ParameterHandler * handler = getHandler(parameter.name);
+            if(handler == 0) {
+                std::cout << "Unknown parameter: " << parameter.name << "\n";
+                return EXIT_FAILURE;
+            }
+            // the models are presolved, scaled and started with the current parameters
+            if(parameter.name.compare(0, 9, "Starting.") == 0) {
+                std::cout << "The Starting parameters cannot be tuned: " << parameter.name << "\n";
+                return EXIT_FAILURE;
+            }
+            std::stringstream values(argv[i+2]);
+            std::string value;
+            while(getline(values, value, ',')) {
+                const std::string original = handler->writeParameter(parameter.name);
+                if(!setParameter(*handler, parameter.name, value)) {
+                    std::cout << "Invalid value " << value << " for parameter " << parameter.name << "\n";
+                    return EXIT_FAILURE;
+                }
+                setParameter(*handler, parameter.name, original);
+                parameter.values.push_back(value);
+            }
+            parameters.push_back(parameter);
+            i += 2;
+        } else if(hasOperand && (arg.compare("-j") == 0 || arg.compare("--jobs") == 0)) {
+            settings.jobs = std::max(1, atoi(argv[++i]));
+        } else if(hasOperand && (arg.compare("-t") == 0 || arg.compare("--timeout") == 0)) {
+            settings.timeout = std::max(0, atoi(argv[++i]));
+        } else if(hasOperand && (arg.compare("-m") == 0 || arg.compare("--min-models") == 0)) {
+            settings.minModels = std::max(1, atoi(argv[++i]));
+        } else if(hasOperand && (arg.compare("-r") == 0 || arg.compare("--drop-ratio") == 0)) {
+            settings.dropRatio = std::max(1.0, atof(argv[++i]));
+        } else if(arg.compare("-pc") == 0 || arg.compare("--per-class") == 0) {
+            perClass = true;
+        } else {
+            std::cout << argv[0]<< ": invalid option: `" << argv[i]<<"`\n"<<
+                         "Try `"<< argv[0] <<" --help` for more information.\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if(files.empty() || parameters.empty()) {
+        std::cout << "Please specify the models and the candidate values. Use `--help` for further information!\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Candidate> candidates;
+    std::vector<std::string> values(parameters.size());
+    generateCandidates(parameters, 0, values, candidates);
+    LPINFO("Racing " << candidates.size() << " candidates over " << files.size() << " models");
+
+    if(!perClass) {
+        const unsigned int winner = race(files, parameters, candidates, settings);
+        writeWinner(parameters, candidates[winner], "");
+        return EXIT_SUCCESS;
+    }
+
+    // the classes are computed from the original models, without presolving
+    std::map<std::string, std::vector<std::string> > classes;
+    for(unsigned int i = 0; i < files.size(); i++) {
+        Model model;
+        if(!loadModel(files[i], model, false)) {
+            continue;
+        }
+        const std::string modelClass = getModelClass(model);
+        LPINFO(files[i] << ": " << model.getMatrix().rowCount() << " x " << model.getMatrix().columnCount() <<
+               ", density " << model.getMatrix().density() << ", class " << modelClass);
+        classes[modelClass].push_back(files[i]);
+    }
+    std::map<std::string, std::vector<std::string> >::const_iterator iter = classes.begin();
+    for(; iter != classes.end(); ++iter) {
+        LPINFO("Tuning class " << iter->first << " with " << iter->second.size() << " models");
+        const unsigned int winner = race(iter->second, parameters, candidates, settings);
+        writeWinner(parameters, candidates[winner], "_" + iter->first);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,633 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#include <globals.h>
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <ctime>
+
+#ifdef UNIX
+#include <sys/resource.h>
+#endif
+
+#include <lp/model.h>
+#include <lp/manualmodelbuilder.h>
+#include <lp/hilbertmodelbuilder.h>
+#include <lp/pascalmodelbuilder.h>
+#include <simplex/simplexparameterhandler.h>
+#include <linalg/linalgparameterhandler.h>
+#include <simplex/simplexcontroller.h>
+#include <utils/timer.h>
+#include <utils/processpool.h>
+
+#include <framework/report.h>
+#include <framework/sqlitereportgenerator.h>
+
+/**
+ * The name of the database table of the results.
+ */
+static const char * BENCHMARK_TABLE = "benchmark";
+
+/**
+ * Time differences below this limit are never reported, the timers are too coarse for them.
+ */
+static const double MIN_TIME_DIFFERENCE = 0.01;
+
+/**
+ * A model of the benchmark corpus, it is generated in the worker process.
+ */
+struct BenchmarkModel {
+    std::string name;
+    std::function<void(Model &)> build;
+};
+
+/**
+ * The measures of a solve.
+ */
+struct Measure {
+    bool measured;
+    std::string status;
+    double time;
+    SimplexController::SolveStatistics statistics;
+    unsigned int iterations;
+    long peakMemory;
+};
+
+/**
+ * The settings of the benchmark.
+ */
+struct BenchmarkSettings {
+    std::string database;
+    std::string run;
+    std::string baseline;
+    std::string filter;
+    double threshold;
+    unsigned int repeat;
+    unsigned int jobs;
+    unsigned int timeout;
+};
+
+void printHelp() {
+    std::cout << "Usage: NewPanOptBenchmark [OPTION] \n" <<
+                 "Solve a fixed corpus of generated models, and store the time of the solver phases, \n"<<
+                 "the iterations, the reinversions, the size of the inverse and the peak memory \n"<<
+                 "into an SQLite database. No model files are needed. \n"<<
+                 "\n"<<
+                 "   -db, --database \t The SQLite database file (default: benchmark.db).\n"<<
+                 "   -r, --run       \t The name of the run in the database (default: run_DATE_TIME).\n"<<
+                 "   -c, --compare   \t Compare the run with a stored baseline run, and report the\n"<<
+                 "                   \t regressions. The exit code is nonzero if there are regressions.\n"<<
+                 "   -th, --threshold \t The relative noise threshold of the comparison (default: 0.1).\n"<<
+                 "   -n, --repeat    \t Solve each model this many times, and keep the fastest (default: 3).\n"<<
+                 "   -m, --models    \t Benchmark only the models whose names contain this text.\n"<<
+                 "   -l, --list      \t List the models of the corpus.\n"<<
+                 "   -j, --jobs      \t The number of solves running at once (default: 1).\n"<<
+                 "   -t, --timeout   \t The time limit of a solve in seconds (default: none).\n"<<
+                 "   -h, --help      \t Displays this help.\n"<<
+                 "\n"<<
+                 "The solver uses the simplex.PAR and linalg.PAR files of the working directory, or\n"<<
+                 "the defaults, so compare runs made with the same parameter files. Parallel jobs\n"<<
+                 "disturb the timing, use them only for quick checks.\n"<<
+                 "\n";
+}
+
+/**
+ * A deterministic pseudo-random sequence: the standard fixes the output of std::mt19937,
+ * unlike the distributions, so the generated models are the same on every platform.
+ */
+class ModelRandom {
+public:
+    explicit ModelRandom(unsigned int seed): m_generator(seed) {}
+
+    double uniform(double lower, double upper) {
+        return lower + (upper - lower) * (m_generator() / 4294967296.0);
+    }
+
+    unsigned int index(unsigned int count) {
+        return m_generator() % count;
+    }
+
+private:
+    std::mt19937 m_generator;
+};
+
+void buildHilbert(Model & model, unsigned int size) {
+    HilbertModelBuilder builder(size);
+    unsigned int index;
+    for (index = 0; index < size; index++) {
+        builder.setCostCoefficient(index, 1.0);
+    }
+    builder.setName("HILBERT" + std::to_string(size));
+    model.build(builder);
+}
+
+void buildPascal(Model & model, unsigned int size) {
+    PascalModelBuilder builder(size);
+    unsigned int index;
+    for (index = 0; index < size; index++) {
+        builder.setCostCoefficient(index, 1.0);
+    }
+    builder.setName("PASCAL" + std::to_string(size));
+    model.build(builder);
+}
+
+/**
+ * A small production planning model with all the constraint and variable types.
+ */
+void buildManual(Model & model) {
+    ManualModelBuilder builder;
+    builder.setName("MANUAL");
+    Variable defaultVariable = Variable::createPlusTypeVariable(nullptr, 0.0);
+    const unsigned int indices[] = {0, 1, 2, 3, 4};
+    const double capacity[] = {2, 3, 1, 4, 2};
+    const double labour[] = {3, 1, 2, 1, 4};
+    const double material[] = {1, 2, 3, 2, 1};
+    const double mix[] = {1, -1, 0, 1, 0};
+    builder.addConstraint(Constraint::createLessTypeConstraint("CAPACITY", 40), capacity, indices, 5, &defaultVariable);
+    builder.addConstraint(Constraint::createLessTypeConstraint("LABOUR", 45), labour, indices, 5, &defaultVariable);
+    builder.addConstraint(Constraint::createRangeTypeConstraint("MATERIAL", 10, 50), material, indices, 5, &defaultVariable);
+    builder.addConstraint(Constraint::createGreaterTypeConstraint("MIX", -5), mix, indices, 5, &defaultVariable);
+    builder.setVariable(0, Variable::createPlusTypeVariable("P1", 0.0));
+    builder.setVariable(1, Variable::createBoundedTypeVariable("P2", 0.0, 8.0));
+    builder.setVariable(2, Variable::createBoundedTypeVariable("P3", 1.0, 6.0));
+    builder.setVariable(3, Variable::createPlusTypeVariable("P4", 0.0));
+    builder.setVariable(4, Variable::createBoundedTypeVariable("P5", -5.0, 5.0));
+    const double profits[] = {5, 4, 6, 3, 2};
+    unsigned int index;
+    for (index = 0; index < 5; index++) {
+        builder.setCostCoefficient(index, profits[index]);
+    }
+    builder.setObjectiveType(MAXIMIZE);
+    model.build(builder);
+}
+
+/**
+ * A transportation problem with the given number of sources and destinations.
+ * The supplies exceed the demands, so the problem is feasible.
+ */
+void buildTransportation(Model & model, unsigned int sources, unsigned int destinations, unsigned int seed) {
+    ModelRandom random(seed);
+    ManualModelBuilder builder;
+    builder.setName("TRANSPORT" + std::to_string(sources) + "X" + std::to_string(destinations));
+    Variable defaultVariable = Variable::createPlusTypeVariable(nullptr, 0.0);
+    std::vector<double> values;
+    std::vector<unsigned int> indices;
+    const double totalDemand = 100.0 * destinations;
+    unsigned int source;
+    unsigned int destination;
+    for (source = 0; source < sources; source++) {
+        values.assign(destinations, 1.0);
+        indices.clear();
+        for (destination = 0; destination < destinations; destination++) {
+            indices.push_back(source * destinations + destination);
+        }
+        const double supply = 1.2 * totalDemand / sources * random.uniform(0.8, 1.2);
+        builder.addConstraint(Constraint::createLessTypeConstraint(("S" + std::to_string(source)).c_str(), supply),
+                              values.data(), indices.data(), destinations, &defaultVariable);
+    }
+    for (destination = 0; destination < destinations; destination++) {
+        values.assign(sources, 1.0);
+        indices.clear();
+        for (source = 0; source < sources; source++) {
+            indices.push_back(source * destinations + destination);
+        }
+        builder.addConstraint(Constraint::createGreaterTypeConstraint(("D" + std::to_string(destination)).c_str(), 100.0),
+                              values.data(), indices.data(), sources, &defaultVariable);
+    }
+    unsigned int index;
+    for (index = 0; index < sources * destinations; index++) {
+        builder.setCostCoefficient(index, random.uniform(1.0, 20.0));
+    }
+    model.build(builder);
+}
+
+/**
+ * A random sparse model with bounded variables. The right-hand sides are computed from
+ * a random point, so the problem is feasible, and the bounds keep it bounded.
+ */
+void buildRandomSparse(Model & model, unsigned int rows, unsigned int columns,
+                       unsigned int rowNonzeros, unsigned int seed) {
+    ModelRandom random(seed);
+    ManualModelBuilder builder;
+    builder.setName("SPARSE" + std::to_string(rows) + "X" + std::to_string(columns));
+    Variable defaultVariable = Variable::createBoundedTypeVariable(nullptr, 0.0, 10.0);
+    std::vector<double> point(columns);
+    unsigned int column;
+    for (column = 0; column < columns; column++) {
+        point[column] = random.uniform(0.0, 10.0);
+    }
+    std::vector<double> values;
+    std::vector<unsigned int> indices;
+    std::vector<bool> used(columns, false);
+    unsigned int row;
+    for (row = 0; row < rows; row++) {
+        values.clear();
+        indices.clear();
+        // every column appears in some row
+        const unsigned int first = (row * columns) / rows;
+        indices.push_back(first);
+        used[first] = true;
+        while (indices.size() < rowNonzeros && indices.size() < columns) {
+            column = random.index(columns);
+            if (!used[column]) {
+                used[column] = true;
+                indices.push_back(column);
+            }
+        }
+        double activity = 0;
+        for (unsigned int index: indices) {
+            used[index] = false;
+            values.push_back(random.uniform(-5.0, 10.0));
+            activity += values.back() * point[index];
+        }
+        const std::string name = "R" + std::to_string(row);
+        if (row % 3 == 0) {
+            builder.addConstraint(Constraint::createGreaterTypeConstraint(name.c_str(), activity - random.uniform(0.0, 5.0)),
+                                  values.data(), indices.data(), indices.size(), &defaultVariable);
+        } else {
+            builder.addConstraint(Constraint::createLessTypeConstraint(name.c_str(), activity + random.uniform(0.0, 5.0)),
+                                  values.data(), indices.data(), indices.size(), &defaultVariable);
+        }
+    }
+    for (column = 0; column < columns; column++) {
+        builder.setVariable(column, Variable::createBoundedTypeVariable(("C" + std::to_string(column)).c_str(), 0.0, 10.0));
+        builder.setCostCoefficient(column, random.uniform(-10.0, 10.0));
+    }
+    model.build(builder);
+}
+
+/**
+ * The benchmark corpus. Do not change the existing models, otherwise the stored
+ * baselines are not comparable any more; add new models instead.
+ */
+std::vector<BenchmarkModel> createCorpus() {
+    std::vector<BenchmarkModel> corpus;
+    corpus.push_back({"manual", [](Model & model) { buildManual(model); }});
+    // the larger Hilbert and Pascal models are numerically too hard for the solver
+    corpus.push_back({"hilbert_4", [](Model & model) { buildHilbert(model, 4); }});
+    corpus.push_back({"hilbert_5", [](Model & model) { buildHilbert(model, 5); }});
+    corpus.push_back({"pascal_8", [](Model & model) { buildPascal(model, 8); }});
+    corpus.push_back({"pascal_12", [](Model & model) { buildPascal(model, 12); }});
+    corpus.push_back({"transport_20x30", [](Model & model) { buildTransportation(model, 20, 30, 1); }});
+    corpus.push_back({"transport_60x80", [](Model & model) { buildTransportation(model, 60, 80, 2); }});
+    corpus.push_back({"transport_150x200", [](Model & model) { buildTransportation(model, 150, 200, 3); }});
+    corpus.push_back({"sparse_200x300", [](Model & model) { buildRandomSparse(model, 200, 300, 8, 4); }});
+    corpus.push_back({"sparse_500x750", [](Model & model) { buildRandomSparse(model, 500, 750, 8, 5); }});
+    return corpus;
+}
+
+/**
+ * Returns the peak resident memory of the process in kilobytes, or 0 if it is unknown.
+ */
+long getPeakMemory() {
+#ifdef UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Builds and solves a model in the worker process, and writes its measures into the result file.
+ */
+bool solveModel(const BenchmarkModel & benchmarkModel, const std::string & resultName) {
+    Model model;
+    benchmarkModel.build(model);
+    if (SimplexParameterHandler::getInstance().getBoolParameterValue("Starting.Scaling.enable") == true) {
+        model.scale();
+    }
+    Timer timer;
+    timer.start();
+    SimplexController simplexController;
+    simplexController.solve(model);
+    timer.stop();
+    const SimplexController::SolveStatistics & statistics = simplexController.getSolveStatistics();
+    std::ofstream result(resultName.c_str());
+    result << (simplexController.isOptimal() ? "optimal" : "unsolved") << " " << std::setprecision(9)
+           << timer.getTotalElapsed() << " "
+           << statistics.m_inversionTime << " " << statistics.m_computeBasicSolutionTime << " "
+           << statistics.m_computeReducedCostsTime << " " << statistics.m_priceTime << " "
+           << statistics.m_selectPivotTime << " " << statistics.m_updateTime << " "
+           << simplexController.getIterationCount() << " " << statistics.m_reinversions << " "
+           << statistics.m_maxInverseNonzeros << " " << getPeakMemory() << "\n";
+    return true;
+}
+
+bool readMeasure(const std::string & resultName, Measure & measure) {
+    std::ifstream in(resultName.c_str());
+    SimplexController::SolveStatistics & statistics = measure.statistics;
+    return static_cast<bool>(in >> measure.status >> measure.time
+                             >> statistics.m_inversionTime >> statistics.m_computeBasicSolutionTime
+                             >> statistics.m_computeReducedCostsTime >> statistics.m_priceTime
+                             >> statistics.m_selectPivotTime >> statistics.m_updateTime
+                             >> measure.iterations >> statistics.m_reinversions
+                             >> statistics.m_maxInverseNonzeros >> measure.peakMemory);
+}
+
+/**
+ * Solves every model of the corpus settings.repeat times, and keeps the fastest solve of each.
+ */
+void runCorpus(const std::vector<BenchmarkModel> & corpus, const BenchmarkSettings & settings,
+               std::vector<Measure> & measures) {
+    measures.assign(corpus.size(), Measure());
+    for (Measure & measure: measures) {
+        measure.measured = false;
+        measure.status = "failed";
+    }
+    ProcessPool pool(settings.jobs, settings.timeout);
+    pool.run(corpus.size() * settings.repeat, std::vector<unsigned long long int>(),
+             [&](unsigned int index, const std::string & resultName) {
+        return solveModel(corpus[index / settings.repeat], resultName);
+    }, [&](unsigned int index, ProcessPool::TASK_RESULT result, const std::string &,
+           const std::string & resultName) {
+        Measure & best = measures[index / settings.repeat];
+        if (result == ProcessPool::TIMED_OUT && !best.measured) {
+            best.status = "timeout";
+        }
+        Measure measure;
+        if (result != ProcessPool::SUCCEEDED || !readMeasure(resultName, measure)) {
+            return;
+        }
+        measure.measured = true;
+        if (!best.measured || measure.time < best.time) {
+            best = measure;
+        }
+    });
+}
+
+std::string formatDouble(double value, int precision) {
+    std::ostringstream str;
+    str << std::fixed << std::setprecision(precision) << value;
+    return str.str();
+}
+
+/**
+ * Converts the measures into a report table, the first row holds the column names.
+ */
+ReportTable createResultTable(const std::vector<BenchmarkModel> & corpus, const std::vector<Measure> & measures,
+                              const BenchmarkSettings & settings, const std::string & date) {
+    const std::vector<std::pair<std::string, ReportTable::TYPE> > columns = {
+        {"run", ReportTable::TYPE::STRING},
+        {"date", ReportTable::TYPE::STRING},
+        {"model", ReportTable::TYPE::STRING},
+        {"status", ReportTable::TYPE::STRING},
+        {"time", ReportTable::TYPE::FLOAT},
+        {"inversion_time", ReportTable::TYPE::FLOAT},
+        {"basic_solution_time", ReportTable::TYPE::FLOAT},
+        {"reduced_costs_time", ReportTable::TYPE::FLOAT},
+        {"pricing_time", ReportTable::TYPE::FLOAT},
+        {"pivot_selection_time", ReportTable::TYPE::FLOAT},
+        {"update_time", ReportTable::TYPE::FLOAT},
+        {"iterations", ReportTable::TYPE::INTEGER},
+        {"reinversions", ReportTable::TYPE::INTEGER},
+        {"inverse_nonzeros", ReportTable::TYPE::INTEGER},
+        {"peak_memory_kb", ReportTable::TYPE::INTEGER}
+    };
+    const ReportTable::ALIGNMENT left = ReportTable::ALIGNMENT::LEFT;
+    const ReportTable::ALIGNMENT right = ReportTable::ALIGNMENT::RIGHT;
+    ReportTable table(columns.size());
+    table.setTitle(BENCHMARK_TABLE);
+    unsigned int column;
+    for (column = 0; column < columns.size(); column++) {
+        table.setColumn(column, {true, columns[column].second});
+        table.setCell(0, column, {columns[column].first, left, nullptr, true});
+    }
+    unsigned int index;
+    for (index = 0; index < corpus.size(); index++) {
+        const Measure & measure = measures[index];
+        const SimplexController::SolveStatistics & statistics = measure.statistics;
+        std::vector<std::string> cells = {settings.run, date, corpus[index].name, measure.status};
+        if (measure.measured) {
+            cells.push_back(formatDouble(measure.time, 6));
+            cells.push_back(formatDouble(statistics.m_inversionTime, 6));
+            cells.push_back(formatDouble(statistics.m_computeBasicSolutionTime, 6));
+            cells.push_back(formatDouble(statistics.m_computeReducedCostsTime, 6));
+            cells.push_back(formatDouble(statistics.m_priceTime, 6));
+            cells.push_back(formatDouble(statistics.m_selectPivotTime, 6));
+            cells.push_back(formatDouble(statistics.m_updateTime, 6));
+            cells.push_back(std::to_string(measure.iterations));
+            cells.push_back(std::to_string(statistics.m_reinversions));
+            cells.push_back(std::to_string(statistics.m_maxInverseNonzeros));
+            cells.push_back(std::to_string(measure.peakMemory));
+        }
+        cells.resize(columns.size());
+        for (column = 0; column < columns.size(); column++) {
+            table.setCell(index + 1, column, {cells[column], column < 4 ? left : right, nullptr, false});
+        }
+    }
+    return table;
+}
+
+void printResults(const std::vector<BenchmarkModel> & corpus, const std::vector<Measure> & measures) {
+    std::ostringstream header;
+    header << std::left << std::setw(20) << "Model" << std::setw(10) << "Status" << std::right
+           << std::setw(12) << "Time [s]" << std::setw(12) << "Iterations" << std::setw(14) << "Reinversions"
+           << std::setw(12) << "Inverse nz" << std::setw(14) << "Memory [kB]";
+    LPINFO(header.str());
+    unsigned int index;
+    for (index = 0; index < corpus.size(); index++) {
+        const Measure & measure = measures[index];
+        std::ostringstream line;
+        line << std::left << std::setw(20) << corpus[index].name << std::setw(10) << measure.status << std::right;
+        if (measure.measured) {
+            line << std::setw(12) << formatDouble(measure.time, 4) << std::setw(12) << measure.iterations
+                 << std::setw(14) << measure.statistics.m_reinversions
+                 << std::setw(12) << measure.statistics.m_maxInverseNonzeros
+                 << std::setw(14) << measure.peakMemory;
+        }
+        LPINFO(line.str());
+    }
+}
+
+/**
+ * Compares the run with the baseline run of the database.
+ * Returns the number of regressions.
+ */
+unsigned int compareWithBaseline(const std::vector<BenchmarkModel> & corpus, const std::vector<Measure> & measures,
+                                 const BenchmarkSettings & settings, const SqliteReportGenerator & database) {
+    const std::vector<std::vector<std::string> > rows =
+            database.query(settings.database.c_str(),
+                           std::string("SELECT model, status, time, iterations, peak_memory_kb FROM ") + BENCHMARK_TABLE +
+                           " WHERE run = " + database.quote(settings.baseline));
+    if (rows.empty()) {
+        LPERROR("The baseline run " << settings.baseline << " is not found in " << settings.database);
+        return 1;
+    }
+    std::map<std::string, std::vector<std::string> > baseline;
+    for (const std::vector<std::string> & row: rows) {
+        baseline[row[0]] = row;
+    }
+
+    LPINFO("Comparison with " << settings.baseline << " (noise threshold: " << settings.threshold * 100 << "%)");
+    unsigned int regressions = 0;
+    unsigned int index;
+    for (index = 0; index < corpus.size(); index++) {
+        const std::string & name = corpus[index].name;
+        const Measure & measure = measures[index];
+        if (baseline.find(name) == baseline.end()) {
+            LPINFO(name << ": new model");
+            continue;
+        }
+        const std::vector<std::string> & row = baseline[name];
+        if (measure.status != row[1]) {
+            LPWARNING(name << ": REGRESSION, status " << row[1] << " -> " << measure.status);
+            regressions += row[1] == "optimal" ? 1 : 0;
+            continue;
+        }
+        if (!measure.measured || row[2].empty()) {
+            continue;
+        }
+        const double baseTime = atof(row[2].c_str());
+        const unsigned int baseIterations = atoi(row[3].c_str());
+        const long baseMemory = atol(row[4].c_str());
+        std::ostringstream message;
+        message << name << ": time " << formatDouble(baseTime, 4) << " -> " << formatDouble(measure.time, 4)
+                << ", iterations " << baseIterations << " -> " << measure.iterations
+                << ", memory " << baseMemory << " -> " << measure.peakMemory << " kB";
+        const bool slower = measure.time > baseTime * (1 + settings.threshold) &&
+                measure.time - baseTime > MIN_TIME_DIFFERENCE;
+        const bool moreIterations = measure.iterations > baseIterations * (1 + settings.threshold);
+        const bool moreMemory = baseMemory > 0 && measure.peakMemory > baseMemory * (1 + settings.threshold);
+        if (slower || moreIterations || moreMemory) {
+            LPWARNING(message.str() << ": REGRESSION");
+            regressions++;
+        } else {
+            LPINFO(message.str());
+        }
+    }
+    if (regressions > 0) {
+        LPWARNING(regressions << " regressions found");
+    } else {
+        LPINFO("No regressions found");
+    }
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    std::vector<BenchmarkModel> corpus = createCorpus();
+    BenchmarkSettings settings;
+    settings.database = "benchmark.db";
+    settings.threshold = 0.1;
+    settings.repeat = 3;
+    settings.jobs = 1;
+    settings.timeout = 0;
+
+    char date[32];
+    const time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    char defaultRun[32];
+    strftime(defaultRun, sizeof(defaultRun), "run_%Y%m%d_%H%M%S", localtime(&now));
+    settings.run = defaultRun;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        const bool hasOperand = i + 1 < argc;
+        if(arg.compare("-h") == 0 || arg.compare("--help") == 0) {
+            printHelp();
+            return EXIT_SUCCESS;
+        } else if(arg.compare("-l") == 0 || arg.compare("--list") == 0) {
+            for(const BenchmarkModel & model: corpus) {
+                std::cout << model.name << "\n";
+            }
+            return EXIT_SUCCESS;
+        } else if(hasOperand && (arg.compare("-db") == 0 || arg.compare("--database") == 0)) {
+            settings.database = argv[++i];
+        } else if(hasOperand && (arg.compare("-r") == 0 || arg.compare("--run") == 0)) {
+            settings.run = argv[++i];
+        } else if(hasOperand && (arg.compare("-c") == 0 || arg.compare("--compare") == 0)) {
+            settings.baseline = argv[++i];
+        } else if(hasOperand && (arg.compare("-th") == 0 || arg.compare("--threshold") == 0)) {
+            settings.threshold = std::max(0.0, atof(argv[++i]));
+        } else if(hasOperand && (arg.compare("-n") == 0 || arg.compare("--repeat") == 0)) {
+            settings.repeat = std::max(1, atoi(argv[++i]));
+        } else if(hasOperand && (arg.compare("-m") == 0 || arg.compare("--models") == 0)) {
+            settings.filter = argv[++i];
+        } else if(hasOperand && (arg.compare("-j") == 0 || arg.compare("--jobs") == 0)) {
+            settings.jobs = std::max(1, atoi(argv[++i]));
+        } else if(hasOperand && (arg.compare("-t") == 0 || arg.compare("--timeout") == 0)) {
+            settings.timeout = std::max(0, atoi(argv[++i]));
+        } else {
+            std::cout << argv[0]<< ": invalid option: `" << argv[i]<<"`\n"<<
+                         "Try `"<< argv[0] <<" --help` for more information.\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if(!settings.filter.empty()) {
+        corpus.erase(std::remove_if(corpus.begin(), corpus.end(), [&](const BenchmarkModel & model) {
+            return model.name.find(settings.filter) == std::string::npos;
+        }), corpus.end());
+        if(corpus.empty()) {
+            std::cout << "No model matches " << settings.filter << ".\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // the parameter handlers are initialized before the workers are forked
+    LinalgParameterHandler::getInstance();
+    SimplexParameterHandler::getInstance();
+
+    SqliteReportGenerator database;
+    try {
+        const std::vector<std::vector<std::string> > existing =
+                database.query(settings.database.c_str(),
+                               std::string("SELECT name FROM sqlite_master WHERE type = 'table' AND name = '") +
+                               BENCHMARK_TABLE + "'");
+        if(!existing.empty() &&
+                !database.query(settings.database.c_str(), std::string("SELECT run FROM ") + BENCHMARK_TABLE +
+                                " WHERE run = " + database.quote(settings.run) + " LIMIT 1").empty()) {
+            LPERROR("The run " << settings.run << " already exists in " << settings.database);
+            return EXIT_FAILURE;
+        }
+    } catch(const std::runtime_error & error) {
+        LPERROR(error.what());
+        return EXIT_FAILURE;
+    }
+
+    LPINFO("Benchmarking " << corpus.size() << " models, " << settings.repeat << " solves each, run " << settings.run);
+    std::vector<Measure> measures;
+    runCorpus(corpus, settings, measures);
+    printResults(corpus, measures);
+
+    Report report;
+    report.setTitle("Pannon Optimizer benchmark");
+    ReportModule module;
+    module.setName(BENCHMARK_TABLE);
+    module.addTable(createResultTable(corpus, measures, settings, date));
+    report.addModule(module);
+    unsigned int regressions = 0;
+    try {
+        database.save(report, settings.database.c_str());
+        LPINFO("Results are saved into " << settings.database << " as " << settings.run);
+        if(!settings.baseline.empty()) {
+            regressions = compareWithBaseline(corpus, measures, settings, database);
+        }
+    } catch(const std::runtime_error & error) {
+        LPERROR(error.what());
+        return EXIT_FAILURE;
+    }
+    return regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,725 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#include <globals.h>
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+#include <initpanopt.h>
+#include <linalg/densevector.h>
+#include <linalg/sparsevector.h>
+#include <linalg/indexeddensevector.h>
+#include <utils/architecture.h>
+#include <utils/primitives.h>
+#include <utils/numerical.h>
+#include <utils/memoryman.h>
+
+/**
+ * The relative error of a kernel result compared with the long double reference,
+ * scaled by the sum of the absolute values of the terms.
+ */
+static const long double RELATIVE_ERROR_LIMIT = 1e-12;
+
+/**
+ * The vector classes of the linalg module.
+ */
+enum VECTOR_TYPE {
+    DENSE_VECTOR,
+    SPARSE_VECTOR,
+    INDEXED_DENSE_VECTOR,
+    VECTOR_TYPE_COUNT
+};
+
+static const char * VECTOR_TYPE_NAMES[VECTOR_TYPE_COUNT] = {"dense", "sparse", "indexed"};
+
+static const char * ADD_TYPE_NAMES[] = {"ADD_FAST", "ADD_ABS", "ADD_ABS_REL"};
+
+static const char * DOT_PRODUCT_TYPE_NAMES[] = {"DOT_UNSTABLE", "DOT_FAST", "DOT_ABS", "DOT_ABS_REL"};
+
+/**
+ * The settings of the benchmark.
+ */
+struct BenchmarkSettings {
+    std::vector<unsigned int> lengths;
+    std::vector<double> densities;
+    double minTime;
+    std::string filter;
+    std::string csv;
+    bool vectors;
+    bool kernels;
+    bool memory;
+};
+
+/**
+ * The operands of a case: two dense arrays with the same length and density,
+ * and the vectors of every class created from them.
+ */
+struct Operands {
+    unsigned int length;
+    double density;
+    std::vector<Numerical::Double> x;
+    std::vector<Numerical::Double> y;
+    // the nonzero positions and values of x, for the raw sparse kernels
+    std::vector<unsigned int> xIndices;
+    std::vector<Numerical::Double> xValues;
+    unsigned int xNonzeros;
+    unsigned int yNonzeros;
+    DenseVector denseX;
+    DenseVector denseY;
+    SparseVector sparseX;
+    SparseVector sparseY;
+    IndexedDenseVector indexedX;
+    IndexedDenseVector indexedY;
+};
+
+/**
+ * The result of a measured case.
+ */
+struct CaseResult {
+    std::string kernel;
+    std::string variant;
+    std::string mode;
+    unsigned int length;
+    double density;
+    // the number of elements processed by one call
+    double elements;
+    // the estimated number of bytes read and written by one call
+    double bytes;
+    double seconds;
+    unsigned long long int calls;
+    bool passed;
+    double maxError;
+};
+
+/**
+ * The results are summed into this, so the compiler can not drop the dot products.
+ */
+static volatile Numerical::Double sm_sink;
+
+void printHelp() {
+    std::cout << "Usage: NewPanOptLinalgBenchmark [OPTION] \n" <<
+                 "Measure the addVector and dotProduct kernels of the DenseVector, SparseVector and \n"<<
+                 "IndexedDenseVector classes in every ADD_TYPE and DOT_PRODUCT_TYPE mode, and the raw \n"<<
+                 "dense kernels of the Architecture class (the selected SSE2/AVX routines, in cache and \n"<<
+                 "no cache variants) against the portable C implementations. Every result is checked \n"<<
+                 "against a scalar long double reference.\n"<<
+                 "\n"<<
+                 "   -n, --lengths   \t Comma separated vector lengths (default: 100,1000,10000,100000,1000000).\n"<<
+                 "   -d, --densities \t Comma separated densities (default: 1,0.1,0.01).\n"<<
+                 "   -t, --time      \t The minimal measured time of a case in seconds (default: 0.02).\n"<<
+                 "   -f, --filter    \t Run only the cases whose kernel names contain this text.\n"<<
+                 "   -c, --csv       \t Write the results into this CSV file too.\n"<<
+                 "   --vectors       \t Run only the vector class cases.\n"<<
+                 "   --kernels       \t Run only the raw kernel cases.\n"<<
+                 "   --memory        \t Print the statistics of the memory manager at the end.\n"<<
+                 "   -h, --help      \t Displays this help.\n"<<
+                 "\n"<<
+                 "The element count of a case is the length for the dense operations, and the nonzero\n"<<
+                 "count of the sparse operand otherwise; the bytes are estimated from the storage of\n"<<
+                 "the touched elements, so the GB/s column is a lower bound of the real traffic.\n"<<
+                 "The exit code is nonzero if a result differs from the reference.\n"<<
+                 "\n";
+}
+
+template <class T>
+std::vector<T> parseList(const std::string & text) {
+    std::vector<T> result;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        std::istringstream itemStream(item);
+        T value;
+        if (itemStream >> value) {
+            result.push_back(value);
+        }
+    }
+    return result;
+}
+
+/**
+ * Generates a random dense array with the given density, the nonzeros have both signs
+ * and different magnitudes, so the stable kernels have cancellations to handle.
+ */
+void generateArray(std::vector<Numerical::Double> & array, unsigned int length, double density,
+                   std::mt19937 & generator) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    array.assign(length, 0.0);
+    unsigned int index;
+    for (index = 0; index < length; index++) {
+        if (uniform(generator) < density) {
+            const double magnitude = std::pow(10.0, uniform(generator) * 4.0 - 2.0);
+            array[index] = uniform(generator) < 0.5 ? -magnitude : magnitude;
+        }
+    }
+}
+
+void createOperands(Operands & operands, unsigned int length, double density, unsigned int seed) {
+    std::mt19937 generator(seed);
+    operands.length = length;
+    operands.density = density;
+    generateArray(operands.x, length, density, generator);
+    generateArray(operands.y, length, density, generator);
+    operands.xIndices.clear();
+    operands.xValues.clear();
+    operands.yNonzeros = 0;
+    unsigned int index;
+    for (index = 0; index < length; index++) {
+        if (operands.x[index] != 0.0) {
+            operands.xIndices.push_back(index);
+            operands.xValues.push_back(operands.x[index]);
+        }
+        if (operands.y[index] != 0.0) {
+            operands.yNonzeros++;
+        }
+    }
+    operands.xNonzeros = operands.xIndices.size();
+    operands.denseX = DenseVector::createVectorFromDenseArray(operands.x.data(), length);
+    operands.denseY = DenseVector::createVectorFromDenseArray(operands.y.data(), length);
+    operands.sparseX = SparseVector::createVectorFromDenseArray(operands.x.data(), length);
+    operands.sparseY = SparseVector::createVectorFromDenseArray(operands.y.data(), length);
+    operands.indexedX = IndexedDenseVector::createVectorFromDenseArray(operands.x.data(), length);
+    operands.indexedY = IndexedDenseVector::createVectorFromDenseArray(operands.y.data(), length);
+}
+
+/**
+ * Calls the kernel with a doubling call count, until the measured time reaches minTime.
+ */
+void measure(const std::function<void(unsigned long long int)> & kernel, double minTime,
+             double * seconds, unsigned long long int * calls) {
+    // the first call warms up the caches and the lazily allocated buffers
+    kernel(0);
+    unsigned long long int count = 1;
+    while (true) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        unsigned long long int call;
+        for (call = 0; call < count; call++) {
+            kernel(call);
+        }
+        *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        *calls = count;
+        if (*seconds >= minTime || count >= (1ULL << 40)) {
+            return;
+        }
+        count *= 2;
+    }
+}
+
+/**
+ * Returns true if a computed value matches the reference: it differs by a rounding error,
+ * or the stable modes dropped a value which is within the tolerances.
+ *
+ * @param absSum The sum of the absolute values of the terms of the reference.
+ */
+bool checkValue(Numerical::Double value, long double reference, long double absSum,
+                bool absolute, bool relative, double * maxError) {
+    const long double error = std::fabs((long double)value - reference);
+    if (error <= RELATIVE_ERROR_LIMIT * absSum + 1e-300L) {
+        if (absSum > 0) {
+            *maxError = std::max(*maxError, (double)(error / absSum));
+        }
+        return true;
+    }
+    if (value == 0.0) {
+        if (absolute && std::fabs(reference) < Numerical::AbsoluteTolerance) {
+            return true;
+        }
+        if (relative && std::fabs(reference) <= absSum * Numerical::RelativeTolerance) {
+            return true;
+        }
+    }
+    *maxError = std::max(*maxError, absSum > 0 ? (double)(error / absSum) : (double)error);
+    return false;
+}
+
+/**
+ * Checks the result of y + lambda * x, given as a dense array.
+ */
+bool checkAdd(const Operands & operands, const std::vector<Numerical::Double> & result,
+              Numerical::Double lambda, Numerical::ADD_TYPE mode, double * maxError) {
+    bool passed = true;
+    unsigned int index;
+    for (index = 0; index < operands.length; index++) {
+        const long double term = (long double)lambda * operands.x[index];
+        const long double reference = operands.y[index] + term;
+        const long double absSum = std::fabs((long double)operands.y[index]) + std::fabs(term);
+        passed &= checkValue(result[index], reference, absSum, mode != Numerical::ADD_FAST,
+                             mode == Numerical::ADD_ABS_REL, maxError);
+    }
+    return passed;
+}
+
+bool checkDotProduct(const Operands & operands, Numerical::Double result, bool absolute, bool relative,
+                     double * maxError) {
+    long double reference = 0;
+    long double absSum = 0;
+    unsigned int index;
+    for (index = 0; index < operands.length; index++) {
+        const long double term = (long double)operands.x[index] * operands.y[index];
+        reference += term;
+        absSum += std::fabs(term);
+    }
+    return checkValue(result, reference, absSum, absolute, relative, maxError);
+}
+
+template <class VECTOR>
+std::vector<Numerical::Double> toArray(const VECTOR & vector) {
+    std::vector<Numerical::Double> result(vector.length());
+    unsigned int index;
+    for (index = 0; index < vector.length(); index++) {
+        result[index] = vector[index];
+    }
+    return result;
+}
+
+std::vector<Numerical::Double> toArray(const SparseVector & vector) {
+    DenseVector dense;
+    dense = vector;
+    return toArray(dense);
+}
+
+/**
+ * Returns the number of elements processed by an operation of the given operand classes:
+ * the length if both are dense, otherwise the nonzero count of the sparse operand.
+ */
+double getElements(const Operands & operands, VECTOR_TYPE target, VECTOR_TYPE operand) {
+    if (operand != DENSE_VECTOR) {
+        return operands.xNonzeros;
+    }
+    if (target != DENSE_VECTOR) {
+        return operands.yNonzeros;
+    }
+    return operands.length;
+}
+
+/**
+ * The estimated bytes of one element: a value, and an index for the non dense classes.
+ */
+double getElementBytes(VECTOR_TYPE type) {
+    return type == DENSE_VECTOR ? sizeof(Numerical::Double) : sizeof(Numerical::Double) + sizeof(unsigned int);
+}
+
+template <class TARGET, class OPERAND>
+void benchmarkAdd(const Operands & operands, const TARGET & target, VECTOR_TYPE targetType,
+                  const OPERAND & operand, VECTOR_TYPE operandType, Numerical::ADD_TYPE mode,
+                  const BenchmarkSettings & settings, std::vector<CaseResult> & results) {
+    CaseResult result;
+    result.kernel = std::string("addVector ") + VECTOR_TYPE_NAMES[targetType] + " += " + VECTOR_TYPE_NAMES[operandType];
+    if (result.kernel.find(settings.filter) == std::string::npos) {
+        return;
+    }
+    result.variant = "class";
+    result.mode = ADD_TYPE_NAMES[mode];
+    result.length = operands.length;
+    result.density = operands.density;
+    result.elements = getElements(operands, targetType, operandType);
+    // the operand is read, the target is read and written
+    result.bytes = result.elements * (getElementBytes(operandType) + 2 * getElementBytes(targetType));
+    result.maxError = 0;
+
+    DenseVector::setAddMode(mode);
+    SparseVector::setAddMode(mode);
+    IndexedDenseVector::setAddMode(mode);
+
+    const Numerical::Double lambda = 0.75;
+    TARGET checked(target);
+    checked.addVector(lambda, operand);
+    result.passed = checkAdd(operands, toArray(checked), lambda, mode, &result.maxError);
+
+    // the sign of lambda alternates, so the target does not grow during the measurement
+    TARGET measured(target);
+    measure([&](unsigned long long int call) {
+        measured.addVector((call & 1) ? -lambda : lambda, operand);
+    }, settings.minTime, &result.seconds, &result.calls);
+    results.push_back(result);
+}
+
+template <class FIRST, class SECOND>
+void benchmarkDotProduct(const Operands & operands, const FIRST & first, VECTOR_TYPE firstType,
+                         const SECOND & second, VECTOR_TYPE secondType, Numerical::DOT_PRODUCT_TYPE mode,
+                         const BenchmarkSettings & settings, std::vector<CaseResult> & results) {
+    CaseResult result;
+    result.kernel = std::string("dotProduct ") + VECTOR_TYPE_NAMES[firstType] + " . " + VECTOR_TYPE_NAMES[secondType];
+    if (result.kernel.find(settings.filter) == std::string::npos) {
+        return;
+    }
+    result.variant = "class";
+    result.mode = DOT_PRODUCT_TYPE_NAMES[mode];
+    result.length = operands.length;
+    result.density = operands.density;
+    result.elements = getElements(operands, firstType, secondType);
+    result.bytes = result.elements * (getElementBytes(firstType) + getElementBytes(secondType));
+    result.maxError = 0;
+
+    DenseVector::setDotProductMode(mode);
+    SparseVector::setDotProductMode(mode);
+    IndexedDenseVector::setDotProductMode(mode);
+
+    result.passed = checkDotProduct(operands, first.dotProduct(second),
+                                    mode == Numerical::DOT_ABS || mode == Numerical::DOT_ABS_REL,
+                                    mode == Numerical::DOT_ABS_REL, &result.maxError);
+    Numerical::Double sum = 0;
+    measure([&](unsigned long long int) {
+        sum += first.dotProduct(second);
+    }, settings.minTime, &result.seconds, &result.calls);
+    sm_sink = sum;
+    results.push_back(result);
+}
+
+/**
+ * Runs every addVector and dotProduct overload of the vector classes in every mode.
+ */
+void benchmarkVectors(const Operands & operands, const BenchmarkSettings & settings,
+                      std::vector<CaseResult> & results) {
+    int mode;
+    for (mode = Numerical::ADD_FAST; mode <= Numerical::ADD_ABS_REL; mode++) {
+        const Numerical::ADD_TYPE addMode = (Numerical::ADD_TYPE)mode;
+        benchmarkAdd(operands, operands.denseY, DENSE_VECTOR, operands.denseX, DENSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.denseY, DENSE_VECTOR, operands.sparseX, SPARSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.denseY, DENSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.sparseY, SPARSE_VECTOR, operands.denseX, DENSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.sparseY, SPARSE_VECTOR, operands.sparseX, SPARSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.sparseY, SPARSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.denseX, DENSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.sparseX, SPARSE_VECTOR, addMode, settings, results);
+        benchmarkAdd(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, addMode, settings, results);
+    }
+    for (mode = Numerical::DOT_UNSTABLE; mode <= Numerical::DOT_ABS_REL; mode++) {
+        const Numerical::DOT_PRODUCT_TYPE dotMode = (Numerical::DOT_PRODUCT_TYPE)mode;
+        benchmarkDotProduct(operands, operands.denseY, DENSE_VECTOR, operands.denseX, DENSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.denseY, DENSE_VECTOR, operands.sparseX, SPARSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.denseY, DENSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.sparseY, SPARSE_VECTOR, operands.denseX, DENSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.sparseY, SPARSE_VECTOR, operands.sparseX, SPARSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.sparseY, SPARSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.denseX, DENSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.sparseX, SPARSE_VECTOR, dotMode, settings, results);
+        benchmarkDotProduct(operands, operands.indexedY, INDEXED_DENSE_VECTOR, operands.indexedX, INDEXED_DENSE_VECTOR, dotMode, settings, results);
+    }
+
+    // the default modes of the vector classes are restored
+    DenseVector::setAddMode(Numerical::ADD_ABS_REL);
+    SparseVector::setAddMode(Numerical::ADD_ABS_REL);
+    IndexedDenseVector::setAddMode(Numerical::ADD_ABS_REL);
+    DenseVector::setDotProductMode(Numerical::DOT_ABS_REL);
+    SparseVector::setDotProductMode(Numerical::DOT_ABS_REL);
+    IndexedDenseVector::setDotProductMode(Numerical::DOT_ABS_REL);
+}
+
+/**
+ * A raw dense add kernel of the Architecture class, or its portable C counterpart.
+ * The kernels are called with the common parameters, and the tolerances of the mode.
+ */
+struct AddKernel {
+    const char * variant;
+    Numerical::ADD_TYPE mode;
+    std::function<void(const Numerical::Double *, const Numerical::Double *, Numerical::Double *,
+                       size_t, Numerical::Double)> function;
+};
+
+/**
+ * A raw dot product kernel; it returns the dot product of the x and y arrays of the operands.
+ */
+struct DotProductKernel {
+    const char * kernel;
+    const char * variant;
+    bool sparse;
+    std::function<Numerical::Double(const Operands &)> function;
+};
+
+typedef ArchitectureInterface Kernels;
+
+std::vector<AddKernel> getAddKernels() {
+    const Numerical::Double absTolerance = Numerical::AbsoluteTolerance;
+    const Numerical::Double relTolerance = Numerical::RelativeTolerance;
+    const Kernels::AddDenseToDense fast[] = {Architecture::getAddDenseToDenseCache(),
+                                             Architecture::getAddDenseToDenseNoCache(),
+                                             ::denseToDenseAdd};
+    const Kernels::AddDenseToDenseAbs abs[] = {Architecture::getAddDenseToDenseAbsCache(),
+                                               Architecture::getAddDenseToDenseAbsNoCache(),
+                                               ::denseToDenseAddAbs};
+    const Kernels::AddDenseToDenseAbsRel absRel[] = {Architecture::getAddDenseToDenseAbsRelCache(),
+                                                     Architecture::getAddDenseToDenseAbsRelNoCache(),
+                                                     ::denseToDenseAddAbsRel};
+    const char * variants[] = {"cache", "nocache", "C"};
+    std::vector<AddKernel> kernels;
+    unsigned int index;
+    for (index = 0; index < 3; index++) {
+        const Kernels::AddDenseToDense fastKernel = fast[index];
+        const Kernels::AddDenseToDenseAbs absKernel = abs[index];
+        const Kernels::AddDenseToDenseAbsRel absRelKernel = absRel[index];
+        kernels.push_back({variants[index], Numerical::ADD_FAST, fastKernel});
+        kernels.push_back({variants[index], Numerical::ADD_ABS,
+                           [=](const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                               size_t count, Numerical::Double lambda) {
+            absKernel(a, b, c, count, lambda, absTolerance);
+        }});
+        kernels.push_back({variants[index], Numerical::ADD_ABS_REL,
+                           [=](const Numerical::Double * a, const Numerical::Double * b, Numerical::Double * c,
+                               size_t count, Numerical::Double lambda) {
+            absRelKernel(a, b, c, count, lambda, absTolerance, relTolerance);
+        }});
+    }
+    return kernels;
+}
+
+std::vector<DotProductKernel> getDotProductKernels() {
+    std::vector<DotProductKernel> kernels;
+    const Kernels::DenseToDenseDotProductUnstable denseUnstable[] = {
+        Architecture::getDenseToDenseDotProductUnstable(), ::denseToDenseDotProductUnstable};
+    const Kernels::DenseToDenseDotProductStable denseStable[] = {
+        Architecture::getDenseToDenseDotProductStable(), ::denseToDenseDotProductStable};
+    const Kernels::DenseToSparseDotProductUnstable sparseUnstable[] = {
+        Architecture::getDenseToSparseDotProductUnstable(), ::denseToSparseDotProductUnstable};
+    const Kernels::DenseToSparseDotProductStable sparseStable[] = {
+        Architecture::getDenseToSparseDotProductStable(), ::denseToSparseDotProductStable};
+    const Kernels::IndexedDenseToIndexedDenseDotProductUnstable indexedUnstable[] = {
+        Architecture::getIndexedDenseToIndexedDenseDotProductUnstable(), ::indexedDenseToIndexedDenseDotProductUnstable};
+    const Kernels::IndexedDenseToIndexedDenseDotProductStable indexedStable[] = {
+        Architecture::getIndexedDenseToIndexedDenseDotProductStable(), ::indexedDenseToIndexedDenseDotProductStable};
+    const char * variants[] = {"selected", "C"};
+    unsigned int index;
+    for (index = 0; index < 2; index++) {
+        const Kernels::DenseToDenseDotProductUnstable denseUnstableKernel = denseUnstable[index];
+        const Kernels::DenseToDenseDotProductStable denseStableKernel = denseStable[index];
+        const Kernels::DenseToSparseDotProductUnstable sparseUnstableKernel = sparseUnstable[index];
+        const Kernels::DenseToSparseDotProductStable sparseStableKernel = sparseStable[index];
+        const Kernels::IndexedDenseToIndexedDenseDotProductUnstable indexedUnstableKernel = indexedUnstable[index];
+        const Kernels::IndexedDenseToIndexedDenseDotProductStable indexedStableKernel = indexedStable[index];
+        kernels.push_back({"dense-dense unstable", variants[index], false, [=](const Operands & operands) {
+            return denseUnstableKernel(operands.y.data(), operands.x.data(), operands.length);
+        }});
+        kernels.push_back({"dense-dense stable", variants[index], false, [=](const Operands & operands) {
+            Numerical::Double negative;
+            const Numerical::Double positive = denseStableKernel(operands.y.data(), operands.x.data(),
+                                                                 operands.length, &negative);
+            return positive + negative;
+        }});
+        kernels.push_back({"dense-sparse unstable", variants[index], true, [=](const Operands & operands) {
+            return sparseUnstableKernel(operands.y.data(), operands.xValues.data(), operands.xIndices.data(),
+                                        operands.xNonzeros);
+        }});
+        kernels.push_back({"dense-sparse stable", variants[index], true, [=](const Operands & operands) {
+            Numerical::Double negative;
+            const Numerical::Double positive = sparseStableKernel(operands.y.data(), operands.xValues.data(),
+                                                                  operands.xIndices.data(), operands.xNonzeros,
+                                                                  &negative);
+            return positive + negative;
+        }});
+        kernels.push_back({"indexed-indexed unstable", variants[index], true, [=](const Operands & operands) {
+            return indexedUnstableKernel(operands.y.data(), operands.x.data(), operands.xIndices.data(),
+                                         operands.xNonzeros);
+        }});
+        kernels.push_back({"indexed-indexed stable", variants[index], true, [=](const Operands & operands) {
+            Numerical::Double negative;
+            const Numerical::Double positive = indexedStableKernel(operands.y.data(), operands.x.data(),
+                                                                   operands.xIndices.data(), operands.xNonzeros,
+                                                                   &negative);
+            return positive + negative;
+        }});
+    }
+    return kernels;
+}
+
+/**
+ * Runs the raw dense kernels of the Architecture class: both cache variants of the selected
+ * add kernels, the selected dot product kernels, and the portable C implementations.
+ */
+void benchmarkKernels(const Operands & operands, const BenchmarkSettings & settings,
+                      std::vector<CaseResult> & results) {
+    const Numerical::Double lambda = 0.75;
+    if (std::string("kernel add dense-dense").find(settings.filter) != std::string::npos) {
+        for (const AddKernel & kernel: getAddKernels()) {
+            CaseResult result;
+            result.kernel = "kernel add dense-dense";
+            result.variant = kernel.variant;
+            result.mode = ADD_TYPE_NAMES[kernel.mode];
+            result.length = operands.length;
+            result.density = operands.density;
+            result.elements = operands.length;
+            result.bytes = 3.0 * operands.length * sizeof(Numerical::Double);
+            result.maxError = 0;
+            std::vector<Numerical::Double> target(operands.y);
+            kernel.function(target.data(), operands.x.data(), target.data(), operands.length, lambda);
+            result.passed = checkAdd(operands, target, lambda, kernel.mode, &result.maxError);
+            target = operands.y;
+            measure([&](unsigned long long int call) {
+                kernel.function(target.data(), operands.x.data(), target.data(), operands.length,
+                                (call & 1) ? -lambda : lambda);
+            }, settings.minTime, &result.seconds, &result.calls);
+            results.push_back(result);
+        }
+    }
+    for (const DotProductKernel & kernel: getDotProductKernels()) {
+        const std::string name = std::string("kernel dot ") + kernel.kernel;
+        if (name.find(settings.filter) == std::string::npos) {
+            continue;
+        }
+        CaseResult result;
+        result.kernel = name;
+        result.variant = kernel.variant;
+        result.mode = "";
+        result.length = operands.length;
+        result.density = operands.density;
+        result.elements = kernel.sparse ? operands.xNonzeros : operands.length;
+        result.bytes = result.elements * (kernel.sparse ? 2 * sizeof(Numerical::Double) + sizeof(unsigned int) :
+                                                          2 * sizeof(Numerical::Double));
+        result.maxError = 0;
+        // the unstable kernels do not drop small results, the stable ones are summed without tolerances
+        result.passed = checkDotProduct(operands, kernel.function(operands), false, false, &result.maxError);
+        Numerical::Double sum = 0;
+        measure([&](unsigned long long int) {
+            sum += kernel.function(operands);
+        }, settings.minTime, &result.seconds, &result.calls);
+        sm_sink = sum;
+        results.push_back(result);
+    }
+}
+
+void printHeader() {
+    std::ostringstream header;
+    header << std::left << std::setw(42) << "Kernel" << std::setw(10) << "Variant" << std::setw(14) << "Mode"
+           << std::right << std::setw(9) << "Length" << std::setw(9) << "Density"
+           << std::setw(11) << "ns/elem" << std::setw(9) << "GB/s" << std::setw(11) << "Max error"
+           << "  Check";
+    LPINFO(header.str());
+}
+
+double getNanosecondsPerElement(const CaseResult & result) {
+    const double elements = std::max(result.elements, 1.0) * result.calls;
+    return result.seconds * 1e9 / elements;
+}
+
+double getGigabytesPerSecond(const CaseResult & result) {
+    return result.seconds > 0 ? result.bytes * result.calls / result.seconds / 1e9 : 0.0;
+}
+
+void printResult(const CaseResult & result) {
+    std::ostringstream line;
+    line << std::left << std::setw(42) << result.kernel << std::setw(10) << result.variant
+         << std::setw(14) << result.mode << std::right << std::setw(9) << result.length
+         << std::setw(9) << result.density << std::fixed << std::setprecision(3)
+         << std::setw(11) << getNanosecondsPerElement(result)
+         << std::setprecision(2) << std::setw(9) << getGigabytesPerSecond(result)
+         << std::scientific << std::setprecision(1) << std::setw(11) << result.maxError
+         << "  " << (result.passed ? "ok" : "FAILED");
+    LPINFO(line.str());
+}
+
+void writeCsv(const std::string & fileName, const std::vector<CaseResult> & results) {
+    std::ofstream csv(fileName.c_str());
+    if (!csv.is_open()) {
+        LPERROR("Can not open " << fileName);
+        return;
+    }
+    csv << "kernel,variant,mode,length,density,elements,calls,seconds,ns_per_element,gb_per_second,max_error,passed\n";
+    for (const CaseResult & result: results) {
+        csv << result.kernel << "," << result.variant << "," << result.mode << "," << result.length << ","
+            << result.density << "," << result.elements << "," << result.calls << ","
+            << std::setprecision(9) << result.seconds << "," << getNanosecondsPerElement(result) << ","
+            << getGigabytesPerSecond(result) << "," << result.maxError << ","
+            << (result.passed ? 1 : 0) << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchmarkSettings settings;
+    settings.lengths = {100, 1000, 10000, 100000, 1000000};
+    settings.densities = {1.0, 0.1, 0.01};
+    settings.minTime = 0.02;
+    settings.vectors = true;
+    settings.kernels = true;
+    settings.memory = false;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        const bool hasOperand = i + 1 < argc;
+        if(arg.compare("-h") == 0 || arg.compare("--help") == 0) {
+            printHelp();
+            return EXIT_SUCCESS;
+        } else if(arg.compare("--vectors") == 0) {
+            settings.kernels = false;
+        } else if(arg.compare("--kernels") == 0) {
+            settings.vectors = false;
+        } else if(arg.compare("--memory") == 0) {
+            settings.memory = true;
+        } else if(hasOperand && (arg.compare("-n") == 0 || arg.compare("--lengths") == 0)) {
+            settings.lengths = parseList<unsigned int>(argv[++i]);
+        } else if(hasOperand && (arg.compare("-d") == 0 || arg.compare("--densities") == 0)) {
+            settings.densities = parseList<double>(argv[++i]);
+        } else if(hasOperand && (arg.compare("-t") == 0 || arg.compare("--time") == 0)) {
+            settings.minTime = std::max(0.0, atof(argv[++i]));
+        } else if(hasOperand && (arg.compare("-f") == 0 || arg.compare("--filter") == 0)) {
+            settings.filter = argv[++i];
+        } else if(hasOperand && (arg.compare("-c") == 0 || arg.compare("--csv") == 0)) {
+            settings.csv = argv[++i];
+        } else {
+            std::cout << argv[0]<< ": invalid option: `" << argv[i]<<"`\n"<<
+                         "Try `"<< argv[0] <<" --help` for more information.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    const ArchitectureInterface & architecture = InitPanOpt::getInstance().getArchitecture();
+    LPINFO("Architecture: " << architecture.getArchitectureName() << ", CPU: " << architecture.getCPUName()
+           << ", SSE2: " << (architecture.featureExists("SSE2") ? "yes" : "no")
+           << ", AVX: " << (architecture.featureExists("AVX") ? "yes" : "no")
+           << ", largest cache: " << Architecture::getLargestCacheSize() << " bytes");
+    printHeader();
+
+    std::vector<CaseResult> results;
+    Operands operands;
+    unsigned int seed = 1;
+    for (unsigned int length: settings.lengths) {
+        for (double density: settings.densities) {
+            createOperands(operands, length, density, seed++);
+            const unsigned int first = results.size();
+            if (settings.vectors) {
+                benchmarkVectors(operands, settings, results);
+            }
+            if (settings.kernels) {
+                benchmarkKernels(operands, settings, results);
+            }
+            unsigned int index;
+            for (index = first; index < results.size(); index++) {
+                printResult(results[index]);
+            }
+        }
+    }
+
+    if (!settings.csv.empty()) {
+        writeCsv(settings.csv, results);
+    }
+    if (settings.memory) {
+        MemoryManager::printStatistics();
+    }
+    const unsigned int failed = std::count_if(results.begin(), results.end(),
+                                              [](const CaseResult & result) { return !result.passed; });
+    if (failed > 0) {
+        LPERROR(failed << " of " << results.size() << " cases differ from the reference");
+        return EXIT_FAILURE;
+    }
+    LPINFO("All " << results.size() << " cases match the reference");
+    return EXIT_SUCCESS;
+}
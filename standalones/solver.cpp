@@ -20,11 +20,14 @@
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <algorithm>
+#include <iomanip>
 #include <sys/stat.h>
 #include <dirent.h>
 
 #include <lp/model.h>
 #include <lp/mpsproblem.h>
+#include <lp/modelsnapshot.h>
 #include <lp/lpproblem.h>
 #include <lp/presolver.h>
 #include <simplex/dualsimplex.h>
@@ -34,46 +37,27 @@
 #include <simplex/simplexcontroller.h>
 
 #include <utils/tokenizer.h>
+#include <utils/timer.h>
+#include <utils/processpool.h>
 #include <simplex/checker.h>
 
 #include <linalg/indexeddensevector.h>
 
-void solve(std::string filename, ofstream & out, bool dump_vars = false) {
+#include <standalones/standaloneutils.h>
+
+void solve(std::string filename, ofstream & out, bool dump_vars = false, bool write_snapshot = false,
+           bool per_class = false) {
 
     Model model;
 
-    if(filename.size() > 3 && filename.substr(filename.size() - 3, 3) == ".LP") {
-        LpModelBuilder* builder = new LpModelBuilder();
-        builder->loadFromFile(filename);
-        model.build(*builder);
-        delete builder;
-    } else {
-        MpsModelBuilder* builder = new MpsModelBuilder();
-        builder->loadFromFile(filename.c_str());
-        model.build(*builder);
-        delete builder;
+    if(!loadModel(filename, model, write_snapshot)) {
+        return;
     }
-    if(SimplexParameterHandler::getInstance().getIntegerParameterValue("Global.debug_level") > 1) {
-        LPINFO("Number of nonzeros: "<<model.getMatrix().nonZeros());
-        LPINFO("Density: "<<model.getMatrix().density());
+    if(per_class) {
+        loadModelClassParameters(model);
     }
-
-    if(SimplexParameterHandler::getInstance().getBoolParameterValue("Starting.Presolve.enable") == true){
-        Presolver presolver(&model);
-        try {
-            presolver.presolve();
-#ifndef NDEBUG
-            presolver.printStatistics();
-#endif
-//            exit(-1);
-        } catch(Presolver::PresolverException e) {
-            LPERROR("[Presolver] " << e.getMessage());
-            exit(-1);
-        }
-    }
-
-    if(SimplexParameterHandler::getInstance().getBoolParameterValue("Starting.Scaling.enable") == true){
-        model.scale();
+    if(!prepareModel(model)) {
+        exit(-1);
     }
 
     //init simplexController
@@ -109,37 +93,27 @@ void printHelp() {
                  "   -f, --file      \t Solve an MPS file.\n"<<
                  "   -fl, --file-list \t Solve all the MPS files listed in text file.\n"<<
                  "   -p, --parameter-file \t Generate the default parameter files.\n"<<
+                 "   -c, --calibrate \t Measure the cache and sparsity thresholds of the vector kernels on this\n"<<
+                 "                   \t machine, and save them into the architecture parameter file.\n"<<
                  "   -s, --solution \t Prints the primal solution to the output file.\n"
+                 "   -ws, --write-snapshot \t Saves the binary snapshot of each parsed model next to it (.psn),\n"<<
+                 "                   \t the snapshot files can be solved instead of the MPS files.\n"<<
+                 "   -pc, --per-class \t Read the linalg.PAR_CLASS and simplex.PAR_CLASS files of the autotuner\n"<<
+                 "                   \t for the class of each model, if they exist. The class is given by the\n"<<
+                 "                   \t size (small, medium, large) and shape (tall, square, wide) of the model.\n"<<
+                 "   -j, --jobs      \t Solve at most the given number of files at once, in separate processes.\n"<<
+                 "                   \t The largest files are started first, the results are reported in order.\n"<<
+                 "   -t, --timeout   \t Abort the solving of a file after the given number of seconds.\n"<<
+                 "   -sw, --sweep    \t Solve the files with every parameter set of directory DIR and write the\n"<<
+                 "                   \t results into the table TABLE (`-sw DIR TABLE`). The parameter sets are the\n"<<
+                 "                   \t linalg.PAR_i and simplex.PAR_j files of NewPanOptParameterGenerator.\n"<<
+                 "                   \t Each model is loaded, presolved and scaled once with the current parameters.\n"<<
                  "   -o, --output    \t Redirect the solver output to a file.\n"<<
                  "   -h, --help      \t Displays this help.\n"<<
                  "\n";
 
 }
 
-bool isFile(std::string path){
-    struct stat s;
-    if( stat(path.c_str(),&s) == 0 )
-    {
-        if( s.st_mode & S_IFREG )
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool isDir(std::string path){
-    struct stat s;
-    if( stat(path.c_str(),&s) == 0 )
-    {
-        if( s.st_mode & S_IFDIR )
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
 void printInvalidOptionError(char** argv, int index) {
     std::cout << argv[0]<< ": invalid option: `" << argv[index]<<"`\n"<<
                  "Try `"<< argv[0] <<" --help` for more information.\n";
@@ -178,36 +152,45 @@ void generateParameterFiles() {
     }
 }
 
-void solveDir(std::string dirPath, ofstream & out, bool dump_vars = false) {
+void solveDir(std::string dirPath, std::vector<std::string> & files) {
     DIR *dir;
     struct dirent *ent;
+    std::vector<std::string> entries;
     if ((dir = opendir (dirPath.c_str())) != NULL) {
         while ((ent = readdir (dir)) != NULL) {
-            std::string entry(ent->d_name);
-            if(entry.size()>=4){
-                std::cout << "ENTRY: " << entry << "\n";
-            }
-            if(entry.size()>=4 && (entry.substr(entry.size()-4 , 4).compare(".MPS") == 0 ||
-                                   entry.substr(entry.size()-4 , 4).compare(".mps") == 0) ){
-                std::string filePath = dirPath;
-                filePath.append({PATH_SEPARATOR}).append(entry);
-                solve(filePath, out, dump_vars);
-            }
+            entries.push_back(ent->d_name);
         }
         closedir (dir);
     } else {
         std::cout << "Error opening the working directory.\n";
+        return;
+    }
+    // the order of readdir depends on the file system, the results are reported by name
+    std::sort(entries.begin(), entries.end());
+    for(unsigned int i = 0; i < entries.size(); i++) {
+        const std::string & entry = entries[i];
+        if(entry.size()>=4){
+            std::cout << "ENTRY: " << entry << "\n";
+        }
+        if(entry.size()>=4 && (entry.substr(entry.size()-4 , 4).compare(".MPS") == 0 ||
+                               entry.substr(entry.size()-4 , 4).compare(".mps") == 0 ||
+                               ModelSnapshot::isSnapshotFile(entry)) ){
+            std::string filePath = dirPath;
+            filePath.append({PATH_SEPARATOR}).append(entry);
+            files.push_back(filePath);
+        }
     }
 }
 
-void solveFileList(std::string fileListPath, ofstream & out, bool dump_vars = false) {
+void solveFileList(std::string fileListPath, std::vector<std::string> & files) {
     std::string line;
     std::ifstream fileList(fileListPath);
     if(fileList.is_open()) {
         while(getline(fileList,line) ) {
             std::cout << "LINE: "<<line << "\n";
-            if(line.size()>=4 && line.substr(line.size()-4 , 4).compare(".MPS") == 0){
-                solve(line, out, dump_vars);
+            if((line.size()>=4 && line.substr(line.size()-4 , 4).compare(".MPS") == 0) ||
+                    ModelSnapshot::isSnapshotFile(line)){
+                files.push_back(line);
             } else {
                 std::cout << "Invalid record in the list: "<<line << "\n";
             }
@@ -220,35 +203,184 @@ void solveFileList(std::string fileListPath, ofstream & out, bool dump_vars = fa
     }
 }
 
-void redirectOutput(std::string path) {
-    OutputHandler::getInstance().disableAllColors();
-    freopen(path.c_str(), "a", stderr);
+unsigned long long int getFileSize(const std::string & path) {
+    struct stat s;
+    if( stat(path.c_str(),&s) == 0 ) {
+        return s.st_size;
+    }
+    return 0;
 }
 
-bool setParameter(ParameterHandler& handler, const std::string& arg, const char * value){
-    if(handler.getParameterType(arg) == Entry::BOOL){
-        if(strcmp(value,"true") == 0){
-            handler.setParameterValue(arg, true);
-        } else if(strcmp(value,"false") == 0){
-            handler.setParameterValue(arg, false);
-        } else {
-            return false;
+/**
+ * Solves the files with at most jobs worker processes at a time. The largest files
+ * are started first, but the logs and the solutions are written in the order of
+ * the files, so the output does not depend on the scheduling.
+ *
+ * @param timeout The wall-clock time limit of a file in seconds, 0 means no limit.
+ */
+void solveInWorkers(const std::vector<std::string> & files, ofstream & out, bool dump_vars,
+                    bool write_snapshot, bool per_class, unsigned int jobs, unsigned int timeout) {
+    std::vector<unsigned long long int> sizes(files.size());
+    for(unsigned int i = 0; i < files.size(); i++) {
+        sizes[i] = getFileSize(files[i]);
+    }
+    ProcessPool pool(jobs, timeout);
+    pool.run(files.size(), sizes, [&](unsigned int index, const std::string & resultName) {
+        ofstream solutionOut;
+        if(dump_vars) {
+            solutionOut.open(resultName.c_str());
         }
-    } else if(handler.getParameterType(arg) == Entry::DOUBLE) {
-        handler.setParameterValue(arg, atof(value));
-    } else if(handler.getParameterType(arg) == Entry::INTEGER) {
-        handler.setParameterValue(arg, atoi(value));
-    } else if(handler.getParameterType(arg) == Entry::STRING) {
-        if (handler.validateParameterValue(arg, value)) {
-            handler.setParameterValue(arg, std::string(value));
+        solve(files[index], solutionOut, dump_vars, write_snapshot, per_class);
+        solutionOut.close();
+        return true;
+    }, [&](unsigned int index, ProcessPool::TASK_RESULT result, const std::string & logName,
+           const std::string & resultName) {
+        std::cerr.flush();
+        ProcessPool::copyFile(logName, std::cerr);
+        if(result == ProcessPool::SUCCEEDED) {
+            LPINFO("Solved " << files[index]);
+            if(dump_vars) {
+                ProcessPool::copyFile(resultName, out);
+            }
+        } else if(result == ProcessPool::TIMED_OUT) {
+            LPERROR("Time limit of " << timeout << " seconds exceeded, solving of " << files[index] << " aborted");
         } else {
-            std::cout << "Invalid parameter value " << value << " for parameter " << arg << "\n";
+            LPERROR("Solving of " << files[index] << " failed");
+        }
+    });
+}
+
+/**
+ * A set of parameter files of a sweep.
+ */
+struct ParameterSet {
+    std::string m_linalgFile;
+    std::string m_simplexFile;
+};
+
+/**
+ * Lists the parameter sets generated by NewPanOptParameterGenerator into a directory.
+ * Every linalg.PAR_i file is combined with every simplex.PAR_j file; if there are no
+ * files of a kind, the current parameters of that kind are used.
+ */
+std::vector<ParameterSet> listParameterSets(const std::string & dirPath) {
+    std::vector<std::string> linalgFiles;
+    std::vector<std::string> simplexFiles;
+    for(unsigned int i = 0; ; i++) {
+        std::string path = dirPath + PATH_SEPARATOR + "linalg.PAR_" + std::to_string(i);
+        if(!isFile(path)) {
+            break;
+        }
+        linalgFiles.push_back(path);
+    }
+    for(unsigned int i = 0; ; i++) {
+        std::string path = dirPath + PATH_SEPARATOR + "simplex.PAR_" + std::to_string(i);
+        if(!isFile(path)) {
+            break;
+        }
+        simplexFiles.push_back(path);
+    }
+    if(linalgFiles.empty()) {
+        linalgFiles.push_back("");
+    }
+    if(simplexFiles.empty()) {
+        simplexFiles.push_back("");
+    }
+    std::vector<ParameterSet> sets;
+    for(unsigned int linalgIndex = 0; linalgIndex < linalgFiles.size(); linalgIndex++) {
+        for(unsigned int simplexIndex = 0; simplexIndex < simplexFiles.size(); simplexIndex++) {
+            ParameterSet set;
+            set.m_linalgFile = linalgFiles[linalgIndex];
+            set.m_simplexFile = simplexFiles[simplexIndex];
+            sets.push_back(set);
+        }
+    }
+    return sets;
+}
+
+/**
+ * Solves every model with every parameter set of the sweep directory, and writes one
+ * row per model and parameter set into the result table. Each model is loaded, presolved
+ * and scaled only once with the current parameters, then the parameter sets are
+ * evaluated against it in worker processes, which share the model read-only.
+ */
+void solveSweep(const std::vector<std::string> & files, const std::string & sweepDir,
+                const std::string & tablePath, unsigned int jobs, unsigned int timeout) {
+    const std::vector<ParameterSet> sets = listParameterSets(sweepDir);
+    std::ofstream table(tablePath.c_str());
+    if(!table.is_open()) {
+        std::cout << "Unable to open the sweep result table.\n";
+        return;
+    }
+    table << "Model\tLinalg\tSimplex\tStatus\tObjective\tIterations\tTime\n";
+    LPINFO("Parameter sweep of " << files.size() << " models with " << sets.size() << " parameter sets");
+    for(unsigned int fileIndex = 0; fileIndex < files.size(); fileIndex++) {
+        Model model;
+        if(!loadModel(files[fileIndex], model, false)) {
+            table << files[fileIndex] << "\t-\t-\tFAILED\t-\t-\t-\n";
+            continue;
+        }
+        if(!prepareModel(model)) {
             exit(-1);
         }
-    } else {
-        return false;
+
+        ProcessPool pool(jobs, timeout);
+        pool.run(sets.size(), std::vector<unsigned long long int>(),
+                 [&](unsigned int index, const std::string & resultName) {
+            const ParameterSet & set = sets[index];
+            if(!set.m_linalgFile.empty()) {
+                LinalgParameterHandler::getInstance().readParameterFile(set.m_linalgFile.c_str());
+                InitPanOpt::applyLinalgParameters();
+            }
+            if(!set.m_simplexFile.empty()) {
+                SimplexParameterHandler::getInstance().readParameterFile(set.m_simplexFile.c_str());
+            }
+            Timer timer;
+            timer.start();
+            SimplexController simplexController;
+            simplexController.solve(model);
+            timer.stop();
+            std::ofstream result(resultName.c_str());
+            result << (simplexController.isOptimal() ? "OPTIMAL" : "NOT_OPTIMAL") << "\t"
+                   << std::setprecision(16) << simplexController.getObjectiveValue() << "\t"
+                   << simplexController.getIterationCount() << "\t"
+                   << std::setprecision(6) << timer.getTotalElapsed();
+            return true;
+        }, [&](unsigned int index, ProcessPool::TASK_RESULT result, const std::string & logName,
+               const std::string & resultName) {
+            const ParameterSet & set = sets[index];
+            std::cerr.flush();
+            ProcessPool::copyFile(logName, std::cerr);
+            table << files[fileIndex] << "\t"
+                  << (set.m_linalgFile.empty() ? "-" : set.m_linalgFile) << "\t"
+                  << (set.m_simplexFile.empty() ? "-" : set.m_simplexFile) << "\t";
+            if(result == ProcessPool::SUCCEEDED) {
+                ProcessPool::copyFile(resultName, table);
+                table << "\n";
+            } else {
+                table << (result == ProcessPool::TIMED_OUT ? "TIMEOUT" : "FAILED") << "\t-\t-\t-\n";
+            }
+            table.flush();
+        });
+    }
+    table.close();
+}
+
+void solveFiles(const std::vector<std::string> & files, ofstream & out, bool dump_vars,
+                bool write_snapshot, bool per_class, unsigned int jobs, unsigned int timeout) {
+    // the class parameters of a model are read in its own worker, so they do not leak into the next model
+    if(jobs > 1 || timeout > 0 || per_class) {
+        solveInWorkers(files, out, dump_vars, write_snapshot, per_class, jobs, timeout);
+        return;
+    }
+    for(unsigned int i = 0; i < files.size(); i++) {
+        solve(files[i], out, dump_vars, write_snapshot);
     }
-    return true;
+}
+
+void redirectOutput(std::string path) {
+    OutputHandler::getInstance().disableAllColors();
+    freopen(path.c_str(), "a", stderr);
 }
 
 int main(int argc, char** argv) {
@@ -257,6 +389,12 @@ int main(int argc, char** argv) {
     std::vector<std::pair<std::string, std::string> > solvables;
     bool outputRedirected = false;
     bool dump_vars = false;
+    bool write_snapshot = false;
+    bool per_class = false;
+    unsigned int jobs = 1;
+    unsigned int timeout = 0;
+    std::string sweepDir;
+    std::string sweepTable;
     ofstream out;
 
     ParameterHandler& linalgHandler = LinalgParameterHandler::getInstance();
@@ -295,6 +433,40 @@ int main(int argc, char** argv) {
                     }
                     i++;
                 }
+            } else if(arg.compare("-ws") == 0 || arg.compare("--write-snapshot") == 0) {
+                write_snapshot = true;
+            } else if(arg.compare("-pc") == 0 || arg.compare("--per-class") == 0) {
+                per_class = true;
+            } else if(arg.compare("-sw") == 0 || arg.compare("--sweep") == 0) {
+                if(argc < i+3 ){
+                    printMissingOperandError(argv);
+                    return -1;
+                } else if(!isDir(argv[i+1])) {
+                    printInvalidOperandError(argv, i, i+1);
+                    return -1;
+                } else {
+                    sweepDir = argv[i+1];
+                    sweepTable = argv[i+2];
+                    i+=2;
+                }
+            } else if(arg.compare("-j") == 0 || arg.compare("--jobs") == 0 ||
+                      arg.compare("-t") == 0 || arg.compare("--timeout") == 0) {
+                if(argc < i+2 ){
+                    printMissingOperandError(argv);
+                    return -1;
+                } else {
+                    int value = atoi(argv[i+1]);
+                    if(value < 0 || (value == 0 && (arg.compare("-j") == 0 || arg.compare("--jobs") == 0))) {
+                        printInvalidOperandError(argv, i, i+1);
+                        return -1;
+                    }
+                    if(arg.compare("-j") == 0 || arg.compare("--jobs") == 0) {
+                        jobs = value;
+                    } else {
+                        timeout = value;
+                    }
+                    i++;
+                }
             } else if(arg.compare("-f") == 0 || arg.compare("--file") == 0){
                 if(argc < i+2 ){
                     printMissingOperandError(argv);
@@ -325,6 +497,9 @@ int main(int argc, char** argv) {
                 }
             } else if(arg.compare("-p") == 0 || arg.compare("--parameter-file") == 0){
                 generateParameterFiles();
+            } else if(arg.compare("-c") == 0 || arg.compare("--calibrate") == 0){
+                InitPanOpt::getInstance().getArchitecture().calibrate();
+                InitPanOpt::getInstance().getArchitecture().generateParameterFile();
             } else if(arg.compare("-o") == 0 || arg.compare("--output") == 0){
                 if(argc < i+2 ){
                     printMissingOperandError(argv);
@@ -343,6 +518,7 @@ int main(int argc, char** argv) {
                         printInvalidOperandError(argv, i, i+1);
                         break;
                     }
+                    InitPanOpt::applyLinalgParameters();
                 }
                 //Check if the givel value is a simplex parameter
                 else if(simplexHandler.hasParameter(arg)){
@@ -362,15 +538,21 @@ int main(int argc, char** argv) {
         }
     }
 
+    std::vector<std::string> files;
     for(unsigned int i=0; i<solvables.size(); i++){
         if(solvables[i].first.compare("d") == 0){
-            solveDir(solvables[i].second, out, dump_vars);
+            solveDir(solvables[i].second, files);
         } else if(solvables[i].first.compare("f") == 0){
-            solve(solvables[i].second, out, dump_vars);
+            files.push_back(solvables[i].second);
         } else if(solvables[i].first.compare("fl") == 0){
-            solveFileList(solvables[i].second, out, dump_vars);
+            solveFileList(solvables[i].second, files);
         }
     }
+    if(!sweepDir.empty()) {
+        solveSweep(files, sweepDir, sweepTable, jobs, timeout);
+    } else {
+        solveFiles(files, out, dump_vars, write_snapshot, per_class, jobs, timeout);
+    }
 
     if(dump_vars) {
         out.close();
@@ -0,0 +1,195 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file standaloneutils.cpp
+ */
+
+#include <standalones/standaloneutils.h>
+
+#include <cstdlib>
+#include <sys/stat.h>
+
+#include <globals.h>
+#include <initpanopt.h>
+#include <lp/mpsproblem.h>
+#include <lp/lpproblem.h>
+#include <lp/modelsnapshot.h>
+#include <lp/presolver.h>
+#include <simplex/simplexparameterhandler.h>
+#include <linalg/linalgparameterhandler.h>
+
+bool isFile(const std::string & path) {
+    struct stat s;
+    if( stat(path.c_str(),&s) == 0 )
+    {
+        if( s.st_mode & S_IFREG )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isDir(const std::string & path) {
+    struct stat s;
+    if( stat(path.c_str(),&s) == 0 )
+    {
+        if( s.st_mode & S_IFDIR )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string getSnapshotName(const std::string & filename) {
+    std::string::size_type extension = filename.find_last_of('.');
+    std::string::size_type separator = filename.find_last_of(PATH_SEPARATOR);
+    if(extension == std::string::npos || (separator != std::string::npos && extension < separator)) {
+        return filename + ".psn";
+    }
+    return filename.substr(0, extension) + ".psn";
+}
+
+bool loadModel(const std::string & filename, Model & model, bool writeSnapshot) {
+    if(ModelSnapshot::isSnapshotFile(filename)) {
+        ModelSnapshot* snapshot = new ModelSnapshot();
+        try {
+            snapshot->loadFromFile(filename);
+        } catch(ModelSnapshot::InvalidSnapshotException & e) {
+            LPERROR(e.getMessage());
+            delete snapshot;
+            return false;
+        }
+        model.build(*snapshot);
+        if(model.getHash() != snapshot->getModelHash()) {
+            LPERROR("The model built from the snapshot " << filename << " does not match its hash");
+            delete snapshot;
+            return false;
+        }
+        delete snapshot;
+        writeSnapshot = false;
+    } else if(filename.size() > 3 && filename.substr(filename.size() - 3, 3) == ".LP") {
+        LpModelBuilder* builder = new LpModelBuilder();
+        builder->loadFromFile(filename);
+        model.build(*builder);
+        delete builder;
+    } else {
+        MpsModelBuilder* builder = new MpsModelBuilder();
+        builder->loadFromFile(filename.c_str());
+        model.build(*builder);
+        delete builder;
+    }
+    if(writeSnapshot) {
+        std::string snapshotName = getSnapshotName(filename);
+        try {
+            ModelSnapshot::write(model, snapshotName);
+            LPINFO("Model snapshot written to " << snapshotName);
+        } catch(FileNotFoundException & e) {
+            LPERROR(e.getMessage() << " " << e.getFileName());
+        }
+    }
+    if(SimplexParameterHandler::getInstance().getIntegerParameterValue("Global.debug_level") > 1) {
+        LPINFO("Number of nonzeros: "<<model.getMatrix().nonZeros());
+        LPINFO("Density: "<<model.getMatrix().density());
+    }
+    return true;
+}
+
+bool prepareModel(Model & model) {
+    if(SimplexParameterHandler::getInstance().getBoolParameterValue("Starting.Presolve.enable") == true){
+        Presolver presolver(&model);
+        try {
+            presolver.presolve();
+#ifndef NDEBUG
+            presolver.printStatistics();
+#endif
+        } catch(const Presolver::PresolverException & e) {
+            LPERROR("[Presolver] " << e.getMessage());
+            return false;
+        }
+    }
+
+    if(SimplexParameterHandler::getInstance().getBoolParameterValue("Starting.Scaling.enable") == true){
+        model.scale();
+    }
+    return true;
+}
+
+bool setParameter(ParameterHandler & handler, const std::string & name, const std::string & value) {
+    if(handler.getParameterType(name) == Entry::BOOL){
+        if(value.compare("true") == 0){
+            handler.setParameterValue(name, true);
+        } else if(value.compare("false") == 0){
+            handler.setParameterValue(name, false);
+        } else {
+            return false;
+        }
+    } else if(handler.getParameterType(name) == Entry::DOUBLE) {
+        handler.setParameterValue(name, atof(value.c_str()));
+    } else if(handler.getParameterType(name) == Entry::INTEGER) {
+        handler.setParameterValue(name, atoi(value.c_str()));
+    } else if(handler.getParameterType(name) == Entry::STRING) {
+        if (handler.validateParameterValue(name, value)) {
+            handler.setParameterValue(name, value);
+        } else {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string getModelClass(const Model & model) {
+    const Matrix & matrix = model.getMatrix();
+    const unsigned long long int nonZeros = matrix.nonZeros();
+    std::string size;
+    if(nonZeros < 10000) {
+        size = "small";
+    } else if(nonZeros < 1000000) {
+        size = "medium";
+    } else {
+        size = "large";
+    }
+    const double ratio = matrix.columnCount() > 0 ? (double)matrix.rowCount() / matrix.columnCount() : 1;
+    std::string shape;
+    if(ratio > 2) {
+        shape = "tall";
+    } else if(ratio < 0.5) {
+        shape = "wide";
+    } else {
+        shape = "square";
+    }
+    return size + "_" + shape;
+}
+
+void loadModelClassParameters(const Model & model) {
+    const std::string modelClass = getModelClass(model);
+    // readParameterFile would write the missing files, so only the existing ones are read
+    const std::string linalgFile = std::string("linalg.PAR_") + modelClass;
+    if(isFile(linalgFile)) {
+        LPINFO("Reading the parameters of class " << modelClass << " from " << linalgFile);
+        LinalgParameterHandler::getInstance().readParameterFile(linalgFile.c_str());
+        InitPanOpt::applyLinalgParameters();
+    }
+    const std::string simplexFile = std::string("simplex.PAR_") + modelClass;
+    if(isFile(simplexFile)) {
+        LPINFO("Reading the parameters of class " << modelClass << " from " << simplexFile);
+        SimplexParameterHandler::getInstance().readParameterFile(simplexFile.c_str());
+    }
+}
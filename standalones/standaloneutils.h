@@ -0,0 +1,66 @@
+//=================================================================================================
+/*!
+//  This file is part of the Pannon Optimizer library.
+//  This library is free software; you can redistribute it and/or modify it under the
+//  terms of the GNU Lesser General Public License as published by the Free Software
+//  Foundation; either version 3.0, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License; see the file
+//  COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+/**
+ * @file standaloneutils.h This file contains the model loading and parameter handling
+ * functions shared by the solver and the autotuner.
+ */
+
+#ifndef STANDALONEUTILS_H
+#define STANDALONEUTILS_H
+
+#include <string>
+
+#include <lp/model.h>
+#include <utils/parameterhandler.h>
+
+bool isFile(const std::string & path);
+
+bool isDir(const std::string & path);
+
+/**
+ * Reads the model from an MPS, LP or snapshot file, and writes its snapshot if requested.
+ *
+ * @return False if the model cannot be loaded.
+ */
+bool loadModel(const std::string & filename, Model & model, bool writeSnapshot);
+
+/**
+ * Presolves and scales the model, if they are enabled.
+ *
+ * @return False if the presolver fails.
+ */
+bool prepareModel(Model & model);
+
+/**
+ * Sets a parameter from its string value.
+ *
+ * @return False if the value is invalid for the parameter.
+ */
+bool setParameter(ParameterHandler & handler, const std::string & name, const std::string & value);
+
+/**
+ * Returns the class of the model from its size and its row/column ratio, e.g. small_tall.
+ */
+std::string getModelClass(const Model & model);
+
+/**
+ * Reads the linalg.PAR_CLASS and simplex.PAR_CLASS files written by the autotuner for
+ * the class of the model, if they exist.
+ */
+void loadModelClassParameters(const Model & model);
+
+#endif // STANDALONEUTILS_H
@@ -5,8 +5,21 @@
 #include <cmath>
 #include <utils/arch/x86.h>
 #include <utils/primitives.h>
+#include <linalg/linalgparameterhandler.h>
+#include <lp/manualmodelbuilder.h>
+#include <lp/model.h>
+#include <simplex/simplexcontroller.h>
+#include <simplex/simplexparameterhandler.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <limits>
 #include <ctime>
+#include <thread>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #define MEMCPY_TESTBUFFER_MAX_SIZE      1024*10
 #define MEMCPY_FIX_BORDER               10
@@ -14,6 +27,42 @@
 
 #define DOT_PRODUCT_MAX_SIZE            1024
 
+// The standard containers and the objects allocated with new are counted by the MemoryManager too
+// while simplexSteadyStateAllocations() solves its model, so its allocation counter covers every
+// allocation. The other tests use the replacement as a plain malloc.
+static std::atomic<bool> s_countAllocations(false);
+
+void * operator new(size_t size) {
+    if (s_countAllocations.load(std::memory_order_relaxed)) {
+        MemoryManager::countAllocation();
+    }
+    void * pointer = malloc(size > 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void * operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void * pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void * pointer, size_t) noexcept {
+    free(pointer);
+}
+
 enum MEMCPY_SIZE_CASES {
     LARGE,
     SMALL,
@@ -23,6 +72,11 @@ enum MEMCPY_SIZE_CASES {
 CoreTestSuite::CoreTestSuite(const char *name): UnitTest(name) {
     ADD_TEST(CoreTestSuite::memcpy);
     //ADD_TEST(CoreTestSuite::memset);
+    ADD_TEST(CoreTestSuite::memoryManagerAlignment);
+    ADD_TEST(CoreTestSuite::memoryManagerThreads);
+    ADD_TEST(CoreTestSuite::memoryManagerSlabs);
+    ADD_TEST(CoreTestSuite::memoryManagerHugePages);
+    ADD_TEST(CoreTestSuite::simplexSteadyStateAllocations);
     //ADD_TEST(CoreTestSuite::denseToDenseDotProduct);
     //ADD_TEST(CoreTestSuite::denseToSparseDotProduct);
     //ADD_TEST(CoreTestSuite::denseToDenseAdd);
@@ -148,6 +202,184 @@ void CoreTestSuite::memset() {
 
 }
 
+void CoreTestSuite::memoryManagerAlignment() {
+    const size_t sizes[] = {0, 1, 47, 48, 49, 200, 1000, 4096, 100000,
+                            MemoryManager::sm_maxPooledSize, MemoryManager::sm_maxPooledSize + 1, 1000000};
+    std::vector<char*> blocks;
+    for (size_t size: sizes) {
+        char * block = static_cast<char*>(MemoryManager::allocate(size));
+        TEST_ASSERT(reinterpret_cast<size_t>(block) % MemoryManager::sm_alignment == 0);
+        for (size_t index = 0; index < size; index++) {
+            block[index] = (char)size;
+        }
+        blocks.push_back(block);
+    }
+    unsigned int index;
+    for (index = 0; index < blocks.size(); index++) {
+        TEST_ASSERT(sizes[index] == 0 || blocks[index][sizes[index] - 1] == (char)sizes[index]);
+        MemoryManager::release(blocks[index]);
+    }
+    MemoryManager::release(nullptr);
+
+    // the released block is reused by the next allocation of the same size class
+    double * first = alloc<double, 32>(100);
+    release(first);
+    double * second = alloc<double, 32>(100);
+    TEST_ASSERT(first == second);
+    release(second);
+}
+
+void CoreTestSuite::memoryManagerThreads() {
+    const unsigned int threadCount = 4;
+    const unsigned int blockCount = 2000;
+    std::vector<std::vector<unsigned int*> > blocks(threadCount);
+    std::vector<std::thread> threads;
+    unsigned int threadIndex;
+    // every thread allocates its own blocks, and releases the blocks of its neighbour
+    for (threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        threads.push_back(std::thread([&, threadIndex]() {
+            unsigned int index;
+            for (index = 0; index < blockCount; index++) {
+                unsigned int * block = alloc<unsigned int, 16>(index % 300 + 1);
+                block[index % 300] = threadIndex * blockCount + index;
+                blocks[threadIndex].push_back(block);
+            }
+        }));
+    }
+    for (std::thread & thread: threads) {
+        thread.join();
+    }
+    threads.clear();
+    for (threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        unsigned int index;
+        for (index = 0; index < blockCount; index++) {
+            unsigned int * block = blocks[threadIndex][index];
+            TEST_ASSERT(reinterpret_cast<size_t>(block) % MemoryManager::sm_alignment == 0);
+            TEST_ASSERT(block[index % 300] == threadIndex * blockCount + index);
+        }
+    }
+    for (threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        threads.push_back(std::thread([&, threadIndex]() {
+            const std::vector<unsigned int*> & neighbour = blocks[(threadIndex + 1) % threadCount];
+            unsigned int index;
+            for (index = 0; index < neighbour.size(); index++) {
+                release(neighbour[index]);
+            }
+        }));
+    }
+    for (std::thread & thread: threads) {
+        thread.join();
+    }
+
+    // the exited threads have merged their statistics
+    unsigned long long int allocations = 0;
+    unsigned long long int releases = 0;
+    for (const MemoryStatistics & statistics: MemoryManager::getStatistics()) {
+        allocations += statistics.m_allocations;
+        releases += statistics.m_releases;
+    }
+    TEST_ASSERT(allocations >= threadCount * blockCount);
+    TEST_ASSERT(releases >= threadCount * blockCount);
+}
+
+void CoreTestSuite::memoryManagerSlabs() {
+    // the blocks of the 4096 byte class fill their payload completely, and span several slabs
+    const size_t size = 4096 - 16;
+    const unsigned int blockCount = 1000;
+#ifdef __GLIBC__
+    // glibc maps the slabs separately by default, the unused end of their last page would hide an
+    // overrun, so they are carved from the heap, between other chunks
+    mallopt(M_MMAP_THRESHOLD, 64 * 1024 * 1024);
+#endif
+    std::vector<unsigned char*> blocks;
+    unsigned int index;
+    for (index = 0; index < blockCount; index++) {
+        unsigned char * block = static_cast<unsigned char*>(MemoryManager::allocate(size));
+        TEST_ASSERT(reinterpret_cast<size_t>(block) % MemoryManager::sm_alignment == 0);
+        size_t byteIndex;
+        for (byteIndex = 0; byteIndex < size; byteIndex++) {
+            block[byteIndex] = (unsigned char)index;
+        }
+        blocks.push_back(block);
+    }
+    for (index = 0; index < blockCount; index++) {
+        TEST_ASSERT(blocks[index][0] == (unsigned char)index);
+        TEST_ASSERT(blocks[index][size - 1] == (unsigned char)index);
+        MemoryManager::release(blocks[index]);
+    }
+#ifdef __GLIBC__
+    mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+#endif
+}
+
+void CoreTestSuite::memoryManagerHugePages() {
+    MemoryManager::setHugePageThreshold(MemoryManager::sm_hugePageSize);
+    const unsigned long long int hugePageAllocations = MemoryManager::getStatistics().back().m_hugePageAllocations;
+
+    // below the threshold the direct allocations use normal pages
+    const size_t smallCount = MemoryManager::sm_hugePageSize / sizeof(double) / 2;
+    double * small = alloc<double, 32>(smallCount);
+    small[smallCount - 1] = 1.0;
+    TEST_ASSERT(MemoryManager::getStatistics().back().m_hugePageAllocations == hugePageAllocations);
+
+    const size_t largeCount = MemoryManager::sm_hugePageSize / sizeof(double) * 3 + 5;
+    double * large = alloc<double, 32>(largeCount);
+    TEST_ASSERT(reinterpret_cast<size_t>(large) % MemoryManager::sm_alignment == 0);
+    large[0] = 2.0;
+    large[largeCount - 1] = 3.0;
+    TEST_ASSERT(large[0] == 2.0 && large[largeCount - 1] == 3.0);
+#ifdef __linux__
+    TEST_ASSERT(MemoryManager::getStatistics().back().m_hugePageAllocations == hugePageAllocations + 1);
+#endif
+    release(small);
+    release(large);
+
+    MemoryManager::setHugePageThreshold(
+                LinalgParameterHandler::getInstance().getIntegerParameterValue("huge_page_threshold"));
+}
+
+void CoreTestSuite::simplexSteadyStateAllocations() {
+    // a balanced transportation problem, it needs several reinversion cycles
+    const unsigned int sourceCount = 25;
+    const unsigned int sinkCount = 25;
+    ManualModelBuilder builder;
+    builder.setName("transportation");
+    builder.setObjectiveType(MINIMIZE);
+    unsigned int source;
+    unsigned int sink;
+    for (source = 0; source < sourceCount; source++) {
+        builder.addConstraint(Constraint::createEqualityTypeConstraint("source", 10 + source % 4), 0);
+    }
+    for (sink = 0; sink < sinkCount; sink++) {
+        builder.addConstraint(Constraint::createEqualityTypeConstraint("sink", 10 + sink % 4), 0);
+    }
+    for (source = 0; source < sourceCount; source++) {
+        for (sink = 0; sink < sinkCount; sink++) {
+            const double values[] = {1.0, 1.0};
+            const unsigned int indices[] = {source, sourceCount + sink};
+            builder.addVariable(Variable::createPlusTypeVariable("x", 0),
+                                1 + (source * 7 + sink * 13) % 17, 2, values, indices);
+        }
+    }
+    Model model;
+    model.build(builder);
+
+    ParameterHandler & parameters = SimplexParameterHandler::getInstance();
+    const int reinversionFrequency = parameters.getIntegerParameterValue("Factorization.reinversion_frequency");
+    parameters.setParameterValue("Factorization.reinversion_frequency", 10);
+    SimplexController simplexController;
+    s_countAllocations = true;
+    simplexController.solve(model);
+    s_countAllocations = false;
+    parameters.setParameterValue("Factorization.reinversion_frequency", reinversionFrequency);
+
+    const SimplexController::SolveStatistics & statistics = simplexController.getSolveStatistics();
+    TEST_ASSERT(simplexController.isOptimal());
+    TEST_ASSERT(statistics.m_steadyStateIterations > 0);
+    // after the first reinversion cycle the iterations reuse the work vectors and the etas
+    TEST_ASSERT(statistics.m_steadyStateAllocations == 0);
+}
+
 void CoreTestSuite::denseToDenseDotProduct() {
     double * arrayA = alloc<double, 32>(DOT_PRODUCT_MAX_SIZE);
     double * arrayB = alloc<double, 32>(DOT_PRODUCT_MAX_SIZE);
@@ -12,6 +12,13 @@ private:
     void memcpy();
     void memset();
 
+    void memoryManagerAlignment();
+    void memoryManagerThreads();
+    void memoryManagerSlabs();
+    void memoryManagerHugePages();
+
+    void simplexSteadyStateAllocations();
+
     void denseToDenseDotProduct();
     void denseToSparseDotProduct();
 
@@ -0,0 +1,276 @@
+#include <densevectortest.h>
+#include <linalg/densevector.h>
+#include <linalg/sparsevector.h>
+
+// The tests use a fixed sparsity ratio, so they do not depend on the parameter files,
+// and they restore the global settings with DenseVector::_globalInit() at the end
+#define TEST_SPARSITY_RATIO 0.5
+
+#define CHECK_ZERO_VECTOR(vector) \
+{ \
+    unsigned int index; \
+    for (index = 0; index < (vector).length(); index++) { \
+    TEST_ASSERT_EQUALITY((vector).at(index), 0.0); \
+    } \
+    }
+
+DenseVectorTestSuite::DenseVectorTestSuite(const char *name):
+    UnitTest(name)
+{
+    ADD_TEST(DenseVectorTestSuite::setNonzeroTracking);
+    ADD_TEST(DenseVectorTestSuite::dropOnDensity);
+    ADD_TEST(DenseVectorTestSuite::clearAfterDrop);
+    ADD_TEST(DenseVectorTestSuite::reInitGrowth);
+    ADD_TEST(DenseVectorTestSuite::addTrackedVector);
+    ADD_TEST(DenseVectorTestSuite::assignSparse);
+    ADD_TEST(DenseVectorTestSuite::nonzeroIndicesSorted);
+}
+
+void DenseVectorTestSuite::setNonzeroTracking()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    DenseVector v1(10);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), false);
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroIndices, nullptr);
+
+    v1.set(2, 1.0);
+    v1.set(7, 2.0);
+    v1.setNonzeroTracking(true);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.m_sparsityLimit, 5);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 2);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[0], 2);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[1], 7);
+
+    // an index is listed only once
+    v1.set(4, 3.0);
+    v1.set(4, 4.0);
+    v1.set(2, 5.0);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 3);
+    TEST_ASSERT_EQUALITY(v1.at(4), 4.0);
+    TEST_ASSERT_EQUALITY(v1.at(2), 5.0);
+
+    v1.setNonzeroTracking(false);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), false);
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroIndices, nullptr);
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroMarks, nullptr);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 0);
+    TEST_ASSERT_EQUALITY(v1.at(2), 5.0);
+    TEST_ASSERT_EQUALITY(v1.at(4), 4.0);
+    TEST_ASSERT_EQUALITY(v1.at(7), 2.0);
+
+    // a vector which is already too dense is not sparse after enabling the tracking
+    DenseVector v2(4);
+    v2.set(0, 1.0);
+    v2.set(1, 1.0);
+    v2.set(2, 1.0);
+    v2.setNonzeroTracking(true);
+    TEST_ASSERT_EQUALITY(v2.isSparse(), false);
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::dropOnDensity()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    DenseVector v1(10);
+    v1.setNonzeroTracking(true);
+    unsigned int index;
+    for (index = 0; index < 5; index++) {
+        v1.set(index, 1.0 + index);
+        TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    }
+    v1.set(5, 6.0);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), false);
+    for (index = 0; index < 6; index++) {
+        TEST_ASSERT_EQUALITY(v1.at(index), 1.0 + index);
+    }
+
+    // the operations which do not maintain the list drop it too
+    DenseVector v2(10);
+    v2.setNonzeroTracking(true);
+    v2.set(3, 1.0);
+    DenseVector v3(10);
+    v3.set(8, 2.0);
+    v2 = v3;
+    TEST_ASSERT_EQUALITY(v2.isSparse(), false);
+    TEST_ASSERT_EQUALITY(v2.at(8), 2.0);
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::clearAfterDrop()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    DenseVector v1(10);
+    v1.setNonzeroTracking(true);
+    unsigned int index;
+    for (index = 0; index < 10; index++) {
+        v1.set(index, 1.0 + index);
+    }
+    TEST_ASSERT_EQUALITY(v1.isSparse(), false);
+
+    v1.clear();
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 0);
+    CHECK_ZERO_VECTOR(v1);
+    for (index = 0; index < v1.m_nonzeroIndexCapacity; index++) {
+        TEST_ASSERT_EQUALITY(v1.m_nonzeroMarks[index], false);
+    }
+
+    // the restarted list tracks the new nonzeros
+    v1.set(6, 1.0);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 1);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[0], 6);
+
+    // a sparse vector clears only the listed elements
+    v1.clear();
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 0);
+    CHECK_ZERO_VECTOR(v1);
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::reInitGrowth()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    DenseVector v1(4);
+    v1.setNonzeroTracking(true);
+    v1.set(1, 1.0);
+    v1.set(3, 2.0);
+
+    v1.reInit(20);
+    TEST_ASSERT_EQUALITY(v1.length(), 20);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(v1.m_nonzeroIndexCapacity, 20);
+    TEST_ASSERT_EQUALITY(v1.m_sparsityLimit, 10);
+    CHECK_ZERO_VECTOR(v1);
+
+    // the indices beyond the old length can be tracked
+    v1.set(19, 3.0);
+    v1.set(10, 4.0);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 2);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[0], 10);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[1], 19);
+
+    v1.reInit(8);
+    TEST_ASSERT_EQUALITY(v1.length(), 8);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 0);
+    CHECK_ZERO_VECTOR(v1);
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::addTrackedVector()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+    DenseVector::setAddMode(Numerical::ADD_FAST);
+
+    DenseVector v1(10);
+    v1.setNonzeroTracking(true);
+    v1.set(8, 1.0);
+    v1.set(2, 2.0);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+
+    DenseVector v2(10);
+    v2.setNonzeroTracking(true);
+    v2.set(2, 1.0);
+    v2.set(5, 3.0);
+
+    // the tracked elements of v1 are added, and the new nonzeros of v2 are listed
+    v2.addVector(2.0, v1);
+    TEST_ASSERT_EQUALITY(v2.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v2.getNonzeroIndexCount(), 3);
+    TEST_ASSERT_EQUALITY(v2.getNonzeroIndices()[0], 2);
+    TEST_ASSERT_EQUALITY(v2.getNonzeroIndices()[1], 5);
+    TEST_ASSERT_EQUALITY(v2.getNonzeroIndices()[2], 8);
+    TEST_ASSERT_EQUALITY(v2.at(2), 5.0);
+    TEST_ASSERT_EQUALITY(v2.at(5), 3.0);
+    TEST_ASSERT_EQUALITY(v2.at(8), 2.0);
+
+    // an untracked operand drops the list of the result
+    DenseVector v3(10);
+    v3.set(0, 1.0);
+    v2.addVector(1.0, v3);
+    TEST_ASSERT_EQUALITY(v2.isSparse(), false);
+    TEST_ASSERT_EQUALITY(v2.at(0), 1.0);
+    TEST_ASSERT_EQUALITY(v2.at(2), 5.0);
+
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::assignSparse()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    SparseVector s1(12);
+    s1.set(9, 1.0);
+    s1.set(3, 2.0);
+
+    DenseVector v1(6);
+    v1.setNonzeroTracking(true);
+    v1.set(1, 5.0);
+    v1 = s1;
+    TEST_ASSERT_EQUALITY(v1.length(), 12);
+    TEST_ASSERT_EQUALITY(v1.isSparse(), true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 2);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[0], 3);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndices()[1], 9);
+    unsigned int index;
+    for (index = 0; index < v1.length(); index++) {
+        TEST_ASSERT_EQUALITY(v1.at(index), s1.at(index));
+    }
+
+    // without tracking the assignment gives the same elements
+    DenseVector v2(3);
+    v2.set(0, 1.0);
+    v2 = s1;
+    TEST_ASSERT_EQUALITY(v2.length(), 12);
+    TEST_ASSERT_EQUALITY(v2.isSparse(), false);
+    for (index = 0; index < v2.length(); index++) {
+        TEST_ASSERT_EQUALITY(v2.at(index), s1.at(index));
+    }
+
+    DenseVector::_globalInit();
+}
+
+void DenseVectorTestSuite::nonzeroIndicesSorted()
+{
+    DenseVector::sm_sparsityRatio = TEST_SPARSITY_RATIO;
+
+    DenseVector v1(20);
+    v1.setNonzeroTracking(true);
+    v1.set(3, 1.0);
+    v1.set(11, 1.0);
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroIndicesSorted, true);
+    v1.set(7, 1.0);
+    v1.set(1, 1.0);
+    v1.set(15, 1.0);
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroIndicesSorted, false);
+
+    const unsigned int * indices = v1.getNonzeroIndices();
+    TEST_ASSERT_EQUALITY(v1.m_nonzeroIndicesSorted, true);
+    TEST_ASSERT_EQUALITY(v1.getNonzeroIndexCount(), 5);
+    TEST_ASSERT_EQUALITY(indices[0], 1);
+    TEST_ASSERT_EQUALITY(indices[1], 3);
+    TEST_ASSERT_EQUALITY(indices[2], 7);
+    TEST_ASSERT_EQUALITY(indices[3], 11);
+    TEST_ASSERT_EQUALITY(indices[4], 15);
+
+    // the sorting does not move the elements
+    unsigned int index;
+    for (index = 0; index < 5; index++) {
+        TEST_ASSERT_EQUALITY(v1.at(indices[index]), 1.0);
+    }
+
+    DenseVector::_globalInit();
+}
@@ -0,0 +1,21 @@
+#ifndef DENSEVECTORTEST_H
+#define DENSEVECTORTEST_H
+
+#include <framework/tester.h>
+#include <framework/unittest.h>
+
+class DenseVectorTestSuite : public UnitTest {
+public:
+    DenseVectorTestSuite(const char * name);
+
+private:
+    void setNonzeroTracking();
+    void dropOnDensity();
+    void clearAfterDrop();
+    void reInitGrowth();
+    void addTrackedVector();
+    void assignSparse();
+    void nonzeroIndicesSorted();
+};
+
+#endif // DENSEVECTORTEST_H
@@ -1 +1,77 @@
+#include <framework/sqlitereportgenerator.h>
+#include <sqlite3.h>
+#include <stdexcept>
 
+SqliteReportGenerator::SqliteReportGenerator():
+    m_database(nullptr)
+{
+
+}
+
+SqliteReportGenerator::~SqliteReportGenerator()
+{
+    close();
+}
+
+std::vector<std::vector<std::string> > SqliteReportGenerator::query(const char *source,
+                                                                    const std::string &statement) const
+{
+    std::vector<std::vector<std::string> > result;
+    open(source);
+    sqlite3_stmt * prepared = nullptr;
+    checkResult(sqlite3_prepare_v2(m_database, statement.c_str(), -1, &prepared, nullptr), statement);
+    int step;
+    while ((step = sqlite3_step(prepared)) == SQLITE_ROW) {
+        std::vector<std::string> row;
+        int column;
+        for (column = 0; column < sqlite3_column_count(prepared); column++) {
+            const unsigned char * text = sqlite3_column_text(prepared, column);
+            row.push_back(text == nullptr ? "" : reinterpret_cast<const char *>(text));
+        }
+        result.push_back(row);
+    }
+    sqlite3_finalize(prepared);
+    if (step != SQLITE_DONE) {
+        checkResult(step, statement);
+    }
+    close();
+    return result;
+}
+
+void SqliteReportGenerator::open(const char *dest) const
+{
+    close();
+    const int result = sqlite3_open(dest, &m_database);
+    if (result != SQLITE_OK) {
+        close();
+        throw std::runtime_error(std::string("Cannot open the database ") + dest);
+    }
+}
+
+void SqliteReportGenerator::execute(const std::string &statement) const
+{
+    char * message = nullptr;
+    const int result = sqlite3_exec(m_database, statement.c_str(), nullptr, nullptr, &message);
+    if (result != SQLITE_OK) {
+        const std::string error = message == nullptr ? sqlite3_errstr(result) : message;
+        sqlite3_free(message);
+        throw std::runtime_error("SQLite error: " + error + " in " + statement);
+    }
+}
+
+void SqliteReportGenerator::close() const
+{
+    if (m_database != nullptr) {
+        sqlite3_close(m_database);
+        m_database = nullptr;
+    }
+}
+
+void SqliteReportGenerator::checkResult(int result, const std::string &statement) const
+{
+    if (result != SQLITE_OK && result != SQLITE_ROW && result != SQLITE_DONE) {
+        const std::string error = sqlite3_errmsg(m_database);
+        close();
+        throw std::runtime_error("SQLite error: " + error + " in " + statement);
+    }
+}
@@ -1,4 +1,37 @@
 #ifndef SQLITEREPORTGENERATOR_H
 #define SQLITEREPORTGENERATOR_H
 
-#endif // SQLITEGENERATOR_H
+#include <framework/sqlreportgenerator.h>
+#include <vector>
+
+struct sqlite3;
+
+/**
+ * Stores the report in an SQLite database file, the destination is the name
+ * of the file. Errors are reported with std::runtime_error.
+ */
+class SqliteReportGenerator: public SqlReportGenerator {
+public:
+    SqliteReportGenerator();
+
+    ~SqliteReportGenerator();
+
+    /**
+     * Runs a query on the database file, and returns the rows of the result.
+     * NULL values are returned as empty strings.
+     */
+    std::vector<std::vector<std::string> > query(const char * source,
+                                                 const std::string & statement) const;
+protected:
+    void open(const char * dest) const;
+
+    void execute(const std::string & statement) const;
+
+    void close() const;
+private:
+    mutable sqlite3 * m_database;
+
+    void checkResult(int result, const std::string & statement) const;
+};
+
+#endif // SQLITEREPORTGENERATOR_H
@@ -1 +1,129 @@
+#include <framework/sqlreportgenerator.h>
+#include <cctype>
+#include <sstream>
 
+void SqlReportGenerator::save(const Report &report,
+                              const char *dest) const
+{
+    open(dest);
+    execute("BEGIN TRANSACTION");
+    for ( auto & module: report.getModules() ) {
+        for ( auto & table: module.getTables() ) {
+            const std::string tableName = getTableName(module, table);
+            const std::vector<std::string> columnNames = getColumnNames(table);
+            execute(getCreateStatement(tableName, table, columnNames));
+            unsigned int rowIndex;
+            for (rowIndex = 0; rowIndex < table.getTable().size(); rowIndex++) {
+                const std::vector<ReportTable::Cell> & row = table.getTable()[rowIndex];
+                if (row.empty() == false && row[0].m_head) {
+                    continue;
+                }
+                execute(getInsertStatement(tableName, table, columnNames, rowIndex));
+            }
+        }
+    }
+    execute("COMMIT");
+    close();
+}
+
+std::string SqlReportGenerator::quote(const std::string &value) const
+{
+    std::string result = "'";
+    for (char character: value) {
+        if (character == '\'') {
+            result += '\'';
+        }
+        result += character;
+    }
+    return result + "'";
+}
+
+std::string SqlReportGenerator::getTableName(const ReportModule &module,
+                                             const ReportTable &table) const
+{
+    return getIdentifier(table.title().empty() ? module.name() : table.title());
+}
+
+std::vector<std::string> SqlReportGenerator::getColumnNames(const ReportTable &table) const
+{
+    std::vector<std::string> result;
+    const std::vector<std::vector<ReportTable::Cell> > & cells = table.getTable();
+    unsigned int columnIndex;
+    for (columnIndex = 0; columnIndex < table.getColumns().size(); columnIndex++) {
+        if (cells.empty() == false && cells[0][columnIndex].m_head) {
+            result.push_back(getIdentifier(cells[0][columnIndex].m_content));
+        } else {
+            result.push_back("column" + std::to_string(columnIndex));
+        }
+    }
+    return result;
+}
+
+std::string SqlReportGenerator::getCreateStatement(const std::string &tableName,
+                                                   const ReportTable &table,
+                                                   const std::vector<std::string> &columnNames) const
+{
+    std::ostringstream statement;
+    statement << "CREATE TABLE IF NOT EXISTS " << tableName << " (";
+    unsigned int columnIndex;
+    for (columnIndex = 0; columnIndex < columnNames.size(); columnIndex++) {
+        if (columnIndex > 0) {
+            statement << ", ";
+        }
+        statement << columnNames[columnIndex] << " ";
+        switch (table.getColumns()[columnIndex].m_type) {
+        case ReportTable::TYPE::INTEGER:
+            statement << "INTEGER";
+            break;
+        case ReportTable::TYPE::FLOAT:
+            statement << "REAL";
+            break;
+        case ReportTable::TYPE::STRING:
+            statement << "TEXT";
+            break;
+        }
+    }
+    statement << ")";
+    return statement.str();
+}
+
+std::string SqlReportGenerator::getInsertStatement(const std::string &tableName,
+                                                   const ReportTable &table,
+                                                   const std::vector<std::string> &columnNames,
+                                                   unsigned int rowIndex) const
+{
+    std::ostringstream statement;
+    statement << "INSERT INTO " << tableName << " (";
+    unsigned int columnIndex;
+    for (columnIndex = 0; columnIndex < columnNames.size(); columnIndex++) {
+        statement << (columnIndex > 0 ? ", " : "") << columnNames[columnIndex];
+    }
+    statement << ") VALUES (";
+    const std::vector<ReportTable::Cell> & row = table.getTable()[rowIndex];
+    for (columnIndex = 0; columnIndex < columnNames.size(); columnIndex++) {
+        if (columnIndex > 0) {
+            statement << ", ";
+        }
+        const std::string & content = row[columnIndex].m_content;
+        if (content.empty()) {
+            statement << "NULL";
+        } else {
+            // the numbers are quoted too, the affinity of the column converts them
+            statement << quote(content);
+        }
+    }
+    statement << ")";
+    return statement.str();
+}
+
+std::string SqlReportGenerator::getIdentifier(const std::string &name) const
+{
+    std::string result;
+    for (char character: name) {
+        result += std::isalnum((unsigned char)character) ? character : '_';
+    }
+    if (result.empty() || std::isdigit((unsigned char)result[0])) {
+        result = "_" + result;
+    }
+    return result;
+}
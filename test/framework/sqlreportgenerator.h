@@ -1,4 +1,45 @@
 #ifndef SQLREPORTGENERATOR_H
 #define SQLREPORTGENERATOR_H
 
+#include <framework/reportgenerator.h>
+#include <string>
+
+/**
+ * Stores the tables of a report in a relational database. Every table of the
+ * report is appended to the database table named after its title (or the name
+ * of its module), which is created at the first save. The first row of a report
+ * table gives the column names if it consists of head cells.
+ */
+class SqlReportGenerator: public ReportGenerator {
+public:
+    void save(const Report & report,
+              const char * dest) const;
+
+    /**
+     * Returns the value as an SQL string literal, the apostrophes are doubled.
+     */
+    std::string quote(const std::string & value) const;
+protected:
+    virtual void open(const char * dest) const = 0;
+
+    virtual void execute(const std::string & statement) const = 0;
+
+    virtual void close() const = 0;
+
+    std::string getTableName(const ReportModule & module, const ReportTable & table) const;
+private:
+    std::vector<std::string> getColumnNames(const ReportTable & table) const;
+
+    std::string getCreateStatement(const std::string & tableName,
+                                   const ReportTable & table,
+                                   const std::vector<std::string> & columnNames) const;
+
+    std::string getInsertStatement(const std::string & tableName,
+                                   const ReportTable & table,
+                                   const std::vector<std::string> & columnNames,
+                                   unsigned int rowIndex) const;
+
+    std::string getIdentifier(const std::string & name) const;
+};
+
 #endif // SQLREPORTGENERATOR_H
@@ -8,13 +8,17 @@
 #include <presolvertest.h>
 #include <lp/model.h>
 #include <lp/manualmodelbuilder.h>
+#include <lp/presolvermodule.h>
 
 using namespace std;
 
 PresolverTestSuite::PresolverTestSuite(const char * name) : UnitTest(name)
 {
     //ADD_TEST(PresolverTestSuite::init);
-    ADD_TEST(PresolverTestSuite::singletonRows);
+    //ADD_TEST(PresolverTestSuite::singletonRows);
+    ADD_TEST(PresolverTestSuite::doubletonEquation);
+    ADD_TEST(PresolverTestSuite::doubletonEquationChain);
+    ADD_TEST(PresolverTestSuite::dominatedColumn);
 }
 
 void PresolverTestSuite::init() {
@@ -43,10 +47,10 @@ void PresolverTestSuite::singletonRows() {
     Constraint c2 = Constraint::createRangeTypeConstraint("c2", 4, 8);
     Constraint c3 = Constraint::createRangeTypeConstraint("c3", 4, 5);
     Constraint c4 = Constraint::createRangeTypeConstraint("c4", 0, 2);
-    Vector cvect1(3); cvect1.set(0, 2);
-    Vector cvect2(3); cvect2.set(2, 4);
-    Vector cvect3(3); cvect3.set(1, 2); cvect3.set(2,5);
-    Vector cvect4(3); cvect4.set(1, -1);
+    SparseVector cvect1(3); cvect1.set(0, 2);
+    SparseVector cvect2(3); cvect2.set(2, 4);
+    SparseVector cvect3(3); cvect3.set(1, 2); cvect3.set(2,5);
+    SparseVector cvect4(3); cvect4.set(1, -1);
 
     builder.addConstraint(c1, cvect1);
     builder.addConstraint(c2, cvect2);
@@ -74,3 +78,150 @@ void PresolverTestSuite::singletonRows() {
 
 
 }
+
+void PresolverTestSuite::doubletonEquation() {
+
+    /*min.  x0 + 2*x1 + x2
+     *st    x0 + 2*x1        = 4
+     *      x0 + 2*x1 + x2  <= 10
+     *             x1 - x2  >= -6
+     *
+     *   x0, x1, x2 >= 0
+     *
+     * x0 = 4 - 2*x1 is substituted, x1 cancels from the second row
+     */
+    ManualModelBuilder builder;
+    builder.setObjectiveType(MINIMIZE);
+    builder.setName("doubleton");
+    const double values1[] = {1, 2};
+    const double values2[] = {1, 2, 1};
+    const double values3[] = {1, -1};
+    const unsigned int indices1[] = {0, 1};
+    const unsigned int indices2[] = {0, 1, 2};
+    const unsigned int indices3[] = {1, 2};
+    builder.addConstraint(Constraint::createEqualityTypeConstraint("c1", 4), values1, indices1, 2);
+    builder.addConstraint(Constraint::createLessTypeConstraint("c2", 10), values2, indices2, 3);
+    builder.addConstraint(Constraint::createGreaterTypeConstraint("c3", -6), values3, indices3, 2);
+    builder.setCostCoefficient(0, 1);
+    builder.setCostCoefficient(1, 2);
+    builder.setCostCoefficient(2, 1);
+
+    Model model;
+    model.build(builder);
+    const int nonZeros = model.getMatrix().nonZeros();
+
+    Presolver presolver(&model);
+    DoubletonEquationModule module(&presolver);
+    module.executeMethod();
+
+    TEST_ASSERT(model.constraintCount() == 2);
+    TEST_ASSERT(model.variableCount() == 2);
+    TEST_ASSERT(module.getRemovedConstraintCount() == 1);
+    TEST_ASSERT(module.getRemovedVariableCount() == 1);
+    TEST_ASSERT(module.getRemovedNonzerosCount() == nonZeros - (int)model.getMatrix().nonZeros());
+    checkNonzeroCounts(presolver);
+
+    //x1 <= 2 is transferred from x0 >= 0, the first row is x2 <= 6
+    TEST_ASSERT(model.getVariable(0).getUpperBound() == 2);
+    TEST_ASSERT(model.getConstraint(0).getVector()->nonZeros() == 1);
+    TEST_ASSERT(model.getConstraint(0).getUpperBound() == 6);
+    TEST_ASSERT(model.getCostVector().at(0) == 0);
+    TEST_ASSERT(model.getCostConstant() == -4);
+}
+
+void PresolverTestSuite::doubletonEquationChain() {
+
+    /*min.  x3
+     *st    x0 + x1            = 2
+     *           x1 + x2       = 3
+     *      x0      + x2 + x3 <= 5
+     *                x2 + x3 >= 1
+     *
+     *   x0, x1, x2, x3 >= 0
+     *
+     * x0 = 2 - x1 is substituted first, then x1 = 3 - x2, which must not fill in
+     * the first row, that is eliminated already
+     */
+    ManualModelBuilder builder;
+    builder.setObjectiveType(MINIMIZE);
+    builder.setName("doubletonchain");
+    const double values1[] = {1, 1};
+    const double values2[] = {1, 1, 1};
+    const unsigned int indices1[] = {0, 1};
+    const unsigned int indices2[] = {1, 2};
+    const unsigned int indices3[] = {0, 2, 3};
+    const unsigned int indices4[] = {2, 3};
+    builder.addConstraint(Constraint::createEqualityTypeConstraint("c1", 2), values1, indices1, 2);
+    builder.addConstraint(Constraint::createEqualityTypeConstraint("c2", 3), values1, indices2, 2);
+    builder.addConstraint(Constraint::createLessTypeConstraint("c3", 5), values2, indices3, 3);
+    builder.addConstraint(Constraint::createGreaterTypeConstraint("c4", 1), values1, indices4, 2);
+    builder.setCostCoefficient(3, 1);
+
+    Model model;
+    model.build(builder);
+    const int nonZeros = model.getMatrix().nonZeros();
+
+    Presolver presolver(&model);
+    DoubletonEquationModule module(&presolver);
+    module.executeMethod();
+
+    TEST_ASSERT(model.constraintCount() == 2);
+    TEST_ASSERT(model.variableCount() == 2);
+    TEST_ASSERT(module.getRemovedNonzerosCount() == nonZeros - (int)model.getMatrix().nonZeros());
+    checkNonzeroCounts(presolver);
+
+    //1 <= x2 <= 3, and the third row is 2*x2 + x3 <= 6
+    TEST_ASSERT(model.getVariable(0).getLowerBound() == 1);
+    TEST_ASSERT(model.getVariable(0).getUpperBound() == 3);
+    TEST_ASSERT(model.getConstraint(0).getVector()->at(0) == 2);
+    TEST_ASSERT(model.getConstraint(0).getUpperBound() == 6);
+    TEST_ASSERT(model.getConstraint(1).getLowerBound() == 1);
+}
+
+void PresolverTestSuite::dominatedColumn() {
+
+    /*min.  x0 + x1 + x2
+     *st    x0 + x1       >= 1
+     *           x1 + x2  <= 4
+     *
+     *   x0, x1, x2 >= 0
+     *
+     * The dual variable of the second row is nonpositive, so the reduced cost of x2 is
+     * at least 1, x2 is fixed to zero
+     */
+    ManualModelBuilder builder;
+    builder.setObjectiveType(MINIMIZE);
+    builder.setName("dominated");
+    const double values[] = {1, 1};
+    const unsigned int indices1[] = {0, 1};
+    const unsigned int indices2[] = {1, 2};
+    builder.addConstraint(Constraint::createGreaterTypeConstraint("c1", 1), values, indices1, 2);
+    builder.addConstraint(Constraint::createLessTypeConstraint("c2", 4), values, indices2, 2);
+    builder.setCostCoefficient(0, 1);
+    builder.setCostCoefficient(1, 1);
+    builder.setCostCoefficient(2, 1);
+
+    Model model;
+    model.build(builder);
+
+    Presolver presolver(&model);
+    DominatedColumnModule module(&presolver);
+    module.executeMethod();
+
+    TEST_ASSERT(module.getRemovedVariableCount() == 1);
+    TEST_ASSERT(module.getRemovedNonzerosCount() == 1);
+    TEST_ASSERT(model.variableCount() == 2);
+    TEST_ASSERT(model.getConstraint(1).getVector()->nonZeros() == 1);
+    TEST_ASSERT(model.getConstraint(1).getUpperBound() == 4);
+}
+
+void PresolverTestSuite::checkNonzeroCounts(Presolver & presolver) {
+    const Model & model = *presolver.getModel();
+    unsigned int index;
+    for (index = 0; index < model.variableCount(); index++) {
+        TEST_ASSERT(presolver.getColumnNonzeros()->at(index) == model.getVariable(index).getVector()->nonZeros());
+    }
+    for (index = 0; index < model.constraintCount(); index++) {
+        TEST_ASSERT(presolver.getRowNonzeros()->at(index) == model.getConstraint(index).getVector()->nonZeros());
+    }
+}
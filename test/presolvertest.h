@@ -14,6 +14,11 @@ private:
 
     void init();
     void singletonRows();
+    void doubletonEquation();
+    void doubletonEquationChain();
+    void dominatedColumn();
+
+    void checkNonzeroCounts(Presolver & presolver);
 };
 
 #endif // PRESOLVERTEST_H
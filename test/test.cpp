@@ -20,10 +20,11 @@
 #include <outputhandlertest.h>
 #include <linalgparameterhandlertest.h>
 #include <simplexparameterhandlertest.h>
-#include <dualratiotesttest.h>
-#include <presolvertest.h>*/
+#include <dualratiotesttest.h>*/
+#include <presolvertest.h>
 #include <coretest.h>
 #include <sparsevectortest.h>
+#include <densevectortest.h>
 
 
 #include <iomanip>
@@ -34,6 +35,7 @@ int main(int, char** )
 {
     setbuf(stdout, 0);
     Tester::addUnitTest(new SparseVectorTestSuite("SparseVector Test"));
+    Tester::addUnitTest(new DenseVectorTestSuite("DenseVector Test"));
     Tester::addUnitTest(new CoreTestSuite("Core Test"));
 //    Tester::addUnitTest(new VariableTestSuite("Variable Test"));
 //    Tester::addUnitTest(new ConstraintTestSuite("Constraint Test"));
@@ -52,7 +54,7 @@ int main(int, char** )
 //    Tester::addUnitTest(new LinalgParameterHandlerTestSuite("Linalg Parameter Handler Test"));
 //    Tester::addUnitTest(new SimplexParameterHandlerTestSuite("Simplex Parameter Handler Test"));
 
-    //Tester::addUnitTest(new PresolverTestSuite("Presolver Test"));
+    Tester::addUnitTest(new PresolverTestSuite("Presolver Test"));
 
     Tester::run();
 